@@ -11,6 +11,7 @@
 #include "open-gl-test.hpp"
 #include "plane-stack.hpp"
 #include "renderer.hpp"
+#include "replay.hpp"
 #include "screen.hpp"
 #include "util.hpp"
 
@@ -103,6 +104,21 @@ int main( int argc, char** argv ) {
     mode = m;
   }
 
+  // Record or replay the games that are played, e.g.:
+  //
+  //   exe --record=session.rnrj
+  //   exe --replay=session.rnrj
+  //
+  if( args.key_val_args.contains( "record" ) )
+    set_replay_mode( ReplayMode::record{
+        .path = args.key_val_args["record"] } );
+  if( args.key_val_args.contains( "replay" ) ) {
+    CHECK( !args.key_val_args.contains( "record" ),
+           "cannot both record and replay." );
+    set_replay_mode( ReplayMode::replay{
+        .path = args.key_val_args["replay"] } );
+  }
+
   linker_dont_discard_me();
   try {
     run( mode );
@@ -14,12 +14,16 @@
 #include "co-wait.hpp"
 #include "console.hpp"
 #include "logger.hpp"
+#include "lua-gc.hpp"
 #include "lua.hpp"
 #include "main-menu.hpp"
 #include "omni.hpp"
 #include "plane-stack.hpp"
 #include "terminal.hpp"
 
+// config
+#include "config/rn.rds.hpp"
+
 // luapp
 #include "luapp/state.hpp"
 
@@ -36,6 +40,10 @@ namespace rn {
 wait<> revolution_now( Planes& planes ) {
   lua::state st;
   lua_init( st );
+  LuaGcScheduler gc_scheduler( st, config_rn.lua.gc.mode,
+                               config_rn.lua.gc.idle_pause );
+  set_frame_lua_gc_scheduler( &gc_scheduler );
+  SCOPE_EXIT( set_frame_lua_gc_scheduler( nullptr ) );
   Terminal terminal( st );
   set_console_terminal( &terminal );
   SCOPE_EXIT( set_console_terminal( nullptr ) );
@@ -15,13 +15,37 @@
 #include "scope-exit.hpp"
 
 // C++ standard library
+#include <atomic>
 #include <cstring>
 #include <exception>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <system_error>
 
 using namespace std;
 
 namespace base {
 
+namespace {
+
+// Gives a name for a temporary file next to `p` that will not be
+// used by any other thread or (most likely) any other process
+// writing to the same file at the same time.
+fs::path unique_temp_path( fs::path const& p ) {
+  // Distinguishes processes.
+  static uint64_t const process_token = [] {
+    random_device rd;
+    return ( uint64_t( rd() ) << 32 ) | rd();
+  }();
+  // Distinguishes threads within this process.
+  static atomic<uint64_t> counter = 0;
+  return fs::path( p ).concat( fmt::format(
+      ".{:016x}.{}.tmp", process_token, counter++ ) );
+}
+
+} // namespace
+
 string error_read_text_file_msg( string_view            filename,
                                  e_error_read_text_file e ) {
   switch( e ) {
@@ -129,4 +153,37 @@ read_text_file_as_string( fs::path const& p ) {
   return res;
 }
 
+maybe<string> read_binary_file( fs::path const& p ) {
+  ifstream in( p, ios::binary );
+  if( !in.good() ) return nothing;
+  string res( ( istreambuf_iterator<char>( in ) ),
+              istreambuf_iterator<char>() );
+  if( in.bad() ) return nothing;
+  return res;
+}
+
+bool write_binary_file_atomic( fs::path const& p,
+                               string_view     data ) {
+  error_code ec;
+  if( p.has_parent_path() ) {
+    fs::create_directories( p.parent_path(), ec );
+    if( ec ) return false;
+  }
+  fs::path const tmp     = unique_temp_path( p );
+  bool const     written = [&] {
+    ofstream out( tmp, ios::binary );
+    if( !out.good() ) return false;
+    out.write( data.data(), data.size() );
+    return out.good();
+  }();
+  if( written ) fs::rename( tmp, p, ec );
+  if( !written || ec ) {
+    // Don't leave the temporary file behind.
+    error_code ignored;
+    fs::remove( tmp, ignored );
+    return false;
+  }
+  return true;
+}
+
 } // namespace base
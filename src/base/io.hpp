@@ -77,4 +77,21 @@ read_text_file( fs::path const& p,
 expect<std::string, e_error_read_text_file>
 read_text_file_as_string( fs::path const& p );
 
+/****************************************************************
+** Binary files.
+*****************************************************************/
+// Reads the entire file with no conversions. Returns nothing if
+// the file could not be opened or read.
+maybe<std::string> read_binary_file( fs::path const& p );
+
+// Writes to a temporary file next to the destination and then
+// renames it, so that a partially written file is never seen
+// (e.g. by another process reading a cache). The temporary file
+// has a unique name, so concurrent writers (threads or pro-
+// cesses) of the same file don't clobber each other's partial
+// output; the last one to finish wins. Creates the parent fold-
+// er if needed. Returns false on failure.
+bool write_binary_file_atomic( fs::path const& p,
+                               std::string_view data );
+
 } // namespace base
\ No newline at end of file
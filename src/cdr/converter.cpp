@@ -13,6 +13,9 @@
 // base
 #include "base/string.hpp"
 
+// C++ standard library
+#include <algorithm>
+
 using namespace std;
 
 namespace cdr {
@@ -45,6 +48,31 @@ base::valid_or<error> converter::end_field_tracking(
   return base::valid;
 }
 
+base::valid_or<error> converter::find_unrecognized_field(
+    table const& tbl, span<string_view const> used_keys ) {
+  for( auto const& [k, v] : tbl )
+    if( find( used_keys.begin(), used_keys.end(), k ) ==
+        used_keys.end() )
+      return err( "unrecognized key '{}' in table.", k );
+  return base::valid;
+}
+
+string converter::frame_desc::to_string() const {
+  switch( kind ) {
+    case e_kind::type: break;
+    case e_kind::index: return fmt::format( "index {}", index );
+    case e_kind::key:
+      return fmt::format( "value for key '{}'", name );
+  }
+  return string( name );
+}
+
+void converter::render_frames_on_error() {
+  frames_on_error_.clear();
+  for( frame_desc const& desc : frames_ )
+    frames_on_error_.push_back( desc.to_string() );
+}
+
 vector<string> const& converter::error_stack() const {
   return frames_on_error_;
 }
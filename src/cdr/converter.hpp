@@ -16,13 +16,51 @@
 
 // base
 #include "base/cc-specific.hpp"
+#include "base/error.hpp"
 #include "base/valid.hpp"
 
 // C++ standard library
+#include <array>
+#include <bitset>
+#include <span>
+#include <string_view>
 #include <unordered_set>
 
 namespace cdr {
 
+/****************************************************************
+** field_tracker
+*****************************************************************/
+// When converting a record with a fixed number of fields (N)
+// from a table, this records which fields were looked up (and
+// whether they were found) so that end_field_tracking can de-
+// tect unrecognized keys. Unlike tracking the keys in a set, it
+// does not allocate, which matters since this is done for every
+// reflected struct in a save file. The keys are held as
+// string_views so they must outlive the tracker; they will nor-
+// mally be string literals or reflected field names.
+template<size_t N>
+struct field_tracker {
+  void add( std::string_view key, bool found ) {
+    CHECK( next_ < N, "too many fields tracked." );
+    keys_[next_]  = key;
+    found_[next_] = found;
+    ++next_;
+  }
+
+  std::span<std::string_view const> keys() const {
+    return { keys_.data(), next_ };
+  }
+
+  // Number of tracked keys that were present in the table.
+  size_t num_found() const { return found_.count(); }
+
+ private:
+  std::array<std::string_view, N> keys_  = {};
+  std::bitset<N>                  found_ = {};
+  size_t                          next_  = 0;
+};
+
 /****************************************************************
 ** converter
 *****************************************************************/
@@ -75,31 +113,21 @@ struct converter {
 
   template<typename... Args>
   error err( std::string_view fmt_str, Args&&... args ) & {
-    frames_on_error_ = frames_;
+    render_frames_on_error();
     return error( fmt_str, std::forward<Args>( args )... );
   }
 
   template<FromCanonical T>
   result<std::remove_const_t<T>> from_index( list const& lst,
                                              int         idx ) {
-    auto _ = frame( "index {}", idx );
+    auto _ = index_frame( idx );
     return from<T>( lst[idx] );
   }
 
   template<FromCanonical T>
   result<std::remove_const_t<T>> from_field_no_tracking(
-      table const& tbl, std::string const& key ) {
-    auto _ = frame( "value for key '{}'", key );
-    base::maybe<value const&> val = tbl[key];
-    if( !val.has_value() ) {
-      static_assert( std::is_default_constructible_v<
-                     std::remove_const_t<T>> );
-      if( options_.default_construct_missing_fields )
-        return T{};
-      else
-        return err( "key '{}' not found in table.", key );
-    }
-    return from<T>( *val );
+      table const& tbl, std::string_view key ) {
+    return from_field_value<T>( key, tbl[key] );
   }
 
   // The `used_keys` set should be a set that you create in the
@@ -109,12 +137,23 @@ struct converter {
   // object so that the used fields can be recorded.
   template<FromCanonical T>
   result<std::remove_const_t<T>> from_field(
-      table const& tbl, std::string const& key,
+      table const& tbl, std::string_view key,
       std::unordered_set<std::string>& used_keys ) {
-    used_keys.insert( key );
+    used_keys.insert( std::string( key ) );
     return from_field_no_tracking<T>( tbl, key );
   }
 
+  // Same as above but for records with a fixed set of fields;
+  // this one does not allocate.
+  template<FromCanonical T, size_t N>
+  result<std::remove_const_t<T>> from_field(
+      table const& tbl, std::string_view key,
+      field_tracker<N>& tracker ) {
+    base::maybe<value const&> val = tbl[key];
+    tracker.add( key, val.has_value() );
+    return from_field_value<T>( key, val );
+  }
+
   // This one should only really be called by a top-level conver-
   // sion that is initiating the entire operation (which includes
   // unit tests, which will have to call this). Otherwise, you
@@ -123,7 +162,7 @@ struct converter {
   // that you are going into.
   template<FromCanonical T>
   result<std::remove_const_t<T>> from( value const& v ) {
-    auto _ = frame( base::demangled_typename<T>() );
+    auto _ = type_frame( base::demangled_typename<T>() );
     // The function called below should be found via ADL.
     auto res =
         from_canonical( *this, v, tag<std::remove_const_t<T>> );
@@ -164,8 +203,19 @@ struct converter {
       table const&                           tbl,
       std::unordered_set<std::string> const& used_keys );
 
+  template<size_t N>
+  base::valid_or<error> end_field_tracking(
+      table const& tbl, field_tracker<N> const& tracker ) {
+    if( options_.allow_unrecognized_fields ) return base::valid;
+    // The table keys are unique, so if each one of them was
+    // found then there can't be any others. This is the common
+    // case, and we only need to search for the bad key if not.
+    if( tracker.num_found() == tbl.size() ) return base::valid;
+    return find_unrecognized_field( tbl, tracker.keys() );
+  }
+
   template<ToCanonical T>
-  void to_field( table& tbl, std::string const& key,
+  void to_field( table& tbl, std::string_view key,
                  T const& o ) {
     if( !options_.write_fields_with_default_value && o == T{} )
       return;
@@ -195,10 +245,25 @@ struct converter {
   error from_canonical_readable_error( error const& err ) const;
 
  private:
+  // Formatting the name of each frame as we go would entail an
+  // allocation for every value converted, so instead we record
+  // what is needed to format it and only do so when there is an
+  // error. The string_views must outlive the frame, which they
+  // will since frames are scoped to the calls that use them.
+  struct frame_desc {
+    enum class e_kind { type, index, key };
+
+    e_kind           kind  = e_kind::type;
+    std::string_view name  = {};
+    int              index = 0;
+
+    std::string to_string() const;
+  };
+
   struct scoped_frame {
-    explicit scoped_frame( converter* owner, std::string name )
+    explicit scoped_frame( converter* owner, frame_desc desc )
       : owner_( owner ) {
-      owner_->frames_.push_back( std::move( name ) );
+      owner_->frames_.push_back( desc );
     }
 
     ~scoped_frame() noexcept { owner_->frames_.pop_back(); }
@@ -210,23 +275,50 @@ struct converter {
     converter* owner_;
   };
 
-  scoped_frame frame( std::string name ) {
-    return scoped_frame( this, std::move( name ) );
+  scoped_frame type_frame( std::string_view type_name ) {
+    return scoped_frame(
+        this, frame_desc{ .kind = frame_desc::e_kind::type,
+                          .name = type_name } );
   }
 
-  template<typename Arg1, typename... Args>
-  scoped_frame frame( std::string_view fmt_str, Arg1&& arg1,
-                      Args&&... args ) & {
-    return frame( fmt::format( fmt::runtime( fmt_str ),
-                               std::forward<Arg1>( arg1 ),
-                               std::forward<Args>( args )... ) );
+  scoped_frame index_frame( int idx ) {
+    return scoped_frame(
+        this, frame_desc{ .kind  = frame_desc::e_kind::index,
+                          .index = idx } );
+  }
+
+  scoped_frame key_frame( std::string_view key ) {
+    return scoped_frame(
+        this, frame_desc{ .kind = frame_desc::e_kind::key,
+                          .name = key } );
+  }
+
+  template<FromCanonical T>
+  result<std::remove_const_t<T>> from_field_value(
+      std::string_view key, base::maybe<value const&> val ) {
+    auto _ = key_frame( key );
+    if( !val.has_value() ) {
+      static_assert( std::is_default_constructible_v<
+                     std::remove_const_t<T>> );
+      if( options_.default_construct_missing_fields )
+        return T{};
+      else
+        return err( "key '{}' not found in table.", key );
+    }
+    return from<T>( *val );
   }
 
+  void render_frames_on_error();
+
+  base::valid_or<error> find_unrecognized_field(
+      table const&                      tbl,
+      std::span<std::string_view const> used_keys );
+
   options options_ = {};
 
   // Backtrace frames that are accumulated during the conversion
   // process.
-  std::vector<std::string> frames_ = {};
+  std::vector<frame_desc> frames_ = {};
 
   // These are the frames as they were on the most recent call to
   // generate an error. This gets reset when a call to
@@ -34,12 +34,15 @@ long table::ssize() const { return long( o_->size() ); }
 
 bool table::empty() const { return o_->empty(); }
 
-value& table::operator[]( string const& key ) {
-  return o_.get()[key];
+value& table::operator[]( string_view key ) {
+  auto& impl = o_.get();
+  if( auto it = impl.find( key ); it != impl.end() )
+    return it->second;
+  return impl.emplace( string( key ), value{} ).first->second;
 }
 
 base::maybe<value const&> table::operator[](
-    string const& key ) const {
+    string_view key ) const {
   auto& impl = o_.get();
   auto  it   = impl.find( key );
   if( it == impl.end() ) return base::nothing;
@@ -53,7 +56,7 @@ bool table::operator==( table const& rhs ) const {
   return o_ == rhs.o_;
 }
 
-bool table::contains( string const& key ) const {
+bool table::contains( string_view key ) const {
   return ( *this )[key].has_value();
 }
 
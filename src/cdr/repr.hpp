@@ -18,8 +18,10 @@
 
 // C++ standard library
 #include <concepts>
+#include <functional>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace cdr {
@@ -100,8 +102,11 @@ inline constexpr null_t null;
 // for specific keys (a use case where unordered_map would ex-
 // cel). Hence, std::map might be more performant here than
 // unordered_map, but no profiling was done.
+//
+// The comparator is transparent so that lookups can be done with
+// a string_view without first allocating a string for the key.
 template<std::same_as<value> V>
-using MapTo = std::map<std::string, V>;
+using MapTo = std::map<std::string, V, std::less<>>;
 
 // Writing this is a bit tricky because the table depends on
 // `value`, but `value` is an incomplete type at this point, so
@@ -140,10 +145,10 @@ struct table {
 
   // Will create the value if it doesn't exist, and it will have
   // an initial value of null.
-  value& operator[]( std::string const& key );
+  value& operator[]( std::string_view key );
 
   base::maybe<value const&> operator[](
-      std::string const& key ) const;
+      std::string_view key ) const;
 
   template<typename K, typename V>
   auto emplace( K&& k, V&& v );
@@ -151,7 +156,7 @@ struct table {
   void insert( value_type const& o );
   void insert( value_type&& o );
 
-  bool contains( std::string const& key ) const;
+  bool contains( std::string_view key ) const;
 
   size_t size() const;
   long   ssize() const;
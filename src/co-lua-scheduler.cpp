@@ -49,6 +49,7 @@ int number_of_queued_lua_coroutines() {
 }
 
 void remove_lua_coroutine_if_queued( lua::rthread th ) {
+  if( g_lua_coros_to_resume.empty() ) return;
   queue<lua::rthread> coros_to_resume;
   while( !g_lua_coros_to_resume.empty() ) {
     lua::rthread front = g_lua_coros_to_resume.front();
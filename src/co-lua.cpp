@@ -14,6 +14,7 @@
 #include "co-lua-scheduler.hpp"
 #include "co-wait.hpp"
 #include "lua-wait.hpp"
+#include "maybe.hpp"
 
 // luapp
 #include "luapp/c-api.hpp"
@@ -24,6 +25,9 @@
 // Lua
 #include "lua.h"
 
+// C++ standard library
+#include <algorithm>
+
 using namespace std;
 
 namespace rn {
@@ -76,23 +80,112 @@ int coro_runner( lua_State* L ) {
   return coro_continuation( L, LUA_OK, 0 );
 }
 
+/****************************************************************
+** Thread Pool
+*****************************************************************/
+// Finished runner threads are kept here for reuse instead of
+// creating a new one for each call. This is a table in the reg-
+// istry (so that it lives and dies with the Lua state) used as
+// a stack of threads.
+constexpr string_view kThreadPoolKey = "rn.co_lua.thread_pool";
+
+// Threads beyond this are left to the garbage collector.
+constexpr int kMaxPooledThreads = 32;
+
+LuaCoroPoolStats g_pool_stats;
+
+lua::table thread_pool( lua::cthread L ) {
+  auto st = lua::state::view( L );
+  return lua::table::create_or_get(
+      st.table.registry()[kThreadPoolKey] );
+}
+
+int thread_pool_size( lua::table const& pool ) {
+  lua::cthread const L = pool.this_cthread();
+  lua::push( L, pool );
+  int const size = lua::c_api( L ).rawlen( -1 );
+  lua::c_api( L ).pop();
+  return size;
+}
+
+// Pushes the runner function onto the (empty) stack of the
+// thread, which is the state that create_coro leaves it in.
+void push_runner( lua::rthread const& coro ) {
+  auto st = lua::state::view( coro.cthread() );
+  lua::push( coro.cthread(),
+             st.as<lua::rfunction>( &coro_runner ) );
+}
+
+maybe<lua::rthread> take_pooled_thread( lua::cthread L ) {
+  lua::table pool = thread_pool( L );
+  int const  size = thread_pool_size( pool );
+  if( size == 0 ) return nothing;
+  lua::rthread coro = pool[size].as<lua::rthread>();
+  pool[size]        = lua::nil;
+  return coro;
+}
+
+void return_pooled_thread( lua::rthread const& coro ) {
+  lua::table pool = thread_pool( coro.cthread() );
+  int const  size = thread_pool_size( pool );
+  if( size >= kMaxPooledThreads ) return;
+  push_runner( coro );
+  pool[size + 1] = coro;
+}
+
 } // namespace
 
 namespace internal {
 
 lua::rthread create_runner_coro( lua::cthread L ) {
+  ++g_pool_stats.live;
+  g_pool_stats.peak_live =
+      std::max( g_pool_stats.peak_live, g_pool_stats.live );
+  if( maybe<lua::rthread> coro = take_pooled_thread( L );
+      coro.has_value() ) {
+    ++g_pool_stats.reused;
+    return std::move( *coro );
+  }
+  ++g_pool_stats.created;
   auto st = lua::state::view( L );
   return st.thread.create_coro(
       st.as<lua::rfunction>( &coro_runner ) );
 }
 
 void cleanup_coro( lua::rthread coro ) {
-  (void)coro.resetthread();
+  --g_pool_stats.live;
+  // If the runner ran to completion (even if the Lua function
+  // raised an error, since that is caught by the runner) then
+  // the thread can't be in the queue and nothing else should
+  // hold onto it, so it can be reused. Otherwise we are can-
+  // celling it while it is suspended and waiting on something
+  // that could still try to resume it, so it is not safe to
+  // reuse.
+  bool const finished =
+      coro.status() == lua::thread_status::ok &&
+      coro.coro_status() == lua::coroutine_status::dead;
+  bool const reset_ok = coro.resetthread().valid();
+  if( finished ) {
+    if( reset_ok ) return_pooled_thread( coro );
+    return;
+  }
   remove_lua_coroutine_if_queued( coro );
 }
 
 } // namespace internal
 
+/****************************************************************
+** Public API
+*****************************************************************/
+LuaCoroPoolStats const& lua_coro_pool_stats() {
+  return g_pool_stats;
+}
+
+void reset_lua_coro_pool_stats() {
+  int const live = g_pool_stats.live;
+  g_pool_stats   = { .live = live, .peak_live = live };
+}
+
 void linker_dont_discard_module_co_lua();
 void linker_dont_discard_module_co_lua() {}
 
@@ -24,6 +24,7 @@
 #include "base/scope-exit.hpp"
 
 // C++ standard library
+#include <cstdint>
 #include <stdexcept>
 
 namespace rn {
@@ -36,6 +37,27 @@ void cleanup_coro( lua::rthread coro );
 
 } // namespace internal
 
+// Each call from C++ into a Lua coroutine runs it in its own
+// Lua thread; these are pooled and reused once the call fin-
+// ishes.
+struct LuaCoroPoolStats {
+  // Threads created because the pool was empty.
+  int64_t created = 0;
+  // Threads taken from the pool.
+  int64_t reused = 0;
+  // Threads currently running a call.
+  int live = 0;
+  // The maximum value of `live`.
+  int peak_live = 0;
+
+  bool operator==( LuaCoroPoolStats const& ) const = default;
+};
+
+LuaCoroPoolStats const& lua_coro_pool_stats();
+
+// Resets the counters, except for the number of live threads.
+void reset_lua_coro_pool_stats();
+
 struct lua_error_exception : std::runtime_error {
   lua_error_exception( std::string msg )
     : std::runtime_error( std::move( msg ) ) {}
@@ -39,7 +39,9 @@ wait<chrono::microseconds> wait_for_duration(
     p.set_value( duration_cast<chrono::microseconds>(
         Clock_t::now() - then ) );
   };
-  subscribe_to_frame_tick( after_time, us, /*repeating=*/false );
+  FrameSubscriptionId const id = subscribe_to_frame_tick(
+      after_time, us, /*repeating=*/false );
+  p.on_cancel( [id] { unsubscribe_from_frame_tick( id ); } );
   return p.wait();
 }
 
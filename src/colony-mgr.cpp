@@ -583,16 +583,18 @@ ColonyId found_colony( SS& ss, TS& ts, Player const& player,
   return col_id;
 }
 
-void change_colony_nation( Colony&     colony,
-                           UnitsState& units_state,
-                           e_nation    new_nation ) {
+void change_colony_nation( ColoniesState& colonies_state,
+                           UnitsState&    units_state,
+                           ColonyId       colony_id,
+                           e_nation       new_nation ) {
+  Colony const& colony = colonies_state.colony_for( colony_id );
   unordered_set<UnitId> units =
       units_at_or_in_colony( colony, units_state );
   for( UnitId unit_id : units )
     units_state.unit_for( unit_id ).change_nation( units_state,
                                                    new_nation );
   CHECK( colony.nation != new_nation );
-  colony.nation = new_nation;
+  colonies_state.change_nation( colony_id, new_nation );
 }
 
 void strip_unit_to_base_type( Player const& player, Unit& unit,
@@ -726,9 +728,11 @@ wait<> evolve_colonies_for_player( Planes& planes, SS& ss,
                                    TS& ts, Player& player ) {
   e_nation nation = player.nation;
   lg.info( "processing colonies for the {}.", nation );
+  // Copy the ids since colonies can disappear as we go.
   queue<ColonyId> colonies;
-  for( auto const& [colony_id, colony] : ss.colonies.all() )
-    if( colony.nation == nation ) colonies.push( colony_id );
+  for( ColonyId const colony_id :
+       ss.colonies.for_nation( nation ) )
+    colonies.push( colony_id );
   vector<ColonyEvolution> evolutions;
   while( !colonies.empty() ) {
     ColonyId colony_id = colonies.front();
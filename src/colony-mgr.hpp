@@ -55,9 +55,10 @@ valid_or<e_found_colony_err> unit_can_found_colony(
 // This will change the nation of the colony and all units that
 // are workers in the colony as well as units that are in the
 // same map square as the colony.
-void change_colony_nation( Colony&     colony,
-                           UnitsState& units_state,
-                           e_nation    new_nation );
+void change_colony_nation( ColoniesState& colonies_state,
+                           UnitsState&    units_state,
+                           ColonyId       colony_id,
+                           e_nation       new_nation );
 
 // Before calling this, it should already have been the case that
 // `can_found_colony` was called to validate; so it should work,
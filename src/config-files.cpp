@@ -25,6 +25,7 @@
 #include "base/error.hpp"
 
 // C++ standard library
+#include <algorithm>
 #include <string>
 
 using namespace std;
@@ -35,10 +36,6 @@ namespace {
 
 bool g_configs_loaded = false;
 
-string config_file_for_name( string const& name ) {
-  return "config/rcl/" + name + ".rcl";
-}
-
 void init_configs() {
   rds::PopulatorsMap const& populators =
       rds::config_populators();
@@ -48,8 +45,7 @@ void init_configs() {
   // binary, but it seems like a good idea to ensure that said
   // binary loads all config files, even if it doesn't use them.
   for( auto const& [name, populator] : populators ) {
-    string file = config_file_for_name( name );
-    replace( file.begin(), file.end(), '_', '-' );
+    string const file = config_file_for_name( name );
     base::expect<rcl::doc> doc = rcl::parse_file( file );
     CHECK( doc, "failed to load {}: {}", file, doc.error() );
     lg.debug( "running config populator for {}.", name );
@@ -71,6 +67,12 @@ namespace rn {
 
 bool configs_loaded() { return g_configs_loaded; }
 
+string config_file_for_name( string_view name ) {
+  string file = "config/rcl/" + string( name ) + ".rcl";
+  replace( file.begin(), file.end(), '_', '-' );
+  return file;
+}
+
 void linker_dont_discard_module_config_files();
 void linker_dont_discard_module_config_files() {}
 
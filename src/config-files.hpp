@@ -11,6 +11,10 @@
 
 #include "core-config.hpp"
 
+// C++ standard library
+#include <string>
+#include <string_view>
+
 namespace rn {
 
 // This tells us if all of the configs have been fully loaded.
@@ -19,4 +23,10 @@ namespace rn {
 // loaded from the contents of config files.
 bool configs_loaded();
 
+// Path (relative to the root of the repo) of the file that holds
+// the config with the given name, which is the name that its
+// populator is registered under. The file name uses hyphens
+// where the config name uses underscores.
+std::string config_file_for_name( std::string_view name );
+
 } // namespace rn
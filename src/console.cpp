@@ -15,6 +15,7 @@
 #include "deferred.hpp"
 #include "frame.hpp"
 #include "logger.hpp"
+#include "lua-gc.hpp"
 #include "plane.hpp"
 #include "screen.hpp"
 #include "terminal.hpp"
@@ -189,6 +190,26 @@ struct ConsolePlane::Impl : public Plane {
           .write( formatted );
       info_start -= Delta{ .h = formatted_size.h };
     }
+
+    auto timers = fmt::format( "timers: {}",
+                               active_frame_subscriptions() );
+    Delta timers_size = delta_for( timers );
+    renderer
+        .typer( "simple", info_start - timers_size, stats_color )
+        .write( timers );
+    info_start -= Delta{ .h = timers_size.h };
+
+    if( maybe<LuaGcStats const&> gc = frame_lua_gc_stats();
+        gc.has_value() ) {
+      auto lua_gc = fmt::format( "lua heap: {}KB gc/f: {}us",
+                                 gc->heap_bytes / 1024,
+                                 gc->frame_time.count() );
+      Delta lua_gc_size = delta_for( lua_gc );
+      renderer
+          .typer( "simple", info_start - lua_gc_size,
+                  stats_color )
+          .write( lua_gc );
+    }
   }
 
   e_input_handled input( input::event_t const& event ) override {
@@ -125,13 +125,11 @@ void john_paul_jones( SS& ss, TS& ts, Player const& player ) {
 // All currently existing indian converts are changed to free
 // colonists.
 void bartolome_de_las_casas( SS& ss, Player const& player ) {
-  unordered_map<UnitId, EuroUnitState const*> const& units_all =
-      ss.units.euro_all();
   auto free_colonist_type =
       UnitComposition::create( e_unit_type::free_colonist );
-  for( auto& [unit_id, state] : units_all ) {
+  for( UnitId const unit_id :
+       ss.units.euro_units_for_nation( player.nation ) ) {
     Unit& unit = ss.units.unit_for( unit_id );
-    if( unit.nation() != player.nation ) continue;
     if( unit.type() != e_unit_type::native_convert ) continue;
     // We have a native convert of the appropriate nation.
     unit.change_type( player, free_colonist_type );
@@ -152,6 +150,7 @@ void francisco_de_coronado( SS& ss, TS& ts,
                             Player const& player ) {
   unordered_map<ColonyId, Colony> const& colonies_all =
       ss.colonies.all();
+  auto const transaction = ts.map_updater.begin_transaction();
   for( auto& [colony_id, colony] : colonies_all ) {
     Rect const to_reveal =
         Rect::from( colony.location, Delta{ .w = 1, .h = 1 } )
@@ -170,13 +169,10 @@ void francisco_de_coronado( SS& ss, TS& ts,
 // mediately so that the player sees the stockades appear in the
 // same turn as receiving Sieur de La Salle.
 void sieur_de_la_salle( SS& ss, Player& player ) {
-  unordered_map<ColonyId, Colony> const& colonies_all =
-      ss.colonies.all();
-  for( auto& [colony_id, _] : colonies_all ) {
-    Colony& colony = ss.colonies.colony_for( colony_id );
-    if( colony.nation != player.nation ) continue;
-    give_stockade_if_needed( player, colony );
-  }
+  for( ColonyId const colony_id :
+       ss.colonies.for_nation( player.nation ) )
+    give_stockade_if_needed( player,
+                             ss.colonies.colony_for( colony_id ) );
 }
 
 // All tension levels between you and the natives are reduced to
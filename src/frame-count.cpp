@@ -25,8 +25,9 @@ wait<> wait_n_frames( FrameCount n ) {
   if( n.frames == 0 ) return make_wait<>();
   wait_promise<> p;
   auto after_ticks = [p]() mutable { p.set_value_emplace(); };
-  subscribe_to_frame_tick( after_ticks, n,
-                           /*repeating=*/false );
+  FrameSubscriptionId const id = subscribe_to_frame_tick(
+      after_ticks, n, /*repeating=*/false );
+  p.on_cancel( [id] { unsubscribe_from_frame_tick( id ); } );
   return p.wait();
 }
 
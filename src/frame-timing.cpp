@@ -0,0 +1,173 @@
+/****************************************************************
+**frame-timing.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Histograms of the time spent in each frame phase.
+*
+*****************************************************************/
+#include "frame-timing.hpp"
+
+// Revolution Now
+#include "error.hpp"
+#include "logger.hpp"
+
+// luapp
+#include "luapp/register.hpp"
+#include "luapp/state.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+#include "refl/to-str.hpp"
+
+// C++ standard library
+#include <bit>
+#include <cmath>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+refl::enum_map<e_frame_phase, FrameTimeHistogram>& histograms() {
+  static refl::enum_map<e_frame_phase, FrameTimeHistogram> h;
+  return h;
+}
+
+FrameTimeHistogram& latency_histogram() {
+  static FrameTimeHistogram h;
+  return h;
+}
+
+} // namespace
+
+/****************************************************************
+** FrameTimeHistogram
+*****************************************************************/
+int FrameTimeHistogram::bucket_for( uint64_t micros ) {
+  if( micros < kSubBuckets ) return int( micros );
+  // Shift the value so that it lands in [kSubBuckets,
+  // 2*kSubBuckets); each shift moves us up one group of buckets.
+  int const shift = bit_width( micros ) - ( kSubBucketBits + 1 );
+  return kSubBuckets * shift + int( micros >> shift );
+}
+
+uint64_t FrameTimeHistogram::bucket_upper_bound( int bucket ) {
+  if( bucket < 2 * kSubBuckets ) return uint64_t( bucket );
+  int const      shift = bucket / kSubBuckets - 1;
+  uint64_t const lower =
+      uint64_t( bucket % kSubBuckets + kSubBuckets ) << shift;
+  return lower + ( uint64_t{ 1 } << shift ) - 1;
+}
+
+void FrameTimeHistogram::record(
+    chrono::microseconds duration ) {
+  int64_t const  count = std::max<int64_t>( duration.count(), 0 );
+  uint64_t const micros = std::min( uint64_t( count ), kMaxMicros );
+  int const bucket = bucket_for( micros );
+  DCHECK( bucket < kNumBuckets );
+  ++buckets_[bucket];
+  ++count_;
+  sum_ += micros;
+  max_ = std::max( max_, micros );
+}
+
+void FrameTimeHistogram::reset() { *this = {}; }
+
+chrono::microseconds FrameTimeHistogram::percentile(
+    double p ) const {
+  if( count_ == 0 ) return {};
+  p = std::clamp( p, 0.0, 100.0 );
+  int64_t const target = std::max(
+      int64_t( std::ceil( p * count_ / 100.0 ) ), int64_t{ 1 } );
+  int64_t seen = 0;
+  for( int i = 0; i < kNumBuckets; ++i ) {
+    seen += buckets_[i];
+    if( seen >= target )
+      return chrono::microseconds(
+          std::min( bucket_upper_bound( i ), max_ ) );
+  }
+  return max();
+}
+
+chrono::microseconds FrameTimeHistogram::mean() const {
+  if( count_ == 0 ) return {};
+  return chrono::microseconds( sum_ / count_ );
+}
+
+/****************************************************************
+** Frame Phases
+*****************************************************************/
+void record_frame_phases(
+    FramePhaseDurations const& durations ) {
+  for( auto const& [phase, duration] : durations )
+    histograms()[phase].record(
+        chrono::duration_cast<chrono::microseconds>( duration ) );
+}
+
+FrameTimeHistogram const& frame_phase_histogram(
+    e_frame_phase phase ) {
+  return histograms()[phase];
+}
+
+/****************************************************************
+** Input Latency
+*****************************************************************/
+void record_input_latency( chrono::microseconds latency ) {
+  latency_histogram().record( latency );
+}
+
+FrameTimeHistogram const& input_latency_histogram() {
+  return latency_histogram();
+}
+
+/****************************************************************
+** Reporting
+*****************************************************************/
+void reset_frame_timings() {
+  for( auto& [phase, histogram] : histograms() )
+    histogram.reset();
+  latency_histogram().reset();
+}
+
+vector<string> frame_timing_report() {
+  vector<string> res;
+  static constexpr string_view kFmt = "{:<13} {:>7} {:>7} {:>7}";
+  res.push_back(
+      fmt::format( kFmt, "phase", "p50us", "p99us", "maxus" ) );
+  for( auto const& [phase, histogram] : histograms() )
+    res.push_back( fmt::format(
+        kFmt, refl::enum_value_name( phase ),
+        histogram.percentile( 50 ).count(),
+        histogram.percentile( 99 ).count(),
+        histogram.max().count() ) );
+  FrameTimeHistogram const& latency = latency_histogram();
+  res.push_back( fmt::format( kFmt, "input-latency",
+                             latency.percentile( 50 ).count(),
+                             latency.percentile( 99 ).count(),
+                             latency.max().count() ) );
+  return res;
+}
+
+/****************************************************************
+** Lua Bindings
+*****************************************************************/
+namespace {
+
+LUA_FN( dump_frame_timings, void ) {
+  int64_t const frames =
+      frame_phase_histogram( e_frame_phase::interval ).count();
+  lg.info( "frame timings over {} frames ({} input events):",
+           frames, input_latency_histogram().count() );
+  for( string const& line : frame_timing_report() )
+    lg.info( "{}", line );
+}
+
+LUA_FN( reset_frame_timings, void ) { reset_frame_timings(); }
+
+} // namespace
+
+} // namespace rn
@@ -0,0 +1,114 @@
+/****************************************************************
+**frame-timing.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Histograms of the time spent in each frame phase.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Rds
+#include "frame-timing.rds.hpp"
+
+// refl
+#include "refl/enum-map.hpp"
+
+// C++ standard library
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rn {
+
+/****************************************************************
+** FrameTimeHistogram
+*****************************************************************/
+// A fixed-size histogram of durations in microseconds with
+// log-linear buckets (in the style of HdrHistogram): each power
+// of two is split into kSubBuckets linear buckets, so a recorded
+// value is known to within ~6% regardless of its magnitude,
+// which is enough to get useful percentiles from both a 50us
+// phase and a 200ms hitch. Recording is O(1) and does not allo-
+// cate, so it is cheap enough to do several times per frame.
+struct FrameTimeHistogram {
+  // Values larger than this (~67s) are clamped.
+  static constexpr uint64_t kMaxMicros =
+      ( uint64_t{ 1 } << 26 ) - 1;
+
+  void record( std::chrono::microseconds duration );
+
+  void reset();
+
+  int64_t count() const { return count_; }
+
+  // Returns an upper bound (to within the bucket precision) of
+  // the value at the given percentile in [0, 100]. Returns zero
+  // if nothing has been recorded.
+  std::chrono::microseconds percentile( double p ) const;
+
+  // The exact maximum recorded value.
+  std::chrono::microseconds max() const {
+    return std::chrono::microseconds( max_ );
+  }
+
+  // The exact average.
+  std::chrono::microseconds mean() const;
+
+ private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kSubBuckets    = 1 << kSubBucketBits;
+  static constexpr int kNumBuckets =
+      kSubBuckets * ( 26 - kSubBucketBits + 1 );
+
+  static int      bucket_for( uint64_t micros );
+  static uint64_t bucket_upper_bound( int bucket );
+
+  std::array<uint32_t, kNumBuckets> buckets_ = {};
+  int64_t                           count_   = 0;
+  uint64_t                          sum_     = 0;
+  uint64_t                          max_     = 0;
+};
+
+/****************************************************************
+** Frame Phases
+*****************************************************************/
+// The time spent in each phase during a single frame.
+using FramePhaseDurations =
+    refl::enum_map<e_frame_phase, std::chrono::nanoseconds>;
+
+// Records the durations for one frame into the global his-
+// tograms.
+void record_frame_phases( FramePhaseDurations const& durations );
+
+FrameTimeHistogram const& frame_phase_histogram(
+    e_frame_phase phase );
+
+/****************************************************************
+** Input Latency
+*****************************************************************/
+// Records the time from when an input event was pumped from the
+// OS to when the first frame that could reflect it was pre-
+// sented.
+void record_input_latency( std::chrono::microseconds latency );
+
+FrameTimeHistogram const& input_latency_histogram();
+
+/****************************************************************
+** Reporting
+*****************************************************************/
+// Resets the frame phase and input latency histograms.
+void reset_frame_timings();
+
+// One line per phase, plus one for input latency, with the
+// p50/p99/max, suitable for logging or rendering in a fixed-
+// width font.
+std::vector<std::string> frame_timing_report();
+
+} // namespace rn
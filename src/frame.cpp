@@ -12,11 +12,14 @@
 
 // Revolution Now
 #include "co-runner.hpp"
+#include "frame-timing.hpp"
 #include "input.hpp"
+#include "lua-gc.hpp"
 #include "macros.hpp"
 #include "moving-avg.hpp"
 #include "plane-stack.hpp"
 #include "plane.hpp"
+#include "replay.hpp"
 #include "screen.hpp"
 #include "time.hpp"
 #include "variant.hpp"
@@ -31,7 +34,6 @@
 
 // base
 #include "base/function-ref.hpp"
-#include "base/lambda.hpp"
 #include "base/variant.hpp"
 
 // C++ standard library
@@ -49,70 +51,70 @@ MovingAverage frame_rate( chrono::seconds( 3 ) );
 
 EventCountMap g_event_counts;
 
-struct FrameSubscriptionTick {
-  bool       done = false; // for one-time notifications
-  FrameCount interval{ 1 };
-  uint64_t   last_message{ 0 };
-  FrameSubscriptionFunc func;
-};
-NOTHROW_MOVE( FrameSubscriptionTick );
+// Time spent in each phase of the current frame.
+FramePhaseDurations g_frame_phases;
 
-struct FrameSubscriptionTime {
-  bool done = false; // for one-time notifications
-  chrono::microseconds  interval;
-  Time_t                last_message{};
-  FrameSubscriptionFunc func;
-};
-NOTHROW_MOVE( FrameSubscriptionTime );
+uint64_t micros_since_epoch( Time_t const& time ) {
+  return chrono::duration_cast<chrono::microseconds>(
+             time.time_since_epoch() )
+      .count();
+}
 
-using FrameSubscription =
-    base::variant<FrameSubscriptionTick, FrameSubscriptionTime>;
-NOTHROW_MOVE( FrameSubscription );
+// Subscriptions are kept in timing wheels so that the cost per
+// frame does not grow with the number of subscribers, most of
+// which (e.g. animations) are just waiting on a deadline. One is
+// measured in frames and the other in microseconds with a slot
+// size of ~1ms.
+TimerWheel& frame_wheel() {
+  static TimerWheel wheel( /*now=*/0, /*resolution_bits=*/0 );
+  return wheel;
+}
 
-vector<FrameSubscription>& subscriptions() {
-  static vector<FrameSubscription> subs;
-  return subs;
+TimerWheel& time_wheel() {
+  static TimerWheel wheel( micros_since_epoch( Clock_t::now() ),
+                           /*resolution_bits=*/10 );
+  return wheel;
 }
 
-vector<FrameSubscription>& subscriptions_oneoff() {
-  static vector<FrameSubscription> subs;
-  return subs;
+// The wheels take a period of zero to mean one-shot, so a re-
+// peating subscription with a zero interval gets the smallest
+// non-zero period instead.
+uint64_t wheel_period( uint64_t interval, bool repeating ) {
+  if( !repeating ) return 0;
+  return std::max( interval, uint64_t{ 1 } );
 }
 
-void notify_subscribers() {
-  auto try_notify = []( FrameSubscription& sub ) {
-    overload_visit(
-        sub,
-        []( FrameSubscriptionTick& tick_sub ) {
-          auto& [done, interval, last_message, func] = tick_sub;
-          auto total = total_frame_count();
-          if( int( total - last_message ) >= interval.frames ) {
-            last_message = total;
-            func();
-            done = true;
-          }
-        },
-        []( FrameSubscriptionTime& time_sub ) {
-          auto& [done, interval, last_message, func] = time_sub;
-          auto now = Clock_t::now();
-          if( now - last_message >= interval ) {
-            last_message = now;
-            func();
-            done = true;
-          }
-        } );
-  };
-  for( auto& sub : subscriptions() ) try_notify( sub );
-  for( auto& sub : subscriptions_oneoff() ) try_notify( sub );
-  erase_if( subscriptions_oneoff(), []( FrameSubscription& fs ) {
-    return base::visit( L( _.done ), fs );
-  } );
+void notify_subscribers( Time_t const& curr_time ) {
+  frame_wheel().advance_to( total_frame_count() );
+  time_wheel().advance_to( micros_since_epoch( curr_time ) );
 }
 
 using InputReceivedFunc = base::function_ref<void()>;
 using FrameLoopBodyFunc = base::function_ref<void(
     rr::Renderer&, Planes&, InputReceivedFunc, Time_t const& )>;
 
+// Sleeps until the deadline. The OS will generally oversleep by
+// up to a scheduler tick, so we sleep until a bit before the
+// deadline and then spin for the remainder.
+void sleep_until_deadline(
+    chrono::steady_clock::time_point deadline ) {
+  auto const spin =
+      chrono::microseconds( config_gfx.pacing_spin_micros );
+  if( deadline - chrono::steady_clock::now() > spin )
+    this_thread::sleep_until( deadline - spin );
+  while( chrono::steady_clock::now() < deadline )
+    this_thread::yield();
+}
+
+// Runs the function and adds the time that it took to the given
+// phase of the current frame.
+template<typename Func>
+void timed( e_frame_phase phase, Func&& func ) {
+  auto const start = chrono::steady_clock::now();
+  std::forward<Func>( func )();
+  g_frame_phases[phase] += chrono::steady_clock::now() - start;
+}
+
 void frame_loop_scheduler( wait<> const&     what,
                            rr::Renderer&     renderer,
                            Planes&           planes,
@@ -123,6 +125,9 @@ void frame_loop_scheduler( wait<> const&     what,
 
   static auto time_of_last_input = Clock_t::now();
 
+  maybe<steady_clock::time_point> last_start;
+  steady_clock::time_point        deadline = steady_clock::now();
+
   while( !what.ready() && !what.has_exception() ) {
     microseconds normal_frame_length = 1000000us / g_target_fps;
     // If we go more than the configured time without any user
@@ -132,15 +137,62 @@ void frame_loop_scheduler( wait<> const&     what,
                             ? slow_frame_length
                             : normal_frame_length;
 
-    auto start = system_clock::now();
+    auto start        = system_clock::now();
+    auto steady_start = steady_clock::now();
+    // The interval is only known now, so this records the pre-
+    // vious frame.
+    if( last_start.has_value() ) {
+      g_frame_phases[e_frame_phase::interval] =
+          steady_start - *last_start;
+      record_frame_phases( g_frame_phases );
+    }
+    last_start = steady_start;
+    for( auto& [phase, duration] : g_frame_phases ) duration = {};
     frame_rate.tick();
     auto on_input = [] { time_of_last_input = Clock_t::now(); };
     // ----------------------------------------------------------
     body( renderer, planes, on_input, start );
     // ----------------------------------------------------------
-    auto delta = system_clock::now() - start;
-    if( delta < frame_length )
-      this_thread::sleep_for( frame_length - delta );
+    auto const work_end = steady_clock::now();
+    g_frame_phases[e_frame_phase::work] =
+        work_end - steady_start;
+    // When replaying a recorded game there is no player watching
+    // for whom to pace the frames, so run them back-to-back.
+    if( is_replaying() ) {
+      deadline = work_end;
+      continue;
+    }
+    // Give the Lua garbage collector some of the time that we
+    // would otherwise spend sleeping.
+    auto const frame_end =
+        ( config_gfx.frame_pacing == e_frame_pacing::deadline )
+            ? deadline + frame_length
+            : steady_start + frame_length;
+    if( frame_end > work_end )
+      timed( e_frame_phase::lua_gc, [&] {
+        run_frame_lua_gc( duration_cast<microseconds>(
+            frame_end - work_end ) );
+      } );
+    auto const now = steady_clock::now();
+    switch( config_gfx.frame_pacing ) {
+      case e_frame_pacing::sleep: {
+        auto delta = now - steady_start;
+        if( delta < frame_length )
+          this_thread::sleep_for( frame_length - delta );
+        break;
+      }
+      case e_frame_pacing::deadline: {
+        deadline += frame_length;
+        // If we've fallen behind (e.g. there was a hitch) then
+        // start the next frame right away, but don't try to make
+        // up for it by running frames back-to-back afterward.
+        if( deadline <= now )
+          deadline = now;
+        else
+          sleep_until_deadline( deadline );
+        break;
+      }
+    }
   }
 
   if( what.has_exception() ) {
@@ -159,8 +211,9 @@ void frame_loop_body( rr::Renderer& renderer, Planes& planes,
   // This invokes (synchronous/blocking) callbacks to any sub-
   // scribers that want to be notified at regular tick or time
   // intervals.
-  notify_subscribers();
-  run_all_coroutines();
+  timed( e_frame_phase::notify,
+         [&] { notify_subscribers( curr_time ); } );
+  timed( e_frame_phase::coroutines, run_all_coroutines );
 
   // Keep the state of the moving averages up to date even when
   // there are no ticks happening on them. Specifically, if there
@@ -170,7 +223,7 @@ void frame_loop_body( rr::Renderer& renderer, Planes& planes,
 
   // ----------------------------------------------------------
   // 1. Get Input.
-  input::pump_event_queue();
+  timed( e_frame_phase::input, input::pump_event_queue );
 
   auto is_win_resize = []( auto const& e ) {
     if_get( e, input::win_event_t, val ) {
@@ -182,17 +235,20 @@ void frame_loop_body( rr::Renderer& renderer, Planes& planes,
   auto& q = input::event_queue();
   while( !q.empty() ) {
     input_received();
-    input::event_t const& event = q.front();
-    if( is_win_resize( event ) ) on_main_window_resized();
-    planes.send_input( event );
-    q.pop();
-    run_all_coroutines();
+    timed( e_frame_phase::input, [&] {
+      input::event_t const& event = q.front();
+      if( is_win_resize( event ) ) on_main_window_resized();
+      planes.send_input( event );
+      q.pop();
+    } );
+    timed( e_frame_phase::coroutines, run_all_coroutines );
   }
 
   // ----------------------------------------------------------
   // 2. Update State.
-  planes.advance_state();
-  run_all_coroutines();
+  timed( e_frame_phase::advance_state,
+         [&] { planes.advance_state(); } );
+  timed( e_frame_phase::coroutines, run_all_coroutines );
 
   // ----------------------------------------------------------
   // 3. Draw.
@@ -204,37 +260,64 @@ void frame_loop_body( rr::Renderer& renderer, Planes& planes,
   renderer.set_logical_screen_size( main_window_logical_size() );
   renderer.set_physical_screen_size(
       main_window_physical_size() );
-  renderer.render_pass( [&]( rr::Renderer& renderer ) {
-    planes.draw( renderer );
-  } );
+  rr::RenderPassTimings timings;
+  renderer.render_pass(
+      [&]( rr::Renderer& renderer ) { planes.draw( renderer ); },
+      timings );
+  g_frame_phases[e_frame_phase::draw] += timings.draw;
+  g_frame_phases[e_frame_phase::upload] += timings.upload;
+  g_frame_phases[e_frame_phase::present] += timings.present;
+
+  // All of the events pumped so far have been processed, so this
+  // is the first frame that could reflect them.
+  Time_t const presented  = Clock_t::now();
+  auto&        pump_times = input::event_pump_times();
+  for( Time_t const pumped : pump_times )
+    record_input_latency(
+        chrono::duration_cast<chrono::microseconds>( presented -
+                                                     pumped ) );
+  pump_times.clear();
 };
 
 void deinit_frame() {
-  subscriptions().clear();
-  subscriptions_oneoff().clear();
+  frame_wheel().clear();
+  time_wheel().clear();
 }
 
 } // namespace
 
-void subscribe_to_frame_tick( FrameSubscriptionFunc func,
-                              FrameCount n, bool repeating ) {
-  ( repeating ? subscriptions : subscriptions_oneoff )()
-      .push_back( FrameSubscriptionTick{
-          .done         = false,
-          .interval     = n,
-          .last_message = total_frame_count(),
-          .func         = func } );
+FrameSubscriptionId subscribe_to_frame_tick(
+    FrameSubscriptionFunc func, FrameCount n, bool repeating ) {
+  CHECK_GE( n.frames, 0 );
+  TimerWheel&    wheel    = frame_wheel();
+  uint64_t const interval = uint64_t( n.frames );
+  return FrameSubscriptionId{
+      .timed = false,
+      .id    = wheel.add( total_frame_count() + interval,
+                          wheel_period( interval, repeating ),
+                          std::move( func ) ) };
+}
+
+FrameSubscriptionId subscribe_to_frame_tick(
+    FrameSubscriptionFunc func, chrono::microseconds n,
+    bool repeating ) {
+  CHECK_GE( n.count(), 0 );
+  TimerWheel&    wheel    = time_wheel();
+  uint64_t const interval = uint64_t( n.count() );
+  return FrameSubscriptionId{
+      .timed = true,
+      .id    = wheel.add(
+          micros_since_epoch( Clock_t::now() ) + interval,
+          wheel_period( interval, repeating ),
+          std::move( func ) ) };
+}
+
+void unsubscribe_from_frame_tick( FrameSubscriptionId id ) {
+  ( id.timed ? time_wheel() : frame_wheel() ).cancel( id.id );
 }
 
-void subscribe_to_frame_tick( FrameSubscriptionFunc func,
-                              chrono::microseconds  n,
-                              bool                  repeating ) {
-  ( repeating ? subscriptions : subscriptions_oneoff )()
-      .push_back(
-          FrameSubscriptionTime{ .done         = false,
-                                 .interval     = n,
-                                 .last_message = Clock_t::now(),
-                                 .func         = func } );
+int active_frame_subscriptions() {
+  return frame_wheel().size() + time_wheel().size();
 }
 
 EventCountMap& event_counts() { return g_event_counts; }
@@ -15,6 +15,7 @@
 // Revolution Now
 #include "frame-count.hpp"
 #include "moving-avg.hpp"
+#include "timer-wheel.hpp"
 #include "wait.hpp"
 
 // render
@@ -38,16 +39,34 @@ uint64_t total_frame_count();
 
 using FrameSubscriptionFunc = std::function<void( void )>;
 
+struct FrameSubscriptionId {
+  bool         timed = false;
+  TimerWheelId id    = {};
+
+  bool operator==( FrameSubscriptionId const& ) const = default;
+};
+
 // Subscribe to receive a notification after n ticks, or every n
-// ticks if repeating == true.
-void subscribe_to_frame_tick( FrameSubscriptionFunc f,
-                              FrameCount            n,
-                              bool repeating = true );
+// ticks if repeating == true. A repeating subscription with n=0
+// is treated as n=1, i.e. it is notified every frame.
+FrameSubscriptionId subscribe_to_frame_tick(
+    FrameSubscriptionFunc f, FrameCount n,
+    bool repeating = true );
 // Subscribe to receive a notification after n microseconds, or
-// every n microseconds if repeating == true.
-void subscribe_to_frame_tick( FrameSubscriptionFunc,
-                              std::chrono::microseconds n,
-                              bool repeating = true );
+// every n microseconds if repeating == true. A repeating sub-
+// scription with n=0 is treated as n=1us, which in practice
+// means that it is notified every frame.
+FrameSubscriptionId subscribe_to_frame_tick(
+    FrameSubscriptionFunc, std::chrono::microseconds n,
+    bool repeating = true );
+
+// Removes the subscription so that it will not be notified
+// again. This is a no-op if the subscription was one-time and
+// has already been notified.
+void unsubscribe_from_frame_tick( FrameSubscriptionId id );
+
+// Number of subscriptions that are waiting to be notified.
+int active_frame_subscriptions();
 
 using EventCountMap =
     std::unordered_map<std::string_view,
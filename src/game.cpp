@@ -21,12 +21,14 @@
 #include "land-view.hpp"
 #include "logger.hpp"
 #include "lua.hpp"
+#include "map-gen.hpp"
 #include "map-updater.hpp"
 #include "menu.hpp"
 #include "panel.hpp"
 #include "plane-stack.hpp"
 #include "rand.hpp"
 #include "renderer.hpp" // FIXME: remove
+#include "replay.hpp"
 #include "save-game.hpp"
 #include "ts.hpp"
 #include "turn.hpp"
@@ -37,6 +39,7 @@
 #include "ss/root.hpp"
 
 // luapp
+#include "luapp/rtable.hpp"
 #include "luapp/state.hpp"
 
 // refl
@@ -45,6 +48,9 @@
 // base
 #include "base/to-str-ext-std.hpp"
 
+// C++ standard library
+#include <limits>
+
 using namespace std;
 
 namespace rn {
@@ -94,9 +100,19 @@ wait<> run_game( Planes& planes, LoaderFunc loader ) {
   WindowPlane window_plane;
   group.window = &window_plane;
 
-  RealGui gui( window_plane );
+  RealGui real_gui( window_plane );
+
+  Rand real_rand; // random seed.
 
-  Rand rand; // random seed.
+  ReplaySession replay( replay_mode(), real_rand, real_gui );
+  IGui&         gui  = replay.gui();
+  IRand&        rand = replay.rand();
+  if( !replay_mode().holds<ReplayMode::none>() )
+    // Lua has its own generator, so seed it from the journal too
+    // so that scripts behave the same way in a replay.
+    st["math"]["randomseed"](
+        rand.between_ints( 0, numeric_limits<int>::max(),
+                           IRand::e_interval::closed ) );
 
   {
     // The real map updater needs to know the map size during
@@ -124,7 +140,7 @@ wait<> run_game( Planes& planes, LoaderFunc loader ) {
 
   LandViewPlane land_view_plane( planes, ss, ts,
                                  /*visibility=*/nothing );
-  group.land_view = &land_view_plane;
+  group.land_view = &replay.land_view( land_view_plane );
 
   // Perform the initial rendering of the map. Even though it
   // will be wasteful in a sense, we will render the entire map
@@ -148,9 +164,31 @@ wait<> run_game( Planes& planes, LoaderFunc loader ) {
 }
 
 wait<> handle_mode( Planes& planes, StartMode::new_ const& ) {
-  auto factory = []( SS&,
-                     TS& ts ) -> wait<base::NoDiscard<bool>> {
-    CHECK_HAS_VALUE( ts.lua["new_game"]["create"].pcall() );
+  auto factory = [&]( SS& ss,
+                      TS& ts ) -> wait<base::NoDiscard<bool>> {
+    reset_autosave_journal();
+    lua::table new_game = ts.lua["new_game"].as<lua::table>();
+    UNWRAP_CHECK( options,
+                  new_game["create_before_terrain"]
+                      .pcall<lua::table>() );
+    // Generating the terrain can take a while on large maps, so
+    // do it in the background so that the UI stays responsive.
+    int const seed = ts.rand.between_ints(
+        0, numeric_limits<int>::max(), IRand::e_interval::closed );
+    unique_ptr<StatusWindow> const status =
+        planes.window().status_window( "Generating map..." );
+    co_await generate_terrain_in_background(
+        ss, ts.map_updater, options["map"].as<lua::table>(), seed,
+        [&]( MapGenProgress const& progress ) {
+          string const msg =
+              fmt::format( "Generating map: {} ({}%)",
+                           progress.stage,
+                           int( progress.fraction * 100 ) );
+          lg.info( "{}", msg );
+          status->set_message( msg );
+        } );
+    CHECK_HAS_VALUE(
+        new_game["create_after_terrain"].pcall( options ) );
     co_return true;
   };
   co_await run_game( planes, factory );
@@ -17,6 +17,11 @@
 // base
 #include "base/generator.hpp"
 
+// C++ standard library
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
 namespace gfx {
 
 // These will divide the inside of the rect into subrects of the
@@ -33,4 +38,121 @@ base::generator<rect> subrects( rect rect,
                                 size chunk = size{ .w = 1,
                                                    .h = 1 } );
 
+/****************************************************************
+** subrect_range
+*****************************************************************/
+namespace detail {
+
+inline rn::Rect make_subrect( std::type_identity<rn::Rect>,
+                              int x, int y, int w, int h ) {
+  return rn::Rect{ .x = x, .y = y, .w = w, .h = h };
+}
+
+inline rect make_subrect( std::type_identity<rect>, int x,
+                          int y, int w, int h ) {
+  return rect{ .origin = { .x = x, .y = y },
+               .size   = { .w = w, .h = h } };
+}
+
+} // namespace detail
+
+// Yields the same rects as `subrects` above, in the same order,
+// but does so with a plain iterator that just steps a pair of
+// coordinates instead of with a coroutine, so there is no heap
+// allocation and the loop can be inlined. Use this for loops
+// that visit each tile of the map. Example:
+//
+//   for( Rect const r : gfx::subrect_range( world_rect ) ) ...
+//
+template<typename RectT, typename SizeT>
+class subrect_range {
+ public:
+  subrect_range( RectT r,
+                 SizeT chunk = SizeT{ .w = 1, .h = 1 } )
+    : chunk_( chunk ) {
+    if constexpr( std::is_same_v<RectT, rn::Rect> ) {
+      left_   = r.left_edge();
+      top_    = r.top_edge();
+      right_  = r.right_edge();
+      bottom_ = r.bottom_edge();
+    } else {
+      rect const norm = r.normalized();
+      left_           = norm.left();
+      top_            = norm.top();
+      right_          = norm.right();
+      bottom_         = norm.bottom();
+    }
+  }
+
+  struct sentinel {};
+
+  class iterator {
+   public:
+    using value_type      = RectT;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    // Since x and y are always inside the rect this gives the
+    // same result as clamping the chunk to the rect.
+    RectT operator*() const {
+      return detail::make_subrect(
+          std::type_identity<RectT>{}, x_, y_,
+          std::min( range_->chunk_.w, range_->right_ - x_ ),
+          std::min( range_->chunk_.h, range_->bottom_ - y_ ) );
+    }
+
+    iterator& operator++() {
+      x_ += range_->chunk_.w;
+      if( x_ >= range_->right_ ) {
+        x_ = range_->left_;
+        y_ += range_->chunk_.h;
+      }
+      return *this;
+    }
+
+    iterator operator++( int ) {
+      iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==( sentinel ) const {
+      return y_ >= range_->bottom_;
+    }
+
+   private:
+    friend class subrect_range;
+
+    iterator( subrect_range const* range, int x, int y )
+      : range_( range ), x_( x ), y_( y ) {}
+
+    subrect_range const* range_ = nullptr;
+    int                  x_     = 0;
+    int                  y_     = 0;
+  };
+
+  iterator begin() const {
+    // If the rect has no width then there is nothing to yield
+    // even if it has height.
+    if( left_ >= right_ ) return iterator( this, left_, bottom_ );
+    return iterator( this, left_, top_ );
+  }
+
+  sentinel end() const { return {}; }
+
+ private:
+  SizeT chunk_  = {};
+  int   left_   = 0;
+  int   top_    = 0;
+  int   right_  = 0;
+  int   bottom_ = 0;
+};
+
+subrect_range( rn::Rect ) -> subrect_range<rn::Rect, rn::Delta>;
+subrect_range( rn::Rect, rn::Delta )
+    -> subrect_range<rn::Rect, rn::Delta>;
+subrect_range( rect ) -> subrect_range<rect, size>;
+subrect_range( rect, size ) -> subrect_range<rect, size>;
+
 } // namespace gfx
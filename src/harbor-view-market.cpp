@@ -34,7 +34,13 @@ using namespace std;
 
 namespace rn {
 
-namespace {} // namespace
+namespace {
+
+constexpr ui::VertexCacheCounters kVertexCacheCounters{
+    .replayed_vertices = "harbor cached verts",
+    .micros_saved      = "harbor cached us saved" };
+
+} // namespace
 
 /****************************************************************
 ** HarborMarketCommodities
@@ -248,43 +254,63 @@ wait<> HarborMarketCommodities::drop(
         ts_, player_, invoice.price_change );
 }
 
+bool HarborMarketCommodities::update_price_tags() const {
+  bool changed = false;
+  for( e_commodity comm : refl::enum_values<e_commodity> ) {
+    PriceTag const tag{
+        .price = market_price( player_, comm ),
+        .boycott =
+            player_.old_world.market.commodities[comm].boycott };
+    if( tag == drawn_price_tags_[comm] ) continue;
+    drawn_price_tags_[comm] = tag;
+    changed                 = true;
+  }
+  return changed;
+}
+
 void HarborMarketCommodities::draw( rr::Renderer& renderer,
                                     Coord         coord ) const {
-  rr::Painter painter = renderer.painter();
-  auto        bds     = rect( coord );
-  // Our delta for this view has one extra pixel added to the
-  // width and height to allow for the border, and so we need to
-  // remove that otherwise the subrects method below will create
-  // too many boxes.
-  --bds.w;
-  --bds.h;
-  auto comm_it = refl::enum_values<e_commodity>.begin();
-  auto label   = CommodityLabel::buy_sell{};
-  for( Rect const rect : gfx::subrects( bds, g_tile_delta ) ) {
-    CHECK( comm_it != refl::enum_values<e_commodity>.end() );
-    // FIXME: this color should be deduped with the one in the
-    // colony view.
-    static gfx::pixel const bg_color =
-        gfx::pixel{ .r = 0x90, .g = 0x90, .b = 0xc0, .a = 0xff };
-    painter.draw_solid_rect( rect, bg_color );
-    painter.draw_empty_rect( rect,
-                             rr::Painter::e_border_mode::in_out,
-                             gfx::pixel::white() );
-    CommodityPrice price = market_price( player_, *comm_it );
-    label.bid            = price.bid;
-    label.ask            = price.ask;
-    render_commodity_annotated(
-        renderer,
-        rect.upper_left() + kCommodityInCargoHoldRenderingOffset,
-        *comm_it, label );
-    if( player_.old_world.market.commodities[*comm_it].boycott )
-      render_sprite( painter,
-                     rect.upper_left() +
-                         kCommodityInCargoHoldRenderingOffset,
-                     e_tile::boycott );
-    ++comm_it;
-  }
-  CHECK( comm_it == refl::enum_values<e_commodity>.end() );
+  // Computing the prices is cheap compared to rendering them, so
+  // we do that each frame to decide if the vertices from the
+  // previous frame can be reused.
+  if( update_price_tags() ) cache_.invalidate();
+  cache_.draw( renderer, coord, [&]( Coord where ) {
+    rr::Painter painter = renderer.painter();
+    auto        bds     = rect( where );
+    // Our delta for this view has one extra pixel added to the
+    // width and height to allow for the border, and so we need
+    // to remove that otherwise the subrects method below will
+    // create too many boxes.
+    --bds.w;
+    --bds.h;
+    auto comm_it = refl::enum_values<e_commodity>.begin();
+    auto label   = CommodityLabel::buy_sell{};
+    for( Rect const rect : gfx::subrects( bds, g_tile_delta ) ) {
+      CHECK( comm_it != refl::enum_values<e_commodity>.end() );
+      // FIXME: this color should be deduped with the one in the
+      // colony view.
+      static gfx::pixel const bg_color = gfx::pixel{
+          .r = 0x90, .g = 0x90, .b = 0xc0, .a = 0xff };
+      painter.draw_solid_rect( rect, bg_color );
+      painter.draw_empty_rect(
+          rect, rr::Painter::e_border_mode::in_out,
+          gfx::pixel::white() );
+      PriceTag const& tag = drawn_price_tags_[*comm_it];
+      label.bid           = tag.price.bid;
+      label.ask           = tag.price.ask;
+      render_commodity_annotated(
+          renderer,
+          rect.upper_left() + kCommodityInCargoHoldRenderingOffset,
+          *comm_it, label );
+      if( tag.boycott )
+        render_sprite( painter,
+                       rect.upper_left() +
+                           kCommodityInCargoHoldRenderingOffset,
+                       e_tile::boycott );
+      ++comm_it;
+    }
+    CHECK( comm_it == refl::enum_values<e_commodity>.end() );
+  } );
 }
 
 PositionedHarborSubView<HarborMarketCommodities>
@@ -328,6 +354,8 @@ HarborMarketCommodities::create( SS& ss, TS& ts, Player& player,
 HarborMarketCommodities::HarborMarketCommodities( SS& ss, TS& ts,
                                                   Player& player,
                                                   bool stacked )
-  : HarborSubView( ss, ts, player ), stacked_( stacked ) {}
+  : HarborSubView( ss, ts, player ),
+    stacked_( stacked ),
+    cache_( kVertexCacheCounters ) {}
 
 } // namespace rn
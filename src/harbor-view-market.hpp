@@ -17,6 +17,10 @@
 #include "drag-drop.hpp"
 #include "harbor-view-entities.hpp"
 #include "market.rds.hpp"
+#include "views.hpp"
+
+// refl
+#include "refl/enum-map.hpp"
 
 // base
 #include "base/vocab.hpp"
@@ -131,8 +135,25 @@ struct HarborMarketCommodities
     PriceChange price_change = {};
   };
 
-  maybe<Draggable> dragging_;
-  bool             stacked_ = false;
+  // What is shown for a single commodity. The cached vertices
+  // are only redrawn when one of these changes.
+  struct PriceTag {
+    CommodityPrice price   = {};
+    bool           boycott = false;
+
+    bool operator==( PriceTag const& ) const = default;
+  };
+
+  // Brings drawn_price_tags_ up to date (in place, since this
+  // is done every frame) and returns true if anything changed.
+  bool update_price_tags() const;
+
+  using PriceTags = refl::enum_map<e_commodity, PriceTag>;
+
+  maybe<Draggable>        dragging_;
+  bool                    stacked_ = false;
+  mutable PriceTags       drawn_price_tags_;
+  mutable ui::VertexCache cache_;
 };
 
 } // namespace rn
@@ -30,6 +30,18 @@ MapUpdaterOptionsPopper::~MapUpdaterOptionsPopper() noexcept {
     map_updater_.redraw();
 }
 
+/****************************************************************
+** MapUpdaterTransactionCommitter
+*****************************************************************/
+MapUpdaterTransactionCommitter::
+    ~MapUpdaterTransactionCommitter() noexcept {
+  CHECK_GT( map_updater_.transaction_depth_, 0 );
+  --map_updater_.transaction_depth_;
+  if( map_updater_.transaction_depth_ > 0 ) return;
+  map_updater_.last_transaction_stats_ =
+      map_updater_.commit_transaction();
+}
+
 } // namespace detail
 
 /****************************************************************
@@ -49,6 +61,11 @@ IMapUpdater::Popper IMapUpdater::push_options_and_redraw(
   return Popper{ *this };
 }
 
+IMapUpdater::Committer IMapUpdater::begin_transaction() {
+  ++transaction_depth_;
+  return Committer{ *this };
+}
+
 MapUpdaterOptions const& IMapUpdater::options() const {
   CHECK( !options_.empty() );
   return options_.top();
@@ -48,6 +48,27 @@ struct MapUpdaterOptions {
   bool operator==( MapUpdaterOptions const& ) const = default;
 };
 
+/****************************************************************
+** MapUpdaterTransactionStats
+*****************************************************************/
+// Describes the rendering work done when a transaction was com-
+// mitted.
+struct MapUpdaterTransactionStats {
+  // Number of tile redraws that were asked for while the trans-
+  // action was open, including duplicates and the neighbors of
+  // changed tiles.
+  int tiles_requested = 0;
+
+  // Number of distinct tiles that were actually redrawn. This is
+  // zero when the entire map was redrawn instead.
+  int tiles_redrawn = 0;
+
+  bool full_redraw = false;
+
+  bool operator==( MapUpdaterTransactionStats const& ) const =
+      default;
+};
+
 namespace detail {
 
 struct [[nodiscard]] MapUpdaterOptionsPopper {
@@ -60,6 +81,16 @@ struct [[nodiscard]] MapUpdaterOptionsPopper {
   IMapUpdater& map_updater_;
 };
 
+struct [[nodiscard]] MapUpdaterTransactionCommitter {
+  MapUpdaterTransactionCommitter( IMapUpdater& map_updater )
+    : map_updater_( map_updater ) {}
+  ~MapUpdaterTransactionCommitter() noexcept;
+  NO_COPY_NO_MOVE( MapUpdaterTransactionCommitter );
+
+ private:
+  IMapUpdater& map_updater_;
+};
+
 } // namespace detail
 
 /****************************************************************
@@ -77,7 +108,8 @@ struct IMapUpdater {
       base::function_ref<void( Matrix<MapSquare>& )>;
   using OptionsUpdateFunc =
       base::function_ref<void( MapUpdaterOptions& )>;
-  using Popper = detail::MapUpdaterOptionsPopper;
+  using Popper    = detail::MapUpdaterOptionsPopper;
+  using Committer = detail::MapUpdaterTransactionCommitter;
 
   IMapUpdater();
 
@@ -91,10 +123,12 @@ struct IMapUpdater {
                                   SquareUpdateFunc mutator ) = 0;
 
   // This function should be used when generating the map. It
-  // will not (re)draw the map or update player maps, since it is
-  // only expected to be called when setting up the world, and in
-  // that process the player maps and drawing happen subse-
-  // quently.
+  // will not (re)draw the map or make any squares visible to
+  // players, since it is only expected to be called when setting
+  // up the world, and in that process the player maps and draw-
+  // ing happen subsequently. If player maps already exist (e.g.
+  // in the map editor) then they keep their old view of any
+  // squares that were changed.
   virtual void modify_entire_map( MapUpdateFunc mutator ) = 0;
 
   // If the given nation cannot see the square it will be made
@@ -123,13 +157,42 @@ struct IMapUpdater {
   // tions and will redraw only they've actually changed.
   void mutate_options_and_redraw( OptionsUpdateFunc mutator );
 
+  // Opens a transaction that lasts until the returned object
+  // goes out of scope. While it is open the map is still updated
+  // immediately, but any tile redrawing is deferred; the tiles
+  // that need it are collected (along with their neighbors) and
+  // each is redrawn once when the transaction is committed, or
+  // the entire map is redrawn if there are enough of them. This
+  // should be used when changing or revealing many tiles in one
+  // go. Transactions can be nested, in which case only the out-
+  // ermost one commits.
+  Committer begin_transaction();
+
+  bool in_transaction() const { return transaction_depth_ > 0; }
+
+  // What was done when the most recent transaction committed.
+  MapUpdaterTransactionStats const& last_transaction_stats()
+      const {
+    return last_transaction_stats_;
+  }
+
   friend void to_str( IMapUpdater const& o, std::string& out,
                       base::ADL_t );
 
+ protected:
+  // Called when the outermost transaction is committed in order
+  // to do any deferred rendering.
+  virtual MapUpdaterTransactionStats commit_transaction() {
+    return {};
+  }
+
  private:
   friend struct detail::MapUpdaterOptionsPopper;
+  friend struct detail::MapUpdaterTransactionCommitter;
 
   std::stack<MapUpdaterOptions> options_;
+  int                           transaction_depth_ = 0;
+  MapUpdaterTransactionStats    last_transaction_stats_;
 };
 
 } // namespace rn
@@ -68,12 +68,13 @@ struct UnitCounts {
 UnitCounts unit_counts( UnitsState const& units_state,
                         e_nation          nation ) {
   UnitCounts counts;
-  for( auto const& [id, state] : units_state.euro_all() ) {
-    Unit const& unit = state->unit;
-    if( unit.nation() != nation ) continue;
+  for( UnitId const id :
+       units_state.euro_units_for_nation( nation ) ) {
+    EuroUnitState const& state = units_state.state_of( id );
+    Unit const&          unit  = state.unit;
     ++counts.total_units;
     if( auto harbor =
-            state->ownership.get_if<UnitOwnership::harbor>();
+            state.ownership.get_if<UnitOwnership::harbor>();
         harbor.has_value() ) {
       if( !unit.desc().ship ) {
         ++counts.units_on_dock;
@@ -15,6 +15,7 @@
 #include "error.hpp"
 #include "logger.hpp"
 #include "maybe.hpp"
+#include "task-graph.hpp"
 
 // base
 #include "base/lambda.hpp"
@@ -28,7 +29,9 @@
 #include "base-util/graph.hpp"
 
 // C++ standard library
+#include <algorithm>
 #include <span>
+#include <thread>
 #include <unordered_set>
 
 using namespace std;
@@ -72,11 +75,16 @@ unordered_map<e_init_routine, vector<e_init_routine>>
                        e_init_routine::configs, //
                        e_init_routine::sdl      //
                    } },
+                 { e_init_routine::images,
+                   {
+                       e_init_routine::configs, //
+                   } },
                  { e_init_routine::renderer,
                    {
                        e_init_routine::configs, //
                        e_init_routine::sdl,     //
-                       e_init_routine::screen   //
+                       e_init_routine::screen,  //
+                       e_init_routine::images   //
                    } },
                  { e_init_routine::sprites,
                    {
@@ -126,6 +134,44 @@ unordered_map<e_init_routine, vector<e_init_routine>>
                        e_init_routine::configs, //
                    } } };
 
+// Routines that don't touch SDL or the OpenGL context and so can
+// be run on a worker thread, overlapping with others that are
+// not dependent on them. All others have main thread affinity;
+// that includes sound, since SDL's audio subsystem must be ini-
+// tialized on the same thread as the rest of SDL. The sheet im-
+// ages are decoded on a worker so that the main thread only has
+// to build the atlas and upload it to the GL context.
+unordered_set<e_init_routine> const g_init_off_main_thread{
+    e_init_routine::configs,
+    e_init_routine::images,
+    e_init_routine::tunes,
+    e_init_routine::midiseq,
+};
+
+// Logs when each routine started and ended, relative to the
+// start of initialization, along with the critical path.
+void log_init_timeline( vector<e_init_routine> const& routines,
+                        vector<TaskGraphNode> const&  nodes,
+                        vector<TaskTiming> const&     timings ) {
+  vector<TaskTiming> by_start = timings;
+  sort( by_start.begin(), by_start.end(),
+        []( TaskTiming const& l, TaskTiming const& r ) {
+          return l.start < r.start;
+        } );
+  lg.debug( "startup timeline:" );
+  for( TaskTiming const& timing : by_start )
+    lg.debug( "  {:<11} {:>6.1f}ms - {:>6.1f}ms  ({})",
+              routines[timing.node],
+              timing.start.count() / 1000.0,
+              timing.end.count() / 1000.0,
+              timing.on_main_thread ? "main" : "worker" );
+  vector<e_init_routine> critical_path;
+  for( int node : task_graph_critical_path( nodes, timings ) )
+    critical_path.push_back( routines[node] );
+  lg.debug( "startup critical path: {}",
+            base::FmtJsonStyleList{ critical_path } );
+}
+
 } // namespace
 
 void register_init_routine( e_init_routine      routine,
@@ -208,14 +254,40 @@ void run_all_init_routines(
       reachable.insert( routine );
   }
 
+  // Build the task graph of the routines that we need to run.
+  // Routines that don't depend on each other will run concur-
+  // rently.
+  vector<e_init_routine>             routines;
+  unordered_map<e_init_routine, int> node_for;
   for( auto routine : sorted ) {
-    if( find( reachable.begin(), reachable.end(), routine ) !=
-        reachable.end() ) {
+    if( !reachable.contains( routine ) ) continue;
+    node_for[routine] = int( routines.size() );
+    routines.push_back( routine );
+  }
+  vector<TaskGraphNode> nodes;
+  int                   num_off_main = 0;
+  for( e_init_routine routine : routines ) {
+    TaskGraphNode& node = nodes.emplace_back();
+    // Note that we must use `at` here instead of operator[] on
+    // the maps since these can be run concurrently.
+    node.run = [routine] {
       lg.debug( "initializing: {}", routine );
-      init_functions()[routine]();
-      init_routine_run_map()[routine] = true;
-    }
+      init_functions().at( routine )();
+      init_routine_run_map().at( routine ) = true;
+    };
+    for( e_init_routine dep : g_init_deps[routine] )
+      node.deps.push_back( node_for.at( dep ) );
+    node.main_thread =
+        !g_init_off_main_thread.contains( routine );
+    if( !node.main_thread ) ++num_off_main;
   }
+  int const num_workers =
+      std::min( num_off_main,
+                int( std::thread::hardware_concurrency() ) );
+
+  vector<TaskTiming> const timings =
+      run_task_graph( nodes, num_workers );
+  log_init_timeline( routines, nodes, timings );
 
   g_init_finished = true;
 }
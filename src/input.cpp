@@ -450,17 +450,30 @@ maybe<event_t> next_event() {
 
 constexpr int       kMaxEventQueueSize = 10000;
 std::queue<event_t> g_event_queue;
+vector<Time_t>      g_event_pump_times;
 
 } // namespace
 
 void pump_event_queue() {
-  while( auto event = input::next_event() )
-    if( g_event_queue.size() < kMaxEventQueueSize )
+  while( auto event = input::next_event() ) {
+    // Mouse motion can arrive much faster than the frame rate
+    // and each event gets dispatched to the planes, so fold it
+    // into the previous one if that one has not been processed
+    // yet.
+    if( !g_event_queue.empty() &&
+        coalesce_events( g_event_queue.back(), *event ) )
+      continue;
+    if( g_event_queue.size() < kMaxEventQueueSize ) {
       g_event_queue.push( *event );
+      g_event_pump_times.push_back( Clock_t::now() );
+    }
+  }
 }
 
 std::queue<event_t>& event_queue() { return g_event_queue; }
 
+vector<Time_t>& event_pump_times() { return g_event_pump_times; }
+
 /****************************************************************
 ** Utilities
 *****************************************************************/
@@ -527,6 +540,37 @@ event_t move_mouse_origin_by( event_t const& event,
   return new_event;
 }
 
+bool coalesce_events( event_t& into, event_t const& next ) {
+  auto same_state = []( event_base_t const& l,
+                        event_base_t const& r ) {
+    return l.mod == r.mod && l.l_mouse_down == r.l_mouse_down &&
+           l.r_mouse_down == r.r_mouse_down;
+  };
+  if( auto* l = std::get_if<mouse_move_event_t>( &into ) ) {
+    auto* r = std::get_if<mouse_move_event_t>( &next );
+    if( r == nullptr || !same_state( *l, *r ) ) return false;
+    // Keep the `prev` of the first so that the delta of the
+    // merged event is the sum of the two.
+    l->pos = r->pos;
+    return true;
+  }
+  if( auto* l = std::get_if<mouse_drag_event_t>( &into ) ) {
+    auto* r = std::get_if<mouse_drag_event_t>( &next );
+    if( r == nullptr || !same_state( *l, *r ) ) return false;
+    if( l->button != r->button ) return false;
+    if( l->state.origin != r->state.origin ) return false;
+    // The begin and end events must still be seen by the planes,
+    // but the updates in between can be folded into either the
+    // begin event or the previous update.
+    if( l->state.phase == e_drag_phase::end ) return false;
+    if( r->state.phase != e_drag_phase::in_progress )
+      return false;
+    l->pos = r->pos;
+    return true;
+  }
+  return false;
+}
+
 maybe<mouse_event_base_t const&> is_mouse_event(
     event_t const& event ) {
   // For any events that are mouse events it will return the base
@@ -15,6 +15,7 @@
 // Revolution Now
 #include "macros.hpp"
 #include "maybe.hpp"
+#include "time.hpp"
 
 // Rds
 #include "input.rds.hpp"
@@ -32,6 +33,7 @@
 
 // C++ standard library.
 #include <queue>
+#include <vector>
 
 namespace rn::input {
 
@@ -165,6 +167,11 @@ void pump_event_queue();
 // Callers are responsible for popping used events.
 std::queue<event_t>& event_queue();
 
+// The time at which each event that was pushed onto the queue
+// was pumped, in order, used to measure input latency. Callers
+// are responsible for clearing it.
+std::vector<Time_t>& event_pump_times();
+
 /****************************************************************
 ** Utilities
 *****************************************************************/
@@ -187,6 +194,13 @@ maybe<mouse_event_base_t const&> is_mouse_event(
     event_t const& event );
 maybe<Coord const&> mouse_position( event_t const& event );
 
+// If `next` is a mouse motion or drag update that can be merged
+// into `into` (i.e. same kind of event, with the same buttons
+// and keys held down) then does so and returns true. The merged
+// event will have the position of `next` and the previous posi-
+// tion of `into`, so that no motion is lost.
+bool coalesce_events( event_t& into, event_t const& next );
+
 // These are useful if a client of the input events wants to
 // treat dragging as normal mouse motion/click events.
 maybe<mouse_button_event_t> drag_event_to_mouse_button_event(
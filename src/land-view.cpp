@@ -26,6 +26,7 @@
 #include "plane-stack.hpp"
 #include "plane.hpp"
 #include "rand.hpp"
+#include "render-terrain.hpp"
 #include "render.hpp"
 #include "road.hpp"
 #include "screen.hpp"
@@ -1268,10 +1269,7 @@ struct LandViewPlane::Impl : public Plane {
     renderer.set_camera( translation.distance_from_origin(),
                          zoom );
     // Should do this after setting the camera.
-    renderer.render_buffer(
-        rr::e_render_target_buffer::landscape );
-    renderer.render_buffer(
-        rr::e_render_target_buffer::landscape_annex );
+    render_landscape_buffers( renderer, zoom );
   }
 
   void render_land_view( rr::Renderer& renderer ) const {
@@ -384,6 +384,9 @@ wait<LostCityRumorResult_t> run_lost_city_rumor_result(
       type, burial_type, has_burial_grounds, ss, ts, player,
       unit_id, world_square );
 
+  // Both of the below redraw the same tiles.
+  auto const transaction = ts.map_updater.begin_transaction();
+
   // Remove lost city rumor.
   ts.map_updater.modify_map_square(
       world_square, []( MapSquare& square ) {
@@ -20,6 +20,7 @@ void linker_dont_discard_module_conductor();
 void linker_dont_discard_module_co_lua();
 void linker_dont_discard_module_lua_ui();
 void linker_dont_discard_module_map_gen();
+void linker_dont_discard_module_map_gen_kernels();
 void linker_dont_discard_module_config_files();
 void linker_dont_discard_module_ss_fathers();
 void linker_dont_discard_module_time();
@@ -39,6 +40,7 @@ void linker_dont_discard_me() {
   linker_dont_discard_module_co_lua();
   linker_dont_discard_module_lua_ui();
   linker_dont_discard_module_map_gen();
+  linker_dont_discard_module_map_gen_kernels();
   linker_dont_discard_module_config_files();
   linker_dont_discard_module_ss_fathers();
   linker_dont_discard_module_time();
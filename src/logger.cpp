@@ -87,8 +87,8 @@ struct ConsoleLogger final : public ILogger {
             base::SourceLoc const& ) override {
     if( target < global_log_level() ) return;
     if( terminal_ )
-      // Note that the console has its own mutex, so we don't
-      // need to guard this.
+      // Note that logging to the console is thread safe, so we
+      // don't need to guard this.
       terminal_->log( what );
   }
   Terminal* terminal_ = nullptr;
@@ -113,8 +113,8 @@ void set_console_terminal( Terminal* terminal ) {
 *****************************************************************/
 namespace {
 
-// The console has its own mutex and so does not need one here.
-// We only need the mutex for the terminal logger.
+// Logging to the console is thread safe and so does not need a
+// mutex here. We only need the mutex for the terminal logger.
 mutex& terminal_mutex() {
   static mutex m;
   return m;
@@ -0,0 +1,166 @@
+/****************************************************************
+**lua-cache.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: On-disk cache of compiled Lua modules.
+*
+*****************************************************************/
+#include "lua-cache.hpp"
+
+// Revolution Now
+#include "logger.hpp"
+
+// luapp
+#include "luapp/c-api.hpp"
+#include "luapp/state.hpp"
+
+// base
+#include "base/io.hpp"
+
+// C++ standard library
+#include <cstring>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+// "RLUC" in little endian.
+constexpr uint32_t kCacheMagic = 0x43554C52;
+
+// Increment this whenever the format of the cache file changes.
+constexpr uint32_t kCacheVersion = 2;
+
+uint64_t const kFnvOffsetBasis = 0xcbf29ce484222325;
+
+struct CacheHeader {
+  uint32_t magic         = 0;
+  uint32_t version       = 0;
+  uint64_t source_hash   = 0;
+  uint64_t source_size   = 0;
+  uint64_t bytecode_size = 0;
+  // The bytecode is loaded without being verified by Lua, so we
+  // need to make sure that it has not been corrupted on disk.
+  uint64_t bytecode_hash = 0;
+};
+
+static_assert( sizeof( CacheHeader ) == 40 );
+
+// FNV-1a.
+uint64_t hash_bytes( string_view bytes, uint64_t hash ) {
+  for( char const c : bytes ) {
+    hash ^= uint64_t( static_cast<unsigned char>( c ) );
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+fs::path cache_file_for( fs::path const& file,
+                         fs::path const& cache_dir ) {
+  fs::path relative = file.relative_path();
+  relative.replace_extension( ".luac" );
+  return cache_dir / relative;
+}
+
+} // namespace
+
+/****************************************************************
+** Cache Entries
+*****************************************************************/
+uint64_t lua_source_hash( string_view source ) {
+  uint64_t const hash =
+      hash_bytes( lua::c_api::release(), kFnvOffsetBasis );
+  return hash_bytes( source, hash );
+}
+
+string make_lua_cache_entry( string_view source,
+                             string_view bytecode ) {
+  CacheHeader const header{
+      .magic         = kCacheMagic,
+      .version       = kCacheVersion,
+      .source_hash   = lua_source_hash( source ),
+      .source_size   = source.size(),
+      .bytecode_size = bytecode.size(),
+      .bytecode_hash = hash_bytes( bytecode, kFnvOffsetBasis ) };
+  string res( sizeof( header ) + bytecode.size(), '\0' );
+  memcpy( res.data(), &header, sizeof( header ) );
+  memcpy( res.data() + sizeof( header ), bytecode.data(),
+          bytecode.size() );
+  return res;
+}
+
+maybe<string_view> lua_cache_entry_bytecode(
+    string_view entry, string_view source ) {
+  CacheHeader header;
+  if( entry.size() < sizeof( header ) ) return nothing;
+  memcpy( &header, entry.data(), sizeof( header ) );
+  if( header.magic != kCacheMagic ) return nothing;
+  if( header.version != kCacheVersion ) return nothing;
+  if( header.source_size != source.size() ) return nothing;
+  if( header.bytecode_size != entry.size() - sizeof( header ) )
+    return nothing;
+  if( header.source_hash != lua_source_hash( source ) )
+    return nothing;
+  string_view const bytecode = entry.substr( sizeof( header ) );
+  if( header.bytecode_hash !=
+      hash_bytes( bytecode, kFnvOffsetBasis ) )
+    return nothing;
+  return bytecode;
+}
+
+/****************************************************************
+** Loading
+*****************************************************************/
+LuaChunk load_lua_file( lua::state& st, fs::path const& file,
+                        maybe<fs::path const&> cache_dir ) {
+  maybe<string> const source = base::read_binary_file( file );
+  if( !source.has_value() )
+    st.error( "failed to read lua file {}.", file );
+  // Same as the name that luaL_loadfile would give it.
+  string const chunk_name = "@" + file.string();
+
+  maybe<fs::path> cache_file;
+  if( cache_dir.has_value() )
+    cache_file = cache_file_for( file, *cache_dir );
+  if( cache_file.has_value() ) {
+    if( maybe<string> const entry =
+            base::read_binary_file( *cache_file );
+        entry.has_value() ) {
+      if( maybe<string_view> const bytecode =
+              lua_cache_entry_bytecode( *entry, *source );
+          bytecode.has_value() ) {
+        lua::lua_expect<lua::rfunction> fn =
+            st.script.load_chunk_safe( *bytecode, chunk_name );
+        if( fn.has_value() )
+          return LuaChunk{ .fn = *fn, .from_cache = true };
+        lg.warn( "failed to load lua cache file {}: {}",
+                 *cache_file, fn.error() );
+      } else {
+        lg.debug( "lua cache file {} is stale.", *cache_file );
+      }
+    }
+  }
+
+  lua::lua_expect<lua::rfunction> fn =
+      st.script.load_chunk_safe( *source, chunk_name );
+  if( !fn.has_value() )
+    st.error( "failed to load lua file {}: {}", file,
+              fn.error() );
+  if( cache_file.has_value() ) {
+    lua::lua_expect<string> const bytecode =
+        st.script.dump( *fn );
+    if( !bytecode.has_value() ||
+        !base::write_binary_file_atomic(
+            *cache_file,
+            make_lua_cache_entry( *source, *bytecode ) ) )
+      lg.warn( "failed to write lua cache file {}.",
+               *cache_file );
+  }
+  return LuaChunk{ .fn = *fn, .from_cache = false };
+}
+
+} // namespace rn
@@ -0,0 +1,66 @@
+/****************************************************************
+**lua-cache.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: On-disk cache of compiled Lua modules.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Revolution Now
+#include "maybe.hpp"
+
+// luapp
+#include "luapp/rfunction.hpp"
+
+// base
+#include "base/fs.hpp"
+
+// C++ standard library
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lua {
+struct state;
+}
+
+namespace rn {
+
+// Identifies the source code that a cache entry was compiled
+// from. This includes the Lua version, since bytecode is not
+// portable across versions.
+uint64_t lua_source_hash( std::string_view source );
+
+// Wraps the bytecode with a header identifying the source.
+std::string make_lua_cache_entry( std::string_view source,
+                                  std::string_view bytecode );
+
+// Returns the bytecode in the entry, or nothing if the entry is
+// not valid (including if the bytecode does not match its
+// checksum) or was compiled from different source.
+maybe<std::string_view> lua_cache_entry_bytecode(
+    std::string_view entry, std::string_view source );
+
+struct LuaChunk {
+  lua::rfunction fn;
+  // Whether the function was loaded from the bytecode cache as
+  // opposed to being compiled from source.
+  bool from_cache = false;
+};
+
+// Loads the Lua file into a function without running it. If a
+// cache folder is given then the function is loaded from the
+// bytecode there when it is up to date with the source; other-
+// wise the source is compiled and the cache updated. Failure to
+// read or write the cache is not an error. Throws a Lua error if
+// the file cannot be read or compiled.
+LuaChunk load_lua_file( lua::state& st, fs::path const& file,
+                        maybe<fs::path const&> cache_dir );
+
+} // namespace rn
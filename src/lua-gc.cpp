@@ -0,0 +1,137 @@
+/****************************************************************
+**lua-gc.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Scheduling of Lua garbage collection work.
+*
+*****************************************************************/
+#include "lua-gc.hpp"
+
+// Revolution Now
+#include "logger.hpp"
+
+// config
+#include "config/rn.rds.hpp"
+
+// luapp
+#include "luapp/c-api.hpp"
+#include "luapp/register.hpp"
+#include "luapp/state.hpp"
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+LuaGcScheduler* g_scheduler = nullptr;
+
+lua::c_api c_api_for( lua::state& st ) {
+  return lua::c_api( st.thread.main().cthread() );
+}
+
+} // namespace
+
+/****************************************************************
+** Collector Mode
+*****************************************************************/
+void configure_lua_gc( lua::state& st ) {
+  auto const& conf = config_rn.lua.gc;
+  lua::c_api  C    = c_api_for( st );
+  switch( conf.mode ) {
+    case e_lua_gc_mode::incremental:
+      C.gc_incremental( conf.pause, conf.step_multiplier,
+                        conf.step_size );
+      break;
+    case e_lua_gc_mode::generational:
+      C.gc_generational( conf.minor_multiplier,
+                         conf.major_multiplier );
+      break;
+  }
+}
+
+/****************************************************************
+** LuaGcScheduler
+*****************************************************************/
+LuaGcScheduler::LuaGcScheduler( lua::state&   st,
+                                e_lua_gc_mode mode,
+                                int           idle_pause )
+  : st_( st ), mode_( mode ), idle_pause_( idle_pause ) {
+  heap_after_last_cycle_ = c_api_for( st_ ).gc_count_bytes();
+}
+
+void LuaGcScheduler::run_frame( chrono::microseconds budget ) {
+  using namespace chrono;
+  lua::c_api C = c_api_for( st_ );
+  stats_.frame_time  = {};
+  stats_.frame_steps = 0;
+  stats_.heap_bytes  = C.gc_count_bytes();
+  if( budget <= 0us ) return;
+  if( !in_cycle_ ) {
+    int64_t const threshold =
+        heap_after_last_cycle_ * idle_pause_ / 100;
+    if( stats_.heap_bytes < threshold ) return;
+    in_cycle_ = true;
+  }
+  auto const start    = steady_clock::now();
+  auto const deadline = start + budget;
+  auto       now      = start;
+  while( now < deadline ) {
+    bool const finished =
+        C.gc_step( /*kbytes=*/0 ) ||
+        mode_ == e_lua_gc_mode::generational;
+    ++stats_.frame_steps;
+    now = steady_clock::now();
+    if( finished ) {
+      in_cycle_ = false;
+      ++stats_.cycles_finished;
+      heap_after_last_cycle_ = C.gc_count_bytes();
+      break;
+    }
+  }
+  stats_.frame_time = duration_cast<microseconds>( now - start );
+  stats_.heap_bytes = C.gc_count_bytes();
+}
+
+void set_frame_lua_gc_scheduler( LuaGcScheduler* scheduler ) {
+  g_scheduler = scheduler;
+}
+
+void run_frame_lua_gc( chrono::microseconds idle_time ) {
+  if( g_scheduler == nullptr ) return;
+  auto const max_budget = chrono::microseconds(
+      config_rn.lua.gc.frame_budget_micros );
+  // Only use half of the idle time since a step can overshoot.
+  g_scheduler->run_frame(
+      std::min( idle_time / 2, max_budget ) );
+}
+
+maybe<LuaGcStats const&> frame_lua_gc_stats() {
+  if( g_scheduler == nullptr ) return nothing;
+  return g_scheduler->stats();
+}
+
+/****************************************************************
+** Lua Bindings
+*****************************************************************/
+namespace {
+
+LUA_FN( dump_lua_gc_stats, void ) {
+  maybe<LuaGcStats const&> stats = frame_lua_gc_stats();
+  if( !stats.has_value() ) {
+    lg.info( "lua gc scheduler is not running." );
+    return;
+  }
+  lg.info( "lua heap: {}KB", stats->heap_bytes / 1024 );
+  lg.info( "lua gc last frame: {}us in {} steps",
+           stats->frame_time.count(), stats->frame_steps );
+  lg.info( "lua gc cycles finished in idle time: {}",
+           stats->cycles_finished );
+}
+
+} // namespace
+
+} // namespace rn
@@ -0,0 +1,98 @@
+/****************************************************************
+**lua-gc.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Scheduling of Lua garbage collection work.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Revolution Now
+#include "maybe.hpp"
+
+// config
+#include "config/rn.rds.hpp"
+
+// C++ standard library
+#include <chrono>
+#include <cstdint>
+
+namespace lua {
+struct state;
+}
+
+namespace rn {
+
+/****************************************************************
+** Collector Mode
+*****************************************************************/
+// Puts the collector in the mode (incremental or generational)
+// given in the config, with the configured parameters.
+void configure_lua_gc( lua::state& st );
+
+/****************************************************************
+** LuaGcScheduler
+*****************************************************************/
+struct LuaGcStats {
+  // Time spent stepping the collector during the last frame.
+  std::chrono::microseconds frame_time = {};
+  // Number of collector steps done during the last frame.
+  int frame_steps = 0;
+  // Number of cycles finished by scheduled steps.
+  int64_t cycles_finished = 0;
+  // Total memory in use by the Lua state as of the last frame.
+  int64_t heap_bytes = 0;
+};
+
+// Left to itself, Lua runs the collector whenever allocation
+// pressure triggers it, which can land in the middle of a frame.
+// This instead does collector work in the idle time at the end
+// of each frame, which means that the automatic steps (which
+// still run as a backstop) have less to do. It does not start a
+// new cycle until the heap has grown by the given percentage
+// since the last one finished, otherwise it would spend every
+// frame collecting even when there is little garbage.
+//
+// In generational mode Lua never reports a step as having fin-
+// ished a cycle, since each step is itself a complete (minor or
+// major) collection. So in that mode a single step is counted
+// as a cycle. The mode must be the one that the collector is in.
+struct LuaGcScheduler {
+  LuaGcScheduler( lua::state& st, e_lua_gc_mode mode,
+                  int idle_pause );
+
+  // Steps the collector until either the budget is used up or
+  // there is no work worth doing. A single step can overshoot
+  // the budget a bit, so the budget should have some slack.
+  void run_frame( std::chrono::microseconds budget );
+
+  LuaGcStats const& stats() const { return stats_; }
+
+ private:
+  lua::state&   st_;
+  e_lua_gc_mode mode_                  = {};
+  int           idle_pause_            = 0;
+  bool          in_cycle_              = false;
+  int64_t       heap_after_last_cycle_ = 0;
+  LuaGcStats    stats_;
+};
+
+// The frame loop will run the scheduler registered here (if any)
+// at the end of each frame. Pass nullptr to unregister.
+void set_frame_lua_gc_scheduler( LuaGcScheduler* scheduler );
+
+// Runs the registered scheduler (if any) given the amount of
+// idle time left in the frame. Only part of the idle time is
+// used, and it is capped by the configured budget.
+void run_frame_lua_gc( std::chrono::microseconds idle_time );
+
+// Stats for the registered scheduler, or nothing if there is
+// none.
+maybe<LuaGcStats const&> frame_lua_gc_stats();
+
+} // namespace rn
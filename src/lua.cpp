@@ -14,6 +14,11 @@
 #include "error.hpp"
 #include "expect.hpp"
 #include "logger.hpp"
+#include "lua-cache.hpp"
+#include "lua-gc.hpp"
+
+// config
+#include "config/rn.rds.hpp"
 
 // luapp
 #include "luapp/c-api.hpp"
@@ -32,6 +37,9 @@
 #include "base-util/io.hpp"
 #include "base-util/string.hpp"
 
+// C++ standard library
+#include <chrono>
+
 using namespace std;
 
 namespace rn {
@@ -45,6 +53,11 @@ fs::path module_name_to_file_name( string const& m ) {
   return file_name;
 }
 
+maybe<fs::path const&> bytecode_cache_folder() {
+  if( !config_rn.lua.use_bytecode_cache ) return nothing;
+  return config_rn.lua.bytecode_cache_folder;
+}
+
 lua::table require( lua::state& st, string const& required ) {
   string const key = base::str_replace_all(
       required, { { "-", "_" }, { "/", "." } } );
@@ -65,8 +78,21 @@ lua::table require( lua::state& st, string const& required ) {
   // Set the module to something while we're loading in order to
   // detect and break cyclic dependencies.
   modules[key] = "loading";
-  lua::table const module_table =
-      st.script.run_file<lua::table>( file_name.string() );
+  auto const     start_time = chrono::steady_clock::now();
+  LuaChunk const chunk =
+      load_lua_file( st, file_name, bytecode_cache_folder() );
+  auto const       load_time    = chrono::steady_clock::now();
+  lua::table const module_table = chunk.fn.call<lua::table>();
+  auto const       end_time     = chrono::steady_clock::now();
+  lg.debug(
+      "lua module \"{}\": loaded in {}us ({}), ran in {}us.", key,
+      chrono::duration_cast<chrono::microseconds>( load_time -
+                                                   start_time )
+          .count(),
+      chunk.from_cache ? "bytecode cache" : "compiled",
+      chrono::duration_cast<chrono::microseconds>( end_time -
+                                                   load_time )
+          .count() );
   modules[key] = module_table;
   // Create nested tables to hold the module.
   vector<string> const components = base::str_split( key, '.' );
@@ -137,6 +163,7 @@ void freeze_globals( lua::state& st ) {
 }
 
 void lua_init( lua::state& st ) {
+  configure_lua_gc( st );
   add_some_members( st );
   run_lua_startup_routines( st );
   load_lua_modules( st );
@@ -25,6 +25,10 @@ local timer = require( 'util.timer' )
 local min = math.min
 local max = math.max
 
+-- Native implementations of the passes that touch every square on
+-- the map; see map-gen-kernels.hpp.
+local kernels = map_gen_kernels
+
 -----------------------------------------------------------------
 -- Constants
 -----------------------------------------------------------------
@@ -84,6 +88,35 @@ function M.default_options()
   }
 end
 
+local function merge_with_default_options( options )
+  options = options or {}
+  -- Merge the options with the default ones so that any missing
+  -- fields will have their default values.
+  -- TODO: move this into a dedicated options module that can be
+  -- shared.
+  for k, v in pairs( M.default_options() ) do
+    if options[k] == nil then options[k] = v end
+  end
+  return secure_options( options )
+end
+
+-----------------------------------------------------------------
+-- Progress
+-----------------------------------------------------------------
+-- When set, this will be called with the name of each stage of
+-- the terrain generation as it starts along with the approximate
+-- fraction of the work done. If it returns false then genera-
+-- tion will be aborted. This is used when the map is being gen-
+-- erated on a background thread.
+local on_progress = nil
+
+local function progress( stage, fraction )
+  if on_progress == nil then return end
+  if on_progress( stage, fraction ) == false then
+    error( 'map generation cancelled.' )
+  end
+end
+
 -----------------------------------------------------------------
 -- Utils
 -----------------------------------------------------------------
@@ -178,7 +211,7 @@ local function square_at( coord )
   assert( square_exists( coord ),
           string.format( 'square {x=%d,y=%d} does not exist.',
                          coord.x, coord.y ) )
-  return ROOT.terrain:square_at( coord )
+  return ROOT.terrain:mutable_square_at( coord )
 end
 
 -----------------------------------------------------------------
@@ -254,22 +287,13 @@ local function set_land( coord )
   square.ground = 'grassland'
 end
 
-local function set_water( coord )
-  local square = square_at( coord )
-  square.surface = 'water'
-  square.ground = 'arctic'
-  square.sea_lane = false
-end
-
 -- This will create a new empty map set all squares to water.
 local function reset_terrain( options )
   ROOT.terrain:reset( options.world_size )
   -- FIXME: needed?
-  on_all( set_water )
-end
-
-local function is_square_water( square )
-  return square.surface == 'water'
+  kernels.fill_where{
+    set={ surface='water', ground='arctic', sea_lane=false }
+  }
 end
 
 local function set_square_arctic( square )
@@ -277,11 +301,6 @@ local function set_square_arctic( square )
   square.ground = 'arctic'
 end
 
-local function set_arctic( coord )
-  local square = square_at( coord )
-  set_square_arctic( square )
-end
-
 local function is_arctic_square( square )
   return square.surface == 'land' and square.ground == 'arctic'
 end
@@ -305,15 +324,6 @@ local function square_has_river( square )
   return square.river ~= nil
 end
 
-local function square_is_water_source( square )
-  return square_has_river( square ) or is_square_water( square )
-end
-
-local function square_is_indirect_water_source( square )
-  return square_is_water_source( square ) or square.ground ==
-             'marsh' or square.ground == 'swamp'
-end
-
 -- row is zero-based.
 local function row_has_land( row )
   local size = world_size()
@@ -326,10 +336,6 @@ end
 
 local function is_land( square ) return square.surface == 'land' end
 
-local function is_coord_land( coord )
-  return square_at( coord ).surface == 'land'
-end
-
 local function is_water( square ) return
     square.surface == 'water' end
 
@@ -413,18 +419,6 @@ local function surrounding_squares_tribe_owned( tribe, coord )
   end
 end
 
-local function surrounding_squares_5x5( square )
-  local possible = {}
-  for y = square.y - 2, square.y + 2 do
-    for x = square.x - 2, square.x + 2 do
-      if x ~= square.x or y ~= square.y then
-        append( possible, { x=x, y=y } )
-      end
-    end
-  end
-  return possible
-end
-
 -- This will give the tiles along the right edge of the 7x7 block
 -- of tiles centered on `square`.
 local function surrounding_squares_7x7_right_edge( square )
@@ -477,18 +471,16 @@ end
 -- Hills/Mountains Generation
 -----------------------------------------------------------------
 local function create_hills( options )
-  local size = world_size()
-  on_all( function( coord )
-    local square = square_at( coord )
-    if square.surface == 'land' then
-      -- Make sure there are no hills/mountains on this tile.
-      if square.ground ~= 'arctic' and square.overlay == nil then
-        if math.random() <= options.hills_density then
-          square.overlay = 'hills'
-        end
-      end
-    end
-  end )
+  kernels.fill_where{
+    -- Make sure there are no hills/mountains on this tile.
+    where={
+      surface='land',
+      not_ground='arctic',
+      has_overlay=false,
+      probability=options.hills_density
+    },
+    set={ overlay='hills' }
+  }
 end
 
 local function can_receive_mountain( square )
@@ -534,18 +526,16 @@ end
 -----------------------------------------------------------------
 -- TODO: tweak the density of forest to match the original game.
 local function forest_cover()
-  local size = world_size()
-  on_all( function( coord )
-    local square = square_at( coord )
-    if square.surface == 'land' then
-      -- Make sure there are no hills/mountains on this tile.
-      if square.ground ~= 'arctic' and square.overlay == nil then
-        if math.random() <= .95 then
-          square.overlay = 'forest'
-        end
-      end
-    end
-  end )
+  kernels.fill_where{
+    -- Make sure there are no hills/mountains on this tile.
+    where={
+      surface='land',
+      not_ground='arctic',
+      has_overlay=false,
+      probability=.95
+    },
+    set={ overlay='forest' }
+  }
 end
 
 -----------------------------------------------------------------
@@ -556,22 +546,26 @@ end
 -- have room for sea lane squares.
 local function clear_buffer_area( buffer )
   local size = world_size()
-  on_all( function( coord )
-    local x = coord.x
-    local y = coord.y
-    if y < buffer.top or y >= size.h - buffer.bottom or x <
-        buffer.left or x >= size.w - buffer.right then
-      set_water( coord )
-    end
-  end )
+  local water = { surface='water', ground='arctic', sea_lane=false }
+  local rects = {
+    { x=0, y=0, w=size.w, h=buffer.top }, --
+    { x=0, y=size.h - buffer.bottom, w=size.w, h=buffer.bottom }, --
+    { x=0, y=0, w=buffer.left, h=size.h }, --
+    { x=size.w - buffer.right, y=0, w=buffer.right, h=size.h } --
+  }
+  for _, rect in ipairs( rects ) do
+    kernels.fill_where{ region=rect, set=water }
+  end
 end
 
 local function create_arctic_along_row( y )
   local size = world_size()
   -- Note that we don't include the edges.
-  for x = 1, size.w - 2 do
-    if math.random( 1, 2 ) == 1 then set_arctic{ x=x, y=y } end
-  end
+  kernels.fill_where{
+    region={ x=1, y=y, w=size.w - 2, h=1 },
+    where={ one_in=2 },
+    set={ surface='land', ground='arctic' }
+  }
 end
 
 local function create_arctic( options )
@@ -588,16 +582,18 @@ local function create_sea_lanes()
   local size = world_size()
 
   -- First set all water tiles to sea lane.
-  on_all( function( coord, square )
-    if is_square_water( square ) then square.sea_lane = true end
-  end )
+  kernels.fill_where{
+    where={ surface='water' },
+    set={ sea_lane=true }
+  }
 
   -- Now clear out the sea lane tiles in the west half of the map
   -- because we don't want sea lane to extend too far west. Also,
   -- the original game seems to do exactly this.
-  on_all( function( coord, square )
-    if coord.x < size.w / 2 then square.sea_lane = false end
-  end )
+  kernels.fill_where{
+    region={ x=0, y=0, w=(size.w + 1) // 2, h=size.h },
+    set={ sea_lane=false }
+  }
 
   -- Now find all land squares and make sure that there are no
   -- sea lane squares in their vicinity (7x7 square). And for
@@ -937,12 +933,9 @@ end
 
 local function create_indian_villages( options )
   local size = world_size()
-  local function has_land( coord )
-    return square_at( coord ).surface == 'land'
-  end
   local partitions = partition.generate( size,
                                          #options.native_tribes,
-                                         has_land )
+                                         kernels.land_coords() )
   create_indian_villages_using_partition( options, partitions )
   log_dwelling_expertises( 'semi_nomadic' )
   log_dwelling_expertises( 'agrarian' )
@@ -1012,13 +1005,8 @@ local RESOURCES_FOREST = {
 -- and 2) it does make navigating by ship a bit easier since you
 -- can effectively spot land from further away by noticing
 -- fishes, which is a help.
-local function can_place_fish( coord )
-  local squares =
-      filter_on_map( surrounding_squares_5x5( coord ) )
-  for _, coord in ipairs( squares ) do
-    if square_at( coord ).surface == 'land' then return true end
-  end
-  return false
+local function can_place_fish( land_distance, coord )
+  return land_distance:at( coord ) <= 2
 end
 
 -- This includes water, hills, and mountains, i.e. everything but
@@ -1029,9 +1017,10 @@ end
 -- fixed pattern) which then appears only after the forest is
 -- cleared (the ground resource has no effect on production until
 -- the forest is cleared).
-local function add_ground_prime_resource( coord, square )
+local function add_ground_prime_resource( land_distance, coord,
+                                         square )
   if square.surface == 'water' then
-    if can_place_fish( coord ) then
+    if can_place_fish( land_distance, coord ) then
       square.ground_resource = 'fish'
     end
     return
@@ -1061,9 +1050,10 @@ local function distribute_prime_ground_resources( y_offset )
   local size = world_size()
   local coords = dist.compute_prime_ground_resources( size,
                                                       y_offset )
+  local land_distance = kernels.distance_to( 'land' )
   for _, coord in ipairs( coords ) do
     local square = square_at( coord )
-    add_ground_prime_resource( coord, square )
+    add_ground_prime_resource( land_distance, coord, square )
   end
   log.debug( 'prime ground resources density: ' ..
                  tostring( #coords / (size.w * size.h) ) )
@@ -1111,29 +1101,18 @@ local function assign_dry_ground_types()
   for y = 0, size.h - 1 do
     dry_weights[y] = weights.dry_weights_for_row( size.h, y )
   end
-  on_all( function( coord, square )
-    if is_water( square ) then return end
-    if coord.y == 0 or coord.y == size.h - 1 then
-      square.ground = 'arctic'
-      return
-    end
-    square.ground = weights.select_from_weights(
-                        dry_weights[coord.y] )
-  end )
-end
-
--- Is this tile or an adjacent tile a direct water source, e.g.
--- an ocean/lake or river.
-local function has_water_source( coord )
-  local squares =
-      filter_on_map( surrounding_squares_3x3( coord ) )
-  table.insert( squares, coord )
-  for _, adjacent in ipairs( squares ) do
-    if square_is_indirect_water_source( square_at( adjacent ) ) then
-      return true
-    end
+  for _, y in ipairs{ 0, size.h - 1 } do
+    kernels.fill_where{
+      region={ x=0, y=y, w=size.w, h=1 },
+      where={ surface='land' },
+      set={ ground='arctic' }
+    }
   end
-  return false
+  kernels.select_ground_by_row{
+    weights=dry_weights,
+    region={ x=0, y=1, w=size.w, h=size.h - 2 },
+    where={ surface='land' }
+  }
 end
 
 local function assign_wet_ground_types()
@@ -1142,17 +1121,14 @@ local function assign_wet_ground_types()
   for y = 0, size.h - 1 do
     wet_weights[y] = weights.wet_weights_for_row( size.h, y )
   end
-  on_all( function( coord, square )
-    if is_water( square ) then return end
-    if coord.y == 0 or coord.y == size.h - 1 then return end
-    if not has_water_source( coord ) then return end
-    -- This is a land tile not on the border and it is on or ad-
-    -- jacent to a river or ocean/lake.
-    local type = weights.select_from_weights(
-                     wet_weights[coord.y] )
-    if type == 'none' then return end
-    square.ground = type
-  end )
+  -- Only land tiles not on the border that are on or adjacent to
+  -- a river or ocean/lake (or marsh/swamp) are considered. A
+  -- weight of 'none' leaves the tile as it is.
+  kernels.select_ground_by_row{
+    weights=wet_weights,
+    region={ x=0, y=1, w=size.w, h=size.h - 2 },
+    where={ surface='land', near_water_source=true }
+  }
 end
 
 -----------------------------------------------------------------
@@ -1215,23 +1191,11 @@ end
 -- it.
 local function remove_islands()
   local size = world_size()
-  on_all( function( coord, square )
-    if coord.y > 0 and coord.y < size.h - 1 then
-      local surrounding = filter_on_map(
-                              surrounding_squares_3x3( coord ) )
-      local has_land = false
-      for _, square in ipairs( surrounding ) do
-        if square_at( square ).surface == 'land' then
-          has_land = true
-          break
-        end
-      end
-      if not has_land then
-        -- We have an island.
-        square.surface = 'water'
-      end
-    end
-  end )
+  kernels.fill_where{
+    region={ x=0, y=1, w=size.w, h=size.h - 2 },
+    where={ surface='land', max_land_component_size=1 },
+    set={ surface='water' }
+  }
 end
 
 -- Although there is nothing wrong with river islands from the
@@ -1547,6 +1511,7 @@ local function generate_land( options )
     end
     local density = total_land_density( land_squares )
     local target = options.land_density
+    progress( 'continents', .5 * min( density / target, 1.0 ) )
     if density > target then
       log.info( 'land density actual/target: ' ..
                     percent( density ) .. '/' ..
@@ -1554,23 +1519,29 @@ local function generate_land( options )
       break
     end
   end
+  progress( 'cleanup', .5 )
   clear_buffer_area( buffer )
   if options.remove_Xs then remove_Xs() end
   remove_islands()
   create_arctic( options )
+  progress( 'ground', .55 )
   assign_dry_ground_types()
   -- We need to have already created the rivers before this.
   assign_wet_ground_types()
 
   -- These need to be done before the rivers since rivers don't
   -- seem to flow on hills/mountains in the OG.
+  progress( 'mountains', .65 )
   create_hills( options )
   create_mountains( options )
 
+  progress( 'rivers', .7 )
   create_rivers( options )
 
+  progress( 'forest', .8 )
   forest_cover()
 
+  progress( 'resources', .85 )
   local placement_seed = set_random_placement_seed()
   distribute_prime_resources( placement_seed )
   distribute_lost_city_rumors( placement_seed )
@@ -1701,7 +1672,7 @@ function M.regenerate_native_land_partitions(
   local size = world_size()
   local NUM_TRIBES = 8
   local partitions = partition.generate( size, NUM_TRIBES,
-                                         is_coord_land )
+                                         kernels.land_coords() )
   if paint_map_by_partition then
     paint_native_land_partitions( partitions )
   end
@@ -1716,19 +1687,13 @@ function M.regen( options )
   ROOT_TS.map_updater:redraw()
 end
 
-local function generate( options )
-  options = options or {}
-  -- Merge the options with the default ones so that any missing
-  -- fields will have their default values.
-  -- TODO: move this into a dedicated options module that can be
-  -- shared.
-  for k, v in pairs( M.default_options() ) do
-    if options[k] == nil then options[k] = v end
-  end
-  options = secure_options( options )
-
+-- This only touches the terrain and so it can be run in a Lua
+-- state that is separate from the main one (and on a different
+-- thread), so long as ROOT.terrain is available.
+local function generate_terrain( options )
   log.info( 'generating map...' );
 
+  progress( 'reset', 0.0 )
   reset_terrain( options )
 
   generate_proto_squares()
@@ -1736,11 +1701,6 @@ local function generate( options )
   if options.type == 'battlefield' then
     generate_battlefield( options )
     return
-  elseif options.type == 'land-partition' then
-    generate_land( options )
-    create_sea_lanes()
-    M.regenerate_native_land_partitions( true )
-    return
   elseif options.type == 'half_and_half' then
     generate_half_land()
   elseif options.type == 'testing' then
@@ -1749,13 +1709,48 @@ local function generate( options )
     generate_land( options )
   end
 
+  progress( 'sea lanes', .95 )
   create_sea_lanes()
+  progress( 'done', 1.0 )
+end
 
+-- This must be run after the terrain has been generated, in the
+-- main Lua state.
+local function generate_natives( options )
+  if options.type == 'battlefield' then return end
+  if options.type == 'land-partition' then
+    M.regenerate_native_land_partitions( true )
+    return
+  end
   create_indian_villages( options )
 end
 
+local function generate( options )
+  options = merge_with_default_options( options )
+  generate_terrain( options )
+  generate_natives( options )
+end
+
 function M.generate( ... )
   timer.log_time( 'map generation', generate, ... )
 end
 
+-- The following two functions together are equivalent to `gen-
+-- erate`, but allow running the terrain generation in a sepa-
+-- rate Lua state. The options must be the same for both calls.
+-- `progress_fn` is optional; see `on_progress` for its semantics.
+function M.generate_terrain( options, progress_fn )
+  options = merge_with_default_options( options )
+  on_progress = progress_fn
+  local ok, err = pcall( timer.log_time, 'terrain generation',
+                         generate_terrain, options )
+  on_progress = nil
+  if not ok then error( err ) end
+end
+
+function M.generate_natives( options )
+  options = merge_with_default_options( options )
+  timer.log_time( 'natives generation', generate_natives, options )
+end
+
 return M
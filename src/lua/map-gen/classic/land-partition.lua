@@ -158,16 +158,9 @@ local function do_split(output, split_funcs, n_range,
             world_size )
 end
 
-function M.generate( world_size, partitions, has_land )
-  local land_coords = {}
-  for y = 0, world_size.h - 1 do
-    for x = 0, world_size.w - 1 do
-      if has_land{ x=x, y=y } then
-        table.insert( land_coords, { x=x, y=y } )
-      end
-    end
-  end
-
+-- land_coords is a list of the coordinates of all land squares
+-- on the map in raster order.
+function M.generate( world_size, partitions, land_coords )
   -- Holds a mapping from (rasterized) coordinate to partition
   -- number.
   local res = {}
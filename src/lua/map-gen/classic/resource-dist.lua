@@ -39,6 +39,12 @@ local function col1_distribution_algo( config, coord )
 end
 
 local function distribute( config )
+  -- When running in the game there is a native version of this
+  -- that is much faster on large maps. This module does not re-
+  -- quire it though so that it can be run standalone.
+  if map_gen_kernels then
+    return map_gen_kernels.resource_mask( config )
+  end
   local res = {}
   for y = 0, config.world_size.h - 1 do
     for x = 0, config.world_size.w - 1 do
@@ -325,11 +325,7 @@ end
 -----------------------------------------------------------------
 -- Creates a new Game
 -----------------------------------------------------------------
--- This should be called af the player decides the parameters of
--- the game, which should be passed in as options here. Also, the
--- save-game state should be default-constructed before calling
--- this.
-function M.create( options )
+local function merge_with_default_options( options )
   options = options or {}
   -- Merge the options with the default ones so that any missing
   -- fields will have their default values.
@@ -338,20 +334,18 @@ function M.create( options )
   end
 
   add_testing_options( options )
+  return options
+end
 
-  local root = ROOT
-
+local function create_before_map( options, root )
   set_default_settings( options, root.settings )
 
   create_turn_state( root.turn )
 
   create_nations( options, root )
+end
 
-  -- Do this as late as possible because it's slow and we want to
-  -- catch errors in the other parts of the process as quickly as
-  -- possible.
-  map_gen.generate( options.map )
-
+local function create_after_map( options, root )
   -- Needs to be done after the map is generated because we need
   -- to know the dimensions.
   do
@@ -394,4 +388,40 @@ function M.create( options )
   end
 end
 
+-- This should be called af the player decides the parameters of
+-- the game, which should be passed in as options here. Also, the
+-- save-game state should be default-constructed before calling
+-- this.
+function M.create( options )
+  options = merge_with_default_options( options )
+
+  local root = ROOT
+
+  create_before_map( options, root )
+
+  -- Do this as late as possible because it's slow and we want to
+  -- catch errors in the other parts of the process as quickly as
+  -- possible.
+  map_gen.generate( options.map )
+
+  create_after_map( options, root )
+end
+
+-- The following two functions together do the same as `create`,
+-- except that they leave out the generation of the terrain,
+-- which the caller is expected to do in between them (probably
+-- on a background thread) using map_gen.generate_terrain with
+-- the map options returned by the first one. The options table
+-- returned by the first must be passed to the second.
+function M.create_before_terrain( options )
+  options = merge_with_default_options( options )
+  create_before_map( options, ROOT )
+  return options
+end
+
+function M.create_after_terrain( options )
+  map_gen.generate_natives( options.map )
+  create_after_map( options, ROOT )
+end
+
 return M
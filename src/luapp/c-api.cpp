@@ -605,6 +605,25 @@ void c_api::gc_collect() {
   lua_gc( L_, LUA_GCCOLLECT, 0 );
 }
 
+void c_api::gc_incremental( int pause, int stepmul,
+                            int stepsize ) noexcept {
+  lua_gc( L_, LUA_GCINC, pause, stepmul, stepsize );
+}
+
+void c_api::gc_generational( int minormul,
+                             int majormul ) noexcept {
+  lua_gc( L_, LUA_GCGEN, minormul, majormul );
+}
+
+bool c_api::gc_step( int kbytes ) noexcept {
+  return lua_gc( L_, LUA_GCSTEP, kbytes ) != 0;
+}
+
+int64_t c_api::gc_count_bytes() noexcept {
+  return int64_t( lua_gc( L_, LUA_GCCOUNT ) ) * 1024 +
+         lua_gc( L_, LUA_GCCOUNTB );
+}
+
 cthread c_api::newthread() noexcept {
   return lua_newthread( L_ );
 }
@@ -711,6 +730,47 @@ lua_valid c_api::loadfile( const char* filename ) {
   }
 }
 
+lua_valid c_api::loadbuffer( string_view buffer,
+                             char const* chunkname,
+                             char const* mode ) {
+  int res = luaL_loadbufferx( L_, buffer.data(), buffer.size(),
+                              chunkname, mode );
+  switch( res ) {
+    case LUA_OK: return base::valid;
+    case LUA_ERRSYNTAX: {
+      string err = pop_tostring();
+      return lua_invalid( fmt::format(
+          "syntax error during precompilation: {}", err ) );
+    }
+    case LUA_ERRMEM:
+      return lua_invalid(
+          "memory allocation (out-of-memory) error." );
+    default:
+      return lua_invalid(
+          fmt::format( "unknown error: {}", res ) );
+  }
+}
+
+lua_expect<string> c_api::dump( bool strip ) {
+  if( type_of( -1 ) != type::function )
+    return lua_unexpected<string>(
+        "can only dump a function." );
+  string res;
+  auto   writer = []( lua_State*, void const* p, size_t sz,
+                    void* ud ) -> int {
+    static_cast<string*>( ud )->append(
+        static_cast<char const*>( p ), sz );
+    return 0;
+  };
+  if( lua_dump( L_, writer, &res, strip ? 1 : 0 ) != 0 )
+    return lua_unexpected<string>( "failed to dump function." );
+  return res;
+}
+
+string_view c_api::release() noexcept {
+  return LUA_RELEASE;
+}
+
 cthread c_api::tothread( int idx ) {
   validate_index( idx );
   return lua_tothread( L_, idx );
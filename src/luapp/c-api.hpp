@@ -19,6 +19,9 @@
 // base
 #include "base/maybe.hpp"
 
+// C++ standard library
+#include <cstdint>
+
 namespace lua {
 
 /****************************************************************
@@ -73,6 +76,25 @@ struct c_api {
   // turned.
   lua_valid loadfile( const char* filename );
 
+  // Loads a chunk from the buffer, which may hold either source
+  // code or precompiled bytecode depending on `mode` ("t", "b",
+  // or "bt", as in lua_load). The chunk name is used in error
+  // messages and debug info. If the loading is successful then
+  // the function is pushed onto the stack (not run).
+  lua_valid loadbuffer( std::string_view buffer,
+                        char const*      chunkname,
+                        char const*      mode );
+
+  // Dumps the Lua function at the top of the stack as a binary
+  // chunk which can later be loaded with loadbuffer. The func-
+  // tion is not popped. If `strip` is true then debug informa-
+  // tion (e.g. line numbers) is not included.
+  lua_expect<std::string> dump( bool strip );
+
+  // E.g. "Lua 5.4.4". Binary chunks are only valid for the ver-
+  // sion that produced them.
+  static std::string_view release() noexcept;
+
   /**************************************************************
   ** call / pcall
   ***************************************************************/
@@ -566,6 +588,26 @@ struct c_api {
   // only be used for testing.
   void gc_collect();
 
+  // Puts the collector in incremental mode. The pause and step
+  // multiplier are percentages and the step size is the log2 of
+  // the number of bytes allocated between automatic steps, as in
+  // the collectgarbage function. A zero leaves a parameter un-
+  // changed.
+  void gc_incremental( int pause, int stepmul,
+                       int stepsize ) noexcept;
+
+  // Puts the collector in generational mode. A zero leaves a pa-
+  // rameter unchanged.
+  void gc_generational( int minormul, int majormul ) noexcept;
+
+  // Performs one basic step of the collector (or, if kbytes is
+  // positive, as much work as allocating that many KB would).
+  // Returns true if the step finished a collection cycle.
+  bool gc_step( int kbytes ) noexcept;
+
+  // Total memory in use by the Lua state.
+  int64_t gc_count_bytes() noexcept;
+
   /**************************************************************
   ** types
   ***************************************************************/
@@ -112,6 +112,12 @@ table state::Table::create() noexcept {
   return lua::table( L, C.ref_registry() );
 }
 
+table state::Table::registry() noexcept {
+  c_api C( L );
+  C.pushvalue( LUA_REGISTRYINDEX );
+  return lua::table( L, C.ref_registry() );
+}
+
 /****************************************************************
 ** Functions
 *****************************************************************/
@@ -163,6 +169,23 @@ void state::Script::operator()( string_view code ) {
   return call_lua_unsafe_and_get<void>( L );
 }
 
+lua_expect<rfunction> state::Script::load_chunk_safe(
+    string_view chunk, string_view name ) noexcept {
+  c_api C( L );
+  HAS_VALUE_OR_RET(
+      C.loadbuffer( chunk, string( name ).c_str(), "bt" ) );
+  return rfunction( L, C.ref_registry() );
+}
+
+lua_expect<string> state::Script::dump(
+    rfunction const& fn ) noexcept {
+  c_api C( L );
+  lua::push( L, fn );
+  lua_expect<string> res = C.dump( /*strip=*/false );
+  C.pop();
+  return res;
+}
+
 lua_valid state::Script::load_file_safe(
     std::string_view file ) {
   c_api C( L );
@@ -104,6 +104,9 @@ struct state : base::zero<state, cthread> {
     table global() noexcept;
     table create() noexcept;
 
+    // The registry, which is only accessible from C.
+    table registry() noexcept;
+
    private:
     cthread L;
   } table;
@@ -166,6 +169,17 @@ struct state : base::zero<state, cthread> {
 
     void operator()( std::string_view code );
 
+    // Loads a chunk containing either source code or bytecode
+    // (as produced by `dump`) into a function without running
+    // it. The name is used in error messages and tracebacks; by
+    // Lua convention a file name should be prefixed with '@'.
+    lua_expect<rfunction> load_chunk_safe(
+        std::string_view chunk, std::string_view name ) noexcept;
+
+    // Returns the bytecode for the function, including debug in-
+    // fo. Fails for C functions.
+    lua_expect<std::string> dump( rfunction const& fn ) noexcept;
+
     template<GettableOrVoid R = void>
     R run( std::string_view code ) {
       lua::push( L, load( code ) );
@@ -25,9 +25,6 @@
 #include "ss/ref.hpp"
 #include "ss/terrain.hpp"
 
-// base
-#include "base/range-lite.hpp"
-
 using namespace std;
 
 namespace rn {
@@ -42,15 +39,13 @@ using ::base::generator;
 generator<ColonyId> close_friendly_colonies(
     SSConst const& ss, Player const& player,
     gfx::point const start ) {
-  generator<gfx::point> points =
-      outward_spiral_search_existing( ss, start );
   // If we search a 7x7 grid (49) tiles then we should cover all
   // of the ones that are within a 3.5 pythagorean distance to
   // the starting square.
-  int  kMaxSquaresToSearch = 49;
-  auto rng = base::rl::all( points ).take( kMaxSquaresToSearch );
+  int remaining = 49;
 
-  for( gfx::point p : rng ) {
+  for( gfx::point p : OutwardSpiralExisting( ss, start ) ) {
+    if( remaining-- == 0 ) break;
     Coord const square = Coord::from_gfx( p );
     CHECK( ss.terrain.square_exists( square ) );
     gfx::size const delta = square.to_gfx() - start;
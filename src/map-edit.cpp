@@ -25,6 +25,7 @@
 #include "plane.hpp"
 #include "plow.hpp"
 #include "rand.hpp"     // FIXME
+#include "render-terrain.hpp"
 #include "renderer.hpp" // FIXME
 #include "road.hpp"
 #include "terminal.hpp" // FIXME
@@ -166,10 +167,7 @@ struct MapEditPlane::Impl : public Plane {
             .distance_from_origin(),
         viewport().get_zoom() );
     // Should do this after setting the camera.
-    renderer.render_buffer(
-        rr::e_render_target_buffer::landscape );
-    renderer.render_buffer(
-        rr::e_render_target_buffer::landscape_annex );
+    render_landscape_buffers( renderer, viewport().get_zoom() );
     render_sidebar( renderer );
     render_toolbar( renderer );
   }
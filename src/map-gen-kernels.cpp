@@ -0,0 +1,684 @@
+/****************************************************************
+**map-gen-kernels.cpp
+*
+* Project: Revolution Now
+*
+* Created by dsicilia on 2022-12-22.
+*
+* Description: Native whole-map operations used by the map gen-
+*              erator.
+*
+*****************************************************************/
+#include "map-gen-kernels.hpp"
+
+// Revolution Now
+#include "irand.hpp"
+
+// ss
+#include "ss/ref.hpp"
+#include "ss/terrain.hpp"
+
+// luapp
+#include "luapp/enum.hpp"
+#include "luapp/ext-base.hpp"
+#include "luapp/iter.hpp"
+#include "luapp/register.hpp"
+#include "luapp/rfunction.hpp"
+#include "luapp/rstring.hpp"
+#include "luapp/state.hpp"
+#include "luapp/types.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+#include "refl/to-str.hpp"
+
+// C++ standard library
+#include <algorithm>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+// Lua-style modulus, i.e. the result has the sign of the divi-
+// sor. The resource distribution pattern relies on this.
+int floor_mod( int a, int b ) {
+  int const res = a % b;
+  return ( res != 0 && ( ( res < 0 ) != ( b < 0 ) ) ) ? res + b
+                                                      : res;
+}
+
+int floor_div( int a, int b ) {
+  return ( a - floor_mod( a, b ) ) / b;
+}
+
+e_surface surface_of( MapSquare const& square ) {
+  return square.surface;
+}
+
+e_surface surface_of( PackedSquare const square ) {
+  return square.surface();
+}
+
+bool is_indirect_water_source( MapSquare const& square ) {
+  return square.surface == e_surface::water ||
+         square.river.has_value() ||
+         square.ground == e_ground_terrain::marsh ||
+         square.ground == e_ground_terrain::swamp;
+}
+
+bool near_water_source( Matrix<MapSquare> const& m,
+                        Coord                    tile ) {
+  Rect const map_rect = m.rect();
+  for( int dy = -1; dy <= 1; ++dy ) {
+    for( int dx = -1; dx <= 1; ++dx ) {
+      Coord const c{ .x = tile.x + dx, .y = tile.y + dy };
+      if( !c.is_inside( map_rect ) ) continue;
+      if( is_indirect_water_source( m[c] ) ) return true;
+    }
+  }
+  return false;
+}
+
+// Everything except the random draws.
+bool filter_matches_deterministic(
+    Matrix<MapSquare> const& m, Coord tile,
+    MapGenFilter const& filter, MapComponents const* land ) {
+  MapSquare const& square = m[tile];
+  if( filter.surface.has_value() &&
+      square.surface != *filter.surface )
+    return false;
+  if( filter.ground.has_value() &&
+      square.ground != *filter.ground )
+    return false;
+  if( filter.not_ground.has_value() &&
+      square.ground == *filter.not_ground )
+    return false;
+  if( filter.has_overlay.has_value() &&
+      square.overlay.has_value() != *filter.has_overlay )
+    return false;
+  if( filter.has_river.has_value() &&
+      square.river.has_value() != *filter.has_river )
+    return false;
+  if( filter.sea_lane.has_value() &&
+      square.sea_lane != *filter.sea_lane )
+    return false;
+  if( filter.near_water_source.has_value() &&
+      near_water_source( m, tile ) !=
+          *filter.near_water_source )
+    return false;
+  if( filter.max_land_component_size.has_value() ) {
+    CHECK( land != nullptr );
+    int const label = land->label_at( tile );
+    if( label == 0 ) return false;
+    if( land->size_of( label ) >
+        *filter.max_land_component_size )
+      return false;
+  }
+  return true;
+}
+
+// Some filter criteria need information about the entire map;
+// this computes it once up front when needed.
+maybe<MapComponents> land_components_for_filter(
+    Matrix<MapSquare> const& m, MapGenFilter const& filter ) {
+  if( !filter.max_land_component_size.has_value() )
+    return nothing;
+  return label_components( m, e_surface::land );
+}
+
+// Note that we don't use Rect::overlap_with here because we
+// need an empty result (and not an error) for regions that are
+// empty or off of the map, which Lua code produces naturally for
+// very small maps.
+Rect clip_to_map( Matrix<MapSquare> const& m, Rect region ) {
+  Delta const size = m.size();
+  int const   x1   = std::max( region.x, 0 );
+  int const   y1   = std::max( region.y, 0 );
+  int const   x2   = std::min( region.x + region.w, size.w );
+  int const   y2   = std::min( region.y + region.h, size.h );
+  return Rect{ .x = x1,
+               .y = y1,
+               .w = std::max( x2 - x1, 0 ),
+               .h = std::max( y2 - y1, 0 ) };
+}
+
+MapComponents const* ptr_or_null(
+    maybe<MapComponents> const& m ) {
+  return m.has_value() ? &*m : nullptr;
+}
+
+bool filter_matches( Matrix<MapSquare> const& m, Coord tile,
+                     MapGenFilter const&  filter,
+                     MapComponents const* land, IRand& rand ) {
+  if( !filter_matches_deterministic( m, tile, filter, land ) )
+    return false;
+  if( filter.probability.has_value() &&
+      !rand.bernoulli( *filter.probability ) )
+    return false;
+  if( filter.one_in.has_value() &&
+      rand.between_ints( 1, *filter.one_in,
+                         IRand::e_interval::closed ) != 1 )
+    return false;
+  return true;
+}
+
+} // namespace
+
+void linker_dont_discard_module_map_gen_kernels();
+void linker_dont_discard_module_map_gen_kernels() {}
+
+/****************************************************************
+** Filters and Edits
+*****************************************************************/
+bool map_gen_filter_matches( Matrix<MapSquare> const& m,
+                             Coord                    tile,
+                             MapGenFilter const&      filter ) {
+  CHECK( !filter.probability.has_value() &&
+             !filter.one_in.has_value(),
+         "cannot evaluate a probabilistic filter without a "
+         "random number generator." );
+  maybe<MapComponents> const land =
+      land_components_for_filter( m, filter );
+  return filter_matches_deterministic( m, tile, filter,
+                                       ptr_or_null( land ) );
+}
+
+void apply_map_gen_edit( MapSquare&        square,
+                         MapGenEdit const& edit ) {
+  if( edit.clear_overlay ) square.overlay = nothing;
+  if( edit.clear_river ) square.river = nothing;
+  if( edit.clear_resources ) {
+    square.ground_resource = nothing;
+    square.forest_resource = nothing;
+  }
+  if( edit.surface.has_value() ) square.surface = *edit.surface;
+  if( edit.ground.has_value() ) square.ground = *edit.ground;
+  if( edit.overlay.has_value() ) square.overlay = *edit.overlay;
+  if( edit.sea_lane.has_value() )
+    square.sea_lane = *edit.sea_lane;
+  if( edit.road.has_value() ) square.road = *edit.road;
+  if( edit.lost_city_rumor.has_value() )
+    square.lost_city_rumor = *edit.lost_city_rumor;
+}
+
+int fill_where( Matrix<MapSquare>& m, Rect region,
+                MapGenFilter const& filter,
+                MapGenEdit const& edit, IRand& rand ) {
+  Rect const clipped = clip_to_map( m, region );
+  maybe<MapComponents> const land =
+      land_components_for_filter( m, filter );
+  int count = 0;
+  for( int y = clipped.top_edge(); y < clipped.bottom_edge();
+       ++y ) {
+    for( int x = clipped.left_edge(); x < clipped.right_edge();
+         ++x ) {
+      Coord const tile{ .x = x, .y = y };
+      if( !filter_matches( m, tile, filter, ptr_or_null( land ),
+                           rand ) )
+        continue;
+      apply_map_gen_edit( m[tile], edit );
+      ++count;
+    }
+  }
+  return count;
+}
+
+/****************************************************************
+** Connected Components
+*****************************************************************/
+int MapComponents::label_at( Coord tile ) const {
+  if( !tile.is_inside( labels.rect() ) ) return 0;
+  return labels[tile];
+}
+
+int MapComponents::size_of( int label ) const {
+  if( label <= 0 || label > count() ) return 0;
+  return sizes[label - 1];
+}
+
+namespace {
+
+template<typename Square>
+MapComponents label_components_impl( Matrix<Square> const& m,
+                                     e_surface surface ) {
+  Delta const   size = m.size();
+  MapComponents res{ .labels = Matrix<int>( size ), .sizes = {} };
+  Rect const    map_rect = m.rect();
+  // Reused across components to avoid reallocating.
+  vector<Coord> stack;
+  for( int y = 0; y < size.h; ++y ) {
+    for( int x = 0; x < size.w; ++x ) {
+      Coord const seed{ .x = x, .y = y };
+      if( surface_of( m[seed] ) != surface ) continue;
+      if( res.labels[seed] != 0 ) continue;
+      int const label = res.count() + 1;
+      int       area  = 0;
+      res.labels[seed] = label;
+      stack.push_back( seed );
+      while( !stack.empty() ) {
+        Coord const curr = stack.back();
+        stack.pop_back();
+        ++area;
+        for( int dy = -1; dy <= 1; ++dy ) {
+          for( int dx = -1; dx <= 1; ++dx ) {
+            Coord const next{ .x = curr.x + dx,
+                              .y = curr.y + dy };
+            if( !next.is_inside( map_rect ) ) continue;
+            if( res.labels[next] != 0 ) continue;
+            if( surface_of( m[next] ) != surface ) continue;
+            res.labels[next] = label;
+            stack.push_back( next );
+          }
+        }
+      }
+      res.sizes.push_back( area );
+    }
+  }
+  return res;
+}
+
+} // namespace
+
+MapComponents label_components( Matrix<MapSquare> const& m,
+                                e_surface surface ) {
+  return label_components_impl( m, surface );
+}
+
+MapComponents label_components( Matrix<PackedSquare> const& m,
+                                e_surface surface ) {
+  return label_components_impl( m, surface );
+}
+
+/****************************************************************
+** Distance Transforms
+*****************************************************************/
+int MapDistanceField::at( Coord tile ) const {
+  if( !tile.is_inside( distances.rect() ) ) return kUnreachable;
+  return distances[tile];
+}
+
+namespace {
+
+template<typename Square>
+MapDistanceField distance_to_surface_impl(
+    Matrix<Square> const& m, e_surface target ) {
+  Delta const      size = m.size();
+  int const        kFar = MapDistanceField::kUnreachable;
+  MapDistanceField res{ .distances = Matrix<int>( size, kFar ) };
+  Matrix<int>&     d = res.distances;
+  for( int y = 0; y < size.h; ++y )
+    for( int x = 0; x < size.w; ++x )
+      if( surface_of( m[y][x] ) == target ) d[y][x] = 0;
+
+  // Two-pass chamfer transform. With unit weights on all eight
+  // neighbors this is exact for the Chebyshev metric.
+  auto relax = [&]( int x, int y, int nx, int ny ) {
+    if( nx < 0 || ny < 0 || nx >= size.w || ny >= size.h )
+      return;
+    int const via = d[ny][nx];
+    if( via == kFar ) return;
+    d[y][x] = std::min( d[y][x], via + 1 );
+  };
+
+  // Forward pass: upper-left to lower-right, looking at the
+  // neighbors that have already been visited.
+  for( int y = 0; y < size.h; ++y ) {
+    for( int x = 0; x < size.w; ++x ) {
+      relax( x, y, x - 1, y );
+      relax( x, y, x - 1, y - 1 );
+      relax( x, y, x, y - 1 );
+      relax( x, y, x + 1, y - 1 );
+    }
+  }
+
+  // Backward pass: lower-right to upper-left.
+  for( int y = size.h - 1; y >= 0; --y ) {
+    for( int x = size.w - 1; x >= 0; --x ) {
+      relax( x, y, x + 1, y );
+      relax( x, y, x + 1, y + 1 );
+      relax( x, y, x, y + 1 );
+      relax( x, y, x - 1, y + 1 );
+    }
+  }
+  return res;
+}
+
+} // namespace
+
+MapDistanceField distance_to_surface(
+    Matrix<MapSquare> const& m, e_surface target ) {
+  return distance_to_surface_impl( m, target );
+}
+
+MapDistanceField distance_to_surface(
+    Matrix<PackedSquare> const& m, e_surface target ) {
+  return distance_to_surface_impl( m, target );
+}
+
+/****************************************************************
+** Weighted Ground Selection
+*****************************************************************/
+int select_ground_by_row(
+    Matrix<MapSquare>&                m,
+    vector<GroundWeights> const& row_weights, Rect region,
+    MapGenFilter const& filter, IRand& rand ) {
+  CHECK_EQ( int( row_weights.size() ), m.size().h );
+  Rect const clipped = clip_to_map( m, region );
+  maybe<MapComponents> const land =
+      land_components_for_filter( m, filter );
+  int count = 0;
+  for( int y = clipped.top_edge(); y < clipped.bottom_edge();
+       ++y ) {
+    GroundWeights const& weights = row_weights[y];
+    CHECK( !weights.empty(), "no ground weights for row {}.",
+           y );
+    for( int x = clipped.left_edge(); x < clipped.right_edge();
+         ++x ) {
+      Coord const tile{ .x = x, .y = y };
+      if( !filter_matches( m, tile, filter, ptr_or_null( land ),
+                           rand ) )
+        continue;
+      maybe<e_ground_terrain> selected;
+
+      double const cut   = rand.between_doubles( 0.0, 1.0 );
+      double       total = 0.0;
+      bool         found = false;
+      for( auto const& [ground, weight] : weights ) {
+        total += weight;
+        if( total > cut ) {
+          selected = ground;
+          found    = true;
+          break;
+        }
+      }
+      // Same as the Lua version: the weights must add up to 1.0.
+      CHECK( found, "should not be here: the ground weights for "
+                    "row {} do not add up to 1.0.",
+             y );
+      if( !selected.has_value() ) continue;
+      m[tile].ground = *selected;
+      ++count;
+    }
+  }
+  return count;
+}
+
+/****************************************************************
+** Resource Placement Masks
+*****************************************************************/
+vector<Coord> resource_placement_mask(
+    Delta size, ResourcePattern const& pattern ) {
+  static constexpr int kRotation = 12;
+  int const            board     = pattern.board_size;
+  CHECK_GT( board, 0 );
+  CHECK( board % 4 == 0,
+         "board size must be a multiple of four." );
+  vector<bool> has_resource( board, false );
+  for( int const column : pattern.columns )
+    has_resource[floor_mod( column, board )] = true;
+  vector<Coord> res;
+  for( int y = 0; y < size.h; ++y ) {
+    int const idx = floor_mod( y + pattern.y_offset, board );
+    int const rotations =
+        floor_mod( floor_div( idx, 4 ) +
+                       pattern.shifts[floor_mod( idx, 4 )],
+                   board / 4 );
+    for( int x = 0; x < size.w; ++x ) {
+      int const column =
+          x - pattern.x_offset + kRotation * rotations;
+      if( has_resource[floor_mod( column, board )] )
+        res.push_back( Coord{ .x = x, .y = y } );
+    }
+  }
+  return res;
+}
+
+namespace {
+
+template<typename Square>
+vector<Coord> land_coords_impl( Matrix<Square> const& m ) {
+  vector<Coord> res;
+  Delta const   size = m.size();
+  for( int y = 0; y < size.h; ++y )
+    for( int x = 0; x < size.w; ++x )
+      if( surface_of( m[y][x] ) == e_surface::land )
+        res.push_back( Coord{ .x = x, .y = y } );
+  return res;
+}
+
+} // namespace
+
+vector<Coord> land_coords( Matrix<MapSquare> const& m ) {
+  return land_coords_impl( m );
+}
+
+vector<Coord> land_coords( Matrix<PackedSquare> const& m ) {
+  return land_coords_impl( m );
+}
+
+/****************************************************************
+** Lua Bindings
+*****************************************************************/
+namespace {
+
+// Draws from Lua's own generator so that a map generated with a
+// given `math.randomseed` is the same regardless of which of its
+// passes have been moved into C++.
+struct LuaMathRand : IRand {
+  LuaMathRand( lua::state& st )
+    : random_( st["math"]["random"].as<lua::rfunction>() ) {}
+
+  // Implement IRand.
+  bool bernoulli( double p ) override {
+    return between_doubles( 0.0, 1.0 ) <= p;
+  }
+
+  // Implement IRand.
+  int between_ints( int lower, int upper,
+                    e_interval type ) override {
+    if( type == e_interval::half_open ) --upper;
+    return random_.call<int>( lower, upper );
+  }
+
+  // Implement IRand.
+  double between_doubles( double lower, double upper ) override {
+    return lower + random_.call<double>() * ( upper - lower );
+  }
+
+ private:
+  lua::rfunction random_;
+};
+
+// Runs a kernel that changes the map. Getting the mutable map
+// has every player with a view of a square take a copy of it, so
+// afterwards the copies of squares that did not change are
+// dropped again.
+template<typename Func>
+auto modify_world_map( lua::state& st, Func&& func ) {
+  SS&           ss      = st["SS"].as<SS&>();
+  TerrainState& terrain = ss.mutable_terrain_use_with_care;
+  auto const    res = std::forward<Func>( func )(
+      terrain.mutable_world_map() );
+  terrain.drop_redundant_player_squares();
+  return res;
+}
+
+// For the kernels that visit each square many times (e.g. once
+// per neighbor) but only need to read its surface. Packing is a
+// single linear pass, which is cheap in comparison.
+Matrix<PackedSquare> packed_world_map( lua::state& st ) {
+  SS& ss = st["SS"].as<SS&>();
+  return pack_map( ss.terrain.world_map() );
+}
+
+Rect region_from_lua( lua::state& st, lua::any const o ) {
+  SS&        ss    = st["SS"].as<SS&>();
+  Rect const whole = ss.terrain.world_map().rect();
+  if( o == lua::nil ) return whole;
+  lua::table tbl = lua::as<lua::table>( o );
+  return Rect{ .x = tbl["x"].as<maybe<int>>().value_or( 0 ),
+               .y = tbl["y"].as<maybe<int>>().value_or( 0 ),
+               .w = tbl["w"].as<maybe<int>>().value_or( whole.w ),
+               .h = tbl["h"].as<maybe<int>>().value_or( whole.h ) };
+}
+
+MapGenFilter filter_from_lua( lua::any const o ) {
+  MapGenFilter res;
+  if( o == lua::nil ) return res;
+  lua::table tbl = lua::as<lua::table>( o );
+  res.surface     = tbl["surface"].as<maybe<e_surface>>();
+  res.ground      = tbl["ground"].as<maybe<e_ground_terrain>>();
+  res.not_ground  = tbl["not_ground"].as<maybe<e_ground_terrain>>();
+  res.has_overlay = tbl["has_overlay"].as<maybe<bool>>();
+  res.has_river   = tbl["has_river"].as<maybe<bool>>();
+  res.sea_lane    = tbl["sea_lane"].as<maybe<bool>>();
+  res.near_water_source =
+      tbl["near_water_source"].as<maybe<bool>>();
+  res.max_land_component_size =
+      tbl["max_land_component_size"].as<maybe<int>>();
+  res.probability = tbl["probability"].as<maybe<double>>();
+  res.one_in      = tbl["one_in"].as<maybe<int>>();
+  return res;
+}
+
+MapGenEdit edit_from_lua( lua::any const o ) {
+  MapGenEdit res;
+  if( o == lua::nil ) return res;
+  lua::table tbl = lua::as<lua::table>( o );
+  res.surface  = tbl["surface"].as<maybe<e_surface>>();
+  res.ground   = tbl["ground"].as<maybe<e_ground_terrain>>();
+  res.overlay  = tbl["overlay"].as<maybe<e_land_overlay>>();
+  res.sea_lane = tbl["sea_lane"].as<maybe<bool>>();
+  res.road     = tbl["road"].as<maybe<bool>>();
+  res.lost_city_rumor =
+      tbl["lost_city_rumor"].as<maybe<bool>>();
+  res.clear_overlay =
+      tbl["clear_overlay"].as<maybe<bool>>().value_or( false );
+  res.clear_river =
+      tbl["clear_river"].as<maybe<bool>>().value_or( false );
+  res.clear_resources =
+      tbl["clear_resources"].as<maybe<bool>>().value_or( false );
+  return res;
+}
+
+// Note that this preserves the iteration order of the Lua table
+// (i.e., that of `pairs`), since that determines which ground
+// type a given random number selects.
+GroundWeights ground_weights_from_lua( lua::state& st,
+                                       lua::table  tbl ) {
+  GroundWeights res;
+  for( auto [k, v] : tbl ) {
+    string const key = lua::as<string>( k );
+    double const weight = lua::as<double>( v );
+    if( key == "none" ) {
+      res.emplace_back( nothing, weight );
+      continue;
+    }
+    maybe<e_ground_terrain> const ground =
+        refl::enum_from_string<e_ground_terrain>( key );
+    LUA_CHECK( st, ground.has_value(),
+               "unrecognized ground type '{}'.", key );
+    res.emplace_back( *ground, weight );
+  }
+  return res;
+}
+
+lua::table coords_to_lua( lua::state&          st,
+                          vector<Coord> const& coords ) {
+  lua::table res = st.table.create();
+  for( int i = 0; i < int( coords.size() ); ++i )
+    res[i + 1] = coords[i];
+  return res;
+}
+
+// spec: { region={x,y,w,h}, where={...}, set={...} }
+LUA_FN( fill_where, int, lua::table spec ) {
+  Rect const region = region_from_lua( st, spec["region"] );
+  MapGenFilter const filter = filter_from_lua( spec["where"] );
+  MapGenEdit const   edit   = edit_from_lua( spec["set"] );
+  LuaMathRand        rand( st );
+  return modify_world_map( st, [&]( Matrix<MapSquare>& m ) {
+    return fill_where( m, region, filter, edit, rand );
+  } );
+}
+
+// spec: { weights={[0]=..., ...}, region={x,y,w,h}, where={...} }
+LUA_FN( select_ground_by_row, int, lua::table spec ) {
+  SS&       ss = st["SS"].as<SS&>();
+  int const h  = ss.terrain.world_map().size().h;
+
+  lua::table            weights_tbl = spec["weights"].as<lua::table>();
+  vector<GroundWeights> row_weights( h );
+  for( int y = 0; y < h; ++y ) {
+    maybe<lua::table> const row =
+        weights_tbl[y].as<maybe<lua::table>>();
+    // Rows outside of the region need not have weights.
+    if( row.has_value() )
+      row_weights[y] = ground_weights_from_lua( st, *row );
+  }
+  Rect const region = region_from_lua( st, spec["region"] );
+  MapGenFilter const filter = filter_from_lua( spec["where"] );
+  LuaMathRand        rand( st );
+  return modify_world_map( st, [&]( Matrix<MapSquare>& m ) {
+    return select_ground_by_row( m, row_weights, region, filter,
+                                 rand );
+  } );
+}
+
+LUA_FN( label_components, MapComponents, e_surface surface ) {
+  return label_components( packed_world_map( st ), surface );
+}
+
+LUA_FN( distance_to, MapDistanceField, e_surface target ) {
+  return distance_to_surface( packed_world_map( st ), target );
+}
+
+// spec: the same config table used in resource-dist.lua, i.e.
+// { world_size, shifts, resources, board_size, x_offset,
+//   y_offset }, where `resources` is keyed on column.
+LUA_FN( resource_mask, lua::table, lua::table config ) {
+  ResourcePattern pattern;
+  pattern.board_size = config["board_size"].as<int>();
+  pattern.x_offset   = config["x_offset"].as<int>();
+  pattern.y_offset   = config["y_offset"].as<int>();
+  lua::table shifts = config["shifts"].as<lua::table>();
+  for( int i = 0; i < 4; ++i )
+    pattern.shifts[i] = shifts[i + 1].as<int>();
+  lua::table resources = config["resources"].as<lua::table>();
+  for( auto [k, v] : resources )
+    pattern.columns.push_back( lua::as<int>( k ) );
+  Delta const size = config["world_size"].as<Delta>();
+  return coords_to_lua(
+      st, resource_placement_mask( size, pattern ) );
+}
+
+LUA_FN( land_coords, lua::table ) {
+  // A single pass, so packing first would not pay off.
+  SS& ss = st["SS"].as<SS&>();
+  return coords_to_lua( st,
+                        land_coords( ss.terrain.world_map() ) );
+}
+
+LUA_STARTUP( lua::state& st ) {
+  [&] {
+    using U = ::rn::MapComponents;
+    auto u  = st.usertype.create<U>();
+
+    u["count"]    = &U::count;
+    u["label_at"] = &U::label_at;
+    u["size_of"]  = &U::size_of;
+  }();
+
+  [&] {
+    using U = ::rn::MapDistanceField;
+    auto u  = st.usertype.create<U>();
+
+    u["at"] = &U::at;
+  }();
+};
+
+} // namespace
+
+} // namespace rn
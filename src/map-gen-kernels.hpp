@@ -0,0 +1,231 @@
+/****************************************************************
+**map-gen-kernels.hpp
+*
+* Project: Revolution Now
+*
+* Created by dsicilia on 2022-12-22.
+*
+* Description: Native whole-map operations used by the map gen-
+*              erator.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Revolution Now
+#include "maybe.hpp"
+
+// ss
+#include "ss/map-square.rds.hpp"
+#include "ss/matrix.hpp"
+#include "ss/packed-square.hpp"
+
+// gfx
+#include "gfx/coord.hpp"
+
+// luapp
+#include "luapp/ext-userdata.hpp"
+
+// C++ standard library
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace rn {
+
+struct IRand;
+
+// The map generator (map-gen.lua) decides *what* to do to the
+// map, but many of its passes touch every square on the map, and
+// doing that from Lua through the MapSquare userdata is slow on
+// large maps. The functions in this module implement those
+// O(N) loops natively; the Lua script remains responsible for
+// the policy (densities, weights, which pass to run when, etc.).
+//
+// Note that all squares are visited in raster order (left to
+// right, top to bottom) and the random number generator is con-
+// sulted in that same order and only for squares that pass all
+// of the non-random criteria, which mirrors what the equivalent
+// Lua loops used to do.
+
+/****************************************************************
+** Filters and Edits
+*****************************************************************/
+// Selects squares. Each field that has a value must be satisfied
+// for a square to be selected.
+struct MapGenFilter {
+  maybe<e_surface>        surface     = {};
+  maybe<e_ground_terrain> ground      = {};
+  maybe<e_ground_terrain> not_ground  = {};
+  maybe<bool>             has_overlay = {};
+  maybe<bool>             has_river   = {};
+  maybe<bool>             sea_lane    = {};
+
+  // The square or one of its eight neighbors is water, has a
+  // river, or is marsh or swamp. This is evaluated against the
+  // map as it is being modified, so squares changed earlier in a
+  // pass are seen by squares visited later in the same pass.
+  maybe<bool> near_water_source = {};
+
+  // Select only squares whose (eight-connected) land mass has at
+  // most this many squares. The land masses are computed once
+  // before the pass starts.
+  maybe<int> max_land_component_size = {};
+
+  // Evaluated last, and only when everything else matches.
+  maybe<double> probability = {};
+
+  // Like `probability` but selects with probability 1/N by draw-
+  // ing an integer from [1,N] and checking that it is 1. This
+  // consumes random numbers in the same way as the Lua idiom
+  // `math.random(1,N)==1`, so passes that were written that way
+  // produce the same map for a given seed.
+  maybe<int> one_in = {};
+
+  bool operator==( MapGenFilter const& ) const = default;
+};
+
+// What to do to each selected square.
+struct MapGenEdit {
+  maybe<e_surface>        surface         = {};
+  maybe<e_ground_terrain> ground          = {};
+  maybe<e_land_overlay>   overlay         = {};
+  maybe<bool>             sea_lane        = {};
+  maybe<bool>             road            = {};
+  maybe<bool>             lost_city_rumor = {};
+
+  bool clear_overlay   = false;
+  bool clear_river     = false;
+  bool clear_resources = false;
+
+  bool operator==( MapGenEdit const& ) const = default;
+};
+
+bool map_gen_filter_matches( Matrix<MapSquare> const& m,
+                             Coord                    tile,
+                             MapGenFilter const&      filter );
+
+void apply_map_gen_edit( MapSquare& square,
+                         MapGenEdit const& edit );
+
+// Applies the edit to every square inside `region` (clipped to
+// the map) that is selected by the filter. Returns the number of
+// squares that were selected.
+int fill_where( Matrix<MapSquare>& m, Rect region,
+                MapGenFilter const& filter,
+                MapGenEdit const& edit, IRand& rand );
+
+/****************************************************************
+** Connected Components
+*****************************************************************/
+struct MapComponents {
+  // Zero for squares not of the surface in question, otherwise
+  // the one-based id of the component that contains the square.
+  Matrix<int> labels;
+
+  // sizes[id-1] is the number of squares in component `id`.
+  std::vector<int> sizes;
+
+  int count() const { return int( sizes.size() ); }
+
+  // Returns zero if the coordinate is not on the map.
+  int label_at( Coord tile ) const;
+
+  // Returns zero if the label is not a valid component id.
+  int size_of( int label ) const;
+
+  bool operator==( MapComponents const& ) const = default;
+};
+
+// Labels the eight-connected components formed by the squares
+// with the given surface. Components are numbered in the order
+// in which their first square is encountered in raster order.
+MapComponents label_components( Matrix<MapSquare> const& m,
+                                e_surface surface );
+
+MapComponents label_components( Matrix<PackedSquare> const& m,
+                                e_surface surface );
+
+/****************************************************************
+** Distance Transforms
+*****************************************************************/
+struct MapDistanceField {
+  // For each square this holds the number of king moves (i.e.
+  // Chebyshev distance) to the closest square with the target
+  // surface; those squares themselves hold zero. If there are no
+  // such squares on the map then each square holds `kUnreach-
+  // able`.
+  Matrix<int> distances;
+
+  static constexpr int kUnreachable = 1'000'000'000;
+
+  // Returns kUnreachable if the coordinate is not on the map.
+  int at( Coord tile ) const;
+
+  bool operator==( MapDistanceField const& ) const = default;
+};
+
+// E.g. distance_to_surface( m, e_surface::land ) gives, for each
+// water square, how far it is from the coast.
+MapDistanceField distance_to_surface(
+    Matrix<MapSquare> const& m, e_surface target );
+
+MapDistanceField distance_to_surface(
+    Matrix<PackedSquare> const& m, e_surface target );
+
+/****************************************************************
+** Weighted Ground Selection
+*****************************************************************/
+// A list of (ground, weight) pairs that should add up to 1.0. A
+// `nothing` ground means "leave the square as it is." The order
+// of the entries is significant since it determines which entry
+// a given random number lands on.
+using GroundWeights =
+    std::vector<std::pair<maybe<e_ground_terrain>, double>>;
+
+// For each square in the region that is selected by the filter
+// this will draw one random number and pick the ground type ac-
+// cording to the weights for the square's row. `row_weights`
+// must have an entry for each row of the map. Returns the number
+// of squares whose ground type was assigned.
+int select_ground_by_row(
+    Matrix<MapSquare>&                m,
+    std::vector<GroundWeights> const& row_weights, Rect region,
+    MapGenFilter const& filter, IRand& rand );
+
+/****************************************************************
+** Resource Placement Masks
+*****************************************************************/
+// Parameters for the fixed resource/LCR distribution pattern
+// used by the original game (see resource-dist.lua).
+struct ResourcePattern {
+  int                board_size = 0;
+  std::array<int, 4> shifts     = {};
+  // Which columns of the board hold a resource.
+  std::vector<int> columns  = {};
+  int              x_offset = 0;
+  int              y_offset = 0;
+
+  bool operator==( ResourcePattern const& ) const = default;
+};
+
+// Returns the coordinates, in raster order, of all squares on a
+// map of the given size that are selected by the pattern.
+std::vector<Coord> resource_placement_mask(
+    Delta size, ResourcePattern const& pattern );
+
+// Returns the coordinates of all land squares in raster order.
+std::vector<Coord> land_coords( Matrix<MapSquare> const& m );
+
+std::vector<Coord> land_coords( Matrix<PackedSquare> const& m );
+
+} // namespace rn
+
+/****************************************************************
+** Lua
+*****************************************************************/
+namespace lua {
+LUA_USERDATA_TRAITS( ::rn::MapComponents, owned_by_lua ){};
+LUA_USERDATA_TRAITS( ::rn::MapDistanceField, owned_by_lua ){};
+} // namespace lua
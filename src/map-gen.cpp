@@ -11,6 +11,9 @@
 #include "map-gen.hpp"
 
 // Revolution Now
+#include "co-time.hpp"
+#include "logger.hpp"
+#include "lua.hpp"
 #include "map-square.hpp"
 #include "map-updater.hpp"
 
@@ -18,17 +21,28 @@
 #include "ss/land-view.hpp"
 #include "ss/map-square.hpp"
 #include "ss/ref.hpp"
+#include "ss/root.hpp"
 #include "ss/terrain.hpp"
 
 // luapp
+#include "luapp/iter.hpp"
+#include "luapp/rfunction.hpp"
+#include "luapp/rtable.hpp"
 #include "luapp/state.hpp"
+#include "luapp/types.hpp"
 
 // refl
+#include "refl/query-enum.hpp"
 #include "refl/to-str.hpp"
 
 // base
 #include "base/to-str-ext-std.hpp"
 
+// C++ standard library
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 
 namespace rn {
@@ -40,8 +54,229 @@ void generate_terrain_impl( lua::state& st,
   CHECK_HAS_VALUE( st["map_gen"]["generate"].pcall() );
 }
 
+/****************************************************************
+** Background Generation
+*****************************************************************/
+void to_source( lua::any o, string& out ) {
+  switch( lua::type_of( o ) ) {
+    case lua::type::nil: out += "nil"; return;
+    case lua::type::boolean:
+      out += lua::as<bool>( o ) ? "true" : "false";
+      return;
+    case lua::type::number:
+      if( auto const i = lua::as<maybe<int>>( o ); i )
+        out += fmt::to_string( *i );
+      else
+        out += fmt::format( "{}", lua::as<double>( o ) );
+      return;
+    case lua::type::string:
+      out += '"';
+      for( char const c : lua::as<string>( o ) ) {
+        if( c == '"' || c == '\\' )
+          out += fmt::format( "\\{}", c );
+        else if( static_cast<unsigned char>( c ) < ' ' )
+          out += fmt::format( "\\{:03}", int( c ) );
+        else
+          out += c;
+      }
+      out += '"';
+      return;
+    case lua::type::table: {
+      out += '{';
+      for( auto [k, v] : lua::as<lua::table>( o ) ) {
+        out += '[';
+        to_source( k, out );
+        out += "]=";
+        to_source( v, out );
+        out += ',';
+      }
+      out += '}';
+      return;
+    }
+    default:
+      FATAL( "cannot copy Lua value of type {} between states.",
+             lua::type_of( o ) );
+  }
+}
+
+// Threads of workers that were destroyed before they finished.
+// They have been cancelled, but joining them in the worker's de-
+// structor would still block the main thread briefly, so they
+// are parked here instead and joined once they are done, which
+// is checked each time a new worker is started. Any that are
+// left are joined at exit, which does not take long since the
+// generator checks for cancellation as it runs (see run).
+struct OrphanedMapGenThreads {
+  struct Orphan {
+    thread                                 worker;
+    shared_ptr<MapGenWorker::Shared const> shared;
+  };
+
+  ~OrphanedMapGenThreads() {
+    for( Orphan& orphan : orphans ) orphan.worker.join();
+  }
+
+  void reap();
+
+  vector<Orphan> orphans;
+};
+
+// Only used from the main thread.
+OrphanedMapGenThreads& orphaned_map_gen_threads() {
+  static OrphanedMapGenThreads orphans;
+  return orphans;
+}
+
 } // namespace
 
+/****************************************************************
+** MapGenWorker
+*****************************************************************/
+// Shared between the worker (on the main thread) and the back-
+// ground thread. Apart from construction, all communication with
+// the thread goes through the cancellation flag and the mutex-
+// protected members.
+struct MapGenWorker::Shared {
+  Shared( string options_code, int seed, Setup setup )
+    : options_code( std::move( options_code ) ),
+      seed( seed ),
+      setup( std::move( setup ) ) {}
+
+  // Runs on the background thread.
+  void run();
+
+  // Only touched by the background thread while it is running.
+  SS         ss;
+  lua::state st;
+
+  string const options_code;
+  int const    seed;
+  Setup const  setup;
+
+  atomic<bool> cancelled = false;
+
+  mutable mutex    mtx;
+  MapGenProgress   progress = {};
+  bool             finished = false;
+  maybe<string>    error    = {};
+  GeneratedTerrain result   = {};
+};
+
+void MapGenWorker::Shared::run() {
+  lua_init( st );
+  st["ROOT"] = ss.root;
+  st["SS"]   = ss;
+  st["math"]["randomseed"]( seed );
+  if( setup ) setup( st, ss );
+
+  // The generator only checks for cancellation at its stage
+  // boundaries, which can be far apart on large maps, so also
+  // check periodically while it runs. That way a cancelled
+  // thread exits promptly, including one that has been orphaned
+  // and is joined at exit.
+  lua::rfunction const is_cancelled = st.function.create(
+      [this] { return cancelled.load(); } );
+  st.script.load( R"(
+    local is_cancelled = ...
+    debug.sethook( function()
+      if is_cancelled() then
+        error( 'map generation cancelled.' )
+      end
+    end, '', 10000 )
+  )" )( is_cancelled );
+
+  lua::rfunction const on_progress = st.function.create(
+      [this]( string const& stage, double fraction ) {
+        lock_guard<mutex> lock( mtx );
+        progress = MapGenProgress{ .stage    = stage,
+                                   .fraction = fraction };
+        // Returning false will abort the generation.
+        return !cancelled.load();
+      } );
+
+  lua::lua_expect<lua::table> options =
+      st.script.run_safe<lua::table>( "return " + options_code );
+  lua::lua_valid res =
+      options.has_value()
+          ? st["map_gen"]["generate_terrain"].pcall(
+                *options, on_progress )
+          : lua::lua_invalid( options.error() );
+
+  lock_guard<mutex> lock( mtx );
+  if( res.valid() ) {
+    TerrainState& terrain = ss.mutable_terrain_use_with_care;
+    result.world_map = std::move( terrain.mutable_world_map() );
+    for( e_cardinal_direction d :
+         refl::enum_values<e_cardinal_direction> )
+      result.proto_squares[d] = terrain.proto_square( d );
+    result.placement_seed = terrain.placement_seed();
+  } else {
+    error = res.error();
+  }
+  finished = true;
+}
+
+void OrphanedMapGenThreads::reap() {
+  erase_if( orphans, []( Orphan& orphan ) {
+    lock_guard<mutex> lock( orphan.shared->mtx );
+    if( !orphan.shared->finished ) return false;
+    // It has nothing left to do but exit.
+    orphan.worker.join();
+    return true;
+  } );
+}
+
+MapGenWorker::MapGenWorker( string options_code, int seed,
+                            Setup setup )
+  : shared_( make_shared<Shared>( std::move( options_code ),
+                                  seed, std::move( setup ) ) ) {
+  orphaned_map_gen_threads().reap();
+  thread_ = thread( [shared = shared_] { shared->run(); } );
+}
+
+MapGenWorker::~MapGenWorker() {
+  if( !thread_.joinable() ) return;
+  cancel();
+  if( finished() ) {
+    thread_.join();
+    return;
+  }
+  orphaned_map_gen_threads().orphans.push_back(
+      { .worker = std::move( thread_ ), .shared = shared_ } );
+}
+
+void MapGenWorker::cancel() { shared_->cancelled = true; }
+
+MapGenProgress MapGenWorker::progress() const {
+  lock_guard<mutex> lock( shared_->mtx );
+  return shared_->progress;
+}
+
+bool MapGenWorker::finished() const {
+  lock_guard<mutex> lock( shared_->mtx );
+  return shared_->finished;
+}
+
+expect<GeneratedTerrain> MapGenWorker::take_result() {
+  {
+    lock_guard<mutex> lock( shared_->mtx );
+    CHECK( shared_->finished );
+  }
+  // The thread is done with the shared state at this point.
+  thread_.join();
+  if( shared_->error.has_value() ) return *shared_->error;
+  return std::move( shared_->result );
+}
+
+/****************************************************************
+** Public API
+*****************************************************************/
+string lua_value_to_source( lua::any o ) {
+  string res;
+  to_source( o, res );
+  return res;
+}
+
 void reset_terrain( IMapUpdater& map_updater, Delta size ) {
   map_updater.modify_entire_map(
       [&]( Matrix<MapSquare>& world_map ) {
@@ -56,6 +291,45 @@ void generate_terrain( lua::state&  st,
   } );
 }
 
+wait<> generate_terrain_in_background(
+    SS& ss, IMapUpdater& map_updater, lua::table map_options,
+    int seed,
+    base::function_ref<void( MapGenProgress const& )>
+        on_progress ) {
+  GeneratedTerrain terrain;
+  {
+    // If this coroutine gets cancelled then this will get de-
+    // stroyed, which will cancel the thread without waiting for
+    // it to finish.
+    MapGenWorker   worker( lua_value_to_source( map_options ),
+                           seed );
+    MapGenProgress last;
+    while( !worker.finished() ) {
+      MapGenProgress const curr = worker.progress();
+      if( curr != last ) {
+        on_progress( curr );
+        last = curr;
+      }
+      co_await chrono::milliseconds( 20 );
+    }
+    UNWRAP_CHECK_MSG( res, worker.take_result(),
+                      "background map generation failed" );
+    terrain = std::move( res );
+  }
+
+  map_updater.modify_entire_map( [&]( Matrix<MapSquare>& m ) {
+    m = std::move( terrain.world_map );
+  } );
+  // The map updater does not deal with these, but that's OK be-
+  // cause they are not rendered directly.
+  TerrainState& terrain_state = ss.mutable_terrain_use_with_care;
+  for( e_cardinal_direction d :
+       refl::enum_values<e_cardinal_direction> )
+    terrain_state.mutable_proto_square( d ) =
+        terrain.proto_squares[d];
+  terrain_state.set_placement_seed( terrain.placement_seed );
+}
+
 void ascii_map_gen( lua::state& st, SS& ss ) {
   NonRenderingMapUpdater map_updater( ss );
   generate_terrain( st, map_updater );
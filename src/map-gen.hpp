@@ -12,11 +12,31 @@
 
 #include "core-config.hpp"
 
+// Revolution Now
+#include "expect.hpp"
+#include "wait.hpp"
+
+// ss
+#include "ss/terrain.hpp"
+
+// luapp
+#include "luapp/any.hpp"
+
 // gfx
 #include "gfx/coord.hpp"
 
+// base
+#include "base/function-ref.hpp"
+
+// C++ standard library
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
 namespace lua {
 struct state;
+struct table;
 }
 
 namespace rn {
@@ -27,6 +47,92 @@ struct SS;
 void generate_terrain( lua::state&  st,
                        IMapUpdater& map_updater );
 
+// Reported periodically while a map is being generated in the
+// background. `stage` is a short description of what the gen-
+// erator is currently doing, and `fraction` is an approximate
+// measure in [0, 1] of how much of the work has been done.
+struct MapGenProgress {
+  std::string stage    = {};
+  double      fraction = 0.0;
+
+  bool operator==( MapGenProgress const& ) const = default;
+};
+
+// Lua tables can't be shared between Lua states, so in order to
+// get the map generator options from the main state into the one
+// used by the background thread we convert them to Lua source
+// code which, when run, reproduces the value. Only plain data
+// (nil, booleans, numbers, strings, and tables thereof) is sup-
+// ported.
+std::string lua_value_to_source( lua::any o );
+
+// The parts of the terrain state that are produced by map_-
+// gen.generate_terrain.
+struct GeneratedTerrain {
+  Matrix<MapSquare> world_map;
+  ProtoSquaresMap   proto_squares;
+  int               placement_seed = 0;
+};
+
+// Owns a background thread that runs map_gen.generate_terrain
+// with its own Lua state and game state. The destructor cancels
+// the generation but does not wait for the thread to finish;
+// the thread is cleaned up later.
+struct MapGenWorker {
+  // Called on the background thread once the Lua state has been
+  // initialized and before the generator is run. Mainly for
+  // testing.
+  using Setup = std::function<void( lua::state&, SS& )>;
+
+  MapGenWorker( std::string options_code, int seed,
+                Setup setup = {} );
+
+  ~MapGenWorker();
+
+  MapGenWorker( MapGenWorker const& )            = delete;
+  MapGenWorker& operator=( MapGenWorker const& ) = delete;
+
+  MapGenProgress progress() const;
+
+  bool finished() const;
+
+  // Asks the generator to stop, after which the result will be
+  // an error. The generator checks for this periodically, so it
+  // does not need to wait for the current stage to finish.
+  void cancel();
+
+  // Must only be called (once) after `finished` returns true.
+  expect<GeneratedTerrain> take_result();
+
+  // Implementation detail.
+  struct Shared;
+
+ private:
+  std::shared_ptr<Shared> shared_;
+  std::thread             thread_;
+};
+
+// Runs the terrain portion of the map generator (i.e., map_-
+// gen.generate_terrain) on a background thread using a dedi-
+// cated Lua state and a private copy of the map, so that the UI
+// can keep running while large maps are generated. When it is
+// done, the new map is swapped in via the map updater.
+//
+// `map_options` are the map generator options from the main Lua
+// state; they must only contain plain data since they will be
+// copied into the other Lua state. `seed` is used to seed the
+// random number generator of that state. `on_progress` will be
+// called (on the main thread) each time the progress changes.
+//
+// If the returned wait is cancelled then the generation will be
+// aborted and the map will remain unchanged; the cancellation
+// itself does not block.
+wait<> generate_terrain_in_background(
+    SS& ss, IMapUpdater& map_updater, lua::table map_options,
+    int seed,
+    base::function_ref<void( MapGenProgress const& )>
+        on_progress );
+
 void ascii_map_gen( lua::state& st, SS& ss );
 
 void reset_terrain( IMapUpdater& map_updater, Delta size );
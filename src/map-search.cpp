@@ -10,10 +10,18 @@
 *****************************************************************/
 #include "map-search.hpp"
 
+// Revolution Now
+#include "error.hpp"
+
 // ss
 #include "ss/ref.hpp"
 #include "ss/terrain.hpp"
 
+// C++ standard library
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
 using namespace std;
 
 namespace rn {
@@ -22,6 +30,10 @@ namespace {
 
 using ::base::generator;
 
+int num_spiral_offsets( int radius ) {
+  return ( 2 * radius + 1 ) * ( 2 * radius + 1 );
+}
+
 } // namespace
 
 /****************************************************************
@@ -56,4 +68,64 @@ generator<gfx::point> outward_spiral_search_existing(
   }
 }
 
+/****************************************************************
+** OutwardSpiral
+*****************************************************************/
+OutwardSpiral::iterator& OutwardSpiral::iterator::operator++() {
+  if( side_ < 4 ) {
+    switch( side_ ) {
+      case 0: ++curr_.x; break;
+      case 1: ++curr_.y; break;
+      case 2: --curr_.x; break;
+      case 3: --curr_.y; break;
+    }
+    if( ++step_ < len_ - 1 ) return *this;
+    step_ = 0;
+    if( ++side_ < 4 ) return *this;
+  }
+  // Start the next ring at its upper left corner.
+  --curr_.x;
+  --curr_.y;
+  len_ += 2;
+  side_ = 0;
+  return *this;
+}
+
+/****************************************************************
+** OutwardSpiralExisting
+*****************************************************************/
+shared_ptr<vector<gfx::size> const> outward_spiral_offsets(
+    int radius ) {
+  CHECK_GE( radius, 0 );
+  // This is reachable from the background map generator thread
+  // (via the Lua map generator) as well as from the main thread.
+  static mutex m;
+  static shared_ptr<vector<gfx::size> const> table =
+      make_shared<vector<gfx::size> const>();
+  lock_guard lock( m );
+  int const needed = num_spiral_offsets( radius );
+  if( int( table->size() ) >= needed ) return table;
+  auto res = make_shared<vector<gfx::size>>();
+  res->reserve( needed );
+  gfx::point const origin{};
+  for( gfx::point const p : OutwardSpiral( origin ) ) {
+    if( int( res->size() ) == needed ) break;
+    res->push_back( p - origin );
+  }
+  table = std::move( res );
+  return table;
+}
+
+OutwardSpiralExisting::OutwardSpiralExisting(
+    SSConst const& ss, gfx::point start )
+  : start_( start ), world_( ss.terrain.world_size_tiles() ) {
+  // Far enough to reach the furthest corner of the map.
+  int const radius =
+      std::max( { abs( start.x ), abs( start.x - world_.w + 1 ),
+                  abs( start.y ),
+                  abs( start.y - world_.h + 1 ) } );
+  offsets_ = outward_spiral_offsets( radius );
+  size_    = num_spiral_offsets( radius );
+}
+
 } // namespace rn
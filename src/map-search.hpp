@@ -18,6 +18,11 @@
 // base
 #include "base/generator.hpp"
 
+// C++ standard library
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 namespace rn {
 
 struct SSConst;
@@ -43,4 +48,154 @@ base::generator<gfx::point> outward_spiral_search(
 base::generator<gfx::point> outward_spiral_search_existing(
     SSConst const ss, gfx::point const start );
 
+/****************************************************************
+** Allocation-free spirals
+*****************************************************************/
+// Yields the same infinite stream of points as outward_spiral_-
+// search, in the same order, but with a plain iterator that
+// keeps track of where it is on the current ring instead of with
+// a coroutine, so that nothing is allocated.
+class OutwardSpiral {
+ public:
+  explicit OutwardSpiral( gfx::point start ) : start_( start ) {}
+
+  struct sentinel {};
+
+  class iterator {
+   public:
+    using value_type      = gfx::point;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    gfx::point operator*() const { return curr_; }
+
+    iterator& operator++();
+
+    iterator operator++( int ) {
+      iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==( sentinel ) const { return false; }
+
+   private:
+    friend class OutwardSpiral;
+
+    explicit iterator( gfx::point start ) : curr_( start ) {}
+
+    gfx::point curr_ = {};
+    // Length of a side of the current ring.
+    int len_ = 1;
+    // 0=top, 1=right, 2=bottom, 3=left, 4=ring finished.
+    int side_ = 4;
+    int step_ = 0;
+  };
+
+  iterator begin() const { return iterator( start_ ); }
+  sentinel end() const { return {}; }
+
+ private:
+  gfx::point start_;
+};
+
+// The offsets from the starting point of the first points
+// yielded by outward_spiral_search, in the same order, enough to
+// cover every point within `radius` tiles of the start in each
+// direction (i.e. (2*radius+1)^2 of them). The table is computed
+// once for the largest radius asked for so far and shared; a
+// search holds on to the table that it started with, so growing
+// it does not affect searches in progress. This is thread safe.
+std::shared_ptr<std::vector<gfx::size> const>
+outward_spiral_offsets( int radius );
+
+// Yields the same points as outward_spiral_search_existing, in
+// the same order, but by walking the precomputed spiral table
+// (which covers the whole map from any starting point) and so
+// without a coroutine. Unlike the generator version this holds
+// only the size of the map and not the SSConst, so it can be
+// constructed from temporaries.
+class OutwardSpiralExisting {
+ public:
+  OutwardSpiralExisting( SSConst const& ss, gfx::point start );
+
+  struct sentinel {};
+
+  class iterator {
+   public:
+    using value_type      = gfx::point;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    gfx::point operator*() const {
+      return at( range_->start_, ( *range_->offsets_ )[idx_] );
+    }
+
+    iterator& operator++() {
+      if( --remaining_ == 0 )
+        idx_ = range_->size_;
+      else
+        skip_to_existing( idx_ + 1 );
+      return *this;
+    }
+
+    iterator operator++( int ) {
+      iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==( sentinel ) const {
+      return idx_ >= range_->size_;
+    }
+
+   private:
+    friend class OutwardSpiralExisting;
+
+    iterator( OutwardSpiralExisting const* range, int remaining )
+      : range_( range ), remaining_( remaining ) {
+      if( remaining_ == 0 )
+        idx_ = range_->size_;
+      else
+        skip_to_existing( 0 );
+    }
+
+    static gfx::point at( gfx::point start, gfx::size offset ) {
+      return { .x = start.x + offset.w, .y = start.y + offset.h };
+    }
+
+    void skip_to_existing( int idx ) {
+      std::vector<gfx::size> const& offsets = *range_->offsets_;
+      gfx::point const              start   = range_->start_;
+      gfx::size const               world   = range_->world_;
+      for( ; idx < range_->size_; ++idx ) {
+        gfx::point const p = at( start, offsets[idx] );
+        if( p.x >= 0 && p.y >= 0 && p.x < world.w &&
+            p.y < world.h )
+          break;
+      }
+      idx_ = idx;
+    }
+
+    OutwardSpiralExisting const* range_     = nullptr;
+    int                          idx_       = 0;
+    int                          remaining_ = 0;
+  };
+
+  iterator begin() const {
+    return iterator( this, world_.area() );
+  }
+
+  sentinel end() const { return {}; }
+
+ private:
+  std::shared_ptr<std::vector<gfx::size> const> offsets_;
+  gfx::point                                    start_;
+  gfx::size                                     world_;
+  // Number of offsets that need to be considered.
+  int size_ = 0;
+};
+
 } // namespace rn
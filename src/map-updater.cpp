@@ -11,6 +11,7 @@
 #include "map-updater.hpp"
 
 // Revolution Now
+#include "logger.hpp"
 #include "render-terrain.hpp"
 #include "tiles.hpp"
 #include "visibility.hpp"
@@ -25,6 +26,9 @@
 // gfx
 #include "gfx/iter.hpp"
 
+// C++ standard library
+#include <algorithm>
+
 using namespace std;
 
 namespace rn {
@@ -48,18 +52,22 @@ TerrainRenderOptions make_terrain_options(
 bool NonRenderingMapUpdater::modify_map_square(
     Coord                                  tile,
     base::function_ref<void( MapSquare& )> mutator ) {
-  MapSquare old_square = ss_.terrain.square_at( tile );
-  mutator( ss_.mutable_terrain_use_with_care.mutable_square_at(
-      tile ) );
-  MapSquare new_square = ss_.terrain.square_at( tile );
-  if( new_square == old_square ) return false;
+  TerrainState& terrain    = ss_.mutable_terrain_use_with_care;
+  MapSquare     old_square = terrain.square_at( tile );
+  // This gives each nation that can't see the square (and that
+  // is referring to the real one) a copy of the old square.
+  mutator( terrain.mutable_square_at( tile ) );
+  MapSquare new_square = terrain.square_at( tile );
+  if( new_square == old_square ) {
+    terrain.drop_redundant_player_squares( tile );
+    return false;
+  }
 
   // Update player maps.
   refl::enum_map<e_nation, bool> const visible_to_nations =
       nations_with_visibility_of_square( ss_, tile );
   for( auto [nation, visible] : visible_to_nations )
-    if( visible ) //
-      make_square_visible( tile, nation );
+    if( visible ) make_square_visible( tile, nation );
   return true;
 }
 
@@ -71,27 +79,44 @@ bool NonRenderingMapUpdater::make_square_visible(
   Matrix<maybe<FogSquare>>& map     = player_terrain.map;
   bool                      changed = false;
   if( !map[tile].has_value() ) {
-    // We need this because the default-constructed map square
-    // we're about to make is identical to an ocean square, so we
-    // won't know that we weren't visible before.
+    // We need this because the fog square we're about to make
+    // just refers to the real square, so below we won't know
+    // that we weren't visible before.
     changed = true;
     map[tile].emplace();
   }
-  FogSquare&       fog_square    = *map[tile];
-  MapSquare&       player_square = fog_square.square;
-  MapSquare const& real_square   = ss_.terrain.square_at( tile );
+  FogSquare&        fog_square    = *map[tile];
+  maybe<MapSquare>& player_square = fog_square.square;
+  MapSquare const&  real_square =
+      ss_.terrain.square_at( tile );
 
   // TODO: check and update other members of FogSquare here.
 
-  changed |= ( player_square != real_square );
-  player_square = real_square;
+  // If the player has no copy of the square then they are al-
+  // ready looking at the real one. Otherwise drop the stale copy
+  // so that they are from now on.
+  if( player_square.has_value() ) {
+    changed |= ( *player_square != real_square );
+    player_square.reset();
+  }
   return changed;
 }
 
 void NonRenderingMapUpdater::modify_entire_map(
     base::function_ref<void( Matrix<MapSquare>& )> mutator ) {
-  mutator(
-      ss_.mutable_terrain_use_with_care.mutable_world_map() );
+  TerrainState& terrain = ss_.mutable_terrain_use_with_care;
+  // We don't know which squares are going to change, so this
+  // gives each nation a copy of every square that they can't see
+  // (and that they are referring to). This is rare enough (map
+  // editor, map generation) that it is not worth avoiding, and
+  // it is cheap when there are no player maps, e.g. during map
+  // generation.
+  mutator( terrain.mutable_world_map() );
+  // If the map was resized then the player maps need to be re-
+  // made to match it. Otherwise this drops the copies of the
+  // squares that didn't change.
+  terrain.reinitialize_player_terrain_after_resize();
+  terrain.drop_redundant_player_squares();
 }
 
 void NonRenderingMapUpdater::redraw() {}
@@ -104,7 +129,8 @@ RenderingMapUpdater::RenderingMapUpdater(
   : NonRenderingMapUpdater( ss ),
     renderer_( renderer ),
     tiles_redrawn_( 0 ),
-    tile_bounds_( ss.terrain.world_size_tiles() ) {
+    tile_bounds_( ss.terrain.world_size_tiles() ),
+    lod_tile_bounds_( ss.terrain.world_size_tiles() ) {
   // Something is probably wrong if this happens.
   CHECK_GT( tile_bounds_.size().area(), 0 );
 }
@@ -127,22 +153,39 @@ void RenderingMapUpdater::redraw_square(
     TerrainRenderOptions const& terrain_options, Coord tile ) {
   auto& renderer = renderer_;
   SCOPED_RENDERER_MOD_SET( painter_mods.repos.use_camera, true );
-  SCOPED_RENDERER_MOD_SET(
-      buffer_mods.buffer,
-      rr::e_render_target_buffer::landscape_annex );
-
-  rr::VertexRange const old_bounds = tile_bounds_[tile];
-  tile_bounds_[tile]               = renderer_.range_for( [&] {
-    render_terrain_square( renderer_, tile * g_tile_delta, tile,
-                                         viz, terrain_options );
-  } );
-
-  // Now we zero out the vertices from the old tile. If we don't
-  // do this then, over time, as we overwite a tile many times,
-  // the tile accumulates so many renderable vertices that frame
-  // rate significantly drops when a large number of screen
-  // pixels are occupied by such tiles.
-  renderer_.zap( old_bounds );
+  {
+    SCOPED_RENDERER_MOD_SET(
+        buffer_mods.buffer,
+        rr::e_render_target_buffer::landscape_annex );
+
+    rr::VertexRange const old_bounds = tile_bounds_[tile];
+    tile_bounds_[tile] = renderer_.range_for( [&] {
+      render_terrain_square( renderer_, tile * g_tile_delta,
+                             tile, viz, terrain_options );
+    } );
+
+    // Now we zero out the vertices from the old tile. If we
+    // don't do this then, over time, as we overwite a tile many
+    // times, the tile accumulates so many renderable vertices
+    // that frame rate significantly drops when a large number of
+    // screen pixels are occupied by such tiles.
+    renderer_.zap( old_bounds );
+  }
+
+  // Same for the simplified tile, which goes into its own annex
+  // so that the (whole-map) LOD buffer does not need to get
+  // re-uploaded each time a tile changes.
+  {
+    SCOPED_RENDERER_MOD_SET(
+        buffer_mods.buffer,
+        rr::e_render_target_buffer::landscape_lod_annex );
+    rr::VertexRange const old_bounds = lod_tile_bounds_[tile];
+    lod_tile_bounds_[tile] = renderer_.range_for( [&] {
+      render_terrain_square_lod( renderer_, tile * g_tile_delta,
+                                 tile, viz );
+    } );
+    renderer_.zap( old_bounds );
+  }
 
   // If we've redrawn a number of tiles that are beyond the below
   // threshold then we will just redraw the entire thing. We do
@@ -159,9 +202,24 @@ void RenderingMapUpdater::redraw_square(
   // increase latency of redrawing a tile by having to re-upload
   // a large annex buffer to the GPU).
   ++tiles_redrawn_;
-  int const redraw_threshold = 20000;
   // The > is defensive.
-  if( tiles_redrawn_ >= redraw_threshold ) redraw();
+  if( tiles_redrawn_ >= kAnnexRedrawThreshold ) redraw();
+}
+
+void RenderingMapUpdater::redraw_or_defer( Rect const tiles ) {
+  if( in_transaction() ) {
+    for( Rect const r : gfx::subrect_range( tiles ) )
+      if( ss_.terrain.square_exists( r.upper_left() ) )
+        deferred_tiles_.push_back( r.upper_left() );
+    return;
+  }
+  TerrainRenderOptions const terrain_options =
+      make_terrain_options( options() );
+  Visibility const viz =
+      Visibility::create( ss_, options().nation );
+  for( Rect const r : gfx::subrect_range( tiles ) )
+    if( ss_.terrain.square_exists( r.upper_left() ) )
+      redraw_square( viz, terrain_options, r.upper_left() );
 }
 
 bool RenderingMapUpdater::modify_map_square(
@@ -181,17 +239,8 @@ bool RenderingMapUpdater::modify_map_square(
   // can derive their ground terrain from their neighbors, and
   // those in turn can affect their neighbors. Though changes of
   // this kind only happen in the map editor.
-  Rect const to_update =
-      Rect::from( tile, Delta{ .w = 1, .h = 1 } )
-          .with_border_added( 2 );
-  TerrainRenderOptions const terrain_options =
-      make_terrain_options( options() );
-  Visibility const viz =
-      Visibility::create( ss_, options().nation );
-  for( Rect moved : gfx::subrects( to_update ) )
-    if( ss_.terrain.square_exists( moved.upper_left() ) )
-      redraw_square( viz, terrain_options, moved.upper_left() );
-
+  redraw_or_defer( Rect::from( tile, Delta{ .w = 1, .h = 1 } )
+                       .with_border_added( 2 ) );
   return changed;
 }
 
@@ -208,11 +257,6 @@ bool RenderingMapUpdater::make_square_visible(
       options().nation != nation )
     return changed;
 
-  TerrainRenderOptions const terrain_options =
-      make_terrain_options( options() );
-  Visibility const viz =
-      Visibility::create( ss_, options().nation );
-  redraw_square( viz, terrain_options, tile );
   // We need to draw the surrounding squares because a visibility
   // change in one square can reveal part of the adjacent files
   // even if they are not visible. In some edge cases with map
@@ -223,12 +267,8 @@ bool RenderingMapUpdater::make_square_visible(
   // it doesn't seem worth it to take the performance hit of
   // re-rendering an additional 16 tiles just to support that
   // case, which is not part of a normal game anyway.
-  for( e_direction d : refl::enum_values<e_direction> ) {
-    Coord const moved = tile.moved( d );
-    if( !ss_.terrain.square_exists( moved ) ) continue;
-    redraw_square( viz, terrain_options, moved );
-  }
-
+  redraw_or_defer( Rect::from( tile, Delta{ .w = 1, .h = 1 } )
+                       .with_border_added( 1 ) );
   return changed;
 }
 
@@ -239,18 +279,67 @@ void RenderingMapUpdater::modify_entire_map(
 
 void RenderingMapUpdater::redraw() {
   this->Base::redraw();
+  if( in_transaction() ) {
+    deferred_full_redraw_ = true;
+    return;
+  }
   // No changing map size mid game.
   CHECK( ss_.terrain.world_size_tiles() == tile_bounds_.size() );
   TerrainRenderOptions const terrain_options =
       make_terrain_options( options() );
   Visibility const viz =
       Visibility::create( ss_, options().nation );
-  render_terrain( renderer_, viz, terrain_options,
-                  tile_bounds_ );
+  render_terrain( renderer_, viz, terrain_options, tile_bounds_,
+                  lod_tile_bounds_ );
   // Reset this since we just redrew the map.
   tiles_redrawn_ = 0;
 }
 
+MapUpdaterTransactionStats
+RenderingMapUpdater::commit_transaction() {
+  MapUpdaterTransactionStats stats{
+      .tiles_requested = int( deferred_tiles_.size() ) };
+  // Row-major order, which is also roughly the order in which
+  // the tiles sit in the landscape buffer.
+  sort( deferred_tiles_.begin(), deferred_tiles_.end(),
+        []( Coord const l, Coord const r ) {
+          return l.y != r.y ? l.y < r.y : l.x < r.x;
+        } );
+  deferred_tiles_.erase(
+      unique( deferred_tiles_.begin(), deferred_tiles_.end() ),
+      deferred_tiles_.end() );
+  int const num_tiles = int( deferred_tiles_.size() );
+  // If the redraws would push the annex buffer past its limit
+  // then we'd end up redrawing the map anyway, and if they cover
+  // a good fraction of the map then it is faster to just render
+  // it in one pass than tile by tile.
+  bool const full_redraw =
+      deferred_full_redraw_ ||
+      tiles_redrawn_ + num_tiles >= kAnnexRedrawThreshold ||
+      num_tiles >= tile_bounds_.size().area() / 4;
+  if( full_redraw ) {
+    deferred_tiles_.clear();
+    deferred_full_redraw_ = false;
+    redraw();
+    stats.full_redraw = true;
+  } else if( num_tiles > 0 ) {
+    TerrainRenderOptions const terrain_options =
+        make_terrain_options( options() );
+    Visibility const viz =
+        Visibility::create( ss_, options().nation );
+    for( Coord const tile : deferred_tiles_ )
+      redraw_square( viz, terrain_options, tile );
+    deferred_tiles_.clear();
+    stats.tiles_redrawn = num_tiles;
+  }
+  lg.debug(
+      "map updater transaction: {} tile redraws requested, {} "
+      "tiles redrawn, full redraw: {}.",
+      stats.tiles_requested, stats.tiles_redrawn,
+      stats.full_redraw );
+  return stats;
+}
+
 /****************************************************************
 ** TrappingMapUpdater
 *****************************************************************/
@@ -16,6 +16,9 @@
 // render
 #include "render/renderer.rds.hpp"
 
+// C++ standard library
+#include <vector>
+
 namespace rr {
 struct Renderer;
 }
@@ -63,6 +66,11 @@ struct RenderingMapUpdater : NonRenderingMapUpdater {
 
   RenderingMapUpdater( SS& ss, rr::Renderer& renderer );
 
+  // If we've redrawn this many tiles into the landscape annex
+  // buffer then we will just redraw the entire map. See the com-
+  // ments in redraw_square for why.
+  static constexpr int kAnnexRedrawThreshold = 20000;
+
   // Implement IMapUpdater.
   bool modify_map_square( Coord            tile,
                           SquareUpdateFunc mutator ) override;
@@ -77,14 +85,30 @@ struct RenderingMapUpdater : NonRenderingMapUpdater {
   // Implement IMapUpdater.
   void redraw() override;
 
+ protected:
+  // Implement IMapUpdater.
+  MapUpdaterTransactionStats commit_transaction() override;
+
  private:
   void redraw_square(
       Visibility const&           viz,
       TerrainRenderOptions const& terrain_options, Coord tile );
 
+  // Redraws the tiles in the rect (that exist) now, or, if
+  // there is a transaction open, adds them to the list of tiles
+  // to be redrawn when it is committed.
+  void redraw_or_defer( Rect tiles );
+
   rr::Renderer&           renderer_;
   int                     tiles_redrawn_;
   Matrix<rr::VertexRange> tile_bounds_;
+  // Same as above but for the simplified tiles in the landscape
+  // LOD buffers. These get redrawn along with the full tiles.
+  Matrix<rr::VertexRange> lod_tile_bounds_;
+  // Tiles waiting for the current transaction to commit. May
+  // contain duplicates.
+  std::vector<Coord> deferred_tiles_;
+  bool               deferred_full_redraw_ = false;
 };
 
 /****************************************************************
@@ -61,8 +61,8 @@ MeetTribe check_meet_tribe_single( SSConst const& ss,
   // 1. Compute all land square occupied by the player, meaning
   // the squares containing colonies and the outdoor workers in
   // those colonies.
-  unordered_set<Coord>   land_occupied;
-  vector<ColonyId> const colonies =
+  unordered_set<Coord>       land_occupied;
+  span<ColonyId const> const colonies =
       ss.colonies.for_nation( player.nation );
   for( ColonyId colony_id : colonies ) {
     Colony const& colony = ss.colonies.colony_for( colony_id );
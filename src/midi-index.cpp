@@ -0,0 +1,238 @@
+/****************************************************************
+**midi-index.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Pre-parsed MIDI tunes with an on-disk cache.
+*
+*****************************************************************/
+#include "midi-index.hpp"
+
+// Revolution Now
+#include "logger.hpp"
+#include "time.hpp"
+
+// config
+#include "config/music.rds.hpp"
+
+// base
+#include "base/io.hpp"
+
+// midifile
+#include "MidiFile.h"
+
+// C++ standard library
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+// "RMDX" in little endian.
+constexpr uint32_t kCacheMagic = 0x58444D52;
+
+// Increment this whenever the format of the cache file or the
+// way that the MIDI files are processed changes.
+constexpr uint32_t kCacheVersion = 1;
+
+struct CacheHeader {
+  uint32_t magic      = 0;
+  uint32_t version    = 0;
+  int64_t  mtime      = 0;
+  uint64_t size       = 0;
+  int64_t  duration   = 0; // millis
+  uint64_t num_events = 0;
+  uint64_t num_bytes  = 0;
+};
+
+static_assert( sizeof( CacheHeader ) == 48 );
+static_assert( sizeof( MidiEventRecord ) == 16 );
+
+// An entry in the memoization table of indexed_midi_tune. Each
+// one has its own mutex so that loading one tune does not block
+// other threads from getting other tunes.
+struct MemoizedTune {
+  mutex                             m;
+  shared_ptr<IndexedMidiTune const> tune;
+};
+
+} // namespace
+
+/****************************************************************
+** Parsing
+*****************************************************************/
+maybe<IndexedMidiTune> parse_midi_tune( fs::path const& file ) {
+  // A MidiFile keeps all of its state in the object itself, so
+  // this can be called from multiple threads at once as long as
+  // each uses its own.
+  smf::MidiFile midifile;
+  if( !midifile.read( file.string() ) ) return nothing;
+  // This will cause the MidiEvent::seconds fields to be popu-
+  // lated with the time at which an event should be sent to the
+  // synth. And it does take into account meta events that cause
+  // tempo changes.
+  midifile.doTimeAnalysis();
+
+  // Join/merge all tracks into one, otherwise we'd have to worry
+  // about writing an algorithm that can play two tracks at once.
+  midifile.joinTracks();
+
+  IndexedMidiTune tune;
+  tune.duration = from_seconds<chrono::milliseconds>(
+      midifile.getFileDurationInSeconds() );
+  smf::MidiEventList const& track = midifile[0];
+  tune.events.reserve( track.size() );
+  for( int i = 0; i < track.size(); ++i ) {
+    smf::MidiEvent const& e = track[i];
+    // These messages that start with 0xff are "meta" MIDI mes-
+    // sages that are intended not for the synthesizer but for
+    // the MIDI sequencer itself, and they have already been ac-
+    // counted for by the time analysis above. See
+    // https://github.com/craigsapp/midifile/issues/67.
+    if( e.empty() || e[0] == 0xff ) continue;
+    tune.events.push_back( MidiEventRecord{
+        .time_us = llround( e.seconds * 1'000'000.0 ),
+        .offset  = uint32_t( tune.bytes.size() ),
+        .size    = uint32_t( e.size() ) } );
+    tune.bytes.insert( tune.bytes.end(), e.begin(), e.end() );
+  }
+  return tune;
+}
+
+/****************************************************************
+** Serialization
+*****************************************************************/
+maybe<MidiSourceStamp> midi_source_stamp( fs::path const& file ) {
+  error_code     ec;
+  uint64_t const size = fs::file_size( file, ec );
+  if( ec ) return nothing;
+  auto const mtime = fs::last_write_time( file, ec );
+  if( ec ) return nothing;
+  return MidiSourceStamp{
+      .mtime = int64_t( mtime.time_since_epoch().count() ),
+      .size  = size };
+}
+
+string serialize_midi_tune( IndexedMidiTune const& tune,
+                            MidiSourceStamp const& stamp ) {
+  CacheHeader const header{
+      .magic      = kCacheMagic,
+      .version    = kCacheVersion,
+      .mtime      = stamp.mtime,
+      .size       = stamp.size,
+      .duration   = int64_t( tune.duration.count() ),
+      .num_events = tune.events.size(),
+      .num_bytes  = tune.bytes.size() };
+  size_t const events_size =
+      tune.events.size() * sizeof( MidiEventRecord );
+  string res;
+  res.resize( sizeof( header ) + events_size +
+              tune.bytes.size() );
+  char* p = res.data();
+  memcpy( p, &header, sizeof( header ) );
+  p += sizeof( header );
+  if( events_size > 0 ) memcpy( p, tune.events.data(), events_size );
+  p += events_size;
+  if( !tune.bytes.empty() )
+    memcpy( p, tune.bytes.data(), tune.bytes.size() );
+  return res;
+}
+
+maybe<IndexedMidiTune> deserialize_midi_tune(
+    string_view data, MidiSourceStamp const& stamp ) {
+  CacheHeader header;
+  if( data.size() < sizeof( header ) ) return nothing;
+  memcpy( &header, data.data(), sizeof( header ) );
+  data.remove_prefix( sizeof( header ) );
+  if( header.magic != kCacheMagic ) return nothing;
+  if( header.version != kCacheVersion ) return nothing;
+  if( header.mtime != stamp.mtime ) return nothing;
+  if( header.size != stamp.size ) return nothing;
+  // Check the counts before multiplying to avoid overflow.
+  if( header.num_events > data.size() ) return nothing;
+  size_t const events_size =
+      header.num_events * sizeof( MidiEventRecord );
+  if( data.size() != events_size + header.num_bytes )
+    return nothing;
+  IndexedMidiTune tune;
+  tune.duration = chrono::milliseconds( header.duration );
+  tune.events.resize( header.num_events );
+  if( events_size > 0 )
+    memcpy( tune.events.data(), data.data(), events_size );
+  data.remove_prefix( events_size );
+  tune.bytes.assign( data.begin(), data.end() );
+  for( MidiEventRecord const& event : tune.events )
+    if( uint64_t( event.offset ) + event.size >
+        tune.bytes.size() )
+      return nothing;
+  return tune;
+}
+
+/****************************************************************
+** Loading
+*****************************************************************/
+fs::path midi_cache_file( fs::path const& file,
+                          fs::path const& cache_dir ) {
+  fs::path relative = file.relative_path();
+  relative.replace_extension( ".midx" );
+  return cache_dir / relative;
+}
+
+maybe<IndexedMidiTune> load_midi_tune(
+    fs::path const& file, fs::path const& cache_dir ) {
+  maybe<MidiSourceStamp> const stamp = midi_source_stamp( file );
+  if( !stamp.has_value() ) return nothing;
+  fs::path const cache_file = midi_cache_file( file, cache_dir );
+  if( maybe<string> const data =
+          base::read_binary_file( cache_file );
+      data.has_value() ) {
+    if( maybe<IndexedMidiTune> tune =
+            deserialize_midi_tune( *data, *stamp );
+        tune.has_value() )
+      return tune;
+    lg.debug( "midi cache file {} is stale.", cache_file );
+  }
+  maybe<IndexedMidiTune> tune = parse_midi_tune( file );
+  if( !tune.has_value() ) return nothing;
+  if( !base::write_binary_file_atomic(
+          cache_file, serialize_midi_tune( *tune, *stamp ) ) )
+    lg.warn( "failed to write midi cache file {}.", cache_file );
+  return tune;
+}
+
+shared_ptr<IndexedMidiTune const> indexed_midi_tune(
+    fs::path const& file ) {
+  static mutex m;
+  static map<fs::path, unique_ptr<MemoizedTune>> tunes;
+
+  MemoizedTune* entry = nullptr;
+  {
+    // Only held while looking up the entry, so that the parsing
+    // and file I/O below don't block lookups of other tunes.
+    lock_guard lock( m );
+    unique_ptr<MemoizedTune>& p = tunes[file];
+    if( p == nullptr ) p = make_unique<MemoizedTune>();
+    entry = p.get();
+  }
+  // Held while loading so that the main thread and the MIDI
+  // thread don't both load (and write the cache file of) the
+  // same tune.
+  lock_guard lock( entry->m );
+  if( entry->tune != nullptr ) return entry->tune;
+  maybe<IndexedMidiTune> tune =
+      load_midi_tune( file, config_music.midi_cache_folder );
+  // Don't memoize failures since the file might appear later.
+  if( !tune.has_value() ) return nullptr;
+  entry->tune =
+      make_shared<IndexedMidiTune const>( std::move( *tune ) );
+  return entry->tune;
+}
+
+} // namespace rn
@@ -0,0 +1,106 @@
+/****************************************************************
+**midi-index.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Pre-parsed MIDI tunes with an on-disk cache.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Revolution Now
+#include "maybe.hpp"
+
+// base
+#include "base/fs.hpp"
+
+// C++ standard library
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rn {
+
+// A single MIDI message to be sent to the synth. Meta events are
+// not included since they are never sent.
+struct MidiEventRecord {
+  // Time from the start of the tune at which the event is to be
+  // sent, having taken tempo changes into account.
+  int64_t time_us = 0;
+  // The bytes of the message are in IndexedMidiTune::bytes.
+  uint32_t offset = 0;
+  uint32_t size   = 0;
+
+  bool operator==( MidiEventRecord const& ) const = default;
+};
+
+// A MIDI file that has been parsed, time-analyzed, and had its
+// tracks joined into a single stream of events sorted by time.
+// This is all that the sequencer needs in order to play it, and
+// it is flat so that it can be written to and read from the
+// cache without any parsing, and so that playing it does not re-
+// quire any allocation.
+struct IndexedMidiTune {
+  std::chrono::milliseconds    duration = {};
+  std::vector<MidiEventRecord> events   = {};
+  std::vector<unsigned char>   bytes    = {};
+
+  std::span<unsigned char const> event_bytes(
+      MidiEventRecord const& event ) const {
+    return std::span<unsigned char const>( bytes ).subspan(
+        event.offset, event.size );
+  }
+
+  bool operator==( IndexedMidiTune const& ) const = default;
+};
+
+// Parses the MIDI file from scratch, which is slow.
+maybe<IndexedMidiTune> parse_midi_tune( fs::path const& file );
+
+// Identifies the version of the source file from which a cache
+// entry was generated.
+struct MidiSourceStamp {
+  int64_t  mtime = 0;
+  uint64_t size  = 0;
+
+  bool operator==( MidiSourceStamp const& ) const = default;
+};
+
+maybe<MidiSourceStamp> midi_source_stamp( fs::path const& file );
+
+std::string serialize_midi_tune( IndexedMidiTune const& tune,
+                                 MidiSourceStamp const& stamp );
+
+// Returns nothing if the data is not valid or if it was gener-
+// ated from a different version of the source file.
+maybe<IndexedMidiTune> deserialize_midi_tune(
+    std::string_view data, MidiSourceStamp const& stamp );
+
+// The cache file for the given MIDI file. It mirrors the path of
+// the MIDI file so that tunes with the same name in different
+// folders don't share a cache file.
+fs::path midi_cache_file( fs::path const& file,
+                          fs::path const& cache_dir );
+
+// Loads the tune from the cache in the given folder if it is up
+// to date with the MIDI file, otherwise parses the MIDI file and
+// updates the cache. Failure to write the cache is not an error.
+maybe<IndexedMidiTune> load_midi_tune(
+    fs::path const& file, fs::path const& cache_dir );
+
+// Same as above but memoized in memory and using the game's
+// cache folder, so that each tune is only loaded once per run.
+// This is thread safe since it is called both by the main thread
+// (when selecting tunes) and by the MIDI thread (when playing).
+std::shared_ptr<IndexedMidiTune const> indexed_midi_tune(
+    fs::path const& file );
+
+} // namespace rn
@@ -14,6 +14,7 @@
 #include "error.hpp"
 #include "init.hpp"
 #include "logger.hpp"
+#include "midi-index.hpp"
 #include "ranges-fwd.hpp"
 #include "time.hpp"
 
@@ -24,9 +25,6 @@
 // base-util
 #include "base-util/io.hpp"
 
-// midifile (FIXME)
-#include "../extern/midifile/include/MidiFile.h"
-
 // rtmidi.
 // Don't warn on anything in here.
 #ifdef __clang__
@@ -42,6 +40,7 @@
 #include <algorithm>
 #include <queue>
 #include <set>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -107,25 +106,8 @@ class MidiIO {
     return res;
   }
 
-  void send_midi_message( smf::MidiEvent const& event ) {
-    size_t const max_event_size = 200;
-    // Should be more than large enough for any event. Use a
-    // static vector so that we don't have to do a heap alloca-
-    // tion on each event.
-    static vector<unsigned char> bytes = [&]() {
-      vector<unsigned char> res;
-      res.resize( max_event_size );
-      return res;
-    }();
-    if( event.size() > max_event_size ) {
-      // Should be extremely rare.
-      lg.warn( "midi event size {} is larger than max (={})",
-               event.size(), max_event_size );
-      return;
-    }
-    for( size_t i = 0; i < event.size(); ++i )
-      bytes[i] = event[i];
-    send_midi_message( &bytes[0], event.size() );
+  void send_midi_message( span<unsigned char const> event ) {
+    send_midi_message( event.data(), event.size() );
   }
 
   // Apparently there is a midi message called "all notes off",
@@ -188,7 +170,8 @@ class MidiIO {
   }
 
   // This one does some filtering of midi messages.
-  void send_midi_message( unsigned char* bytes, size_t size ) {
+  void send_midi_message( unsigned char const* bytes,
+                          size_t               size ) {
     if( size == 0 ) return;
 
     if( bytes[0] == 0xff ) {
@@ -230,8 +213,8 @@ class MidiIO {
     send_midi_message_impl( message, 3 );
   }
 
-  void send_midi_message_impl( unsigned char* bytes,
-                               size_t         size ) {
+  void send_midi_message_impl( unsigned char const* bytes,
+                               size_t               size ) {
     // Save the message for debugging purposes.
     last_message_.resize( size );
     for( size_t i = 0; i < size; ++i )
@@ -433,38 +416,29 @@ MidiCommunication g_midi_comm;
 // data in this struct. Even the waiting between notes is done in
 // small intervals to avoid blocking.
 struct MidiPlayInfo {
-  smf::MidiFile midifile;
-  int           current_event;
-  int           track;
-  Time_t        start_time;
-  maybe<Time_t> last_pause_time;
-  Duration_t    stoppage;
-  milliseconds  tune_duration;
+  shared_ptr<IndexedMidiTune const> tune;
+  size_t                            current_event;
+  Time_t                            start_time;
+  maybe<Time_t>                     last_pause_time;
+  Duration_t                        stoppage;
+  milliseconds                      tune_duration;
+
+  bool finished() const {
+    return current_event >= tune->events.size();
+  }
 };
 
 // May fail to load the file. NOTE: this method must be callable
 // from both the main thread and the MIDI thread simultaneously,
 // so it should not change any state of the world apart from log-
-// ging.
+// ging. The tune is only parsed the first time; after that it
+// comes from memory (or from the cache on disk, across runs).
 maybe<MidiPlayInfo> load_midi_file( fs::path const& file ) {
   MidiPlayInfo info;
-  // TODO: check if midifile.read() is thread safe.
-  if( !info.midifile.read( file ) ) return nothing;
-  // This will cause the MidiEvent::seconds fields to be popu-
-  // lated with the time at which an event should be sent to the
-  // synth. And it does take into account meta events that cause
-  // tempo changes.
-  info.midifile.doTimeAnalysis();
-  info.midifile.linkNotePairs(); // why do we need this?
-
-  // Join/merge all tracks into one, otherwise we'd have to worry
-  // about writing an algorithm that can play two tracks at once.
-  info.midifile.joinTracks();
-
-  info.tune_duration = from_seconds<milliseconds>(
-      info.midifile.getFileDurationInSeconds() );
+  info.tune = indexed_midi_tune( file );
+  if( info.tune == nullptr ) return nothing;
+  info.tune_duration   = info.tune->duration;
   info.current_event   = 0;
-  info.track           = 0;
   info.start_time      = Clock_t::now();
   info.last_pause_time = nothing;
   info.stoppage        = 0us;
@@ -475,20 +449,17 @@ maybe<MidiPlayInfo> load_midi_file( fs::path const& file ) {
 
 // Plays a single midi event and waits first if necessary.
 void midi_play_event( MidiPlayInfo* info ) {
-  // Always use track 0 because on loading the midi files we join
-  // all tracks into one.
-  if( info->current_event >=
-      info->midifile[info->track].size() ) {
+  if( info->finished() ) {
     // Finished playing this song.
     return;
   }
 
-  auto const& e =
-      info->midifile[info->track][info->current_event];
+  MidiEventRecord const& e =
+      info->tune->events[info->current_event];
 
   // Get the time (from the start of the tune) at which this
   // event should be played.
-  auto event_time_delta = from_seconds<Duration_t>( e.seconds );
+  Duration_t event_time_delta = microseconds( e.time_us );
 
   // This will yield the correct time taking into account any
   // amount of time that we've been paused during playing.
@@ -552,7 +523,7 @@ void midi_play_event( MidiPlayInfo* info ) {
   // duration that we have calculated above is the amount of time
   // we have to wait until we reach the absolute time
   // (event_time) where this new message is suppose to be sent.
-  g_midi->send_midi_message( e );
+  g_midi->send_midi_message( info->tune->event_bytes( e ) );
   info->current_event++;
 }
 
@@ -593,14 +564,6 @@ void midi_thread_impl() {
           auto& [file] = cmd.value().get<command::play>();
           g_midi_comm.set_state( e_midiseq_state::playing );
           g_midi.value().all_notes_off();
-          // ****************************************************
-          // FIXME: This reset is needed to avoid memory manage-
-          // ment bugs in the smf::MidiFile move assignment oper-
-          // ator. Fix is to trigger destructor before moving.
-          // This can be removed once the issue is fixed. See:
-          //   https://github.com/craigsapp/midifile/issues/69
-          maybe_info.reset();
-          // ****************************************************
           maybe_info = load_midi_file( file );
           if( !maybe_info ) {
             midi_thread_record_failure(
@@ -705,8 +668,7 @@ void midi_thread_impl() {
         midi_play_event( &info ); // play a single event.
         // If this midi file has finished playing then signal
         // that we should load the next one.
-        if( info.current_event >=
-            info.midifile[info.track].size() ) {
+        if( info.finished() ) {
           lg.info( "midi file {} has finished.", stem );
           g_midi->all_notes_off();
           maybe_info = nothing;
@@ -752,6 +714,10 @@ void init_midiseq() {
   if( maybe_midi_io ) {
     g_midi.emplace( std::move( *maybe_midi_io ) );
 
+    // Tunes are indexed lazily the first time that they are
+    // loaded (see load_midi_file) so that startup does not have
+    // to parse every tune when the on-disk cache is cold.
+
     lg.info( "creating midi thread." );
     // Initialization of midi thread. This is only done if we
     // found a midi port.
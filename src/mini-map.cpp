@@ -412,7 +412,8 @@ void MiniMapView::draw_impl( rr::Renderer&     renderer,
           chrono::milliseconds{ 1000 } >
       chrono::milliseconds{ 500 };
 
-  for( gfx::rect r : gfx::subrects( squares.truncated() ) ) {
+  for( gfx::rect r :
+       gfx::subrect_range( squares.truncated() ) ) {
     Coord const land_coord = Coord::from_gfx( r.nw() );
     CHECK( viz.on_map( land_coord ) );
     if( !viz.visible( land_coord ) ) continue;
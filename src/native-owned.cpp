@@ -28,9 +28,6 @@
 #include "ss/settings.rds.hpp"
 #include "ss/terrain.hpp"
 
-// base
-#include "base/keyval.hpp"
-
 using namespace std;
 
 namespace rn {
@@ -46,8 +43,7 @@ is_land_native_owned_after_meeting_without_colonies(
   if( player.fathers.has[e_founding_father::peter_minuit] )
     // Effectively no native land ownership when we have Minuit.
     return nothing;
-  return base::lookup( ss.natives.owned_land_without_minuit(),
-                       coord );
+  return ss.natives.land_owner_without_minuit( coord );
 }
 
 maybe<DwellingId> is_land_native_owned_after_meeting(
@@ -11,6 +11,7 @@
 #include "omni.hpp"
 
 // Revolution Now
+#include "frame-timing.hpp"
 #include "frame.hpp"
 #include "plane.hpp"
 #include "screen.hpp"
@@ -66,9 +67,33 @@ struct OmniPlane::Impl : public Plane {
         .write( frame_rate );
   }
 
+  // Shows the p50/p99/max time taken by each phase of the frame
+  // in the upper left corner of the screen.
+  void render_frame_timings( rr::Renderer& renderer ) const {
+    rr::Painter    painter = renderer.painter();
+    vector<string> lines   = frame_timing_report();
+    gfx::size      size;
+    for( string const& line : lines ) {
+      gfx::size const line_size =
+          rr::rendered_text_line_size_pixels( line );
+      size.w = std::max( size.w, line_size.w );
+      size.h += line_size.h;
+    }
+    painter.draw_solid_rect(
+        gfx::rect{ .origin = {}, .size = size },
+        gfx::pixel::black().with_alpha( 200 ) );
+    rr::Typer typer =
+        renderer.typer( "simple", {}, gfx::pixel::banana() );
+    for( string const& line : lines ) {
+      typer.write( line );
+      typer.newline();
+    }
+  }
+
   void draw( rr::Renderer& renderer ) const override {
     rr::Painter painter = renderer.painter();
     render_framerate( renderer );
+    if( show_frame_timings_ ) render_frame_timings( renderer );
     render_sprite(
         painter, e_tile::mouse_arrow1,
         input::current_mouse_position() - Delta{ .w = 16 } );
@@ -91,6 +116,9 @@ struct OmniPlane::Impl : public Plane {
             // if( !screenshot() )
             //   lg.warn( "failed to take screenshot." );
             break;
+          case ::SDLK_F10:
+            show_frame_timings_ = !show_frame_timings_;
+            break;
           case ::SDLK_F11:
             if( is_window_fullscreen() ) {
               toggle_fullscreen();
@@ -126,6 +154,8 @@ struct OmniPlane::Impl : public Plane {
     }
     return handled;
   }
+
+  bool show_frame_timings_ = false;
 };
 
 /****************************************************************
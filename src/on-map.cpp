@@ -151,8 +151,13 @@ void unit_to_map_square_non_interactive( SS& ss, TS& ts,
   e_nation const      nation  = unit.nation();
   vector<Coord> const visible = unit_visible_squares(
       ss, nation, unit.type(), world_square );
-  for( Coord coord : visible )
-    ts.map_updater.make_square_visible( coord, nation );
+  {
+    // The revealed squares overlap each other's neighbors, so
+    // this avoids redrawing most tiles several times.
+    auto const transaction = ts.map_updater.begin_transaction();
+    for( Coord coord : visible )
+      ts.map_updater.make_square_visible( coord, nation );
+  }
 
   // 4. If the unit is at a colony site then append the unit ID
   //    to the colony's list of unit's at the gate (said list
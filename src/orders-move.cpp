@@ -1402,8 +1402,8 @@ wait<> AttackHandler::perform() {
       // 1. The colony changes ownership, as well as all of the
       // units that are working in it and who are on the map at
       // the colony location.
-      change_colony_nation( ss_.colonies.colony_for( colony_id ),
-                            ss_.units, attacker.nation() );
+      change_colony_nation( ss_.colonies, ss_.units, colony_id,
+                            attacker.nation() );
       // 2. The attacker moves into the colony square.
       maybe<UnitDeleted> unit_deleted =
           co_await unit_to_map_square( ss_, ts_, attacker.id(),
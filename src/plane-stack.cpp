@@ -150,10 +150,9 @@ Planes::popper::~popper() {
   planes_.groups_.pop_back();
 }
 
-vector<Plane*> Planes::active_planes() const {
-  vector<Plane*> res;
+Planes::ActivePlanes Planes::active_planes() const {
+  ActivePlanes res;
   if( groups_.empty() ) return res;
-  res.reserve( kNumPlanes );
   PlaneGroup const& pg = back();
   for( e_plane plane : refl::enum_values<e_plane> ) {
     maybe<Plane&> p = plane_pointer( pg, plane );
@@ -161,8 +160,8 @@ vector<Plane*> Planes::active_planes() const {
     // This will ensure that planes that are completely obscured
     // by a another plane on top of them will not be considered
     // for either drawing or input.
-    if( p->covers_screen() ) res.clear();
-    res.push_back( addressof( *p ) );
+    if( p->covers_screen() ) res.count = 0;
+    res.planes[res.count++] = addressof( *p );
   }
   return res;
 }
@@ -170,14 +169,14 @@ vector<Plane*> Planes::active_planes() const {
 void Planes::draw( rr::Renderer& renderer ) const {
   renderer.clear_screen( gfx::pixel::black() );
   if( groups_.empty() ) return;
-  vector<Plane*> active = active_planes();
-  for( Plane* plane : active ) plane->draw( renderer );
+  ActivePlanes const active = active_planes();
+  for( Plane* plane : active.all() ) plane->draw( renderer );
 }
 
 void Planes::advance_state() {
   if( groups_.empty() ) return;
-  vector<Plane*> active = active_planes();
-  for( Plane* plane : active ) plane->advance_state();
+  ActivePlanes const active = active_planes();
+  for( Plane* plane : active.all() ) plane->advance_state();
 }
 
 e_input_handled Planes::send_input(
@@ -187,8 +186,9 @@ e_input_handled Planes::send_input(
   auto* drag_event =
       std::get_if<input::mouse_drag_event_t>( &event );
   if( drag_event == nullptr ) {
-    vector<Plane*> active   = active_planes();
-    auto           reversed = base::rl::rall( active );
+    ActivePlanes const       active   = active_planes();
+    span<Plane* const> const planes   = active.all();
+    auto                     reversed = base::rl::rall( planes );
     // Normal event, so send it out using the usual protocol.
     for( Plane* plane : reversed ) {
       switch( plane->input( event ) ) {
@@ -262,8 +262,9 @@ e_input_handled Planes::send_input(
   // No drag plane registered to accept the event, so lets send
   // out the event but only if it's a `begin` event.
   if( drag_event->state.phase == e_drag_phase::begin ) {
-    vector<Plane*> active   = active_planes();
-    auto           reversed = base::rl::rall( active );
+    ActivePlanes const       active   = active_planes();
+    span<Plane* const> const planes   = active.all();
+    auto                     reversed = base::rl::rall( planes );
     for( Plane* plane : reversed ) {
       // Note here we use the origin position of the mouse drag
       // as opposed to the current mouse position because that
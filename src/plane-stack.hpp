@@ -27,8 +27,9 @@
 #include "base/macros.hpp"
 
 // C++ standard library
+#include <array>
 #include <list>
-#include <vector>
+#include <span>
 
 #define PLANE_ACCESSOR_DECL( type, name ) \
   type&       name();                     \
@@ -132,7 +133,20 @@ struct Planes {
   // ence to the top group and then add a new one.
   std::list<PlaneGroup> groups_;
 
-  std::vector<Plane*> active_planes() const;
+  // This is computed for each input event, so it has a fixed ca-
+  // pacity in order to avoid allocating. It is not kept between
+  // calls because both the planes in the group and whether they
+  // cover the screen can change while events are dispatched.
+  struct ActivePlanes {
+    std::array<Plane*, kNumPlanes> planes = {};
+    int                            count  = 0;
+
+    std::span<Plane* const> all() const {
+      return { planes.data(), size_t( count ) };
+    }
+  };
+
+  ActivePlanes active_planes() const;
 
   enum class e_drag_send_mode { normal, raw, motion };
 
@@ -12,6 +12,7 @@
 
 // refl
 #include "ext.hpp"
+#include "query-enum.hpp"
 
 // cdr
 #include "cdr/converter.hpp"
@@ -22,7 +23,6 @@
 
 // C++ standard library
 #include <string>
-#include <unordered_set>
 
 namespace refl {
 
@@ -69,10 +69,9 @@ template<refl::ReflectedEnum E>
 result<E> from_canonical( converter& conv, value const& v,
                           tag_t<E> ) {
   UNWRAP_RETURN( str, conv.ensure_type<std::string>( v ) );
-  static auto const& names = refl::traits<E>::value_names;
-  for( size_t i = 0; i < names.size(); ++i )
-    if( names[i] == str ) //
-      return static_cast<E>( i );
+  if( base::maybe<E> const e = refl::enum_from_string<E>( str );
+      e.has_value() )
+    return *e;
   return conv.err( "unrecognized value for enum {}: \"{}\"",
                    refl::traits<E>::name, str );
 }
@@ -94,8 +93,7 @@ value to_canonical( converter& conv, S const& o, tag_t<S> ) {
   FOR_CONSTEXPR_IDX( Idx, kNumFields ) {
     auto& field_desc = std::get<Idx>( Tr::fields );
     auto& field_val  = o.*field_desc.accessor;
-    conv.to_field( tbl, std::string( field_desc.name ),
-                   field_val );
+    conv.to_field( tbl, field_desc.name, field_val );
   };
   return tbl;
 }
@@ -108,15 +106,15 @@ result<S> from_canonical( converter& conv, value const& v,
       std::tuple_size_v<decltype( Tr::fields )>;
   S res{};
   UNWRAP_RETURN( tbl, conv.ensure_type<table>( v ) );
-  std::unordered_set<std::string> used_keys;
-  base::maybe<error>              err;
+  field_tracker<kNumFields> used_keys;
+  base::maybe<error>        err;
   FOR_CONSTEXPR_IDX( Idx, kNumFields ) {
     CHECK( !err.has_value() );
     auto& field_desc = std::get<Idx>( Tr::fields );
     using field_type = typename std::remove_cvref_t<
         decltype( field_desc )>::type;
     auto field_val = conv.from_field<field_type>(
-        tbl, std::string( field_desc.name ), used_keys );
+        tbl, field_desc.name, used_keys );
     if( !field_val.has_value() ) {
       err = std::move( field_val.error() );
       return true; // stop iterating.
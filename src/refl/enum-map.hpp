@@ -26,7 +26,6 @@
 
 // C++ standard library
 #include <memory>
-#include <unordered_set>
 #include <vector>
 
 namespace refl {
@@ -136,8 +135,7 @@ struct enum_map : public std::vector<std::pair<Enum, ValT>> {
     // ture, we know the complete set of possible keys and all of
     // their names, similar to a struct.
     for( Enum e : refl::enum_values<Enum> )
-      conv.to_field(
-          tbl, std::string( refl::enum_value_name( e ) ), o[e] );
+      conv.to_field( tbl, refl::enum_value_name( e ), o[e] );
     return tbl;
   }
 
@@ -145,8 +143,8 @@ struct enum_map : public std::vector<std::pair<Enum, ValT>> {
       cdr::converter& conv, cdr::value const& v,
       cdr::tag_t<enum_map> ) {
     UNWRAP_RETURN( tbl, conv.ensure_type<cdr::table>( v ) );
-    std::unordered_set<std::string> used_keys;
-    enum_map                        res;
+    cdr::field_tracker<refl::enum_count<Enum>> used_keys;
+    enum_map                                   res;
     // Here we can use from_field to allow the converter to con-
     // trol default field value behavior because, for this data
     // structure, we know the complete set of possible keys and
@@ -155,8 +153,7 @@ struct enum_map : public std::vector<std::pair<Enum, ValT>> {
       UNWRAP_RETURN(
           val,
           conv.from_field<ValT>(
-              tbl, std::string( refl::enum_value_name( e ) ),
-              used_keys ) );
+              tbl, refl::enum_value_name( e ), used_keys ) );
       res[e] = std::move( val );
     }
     HAS_VALUE_OR_RET(
@@ -17,8 +17,10 @@
 #include "base/maybe.hpp"
 
 // C++ standard library
+#include <algorithm>
 #include <array>
 #include <concepts>
+#include <utility>
 
 #define FOR_ENUM( var, enum_type ) \
   for( enum_type const var : refl::enum_values<enum_type> )
@@ -50,18 +52,38 @@ constexpr base::maybe<E> enum_from_integral( Int val ) {
   return res;
 }
 
+namespace detail {
+
+// The value names paired with their values and sorted by name
+// so that they can be binary searched. This is built at compile
+// time from value_names so that it works for any reflected enum,
+// including ones with hand-written traits.
+template<ReflectedEnum E>
+inline constexpr auto enum_values_by_name = [] {
+  using entry_t = std::pair<std::string_view, E>;
+  std::array<entry_t, enum_count<E>> arr{};
+  for( int i = 0; i < enum_count<E>; ++i )
+    arr[i] = { traits<E>::value_names[i], static_cast<E>( i ) };
+  std::sort( arr.begin(), arr.end() );
+  return arr;
+}();
+
+} // namespace detail
+
+// This gets called for every enum value in every config and save
+// file that is loaded, and some of the enums (e.g. tiles) are
+// large, so it uses a binary search instead of a linear scan.
 template<ReflectedEnum E>
 constexpr base::maybe<E> enum_from_string(
     std::string_view name ) {
   base::maybe<E> res;
-  int            i = 0;
-  for( std::string_view sv : traits<E>::value_names ) {
-    if( name == sv ) {
-      res = static_cast<E>( i );
-      break;
-    }
-    ++i;
-  }
+  auto const&    sorted = detail::enum_values_by_name<E>;
+  auto const     it     = std::lower_bound(
+      sorted.begin(), sorted.end(), name,
+      []( auto const& p, std::string_view sv ) {
+        return p.first < sv;
+      } );
+  if( it != sorted.end() && it->first == name ) res = it->second;
   return res;
 }
 
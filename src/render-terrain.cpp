@@ -22,6 +22,9 @@
 // ss
 #include "ss/terrain.hpp"
 
+// config
+#include "config/land-view.rds.hpp"
+
 // render
 #include "render/renderer.hpp"
 
@@ -2372,10 +2375,67 @@ void render_terrain_square(
                              gfx::pixel{ 0, 0, 0, 30 } );
 }
 
+void render_terrain_square_lod( rr::Renderer& renderer,
+                                Coord         where,
+                                Coord         world_square,
+                                Visibility const& viz ) {
+  rr::Painter painter = renderer.painter();
+  if( !viz.visible( world_square ) ) {
+    render_sprite( painter, where, e_tile::terrain_hidden );
+    return;
+  }
+  MapSquare const& square = viz.square_at( world_square );
+  if( square.surface == e_surface::water ) {
+    render_sprite( painter, where,
+                   square.sea_lane
+                       ? e_tile::terrain_ocean_sea_lane
+                       : e_tile::terrain_ocean );
+    return;
+  }
+  render_sprite( painter, where,
+                 tile_for_ground_terrain( square.ground ) );
+  if( !square.overlay.has_value() ) return;
+  // The stand-alone overlay sprites don't depend on the neigh-
+  // bors, so they keep this cheap while still showing the color
+  // of the forests, hills and mountains at a distance.
+  e_tile overlay_tile = {};
+  switch( *square.overlay ) {
+    case e_land_overlay::forest:
+      overlay_tile =
+          ( square.ground == e_ground_terrain::desert )
+              ? e_tile::terrain_forest_scrub_island
+              : e_tile::terrain_forest_island;
+      break;
+    case e_land_overlay::hills:
+      overlay_tile = e_tile::terrain_hills_island;
+      break;
+    case e_land_overlay::mountains:
+      overlay_tile = e_tile::terrain_mountains_island;
+      break;
+  }
+  render_sprite( painter, where, overlay_tile );
+}
+
+void render_landscape_buffers( rr::Renderer& renderer,
+                               double const  zoom ) {
+  if( zoom < config_land_view.lod_zoom_threshold ) {
+    renderer.render_buffer(
+        rr::e_render_target_buffer::landscape_lod );
+    renderer.render_buffer(
+        rr::e_render_target_buffer::landscape_lod_annex );
+    return;
+  }
+  renderer.render_buffer(
+      rr::e_render_target_buffer::landscape );
+  renderer.render_buffer(
+      rr::e_render_target_buffer::landscape_annex );
+}
+
 void render_terrain( rr::Renderer&               renderer,
                      Visibility const&           viz,
                      TerrainRenderOptions const& options,
-                     Matrix<rr::VertexRange>&    tile_bounds ) {
+                     Matrix<rr::VertexRange>&    tile_bounds,
+                     Matrix<rr::VertexRange>& lod_tile_bounds ) {
   SCOPED_RENDERER_MOD_SET( painter_mods.repos.use_camera, true );
   // We can throw away all of the tile overwrites that we've
   // made, since we are now going to redraw everything from
@@ -2385,14 +2445,18 @@ void render_terrain( rr::Renderer&               renderer,
   auto const kLandscapeBuf =
       rr::e_render_target_buffer::landscape;
   renderer.clear_buffer( kLandscapeBuf );
-  SCOPED_RENDERER_MOD_SET( buffer_mods.buffer, kLandscapeBuf );
   auto start_time = chrono::system_clock::now();
-  for( Rect const square : gfx::subrects( viz.rect_tiles() ) ) {
-    tile_bounds[square.upper_left()] = renderer.range_for( [&] {
-      render_terrain_square( renderer,
-                             square.upper_left() * g_tile_delta,
-                             square.upper_left(), viz, options );
-    } );
+  {
+    SCOPED_RENDERER_MOD_SET( buffer_mods.buffer, kLandscapeBuf );
+    for( Rect const square :
+         gfx::subrect_range( viz.rect_tiles() ) ) {
+      tile_bounds[square.upper_left()] =
+          renderer.range_for( [&] {
+            render_terrain_square(
+                renderer, square.upper_left() * g_tile_delta,
+                square.upper_left(), viz, options );
+          } );
+    }
   }
   auto end_time = chrono::system_clock::now();
   lg.info(
@@ -2403,6 +2467,33 @@ void render_terrain( rr::Renderer&               renderer,
           .count(),
       renderer.buffer_vertex_count( kLandscapeBuf ),
       renderer.buffer_size_mb( kLandscapeBuf ) );
+
+  renderer.clear_buffer(
+      rr::e_render_target_buffer::landscape_lod_annex );
+  auto const kLodBuf = rr::e_render_target_buffer::landscape_lod;
+  renderer.clear_buffer( kLodBuf );
+  start_time = chrono::system_clock::now();
+  {
+    SCOPED_RENDERER_MOD_SET( buffer_mods.buffer, kLodBuf );
+    for( Rect const square :
+         gfx::subrect_range( viz.rect_tiles() ) ) {
+      lod_tile_bounds[square.upper_left()] =
+          renderer.range_for( [&] {
+            render_terrain_square_lod(
+                renderer, square.upper_left() * g_tile_delta,
+                square.upper_left(), viz );
+          } );
+    }
+  }
+  end_time = chrono::system_clock::now();
+  lg.info(
+      "rendered landscape LOD: {}ms with {} vertices, occupying "
+      "{:.2f}MB.",
+      chrono::duration_cast<chrono::milliseconds>( end_time -
+                                                   start_time )
+          .count(),
+      renderer.buffer_vertex_count( kLodBuf ),
+      renderer.buffer_size_mb( kLodBuf ) );
 }
 
 } // namespace rn
@@ -48,11 +48,30 @@ void render_terrain_square(
     rr::Renderer& renderer, Coord where, Coord world_square,
     Visibility const& viz, TerrainRenderOptions const& options );
 
-// Render the entire map to the landscape buffer. Should only be
+// Render the simplified version of the terrain square that is
+// used when the map is zoomed out; this is one sprite for the
+// ground (or water) of the square with the stand-alone version
+// of its overlay (if any) on top, or the hidden tile if the
+// square is not visible.
+void render_terrain_square_lod( rr::Renderer& renderer,
+                                Coord         where,
+                                Coord         world_square,
+                                Visibility const& viz );
+
+// Draws the landscape buffers, which should have already been
+// rendered, choosing the detailed landscape (and its annex) or
+// the simplified one based on the zoom. The camera should be set
+// before calling this.
+void render_landscape_buffers( rr::Renderer& renderer,
+                               double        zoom );
+
+// Render the entire map to the landscape buffer, and the simpli-
+// fied version of it to the landscape LOD buffer. Should only be
 // called once after the map is generated.
 void render_terrain( rr::Renderer&               renderer,
                      Visibility const&           viz,
                      TerrainRenderOptions const& options,
-                     Matrix<rr::VertexRange>&    tile_bounds );
+                     Matrix<rr::VertexRange>&    tile_bounds,
+                     Matrix<rr::VertexRange>& lod_tile_bounds );
 
 } // namespace rn
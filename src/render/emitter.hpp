@@ -57,6 +57,11 @@ struct Emitter {
         vert.size() ) );
   }
 
+  // Emits vertices that have already been fully processed, e.g.
+  // ones that were copied out of a buffer earlier in order to be
+  // replayed.
+  void emit( std::span<GenericVertex const> vertices );
+
   void log_capacity_changes( bool enable ) {
     log_capacity_changes_ = enable;
   }
@@ -64,8 +69,6 @@ struct Emitter {
  private:
   void emit( GenericVertex const& vert );
 
-  void emit( std::span<GenericVertex const> vertices );
-
   std::vector<GenericVertex>* buffer_;
   long                        pos_;
   bool                        log_capacity_changes_;
@@ -63,6 +63,8 @@ struct DepixelateInfo {
   // triangle will be computed using the stage_gradient slopes to
   // extrapolate.
   base::maybe<gfx::dpoint> stage_anchor = {};
+
+  bool operator==( DepixelateInfo const& ) const = default;
 };
 
 // These options allow specifying a global rescaling and transla-
@@ -73,10 +75,14 @@ struct RepositionInfo {
   base::maybe<double>     scale       = {};
   base::maybe<gfx::dsize> translation = {};
   bool                    use_camera  = false;
+
+  bool operator==( RepositionInfo const& ) const = default;
 };
 
 struct ColorCyclingInfo {
   bool enabled = false;
+
+  bool operator==( ColorCyclingInfo const& ) const = default;
 };
 
 struct PainterMods {
@@ -84,6 +90,8 @@ struct PainterMods {
   base::maybe<double> alpha      = {};
   RepositionInfo      repos      = {};
   ColorCyclingInfo    cycling    = {};
+
+  bool operator==( PainterMods const& ) const = default;
 };
 
 /****************************************************************
@@ -92,6 +92,8 @@ struct Renderer::Impl {
         VertexArray_t vertex_array_arg,
         VertexArray_t landscape_vertex_array_arg,
         VertexArray_t landscape_annex_vertex_array_arg,
+        VertexArray_t landscape_lod_vertex_array_arg,
+        VertexArray_t landscape_lod_annex_vertex_array_arg,
         VertexArray_t backdrop_vertex_array_arg,
         AtlasMap atlas_map_arg, size atlas_size_arg,
         gl::Texture                      atlas_tx_arg,
@@ -109,6 +111,10 @@ struct Renderer::Impl {
           std::move( landscape_vertex_array_arg ) ),
       landscape_annex_vertex_array(
           std::move( landscape_annex_vertex_array_arg ) ),
+      landscape_lod_vertex_array(
+          std::move( landscape_lod_vertex_array_arg ) ),
+      landscape_lod_annex_vertex_array(
+          std::move( landscape_lod_annex_vertex_array_arg ) ),
       backdrop_vertex_array(
           std::move( backdrop_vertex_array_arg ) ),
       atlas_map( std::move( atlas_map_arg ) ),
@@ -122,18 +128,27 @@ struct Renderer::Impl {
       vertices{},
       landscape_vertices{},
       landscape_annex_vertices{},
+      landscape_lod_vertices{},
+      landscape_lod_annex_vertices{},
       backdrop_vertices{},
       emitter( vertices ),
       landscape_emitter( landscape_vertices ),
       landscape_annex_emitter( landscape_annex_vertices ),
+      landscape_lod_emitter( landscape_lod_vertices ),
+      landscape_lod_annex_emitter(
+          landscape_lod_annex_vertices ),
       backdrop_emitter( backdrop_vertices ),
       logical_screen_size( logical_screen_size_arg ),
       landscape_dirty( true ),
-      landscape_annex_dirty( true ) {
+      landscape_annex_dirty( true ),
+      landscape_lod_dirty( true ),
+      landscape_lod_annex_dirty( true ) {
     mod_stack.push( RendererMods{} );
     emitter.log_capacity_changes( false );
     landscape_emitter.log_capacity_changes( false );
     landscape_annex_emitter.log_capacity_changes( false );
+    landscape_lod_emitter.log_capacity_changes( false );
+    landscape_lod_annex_emitter.log_capacity_changes( false );
     backdrop_emitter.log_capacity_changes( false );
   };
 
@@ -160,6 +175,10 @@ struct Renderer::Impl {
         landscape_vertex_array;
     gl::VertexArray<gl::VertexBuffer<GenericVertex>>
         landscape_annex_vertex_array;
+    gl::VertexArray<gl::VertexBuffer<GenericVertex>>
+        landscape_lod_vertex_array;
+    gl::VertexArray<gl::VertexBuffer<GenericVertex>>
+        landscape_lod_annex_vertex_array;
     gl::VertexArray<gl::VertexBuffer<GenericVertex>>
          backdrop_vertex_array;
     auto pgrm = [&] {
@@ -181,17 +200,38 @@ struct Renderer::Impl {
     AtlasBuilder               atlas_builder;
     unordered_map<string, int> atlas_ids;
 
-    for( SpriteSheetConfig const& sheet :
-         config.sprite_sheets ) {
-      CHECK_HAS_VALUE(
-          load_sprite_sheet( atlas_builder, sheet, atlas_ids ) );
+    if( config.sprite_sheet_images != nullptr )
+      CHECK_EQ( config.sprite_sheet_images->size(),
+                config.sprite_sheets.size() );
+    int const num_sprite_sheets = config.sprite_sheets.size();
+    for( int i = 0; i < num_sprite_sheets; ++i ) {
+      SpriteSheetConfig const& sheet = config.sprite_sheets[i];
+      if( config.sprite_sheet_images == nullptr ) {
+        CHECK_HAS_VALUE( load_sprite_sheet( atlas_builder, sheet,
+                                            atlas_ids ) );
+        continue;
+      }
+      CHECK_HAS_VALUE( load_sprite_sheet(
+          atlas_builder,
+          std::move( ( *config.sprite_sheet_images )[i] ),
+          sheet.sprite_size, sheet.sprites, atlas_ids ) );
     }
 
+    if( config.font_sheet_images != nullptr )
+      CHECK_EQ( config.font_sheet_images->size(),
+                config.font_sheets.size() );
     unordered_map<string, AsciiFont> ascii_fonts;
-    for( AsciiFontSheetConfig const& sheet :
-         config.font_sheets ) {
-      UNWRAP_CHECK( ascii_font, load_ascii_font_sheet(
-                                    atlas_builder, sheet ) );
+    int const num_font_sheets = config.font_sheets.size();
+    for( int i = 0; i < num_font_sheets; ++i ) {
+      AsciiFontSheetConfig const& sheet = config.font_sheets[i];
+      UNWRAP_CHECK(
+          ascii_font,
+          config.font_sheet_images == nullptr
+              ? load_ascii_font_sheet( atlas_builder, sheet )
+              : load_ascii_font_sheet(
+                    atlas_builder,
+                    std::move(
+                        ( *config.font_sheet_images )[i] ) ) );
       ascii_fonts.emplace( sheet.font_name,
                            std::move( ascii_font ) );
     }
@@ -232,6 +272,10 @@ struct Renderer::Impl {
         std::move( landscape_vertex_array ),
         /*landscape_annex_vertex_array=*/
         std::move( landscape_annex_vertex_array ),
+        /*landscape_lod_vertex_array=*/
+        std::move( landscape_lod_vertex_array ),
+        /*landscape_lod_annex_vertex_array=*/
+        std::move( landscape_lod_annex_vertex_array ),
         /*backdrop_vertex_array=*/
         std::move( backdrop_vertex_array ),
         /*atlas_map=*/std::move( atlas.dict ),
@@ -283,6 +327,12 @@ struct Renderer::Impl {
       case e_render_target_buffer::landscape_annex:
         modded_emitter = &landscape_annex_emitter;
         break;
+      case e_render_target_buffer::landscape_lod:
+        modded_emitter = &landscape_lod_emitter;
+        break;
+      case e_render_target_buffer::landscape_lod_annex:
+        modded_emitter = &landscape_lod_annex_emitter;
+        break;
       case e_render_target_buffer::backdrop:
         modded_emitter = &backdrop_emitter;
         break;
@@ -337,6 +387,12 @@ struct Renderer::Impl {
     if( mods.buffer_mods.buffer ==
         e_render_target_buffer::landscape_annex )
       landscape_annex_dirty = true;
+    if( mods.buffer_mods.buffer ==
+        e_render_target_buffer::landscape_lod )
+      landscape_lod_dirty = true;
+    if( mods.buffer_mods.buffer ==
+        e_render_target_buffer::landscape_lod_annex )
+      landscape_lod_annex_dirty = true;
   }
 
   void mods_pop() {
@@ -359,6 +415,14 @@ struct Renderer::Impl {
         landscape_annex_vertices.clear();
         landscape_annex_emitter.set_position( 0 );
         break;
+      case e_render_target_buffer::landscape_lod:
+        landscape_lod_vertices.clear();
+        landscape_lod_emitter.set_position( 0 );
+        break;
+      case e_render_target_buffer::landscape_lod_annex:
+        landscape_lod_annex_vertices.clear();
+        landscape_lod_annex_emitter.set_position( 0 );
+        break;
       case e_render_target_buffer::backdrop:
         // We don't currently have a use for this, because the
         // backdrop buffer gets automatically cleared at the
@@ -391,6 +455,10 @@ struct Renderer::Impl {
         return landscape_vertices;
       case e_render_target_buffer::landscape_annex:
         return landscape_annex_vertices;
+      case e_render_target_buffer::landscape_lod:
+        return landscape_lod_vertices;
+      case e_render_target_buffer::landscape_lod_annex:
+        return landscape_lod_annex_vertices;
       case e_render_target_buffer::backdrop:
         return backdrop_vertices;
     }
@@ -403,6 +471,10 @@ struct Renderer::Impl {
         return landscape_emitter;
       case e_render_target_buffer::landscape_annex:
         return landscape_annex_emitter;
+      case e_render_target_buffer::landscape_lod:
+        return landscape_lod_emitter;
+      case e_render_target_buffer::landscape_lod_annex:
+        return landscape_lod_annex_emitter;
       case e_render_target_buffer::backdrop:
         return backdrop_emitter;
     }
@@ -416,6 +488,10 @@ struct Renderer::Impl {
         return landscape_vertex_array;
       case e_render_target_buffer::landscape_annex:
         return landscape_annex_vertex_array;
+      case e_render_target_buffer::landscape_lod:
+        return landscape_lod_vertex_array;
+      case e_render_target_buffer::landscape_lod_annex:
+        return landscape_lod_annex_vertex_array;
       case e_render_target_buffer::backdrop:
         return backdrop_vertex_array;
     }
@@ -431,6 +507,10 @@ struct Renderer::Impl {
         return landscape_dirty;
       case e_render_target_buffer::landscape_annex:
         return landscape_annex_dirty;
+      case e_render_target_buffer::landscape_lod:
+        return landscape_lod_dirty;
+      case e_render_target_buffer::landscape_lod_annex:
+        return landscape_lod_annex_dirty;
       case e_render_target_buffer::backdrop:
         // This is equivalent to always being dirty because it is
         // reuploaded to the GPU each frame.
@@ -505,6 +585,28 @@ struct Renderer::Impl {
                      landscape_annex_vertices.size() );
         break;
       }
+      case e_render_target_buffer::landscape_lod: {
+        if( landscape_lod_dirty ) {
+          landscape_lod_vertex_array.buffer<0>()
+              .upload_data_replace( landscape_lod_vertices,
+                                    gl::e_draw_mode::stat1c );
+          landscape_lod_dirty = false;
+        }
+        program.run( landscape_lod_vertex_array,
+                     landscape_lod_vertices.size() );
+        break;
+      }
+      case e_render_target_buffer::landscape_lod_annex: {
+        if( landscape_lod_annex_dirty ) {
+          landscape_lod_annex_vertex_array.buffer<0>()
+              .upload_data_replace( landscape_lod_annex_vertices,
+                                    gl::e_draw_mode::stat1c );
+          landscape_lod_annex_dirty = false;
+        }
+        program.run( landscape_lod_annex_vertex_array,
+                     landscape_lod_annex_vertices.size() );
+        break;
+      }
     }
   }
 
@@ -518,6 +620,8 @@ struct Renderer::Impl {
   VertexArray_t const              vertex_array;
   VertexArray_t const              landscape_vertex_array;
   VertexArray_t const              landscape_annex_vertex_array;
+  VertexArray_t const              landscape_lod_vertex_array;
+  VertexArray_t const landscape_lod_annex_vertex_array;
   VertexArray_t const              backdrop_vertex_array;
   AtlasMap const                   atlas_map;
   size const                       atlas_size;
@@ -530,14 +634,20 @@ struct Renderer::Impl {
   vector<GenericVertex>                        vertices;
   vector<GenericVertex> landscape_vertices;
   vector<GenericVertex> landscape_annex_vertices;
+  vector<GenericVertex> landscape_lod_vertices;
+  vector<GenericVertex> landscape_lod_annex_vertices;
   vector<GenericVertex> backdrop_vertices;
   Emitter               emitter;
   Emitter               landscape_emitter;
   Emitter               landscape_annex_emitter;
+  Emitter               landscape_lod_emitter;
+  Emitter               landscape_lod_annex_emitter;
   Emitter               backdrop_emitter;
   gfx::size             logical_screen_size;
   bool                  landscape_dirty;
   bool                  landscape_annex_dirty;
+  bool                  landscape_lod_dirty;
+  bool                  landscape_lod_annex_dirty;
 };
 
 /****************************************************************
@@ -616,11 +726,20 @@ gfx::size Renderer::atlas_img_size() const {
 }
 
 void Renderer::render_pass(
-    base::function_ref<void( Renderer& )> drawer ) {
+    base::function_ref<void( Renderer& )> drawer,
+    base::maybe<RenderPassTimings&>       timings ) {
+  using Clock = chrono::steady_clock;
+  auto const t0 = Clock::now();
   begin_pass();
   drawer( *this );
+  auto const t1 = Clock::now();
   end_pass();
+  auto const t2 = Clock::now();
   present();
+  if( !timings.has_value() ) return;
+  timings->draw    = t1 - t0;
+  timings->upload  = t2 - t1;
+  timings->present = Clock::now() - t2;
 }
 
 void Renderer::set_color_cycle_stage( int stage ) {
@@ -658,6 +777,10 @@ long Renderer::buffer_vertex_count(
       return impl_->landscape_vertices.size();
     case e_render_target_buffer::landscape_annex:
       return impl_->landscape_annex_vertices.size();
+    case e_render_target_buffer::landscape_lod:
+      return impl_->landscape_lod_vertices.size();
+    case e_render_target_buffer::landscape_lod_annex:
+      return impl_->landscape_lod_annex_vertices.size();
   }
 }
 
@@ -676,4 +799,28 @@ VertexRange Renderer::range_for(
   return impl_->range_for( f );
 }
 
+vector<GenericVertex> Renderer::copy_range(
+    VertexRange const& rng ) const {
+  CHECK_GE( rng.finish, rng.start );
+  vector<GenericVertex> const& vertices =
+      impl_->get_buffer( rng.buffer );
+  CHECK_LE( rng.finish, long( vertices.size() ) );
+  return vector<GenericVertex>( vertices.begin() + rng.start,
+                                vertices.begin() + rng.finish );
+}
+
+void Renderer::replay( span<GenericVertex const> vertices,
+                       gfx::size                 translation ) {
+  Emitter&   emitter = impl_->curr_emitter();
+  long const start   = emitter.position();
+  emitter.emit( vertices );
+  if( translation == gfx::size{} ) return;
+  vector<GenericVertex>& buffer =
+      impl_->get_buffer( mods().buffer_mods.buffer );
+  for( long i = start; i < emitter.position(); ++i ) {
+    buffer[i].position.x += translation.w;
+    buffer[i].position.y += translation.h;
+  }
+}
+
 } // namespace rr
@@ -18,16 +18,20 @@
 #include "painter.hpp"
 #include "sprite-sheet.hpp"
 #include "typer.hpp"
+#include "vertex.hpp"
 
 // base
 #include "base/function-ref.hpp"
 #include "base/macros.hpp"
 
 // C++ standard library
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace rr {
 
@@ -87,6 +91,11 @@ struct RendererConfig {
   gfx::size                             max_atlas_size      = {};
   std::vector<SpriteSheetConfig> const& sprite_sheets;
   std::vector<AsciiFontSheetConfig> const& font_sheets;
+  // If given, these are the already-decoded images of the above
+  // sheets, in the same order, which will be moved from. Other-
+  // wise the images are loaded from their img_path.
+  std::vector<gfx::image>* sprite_sheet_images = nullptr;
+  std::vector<gfx::image>* font_sheet_images   = nullptr;
 };
 
 /****************************************************************
@@ -94,11 +103,28 @@ struct RendererConfig {
 *****************************************************************/
 struct BufferInfo {
   e_render_target_buffer buffer = e_render_target_buffer::normal;
+
+  bool operator==( BufferInfo const& ) const = default;
 };
 
 struct RendererMods {
   PainterMods painter_mods = {};
   BufferInfo  buffer_mods  = {};
+
+  bool operator==( RendererMods const& ) const = default;
+};
+
+/****************************************************************
+** RenderPassTimings
+*****************************************************************/
+// Where the time went in a render pass; used for profiling.
+struct RenderPassTimings {
+  // Running the drawer function, i.e. generating vertices.
+  std::chrono::nanoseconds draw = {};
+  // Uploading the vertices to the GPU and issuing draw calls.
+  std::chrono::nanoseconds upload = {};
+  // Swapping buffers, which may block on vsync.
+  std::chrono::nanoseconds present = {};
 };
 
 template<typename Func>
@@ -143,9 +169,12 @@ struct Renderer {
   //   4. Calls end_pass.
   //   5. Presents.
   //
-  // It takes the function that does the drawing.
+  // It takes the function that does the drawing. If `timings` is
+  // provided then it will be filled out with the time taken by
+  // each of the above steps.
   void render_pass(
-      base::function_ref<void( Renderer& )> drawer );
+      base::function_ref<void( Renderer& )> drawer,
+      base::maybe<RenderPassTimings&> timings = base::nothing );
 
   void clear_buffer( e_render_target_buffer buffer );
   void render_buffer( e_render_target_buffer buffer );
@@ -175,6 +204,21 @@ struct Renderer {
   // re-uploaded to the GPU.
   void zap( VertexRange const& rng );
 
+  // Returns a copy of the vertices in the given range. Together
+  // with `replay` this allows something that is expensive to
+  // draw but that rarely changes (e.g. a block of text) to be
+  // drawn once and then re-emitted on subsequent frames.
+  std::vector<GenericVertex> copy_range(
+      VertexRange const& rng ) const;
+
+  // Emits the given vertices into the current buffer, shifting
+  // their positions by `translation`. The vertices are otherwise
+  // emitted as-is, so the current mods will not be applied to
+  // them; the caller should only replay vertices that were
+  // recorded under the same mods.
+  void replay( std::span<GenericVertex const> vertices,
+               gfx::size                      translation );
+
   Painter painter();
 
   Typer typer( gfx::point start, gfx::pixel color );
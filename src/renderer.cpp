@@ -17,6 +17,7 @@
 #include "screen.hpp"
 #include "sdl-util.hpp"
 #include "sdl.hpp"
+#include "sheet-images.hpp"
 
 // config
 #include "config/tile-sheet.rds.hpp"
@@ -73,6 +74,9 @@ void init_renderer() {
       // These are taken by reference.
       .sprite_sheets = config_tile_sheet.sheets.sprite_sheets,
       .font_sheets   = config_tile_sheet.sheets.font_sheets,
+      // Decoded by the images init routine.
+      .sprite_sheet_images = &sprite_sheet_images(),
+      .font_sheet_images   = &font_sheet_images(),
   };
 
   // This renderer needs to be released before the SDL context is
@@ -0,0 +1,710 @@
+/****************************************************************
+**replay.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Records a game's inputs and random numbers so
+*              that the game can be replayed deterministically.
+*
+*****************************************************************/
+#include "replay.hpp"
+
+// Revolution Now
+#include "co-wait.hpp"
+#include "interrupts.hpp"
+#include "logger.hpp"
+
+// ss
+#include "ss/root.hpp"
+
+// refl
+#include "refl/cdr.hpp"
+#include "refl/to-str.hpp"
+
+// cdr
+#include "cdr/converter.hpp"
+#include "cdr/ext-base.hpp"
+#include "cdr/ext-builtin.hpp"
+#include "cdr/ext-std.hpp"
+
+// base
+#include "base/io.hpp"
+#include "base/to-str-ext-std.hpp"
+
+// C++ standard library
+#include <bit>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+// Identifies the file type and the version of the format.
+constexpr string_view kMagic   = "RNRJ";
+constexpr uint8_t     kVersion = 2;
+
+ReplayMode_t g_replay_mode = ReplayMode::none{};
+
+// Set while a ReplaySession is recording or replaying.
+ReplayWriter* g_writer = nullptr;
+ReplayReader* g_reader = nullptr;
+
+/****************************************************************
+** Encoding
+*****************************************************************/
+void write_varint( string& out, uint64_t n ) {
+  while( n >= 0x80 ) {
+    out += char( ( n & 0x7f ) | 0x80 );
+    n >>= 7;
+  }
+  out += char( n );
+}
+
+// Zig-zag encoding so that small negative numbers are also
+// small.
+void write_signed( string& out, int64_t n ) {
+  write_varint( out, ( uint64_t( n ) << 1 ) ^
+                         uint64_t( n >> 63 ) );
+}
+
+void write_fixed64( string& out, uint64_t n ) {
+  for( int i = 0; i < 8; ++i ) out += char( n >> ( i * 8 ) );
+}
+
+void write_string( string& out, string_view s ) {
+  write_varint( out, s.size() );
+  out += s;
+}
+
+void write_cdr( string& out, cdr::value const& v );
+
+void write_cdr_alt( string&, cdr::null_t ) {}
+
+void write_cdr_alt( string& out, double d ) {
+  write_fixed64( out, bit_cast<uint64_t>( d ) );
+}
+
+void write_cdr_alt( string& out, cdr::integer_type n ) {
+  write_signed( out, n );
+}
+
+void write_cdr_alt( string& out, bool b ) { out += char( b ); }
+
+void write_cdr_alt( string& out, string const& s ) {
+  write_string( out, s );
+}
+
+void write_cdr_alt( string& out, cdr::table const& tbl ) {
+  write_varint( out, tbl.size() );
+  for( auto const& [k, v] : tbl ) {
+    write_string( out, k );
+    write_cdr( out, v );
+  }
+}
+
+void write_cdr_alt( string& out, cdr::list const& lst ) {
+  write_varint( out, lst.size() );
+  for( cdr::value const& v : lst ) write_cdr( out, v );
+}
+
+// The type is written as the index of the alternative in the
+// variant followed by the value.
+void write_cdr( string& out, cdr::value const& v ) {
+  out += char( v.index() );
+  base::visit( [&]( auto const& o ) { write_cdr_alt( out, o ); },
+               v.as_base() );
+}
+
+uint64_t hash_bytes( string_view bytes ) {
+  // FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325;
+  for( char const c : bytes ) {
+    hash ^= uint64_t( static_cast<unsigned char>( c ) );
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+/****************************************************************
+** Decoding
+*****************************************************************/
+// A corrupt journal can't be replayed, so all of these check-
+// fail on malformed input.
+struct Decoder {
+  string_view bytes;
+  size_t&     pos;
+
+  uint8_t byte() {
+    CHECK( pos < bytes.size(),
+           "unexpected end of replay journal." );
+    return static_cast<uint8_t>( bytes[pos++] );
+  }
+
+  uint64_t varint() {
+    uint64_t res = 0;
+    for( int shift = 0;; shift += 7 ) {
+      CHECK( shift < 64, "malformed varint in replay journal." );
+      uint8_t const b = byte();
+      res |= uint64_t( b & 0x7f ) << shift;
+      if( ( b & 0x80 ) == 0 ) break;
+    }
+    return res;
+  }
+
+  int64_t signed_() {
+    uint64_t const n = varint();
+    return int64_t( n >> 1 ) ^ -int64_t( n & 1 );
+  }
+
+  uint64_t fixed64() {
+    uint64_t res = 0;
+    for( int i = 0; i < 8; ++i )
+      res |= uint64_t( byte() ) << ( i * 8 );
+    return res;
+  }
+
+  string str() {
+    uint64_t const size = varint();
+    CHECK( size <= bytes.size() - pos,
+           "unexpected end of replay journal." );
+    string res( bytes.substr( pos, size ) );
+    pos += size;
+    return res;
+  }
+
+  cdr::value cdr_value() {
+    switch( byte() ) {
+      case 0: return cdr::null;
+      case 1: return bit_cast<double>( fixed64() );
+      case 2: return cdr::integer_type( signed_() );
+      case 3: return bool( byte() );
+      case 4: return str();
+      case 5: {
+        uint64_t const size = varint();
+        cdr::table     res;
+        for( uint64_t i = 0; i < size; ++i ) {
+          string key = str();
+          res[key]   = cdr_value();
+        }
+        return res;
+      }
+      case 6: {
+        uint64_t const size = varint();
+        cdr::list      res;
+        for( uint64_t i = 0; i < size; ++i )
+          res.push_back( cdr_value() );
+        return res;
+      }
+    }
+    FATAL( "malformed value in replay journal." );
+  }
+};
+
+/****************************************************************
+** Land View
+*****************************************************************/
+// Forwards everything to the real land view plane; the replay-
+// ing plane overrides the parts that it needs.
+struct ForwardingLandViewPlane : ILandViewPlane {
+  ForwardingLandViewPlane( ILandViewPlane& real )
+    : real_( real ) {}
+
+  void set_visibility( maybe<e_nation> nation ) override {
+    real_.set_visibility( nation );
+  }
+
+  wait<> ensure_visible( Coord const& coord ) override {
+    return real_.ensure_visible( coord );
+  }
+
+  wait<> center_on_tile( Coord coord ) override {
+    return real_.center_on_tile( coord );
+  }
+
+  wait<> ensure_visible_unit( UnitId id ) override {
+    return real_.ensure_visible_unit( id );
+  }
+
+  wait<LandViewPlayerInput_t> get_next_input(
+      UnitId id ) override {
+    return real_.get_next_input( id );
+  }
+
+  wait<LandViewPlayerInput_t> eot_get_next_input() override {
+    return real_.eot_get_next_input();
+  }
+
+  wait<> animate_move( UnitId      id,
+                       e_direction direction ) override {
+    return real_.animate_move( id, direction );
+  }
+
+  wait<> animate_colony_depixelation(
+      Colony const& colony ) override {
+    return real_.animate_colony_depixelation( colony );
+  }
+
+  wait<> animate_unit_depixelation(
+      UnitId id, maybe<e_unit_type> target_type ) override {
+    return real_.animate_unit_depixelation( id, target_type );
+  }
+
+  wait<> animate_attack( UnitId attacker, UnitId defender,
+                         bool attacker_wins ) override {
+    return real_.animate_attack( attacker, defender,
+                                 attacker_wins );
+  }
+
+  wait<> animate_colony_capture( UnitId   attacker_id,
+                                 UnitId   defender_id,
+                                 ColonyId colony_id ) override {
+    return real_.animate_colony_capture(
+        attacker_id, defender_id, colony_id );
+  }
+
+  void reset_input_buffers() override {
+    real_.reset_input_buffers();
+  }
+
+  void start_new_turn() override { real_.start_new_turn(); }
+
+  void zoom_out_full() override { real_.zoom_out_full(); }
+
+  maybe<UnitId> unit_blinking() override {
+    return real_.unit_blinking();
+  }
+
+  Plane& impl() override { return real_.impl(); }
+
+ protected:
+  ILandViewPlane& real_;
+};
+
+struct ReplayLandViewPlane : ForwardingLandViewPlane {
+  ReplayLandViewPlane( ILandViewPlane& real )
+    : ForwardingLandViewPlane( real ) {}
+
+  wait<> ensure_visible( Coord const& ) override {
+    return make_wait<>();
+  }
+
+  wait<> center_on_tile( Coord ) override {
+    return make_wait<>();
+  }
+
+  wait<> ensure_visible_unit( UnitId ) override {
+    return make_wait<>();
+  }
+
+  wait<> animate_move( UnitId, e_direction ) override {
+    return make_wait<>();
+  }
+
+  wait<> animate_colony_depixelation( Colony const& ) override {
+    return make_wait<>();
+  }
+
+  wait<> animate_unit_depixelation(
+      UnitId, maybe<e_unit_type> ) override {
+    return make_wait<>();
+  }
+
+  wait<> animate_attack( UnitId, UnitId, bool ) override {
+    return make_wait<>();
+  }
+
+  wait<> animate_colony_capture( UnitId, UnitId,
+                                 ColonyId ) override {
+    return make_wait<>();
+  }
+};
+
+// If the journal has run out then the player quit the game at
+// this point in the recording.
+void quit_if_finished( ReplayReader const& reader ) {
+  if( !reader.finished() ) return;
+  lg.info( "replay finished after {} entries.",
+           reader.entries_read() );
+  throw game_quit_interrupt{};
+}
+
+} // namespace
+
+/****************************************************************
+** Replay Mode
+*****************************************************************/
+void set_replay_mode( ReplayMode_t const& mode ) {
+  g_replay_mode = mode;
+}
+
+ReplayMode_t const& replay_mode() { return g_replay_mode; }
+
+bool is_replaying() { return g_reader != nullptr; }
+
+uint64_t replay_state_hash( RootState const& root ) {
+  string bytes;
+  write_cdr( bytes, cdr::run_conversion_to_canonical( root ) );
+  return hash_bytes( bytes );
+}
+
+wait<ReplayedInput_t> replayable_player_input(
+    base::function_ref<wait<ReplayedInput_t>() const> race ) {
+  if( g_reader != nullptr ) {
+    quit_if_finished( *g_reader );
+    co_return g_reader->player_input();
+  }
+  ReplayedInput_t input = co_await race();
+  if( g_writer != nullptr ) {
+    g_writer->player_input( input );
+    g_writer->flush();
+  }
+  co_return input;
+}
+
+void replay_state_checkpoint( RootState const& root ) {
+  if( g_writer != nullptr ) {
+    g_writer->state_hash( replay_state_hash( root ) );
+    return;
+  }
+  if( g_reader == nullptr ) return;
+  quit_if_finished( *g_reader );
+  uint64_t const expected = g_reader->state_hash();
+  uint64_t const actual   = replay_state_hash( root );
+  CHECK( actual == expected,
+         "game state has diverged from the recording after {} "
+         "journal entries: expected hash {:016x} but found "
+         "{:016x}.",
+         g_reader->entries_read(), expected, actual );
+}
+
+/****************************************************************
+** ReplayWriter
+*****************************************************************/
+ReplayWriter::ReplayWriter( maybe<fs::path> file ) {
+  buffer_ += kMagic;
+  buffer_ += char( kVersion );
+  if( !file.has_value() ) return;
+  file_ = make_unique<ofstream>(
+      *file, ios::binary | ios::out | ios::trunc );
+  CHECK( file_->good(), "failed to open replay journal {}.",
+         *file );
+  flush();
+}
+
+ReplayWriter::~ReplayWriter() { flush(); }
+
+void ReplayWriter::flush() {
+  if( file_ == nullptr ) return;
+  file_->write( buffer_.data(), buffer_.size() );
+  file_->flush();
+  buffer_.clear();
+}
+
+void ReplayWriter::tag( e_replay_entry entry ) {
+  buffer_ += char( entry );
+}
+
+void ReplayWriter::bernoulli( bool result ) {
+  tag( e_replay_entry::rand_bernoulli );
+  buffer_ += char( result );
+}
+
+void ReplayWriter::between_ints( int result ) {
+  tag( e_replay_entry::rand_int );
+  write_signed( buffer_, result );
+}
+
+void ReplayWriter::between_doubles( double result ) {
+  tag( e_replay_entry::rand_double );
+  write_fixed64( buffer_, bit_cast<uint64_t>( result ) );
+}
+
+void ReplayWriter::choice( maybe<string> const& result ) {
+  tag( e_replay_entry::gui_choice );
+  buffer_ += char( result.has_value() );
+  if( result.has_value() ) write_string( buffer_, *result );
+}
+
+void ReplayWriter::string_input( maybe<string> const& result ) {
+  tag( e_replay_entry::gui_string_input );
+  buffer_ += char( result.has_value() );
+  if( result.has_value() ) write_string( buffer_, *result );
+}
+
+void ReplayWriter::int_input( maybe<int> result ) {
+  tag( e_replay_entry::gui_int_input );
+  buffer_ += char( result.has_value() );
+  if( result.has_value() ) write_signed( buffer_, *result );
+}
+
+void ReplayWriter::player_input(
+    ReplayedInput_t const& input ) {
+  tag( e_replay_entry::player_input );
+  write_cdr( buffer_,
+             cdr::run_conversion_to_canonical( input ) );
+}
+
+void ReplayWriter::state_hash( uint64_t hash ) {
+  tag( e_replay_entry::state_hash );
+  write_fixed64( buffer_, hash );
+}
+
+/****************************************************************
+** ReplayReader
+*****************************************************************/
+ReplayReader::ReplayReader( string bytes )
+  : bytes_( std::move( bytes ) ) {
+  CHECK( bytes_.starts_with( kMagic ),
+         "this is not a replay journal." );
+  pos_ = kMagic.size();
+  uint8_t const version = Decoder{ bytes_, pos_ }.byte();
+  CHECK( version == kVersion,
+         "unsupported replay journal version: {}.", version );
+}
+
+bool ReplayReader::finished() const {
+  return pos_ == bytes_.size();
+}
+
+void ReplayReader::expect_tag( e_replay_entry entry ) {
+  uint8_t const tag = Decoder{ bytes_, pos_ }.byte();
+  CHECK( tag < refl::enum_count<e_replay_entry>,
+         "malformed entry in replay journal." );
+  CHECK( e_replay_entry( tag ) == entry,
+         "replay has diverged from the recording after {} "
+         "entries: the game asked for {} but the journal has "
+         "{}.",
+         entries_read_, entry, e_replay_entry( tag ) );
+  ++entries_read_;
+}
+
+bool ReplayReader::bernoulli() {
+  expect_tag( e_replay_entry::rand_bernoulli );
+  return bool( Decoder{ bytes_, pos_ }.byte() );
+}
+
+int ReplayReader::between_ints() {
+  expect_tag( e_replay_entry::rand_int );
+  return int( Decoder{ bytes_, pos_ }.signed_() );
+}
+
+double ReplayReader::between_doubles() {
+  expect_tag( e_replay_entry::rand_double );
+  return bit_cast<double>( Decoder{ bytes_, pos_ }.fixed64() );
+}
+
+maybe<string> ReplayReader::choice() {
+  expect_tag( e_replay_entry::gui_choice );
+  Decoder d{ bytes_, pos_ };
+  if( !d.byte() ) return nothing;
+  return d.str();
+}
+
+maybe<string> ReplayReader::string_input() {
+  expect_tag( e_replay_entry::gui_string_input );
+  Decoder d{ bytes_, pos_ };
+  if( !d.byte() ) return nothing;
+  return d.str();
+}
+
+maybe<int> ReplayReader::int_input() {
+  expect_tag( e_replay_entry::gui_int_input );
+  Decoder d{ bytes_, pos_ };
+  if( !d.byte() ) return nothing;
+  return int( d.signed_() );
+}
+
+ReplayedInput_t ReplayReader::player_input() {
+  expect_tag( e_replay_entry::player_input );
+  cdr::value const v = Decoder{ bytes_, pos_ }.cdr_value();
+  UNWRAP_CHECK(
+      input,
+      cdr::run_conversion_from_canonical<ReplayedInput_t>( v ) );
+  return input;
+}
+
+uint64_t ReplayReader::state_hash() {
+  expect_tag( e_replay_entry::state_hash );
+  return Decoder{ bytes_, pos_ }.fixed64();
+}
+
+/****************************************************************
+** RecordingRand
+*****************************************************************/
+bool RecordingRand::bernoulli( double p ) {
+  bool const res = rand_.bernoulli( p );
+  writer_.bernoulli( res );
+  return res;
+}
+
+int RecordingRand::between_ints( int lower, int upper,
+                                 e_interval type ) {
+  int const res = rand_.between_ints( lower, upper, type );
+  writer_.between_ints( res );
+  return res;
+}
+
+double RecordingRand::between_doubles( double lower,
+                                       double upper ) {
+  double const res = rand_.between_doubles( lower, upper );
+  writer_.between_doubles( res );
+  return res;
+}
+
+/****************************************************************
+** RecordingGui
+*****************************************************************/
+wait<> RecordingGui::message_box( string_view msg ) {
+  return gui_.message_box( msg );
+}
+
+wait<chrono::microseconds> RecordingGui::wait_for(
+    chrono::microseconds time ) {
+  return gui_.wait_for( time );
+}
+
+// The real gui's virtual methods are protected, so these go
+// through the public wrappers.
+wait<maybe<string>> RecordingGui::choice(
+    ChoiceConfig const& config, e_input_required required ) {
+  maybe<string> res;
+  if( required == e_input_required::yes )
+    res = co_await gui_.required_choice( config );
+  else
+    res = co_await gui_.optional_choice( config );
+  writer_.choice( res );
+  co_return res;
+}
+
+wait<maybe<string>> RecordingGui::string_input(
+    StringInputConfig const& config,
+    e_input_required         required ) {
+  maybe<string> res;
+  if( required == e_input_required::yes )
+    res = co_await gui_.required_string_input( config );
+  else
+    res = co_await gui_.optional_string_input( config );
+  writer_.string_input( res );
+  co_return res;
+}
+
+wait<maybe<int>> RecordingGui::int_input(
+    IntInputConfig const& config, e_input_required required ) {
+  maybe<int> res;
+  if( required == e_input_required::yes )
+    res = co_await gui_.required_int_input( config );
+  else
+    res = co_await gui_.optional_int_input( config );
+  writer_.int_input( res );
+  co_return res;
+}
+
+/****************************************************************
+** ReplayRand
+*****************************************************************/
+bool ReplayRand::bernoulli( double ) {
+  return reader_.bernoulli();
+}
+
+int ReplayRand::between_ints( int, int, e_interval ) {
+  return reader_.between_ints();
+}
+
+double ReplayRand::between_doubles( double, double ) {
+  return reader_.between_doubles();
+}
+
+/****************************************************************
+** ReplayGui
+*****************************************************************/
+wait<> ReplayGui::message_box( string_view ) {
+  return make_wait<>();
+}
+
+// No frame pacing: report that the full time was waited without
+// actually waiting.
+wait<chrono::microseconds> ReplayGui::wait_for(
+    chrono::microseconds time ) {
+  return make_wait<chrono::microseconds>( time );
+}
+
+// These are coroutines so that when the journal runs out the
+// game_quit_interrupt ends up in the returned wait, just as it
+// would if the player had quit while a real input was pending.
+wait<maybe<string>> ReplayGui::choice( ChoiceConfig const&,
+                                       e_input_required ) {
+  quit_if_finished( reader_ );
+  co_return reader_.choice();
+}
+
+wait<maybe<string>> ReplayGui::string_input(
+    StringInputConfig const&, e_input_required ) {
+  quit_if_finished( reader_ );
+  co_return reader_.string_input();
+}
+
+wait<maybe<int>> ReplayGui::int_input( IntInputConfig const&,
+                                       e_input_required ) {
+  quit_if_finished( reader_ );
+  co_return reader_.int_input();
+}
+
+/****************************************************************
+** ReplaySession
+*****************************************************************/
+ReplaySession::ReplaySession( ReplayMode_t const& mode,
+                              IRand& real_rand, IGui& real_gui )
+  : real_rand_( real_rand ), real_gui_( real_gui ) {
+  CHECK( g_writer == nullptr && g_reader == nullptr,
+         "only one replay session can exist at a time." );
+  switch( mode.to_enum() ) {
+    using namespace ReplayMode;
+    case e::none: break;
+    case e::record: {
+      auto& o = mode.get<record>();
+      lg.info( "recording game to {}.", o.path );
+      writer_ = make_unique<ReplayWriter>( o.path );
+      rand_ = make_unique<RecordingRand>( real_rand, *writer_ );
+      gui_  = make_unique<RecordingGui>( real_gui, *writer_ );
+      g_writer = writer_.get();
+      break;
+    }
+    case e::replay: {
+      auto& o = mode.get<replay>();
+      lg.info( "replaying game from {}.", o.path );
+      UNWRAP_CHECK_MSG( bytes, base::read_binary_file( o.path ),
+                        "failed to read replay journal {}.",
+                        o.path );
+      reader_ = make_unique<ReplayReader>( std::move( bytes ) );
+      rand_   = make_unique<ReplayRand>( *reader_ );
+      gui_    = make_unique<ReplayGui>( *reader_ );
+      g_reader = reader_.get();
+      break;
+    }
+  }
+}
+
+ReplaySession::~ReplaySession() {
+  g_writer = nullptr;
+  g_reader = nullptr;
+}
+
+IRand& ReplaySession::rand() {
+  return ( rand_ != nullptr ) ? *rand_ : real_rand_;
+}
+
+IGui& ReplaySession::gui() {
+  return ( gui_ != nullptr ) ? *gui_ : real_gui_;
+}
+
+ILandViewPlane& ReplaySession::land_view(
+    ILandViewPlane& real ) {
+  if( reader_ == nullptr ) return real;
+  land_view_ = make_unique<ReplayLandViewPlane>( real );
+  return *land_view_;
+}
+
+} // namespace rn
@@ -0,0 +1,296 @@
+/****************************************************************
+**replay.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Records a game's inputs and random numbers so
+*              that the game can be replayed deterministically.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Rds
+#include "land-view.rds.hpp"
+#include "replay.rds.hpp"
+
+// Revolution Now
+#include "igui.hpp"
+#include "irand.hpp"
+#include "land-view.hpp"
+#include "maybe.hpp"
+#include "wait.hpp"
+
+// base
+#include "base/fs.hpp"
+#include "base/function-ref.hpp"
+
+// C++ standard library
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace rn {
+
+struct RootState;
+
+/****************************************************************
+** Replay Mode
+*****************************************************************/
+// The game behaves deterministically given the sequence of
+// values that it gets from IRand, IGui and the land view's
+// player input, so recording those is enough to replay a game.
+// This is set once at startup (from the command line) and then
+// consulted each time a game is started.
+void set_replay_mode( ReplayMode_t const& mode );
+
+ReplayMode_t const& replay_mode();
+
+// True while a game is being played back from a journal, in
+// which case there is no need to pace frames.
+bool is_replaying();
+
+// Hash of the full game state used to check that a replay has
+// not diverged from the recording.
+uint64_t replay_state_hash( RootState const& root );
+
+// The turn processor races the menus, the land view and the
+// end-of-turn button against each other via co::first, and
+// which one wins is a matter of timing. So instead of recording
+// the sources individually, the race is handed to this and the
+// input that won it is recorded. When replaying, the recorded
+// input is returned instead and the race is never run. Outside
+// of a replay session this just runs the race.
+wait<ReplayedInput_t> replayable_player_input(
+    base::function_ref<wait<ReplayedInput_t>() const> race );
+
+// Writes a hash of the game state to the journal when recording,
+// or checks it against the journal when replaying. This must be
+// called at a fixed point in the game (e.g. the start of a turn)
+// and not from within a wait that might get cancelled, otherwise
+// the hashes won't line up.
+void replay_state_checkpoint( RootState const& root );
+
+/****************************************************************
+** ReplayWriter
+*****************************************************************/
+// Writes the compact binary journal. Each entry is a one-byte
+// e_replay_entry tag followed by its value. Integers are zig-zag
+// varints, so most random draws take two or three bytes; player
+// inputs are written via their canonical (cdr) form.
+struct ReplayWriter {
+  // If a file is given then it will be truncated and the entries
+  // will be appended to it on each flush; otherwise the journal
+  // just accumulates in memory.
+  explicit ReplayWriter( maybe<fs::path> file = nothing );
+
+  ~ReplayWriter();
+
+  void bernoulli( bool result );
+  void between_ints( int result );
+  void between_doubles( double result );
+  void choice( maybe<std::string> const& result );
+  void string_input( maybe<std::string> const& result );
+  void int_input( maybe<int> result );
+  void player_input( ReplayedInput_t const& input );
+  void state_hash( uint64_t hash );
+
+  // Entries that have not been flushed yet. If there is no file
+  // then this is the entire journal.
+  std::string const& buffer() const { return buffer_; }
+
+  void flush();
+
+ private:
+  void tag( e_replay_entry entry );
+
+  std::string                    buffer_;
+  std::unique_ptr<std::ofstream> file_;
+};
+
+/****************************************************************
+** ReplayReader
+*****************************************************************/
+// Reads back the entries written by ReplayWriter. Since the game
+// is supposed to ask for exactly the same things in the same
+// order as it did during the recording, reading an entry of the
+// wrong type means that the replay has diverged, and that is a
+// fatal error.
+struct ReplayReader {
+  // Check-fails if this is not a journal.
+  explicit ReplayReader( std::string bytes );
+
+  bool finished() const;
+
+  bool               bernoulli();
+  int                between_ints();
+  double             between_doubles();
+  maybe<std::string> choice();
+  maybe<std::string> string_input();
+  maybe<int>         int_input();
+  ReplayedInput_t    player_input();
+  uint64_t           state_hash();
+
+  // Number of entries read so far.
+  int entries_read() const { return entries_read_; }
+
+ private:
+  void expect_tag( e_replay_entry entry );
+
+  std::string bytes_;
+  size_t      pos_          = 0;
+  int         entries_read_ = 0;
+};
+
+/****************************************************************
+** Recording
+*****************************************************************/
+// Forwards to a real IRand and records the results.
+struct RecordingRand : IRand {
+  RecordingRand( IRand& rand, ReplayWriter& writer )
+    : rand_( rand ), writer_( writer ) {}
+
+  // Implement IRand.
+  bool bernoulli( double p ) override;
+
+  // Implement IRand.
+  int between_ints( int lower, int upper,
+                    e_interval type ) override;
+
+  // Implement IRand.
+  double between_doubles( double lower, double upper ) override;
+
+ private:
+  IRand&        rand_;
+  ReplayWriter& writer_;
+};
+
+// Forwards to a real IGui and records the player's answers.
+struct RecordingGui : IGui {
+  RecordingGui( IGui& gui, ReplayWriter& writer )
+    : gui_( gui ), writer_( writer ) {}
+
+  // Implement IGui.
+  wait<> message_box( std::string_view msg ) override;
+
+  // Implement IGui.
+  wait<std::chrono::microseconds> wait_for(
+      std::chrono::microseconds time ) override;
+
+ private:
+  // Implement IGui.
+  wait<maybe<std::string>> choice(
+      ChoiceConfig const& config,
+      e_input_required    required ) override;
+
+  // Implement IGui.
+  wait<maybe<std::string>> string_input(
+      StringInputConfig const& config,
+      e_input_required         required ) override;
+
+  // Implement IGui.
+  wait<maybe<int>> int_input(
+      IntInputConfig const& config,
+      e_input_required      required ) override;
+
+  IGui&         gui_;
+  ReplayWriter& writer_;
+};
+
+/****************************************************************
+** Replaying
+*****************************************************************/
+// Hands out the recorded random numbers.
+struct ReplayRand : IRand {
+  ReplayRand( ReplayReader& reader ) : reader_( reader ) {}
+
+  // Implement IRand.
+  bool bernoulli( double p ) override;
+
+  // Implement IRand.
+  int between_ints( int lower, int upper,
+                    e_interval type ) override;
+
+  // Implement IRand.
+  double between_doubles( double lower, double upper ) override;
+
+ private:
+  ReplayReader& reader_;
+};
+
+// Answers with the recorded player input without showing any-
+// thing and without waiting. When the journal runs out, the game
+// is quit (via a game_quit_interrupt stored in the wait).
+struct ReplayGui : IGui {
+  ReplayGui( ReplayReader& reader ) : reader_( reader ) {}
+
+  // Implement IGui.
+  wait<> message_box( std::string_view msg ) override;
+
+  // Implement IGui.
+  wait<std::chrono::microseconds> wait_for(
+      std::chrono::microseconds time ) override;
+
+ private:
+  // Implement IGui.
+  wait<maybe<std::string>> choice(
+      ChoiceConfig const& config,
+      e_input_required    required ) override;
+
+  // Implement IGui.
+  wait<maybe<std::string>> string_input(
+      StringInputConfig const& config,
+      e_input_required         required ) override;
+
+  // Implement IGui.
+  wait<maybe<int>> int_input(
+      IntInputConfig const& config,
+      e_input_required      required ) override;
+
+  ReplayReader& reader_;
+};
+
+/****************************************************************
+** ReplaySession
+*****************************************************************/
+// Holds whatever is needed to record or replay one game given
+// the replay mode. When the mode is `none` it just hands back
+// the real objects.
+//
+// The journal covers only the game itself, so a replay has to be
+// started the same way as the recording was (e.g. new game vs.
+// loading the same save). Anything that bypasses IRand, IGui and
+// replayable_player_input (e.g. dragging units around in the
+// colony view) is not recorded. The Lua random number generator
+// is seeded from the journal by the caller. Only one session can
+// exist at a time.
+struct ReplaySession {
+  ReplaySession( ReplayMode_t const& mode, IRand& real_rand,
+                 IGui& real_gui );
+
+  ~ReplaySession();
+
+  IRand& rand();
+  IGui&  gui();
+
+  // When replaying, wraps the land view plane so that anima-
+  // tions are skipped.
+  ILandViewPlane& land_view( ILandViewPlane& real );
+
+ private:
+  IRand& real_rand_;
+  IGui&  real_gui_;
+
+  std::unique_ptr<ReplayWriter>   writer_;
+  std::unique_ptr<ReplayReader>   reader_;
+  std::unique_ptr<IRand>          rand_;
+  std::unique_ptr<IGui>           gui_;
+  std::unique_ptr<ILandViewPlane> land_view_;
+};
+
+} // namespace rn
@@ -14,6 +14,7 @@
 #include "igui.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "save-journal.hpp"
 #include "ts.hpp"
 
 // ss
@@ -84,6 +85,38 @@ fs::path rcl_file_path( string const& slot_path ) {
   return slot_path + ".sav.rcl";
 }
 
+fs::path journal_file_path( int slot ) {
+  return path_for_slot( slot ).replace_extension( ".jrn.rcl" );
+}
+
+// Holds the game state as of the last autosave or journal entry
+// so that we can tell what has changed since then, along with
+// the slot of the save that it is relative to. Entries only get
+// journaled when that is the autosave slot; otherwise the auto-
+// save slot holds some other game (or a different point in this
+// one) and is left alone until the next full autosave.
+struct AutosaveBaseline {
+  SaveJournal journal;
+  maybe<int>  slot;
+
+  void clear() {
+    journal.clear();
+    slot = nothing;
+  }
+};
+
+AutosaveBaseline& autosave_baseline() {
+  static AutosaveBaseline baseline;
+  return baseline;
+}
+
+// A journal to be applied on top of a save file as it is loaded.
+struct JournalFile {
+  fs::path           path;
+  string             text;
+  AppliedSaveJournal applied;
+};
+
 bool rcl_file_exists( string const& slot_path ) {
   return fs::exists( rcl_file_path( slot_path ) );
 }
@@ -143,6 +176,7 @@ string save_game_to_rcl( RootState const&       root,
 valid_or<string> load_game_from_rcl( RootState&    out_root,
                                      string_view   filename,
                                      string const& in,
+                                     maybe<JournalFile&> journal,
                                      SaveGameOptions const& ) {
   cdr::converter::options const cdr_opts{
       .allow_unrecognized_fields        = false,
@@ -156,9 +190,24 @@ valid_or<string> load_game_from_rcl( RootState&    out_root,
   UNWRAP_RETURN( rcl_doc,
                  rcl::parse( filename, in, proc_opts ) );
   watch.stop( "  [load] rcl parse" );
+  cdr::value const* top = &rcl_doc.top_val();
+  cdr::value        patched;
+  if( journal.has_value() ) {
+    watch.start( "  [load] apply journal" );
+    patched          = *top;
+    journal->applied = apply_save_journal(
+        patched, journal->path.string(), journal->text );
+    top = &patched;
+    watch.stop( "  [load] apply journal" );
+    lg.info( "applied {} journal entries from {}.",
+             journal->applied.entries, journal->path );
+    if( journal->applied.truncated.has_value() )
+      lg.warn( "journal is truncated: {}",
+               *journal->applied.truncated );
+  }
   watch.start( "  [load] from_canonical" );
   UNWRAP_RETURN( root, run_conversion_from_canonical<RootState>(
-                           rcl_doc.top_val(), cdr_opts ) );
+                           *top, cdr_opts ) );
   watch.stop( "  [load] from_canonical" );
   watch.stop( "[load] total" );
   print_time( watch, "[load] total" );
@@ -168,6 +217,56 @@ valid_or<string> load_game_from_rcl( RootState&    out_root,
   return valid;
 }
 
+valid_or<string> load_game_from_rcl_file_with_journal(
+    RootState& root, fs::path const& p,
+    maybe<JournalFile&> journal, SaveGameOptions const& opts ) {
+  auto maybe_rcl = base::read_text_file_as_string( p );
+  if( !maybe_rcl )
+    return fmt::format( "failed to read Rcl file" );
+  util::StopWatch watch;
+  watch.start( "loading from rcl" );
+  constexpr int trials = 1;
+  for( int i = trials; i >= 1; --i ) {
+    HAS_VALUE_OR_RET( load_game_from_rcl(
+        root, p.string(), *maybe_rcl, journal, opts ) );
+  }
+  watch.stop( "loading from rcl" );
+  lg.info( "loading game ({} trials) took: {}", trials,
+           watch.human( "loading from rcl" ) );
+  return valid;
+}
+
+maybe<JournalFile> read_journal_file( int slot ) {
+  fs::path const p = journal_file_path( slot );
+  if( !fs::exists( p ) ) return nothing;
+  auto text = base::read_text_file_as_string( p );
+  if( !text ) {
+    lg.warn( "failed to read journal file {}.", p );
+    return nothing;
+  }
+  return JournalFile{ .path = p, .text = std::move( *text ) };
+}
+
+valid_or<string> append_to_journal( RootState const& root,
+                                    SaveJournal&     journal,
+                                    fs::path const&  p ) {
+  util::StopWatch watch;
+  watch.start( "journal" );
+  maybe<string> const entry = journal.record( root );
+  if( !entry.has_value() ) return valid;
+  ofstream out( p, ios::app );
+  if( !out.good() )
+    return fmt::format( "failed to open {} for appending.", p );
+  out << *entry;
+  out.flush();
+  if( !out.good() )
+    return fmt::format( "failed to write to {}.", p );
+  watch.stop( "journal" );
+  lg.info( "appending {} bytes to {} took {}.", entry->size(),
+           p, watch.human( "journal" ) );
+  return valid;
+}
+
 unordered_map<int, string> description_for_slots() {
   unordered_map<int, string> res;
   for( int i = 0; i < number_of_total_slots(); ++i ) {
@@ -311,20 +410,8 @@ valid_or<std::string> save_game_to_rcl_file(
 valid_or<std::string> load_game_from_rcl_file(
     RootState& root, fs::path const& p,
     SaveGameOptions const& opts ) {
-  auto maybe_rcl = base::read_text_file_as_string( p );
-  if( !maybe_rcl )
-    return fmt::format( "failed to read Rcl file" );
-  util::StopWatch watch;
-  watch.start( "loading from rcl" );
-  constexpr int trials = 1;
-  for( int i = trials; i >= 1; --i ) {
-    HAS_VALUE_OR_RET( load_game_from_rcl( root, p.string(),
-                                          *maybe_rcl, opts ) );
-  }
-  watch.stop( "loading from rcl" );
-  lg.info( "loading game ({} trials) took: {}", trials,
-           watch.human( "loading from rcl" ) );
-  return valid;
+  return load_game_from_rcl_file_with_journal( root, p, nothing,
+                                               opts );
 }
 
 expect<fs::path> save_game( SSConst const& ss, TS& ts,
@@ -382,18 +469,98 @@ expect<fs::path> load_game( SS& ss, TS& ts, int slot ) {
   }
 
   CHECK( use_rcl, "other formats not implemented." );
-  HAS_VALUE_OR_RET( load_game_from_rcl_file(
-      ss.root, rcl_path, SaveGameOptions{} ) );
+  // The autosave may have a journal of the turns played since it
+  // was written. If its last entry is torn (e.g. the game
+  // crashed in the middle of writing it) then the entries before
+  // it are still applied. If the result can't be loaded then we
+  // fall back to the last full autosave.
+  maybe<JournalFile> journal = is_autosave_slot( slot )
+                                   ? read_journal_file( slot )
+                                   : nothing;
+  valid_or<string> loaded =
+      journal.has_value()
+          ? load_game_from_rcl_file_with_journal(
+                ss.root, rcl_path, *journal, SaveGameOptions{} )
+          : load_game_from_rcl_file( ss.root, rcl_path,
+                                     SaveGameOptions{} );
+  bool journal_ok = true;
+  if( !loaded && journal.has_value() ) {
+    lg.warn( "failed to apply journal {}: {}", journal->path,
+             loaded.error() );
+    journal_ok = false;
+    loaded     = load_game_from_rcl_file( ss.root, rcl_path,
+                                          SaveGameOptions{} );
+  }
+  HAS_VALUE_OR_RET( loaded );
+
+  // Anything that we append to the journal has to come right
+  // after the last entry that was applied, otherwise it would
+  // never get applied on the next load.
+  if( journal_ok && journal.has_value() &&
+      journal->applied.truncated.has_value() ) {
+    string_view const applied =
+        string_view( journal->text )
+            .substr( 0, journal->applied.size );
+    if( !base::write_binary_file_atomic( journal->path,
+                                         applied ) ) {
+      lg.warn( "failed to truncate journal {}.", journal->path );
+      journal_ok = false;
+    }
+  }
 
+  // Only what is in the autosave slot gets journaled against.
+  // If its journal is broken then there is no baseline, which
+  // makes the next autosave a full one.
+  AutosaveBaseline& baseline = autosave_baseline();
+  baseline.clear();
+  baseline.slot = slot;
+  if( config_savegame.journal_between_autosaves &&
+      slot == autosave_slot() && journal_ok )
+    baseline.journal.reset(
+        ss.root,
+        journal.has_value() ? journal->applied.entries : 0 );
   record_saved_state( ss, ts );
   return rcl_path;
 }
 
 void autosave( SSConst const& ss, TS& ts ) {
+  if( !config_savegame.autosave_frequency.has_value() ) return;
+  AutosaveBaseline& baseline = autosave_baseline();
+  SaveJournal&      journal  = baseline.journal;
+  fs::path const    jrn_path =
+      journal_file_path( autosave_slot() );
+  bool const journaling =
+      config_savegame.journal_between_autosaves;
+  if( !should_autosave( ss.turn.time_point.turns ) ) {
+    if( !journaling ) return;
+    // The autosave slot doesn't hold this game.
+    if( baseline.slot != autosave_slot() ) return;
+    if( journal.has_baseline() ) {
+      valid_or<string> const res =
+          append_to_journal( ss.root, journal, jrn_path );
+      if( res.valid() ) return;
+      lg.warn( "autosave journal failed: {}", res.error() );
+    }
+    // Either there is nothing to journal against yet or the
+    // journal is broken, so fall through to a full autosave.
+  }
+  // The old journal no longer applies to the new autosave; it is
+  // removed first so that a crash in the middle of this can't
+  // leave it behind to be applied to the wrong save.
+  baseline.clear();
+  error_code ec;
+  fs::remove( jrn_path, ec );
   expect<fs::path> res = save_game( ss, ts, autosave_slot() );
-  if( !res ) lg.warn( "autosave failed: {}", res.error() );
+  if( !res ) {
+    lg.warn( "autosave failed: {}", res.error() );
+    return;
+  }
+  baseline.slot = autosave_slot();
+  if( journaling ) journal.reset( ss.root );
 }
 
+void reset_autosave_journal() { autosave_baseline().clear(); }
+
 bool should_autosave( int turns ) {
   if( !config_savegame.autosave_frequency.has_value() )
     return false;
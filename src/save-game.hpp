@@ -28,10 +28,19 @@ struct SSConst;
 struct SS;
 struct TS;
 
+// To be called at the end of each turn. When it is time to auto-
+// save (see below) this writes the entire game to the autosave
+// slot; on other turns it appends the changes made since then to
+// the autosave's journal, if enabled.
 void autosave( SSConst const& ss, TS& ts );
 
+// To be called when a new game is created. Nothing will be
+// journaled for it until its first full autosave, since until
+// then the autosave slot holds some other game.
+void reset_autosave_journal();
+
 // Given the current turn index, this will tell us if it is time
-// to autosave.
+// to do a full autosave.
 bool should_autosave( int turns );
 
 // Opens the save-game box. Returns if the game was actually
@@ -0,0 +1,647 @@
+/****************************************************************
+**save-journal.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Journal of game state changes between full
+*              autosaves.
+*
+*****************************************************************/
+#include "save-journal.hpp"
+
+// Revolution Now
+#include "macros.hpp"
+
+// ss
+#include "ss/root.hpp"
+#include "ss/terrain.hpp"
+
+// refl
+#include "refl/cdr.hpp"
+
+// rcl
+#include "rcl/emit.hpp"
+#include "rcl/model.hpp"
+#include "rcl/parse.hpp"
+
+// cdr
+#include "cdr/converter.hpp"
+#include "cdr/ext-base.hpp"
+#include "cdr/ext-builtin.hpp"
+#include "cdr/ext-std.hpp"
+
+// base
+#include "base/conv.hpp"
+#include "base/meta.hpp"
+#include "base/string.hpp"
+#include "base/to-str.hpp"
+
+// C++ standard library
+#include <map>
+#include <tuple>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+// Must match the options used for full saves so that the paths
+// in the patches exist in the parsed snapshot.
+cdr::converter::options const kCdrOpts{
+    .write_fields_with_default_value = true,
+};
+
+/****************************************************************
+** Keyed Lists
+*****************************************************************/
+// Maps with non-string keys are converted to lists of tables of
+// the form {key=K,val=V}.
+maybe<cdr::value const&> pair_key( cdr::value const& elem ) {
+  maybe<cdr::table const&> tbl = elem.get_if<cdr::table>();
+  if( !tbl.has_value() ) return nothing;
+  if( tbl->size() != 2 || !tbl->contains( "val" ) )
+    return nothing;
+  return ( *tbl )["key"];
+}
+
+bool is_keyed_list( cdr::list const& l ) {
+  if( l.empty() ) return false;
+  for( cdr::value const& elem : l )
+    if( !pair_key( elem ).has_value() ) return false;
+  return true;
+}
+
+// The keys are compared via their string forms so that they can
+// be ordered regardless of their type.
+map<string, cdr::value const*> elems_by_key(
+    cdr::list const& l ) {
+  map<string, cdr::value const*> res;
+  for( cdr::value const& elem : l )
+    res[base::to_str( *pair_key( elem ) )] = &elem;
+  return res;
+}
+
+cdr::value key_selector( cdr::value const& key ) {
+  cdr::table tbl;
+  tbl["key"] = key;
+  return tbl;
+}
+
+bool matches_key_selector( cdr::value const& elem,
+                           cdr::table const& selector ) {
+  maybe<cdr::value const&> key  = pair_key( elem );
+  maybe<cdr::value const&> want = selector["key"];
+  return key.has_value() && want.has_value() && *key == *want;
+}
+
+/****************************************************************
+** Diffing
+*****************************************************************/
+void diff_impl( cdr::value const& old, cdr::value const& now,
+                vector<cdr::value>& path,
+                vector<CdrPatch>&   out );
+
+void diff_tables( cdr::table const& old, cdr::table const& now,
+                  vector<cdr::value>& path,
+                  vector<CdrPatch>&   out ) {
+  for( auto const& [key, old_val] : old ) {
+    path.push_back( key );
+    maybe<cdr::value const&> now_val = now[key];
+    if( now_val.has_value() )
+      diff_impl( old_val, *now_val, path, out );
+    else
+      out.push_back(
+          CdrPatch{ .path = path, .value = nothing } );
+    path.pop_back();
+  }
+  for( auto const& [key, now_val] : now ) {
+    if( old.contains( key ) ) continue;
+    path.push_back( key );
+    out.push_back( CdrPatch{ .path = path, .value = now_val } );
+    path.pop_back();
+  }
+}
+
+void diff_keyed_lists( cdr::list const& old,
+                       cdr::list const& now,
+                       vector<cdr::value>& path,
+                       vector<CdrPatch>&   out ) {
+  map<string, cdr::value const*> const old_elems =
+      elems_by_key( old );
+  map<string, cdr::value const*> const now_elems =
+      elems_by_key( now );
+  for( auto const& [key_str, old_elem] : old_elems ) {
+    path.push_back( key_selector( *pair_key( *old_elem ) ) );
+    auto it = now_elems.find( key_str );
+    if( it != now_elems.end() )
+      diff_impl( *old_elem, *it->second, path, out );
+    else
+      out.push_back(
+          CdrPatch{ .path = path, .value = nothing } );
+    path.pop_back();
+  }
+  for( auto const& [key_str, now_elem] : now_elems ) {
+    if( old_elems.contains( key_str ) ) continue;
+    path.push_back( key_selector( *pair_key( *now_elem ) ) );
+    out.push_back(
+        CdrPatch{ .path = path, .value = *now_elem } );
+    path.pop_back();
+  }
+}
+
+void diff_impl( cdr::value const& old, cdr::value const& now,
+                vector<cdr::value>& path,
+                vector<CdrPatch>&   out ) {
+  if( old == now ) return;
+  maybe<cdr::table const&> old_tbl = old.get_if<cdr::table>();
+  maybe<cdr::table const&> now_tbl = now.get_if<cdr::table>();
+  if( old_tbl.has_value() && now_tbl.has_value() )
+    return diff_tables( *old_tbl, *now_tbl, path, out );
+  maybe<cdr::list const&> old_list = old.get_if<cdr::list>();
+  maybe<cdr::list const&> now_list = now.get_if<cdr::list>();
+  if( old_list.has_value() && now_list.has_value() ) {
+    if( is_keyed_list( *old_list ) &&
+        is_keyed_list( *now_list ) )
+      return diff_keyed_lists( *old_list, *now_list, path,
+                               out );
+    if( old_list->size() == now_list->size() ) {
+      for( size_t i = 0; i < old_list->size(); ++i ) {
+        path.push_back( cdr::integer_type( i ) );
+        diff_impl( ( *old_list )[i], ( *now_list )[i], path,
+                   out );
+        path.pop_back();
+      }
+      return;
+    }
+  }
+  out.push_back( CdrPatch{ .path = path, .value = now } );
+}
+
+/****************************************************************
+** Terrain
+*****************************************************************/
+// Compares the matrices element by element so that only the ele-
+// ments that have changed get converted to canonical form, and
+// updates `old` to match as it goes.
+template<typename T>
+void diff_matrix( Matrix<T>& old, Matrix<T> const& now,
+                  vector<cdr::value>& path,
+                  vector<CdrPatch>&   out ) {
+  if( old.size() != now.size() ) {
+    out.push_back(
+        CdrPatch{ .path  = path,
+                  .value = cdr::run_conversion_to_canonical(
+                      now, kCdrOpts ) } );
+    old = now;
+    return;
+  }
+  vector<T> const& old_data = old.data();
+  vector<T> const& now_data = now.data();
+  int const        w        = old.size().w;
+  path.push_back( string( "data" ) );
+  for( int i = 0; i < ssize( now_data ); ++i ) {
+    if( old_data[i] == now_data[i] ) continue;
+    path.push_back( cdr::integer_type( i ) );
+    out.push_back(
+        CdrPatch{ .path  = path,
+                  .value = cdr::run_conversion_to_canonical(
+                      now_data[i], kCdrOpts ) } );
+    path.pop_back();
+    old[Coord{ .x = i % w, .y = i / w }] = now_data[i];
+  }
+  path.pop_back();
+}
+
+// For the parts of the terrain that are small.
+template<typename T>
+void diff_field( T& old, T const& now, string_view name,
+                 vector<cdr::value>& path,
+                 vector<CdrPatch>&   out ) {
+  if( old == now ) return;
+  path.push_back( string( name ) );
+  diff_impl( cdr::run_conversion_to_canonical( old, kCdrOpts ),
+             cdr::run_conversion_to_canonical( now, kCdrOpts ),
+             path, out );
+  path.pop_back();
+  old = now;
+}
+
+template<typename T>
+size_t constexpr kNumReflFields =
+    tuple_size_v<decltype( refl::traits<T>::fields )>;
+
+// If these fail then a field has been added to the terrain state
+// and needs to be diffed below.
+static_assert( kNumReflFields<wrapped::TerrainState> == 4 );
+static_assert( kNumReflFields<PlayerTerrain> == 1 );
+
+void diff_terrain( wrapped::TerrainState&       old,
+                   wrapped::TerrainState const& now,
+                   vector<cdr::value>&          path,
+                   vector<CdrPatch>&            out ) {
+  diff_field( old.placement_seed, now.placement_seed,
+              "placement_seed", path, out );
+  diff_field( old.proto_squares, now.proto_squares,
+              "proto_squares", path, out );
+  path.push_back( string( "world_map" ) );
+  diff_matrix( old.world_map, now.world_map, path, out );
+  path.pop_back();
+  path.push_back( string( "player_terrain" ) );
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    maybe<PlayerTerrain>&       old_player =
+        old.player_terrain[nation];
+    maybe<PlayerTerrain> const& now_player =
+        now.player_terrain[nation];
+    path.push_back( string( refl::enum_value_name( nation ) ) );
+    if( old_player.has_value() && now_player.has_value() ) {
+      path.push_back( string( "map" ) );
+      diff_matrix( old_player->map, now_player->map, path, out );
+      path.pop_back();
+    } else if( old_player != now_player ) {
+      out.push_back( CdrPatch{
+          .path  = path,
+          .value = cdr::run_conversion_to_canonical(
+              now_player, kCdrOpts ) } );
+      old_player = now_player;
+    }
+    path.pop_back();
+  }
+  path.pop_back();
+}
+
+/****************************************************************
+** Patching
+*****************************************************************/
+expect<cdr::value*> select_child( cdr::value&       v,
+                                  cdr::value const& elem ) {
+  if( maybe<string const&> key = elem.get_if<string>();
+      key.has_value() ) {
+    maybe<cdr::table&> tbl = v.get_if<cdr::table>();
+    if( !tbl.has_value() || !tbl->contains( *key ) )
+      return fmt::format( "no table key '{}'.", *key );
+    return &( *tbl )[*key];
+  }
+  if( maybe<cdr::integer_type const&> idx =
+          elem.get_if<cdr::integer_type>();
+      idx.has_value() ) {
+    maybe<cdr::list&> l = v.get_if<cdr::list>();
+    if( !l.has_value() || *idx < 0 || *idx >= l->ssize() )
+      return fmt::format( "no list index {}.", *idx );
+    return &( *l )[*idx];
+  }
+  if( maybe<cdr::table const&> selector =
+          elem.get_if<cdr::table>();
+      selector.has_value() ) {
+    maybe<cdr::list&> l = v.get_if<cdr::list>();
+    if( l.has_value() )
+      for( cdr::value& e : *l )
+        if( matches_key_selector( e, *selector ) ) return &e;
+    return fmt::format( "no list element with {}.",
+                        base::to_str( elem ) );
+  }
+  return fmt::format( "invalid path element: {}.",
+                      base::to_str( elem ) );
+}
+
+valid_or<string> set_or_remove_child(
+    cdr::value& v, cdr::value const& elem,
+    maybe<cdr::value> const& new_val ) {
+  if( maybe<string const&> key = elem.get_if<string>();
+      key.has_value() ) {
+    maybe<cdr::table&> tbl = v.get_if<cdr::table>();
+    if( !tbl.has_value() )
+      return fmt::format( "cannot set key '{}' on non-table.",
+                          *key );
+    if( new_val.has_value() ) {
+      ( *tbl )[*key] = *new_val;
+      return valid;
+    }
+    // Tables have no way to erase a key.
+    cdr::table rest;
+    for( auto& [k, val] : *tbl )
+      if( k != *key ) rest.emplace( k, std::move( val ) );
+    *tbl = std::move( rest );
+    return valid;
+  }
+  if( maybe<cdr::integer_type const&> idx =
+          elem.get_if<cdr::integer_type>();
+      idx.has_value() ) {
+    if( !new_val.has_value() )
+      return fmt::format( "cannot remove list index {}.", *idx );
+    UNWRAP_RETURN( child, select_child( v, elem ) );
+    *child = *new_val;
+    return valid;
+  }
+  if( maybe<cdr::table const&> selector =
+          elem.get_if<cdr::table>();
+      selector.has_value() ) {
+    maybe<cdr::list&> l = v.get_if<cdr::list>();
+    if( !l.has_value() )
+      return fmt::format( "cannot select {} in non-list.",
+                          base::to_str( elem ) );
+    vector<cdr::value> rest;
+    rest.reserve( l->size() + 1 );
+    bool found = false;
+    for( cdr::value& e : *l ) {
+      if( !matches_key_selector( e, *selector ) ) {
+        rest.push_back( std::move( e ) );
+        continue;
+      }
+      found = true;
+      if( new_val.has_value() ) rest.push_back( *new_val );
+    }
+    if( !found && new_val.has_value() )
+      rest.push_back( *new_val );
+    *l = cdr::list( std::move( rest ) );
+    return valid;
+  }
+  return fmt::format( "invalid path element: {}.",
+                      base::to_str( elem ) );
+}
+
+/****************************************************************
+** Journal Entries
+*****************************************************************/
+string entry_key( int n ) {
+  return fmt::format( "entry_{:06}", n );
+}
+
+// Each entry is preceded by a comment line of the form:
+//
+//   # entry <size> <hash>
+//
+// where the size is the number of bytes in the text of the entry
+// that follows and the hash is of those bytes (in hex).
+string_view constexpr kEntryHeaderPrefix = "# entry ";
+
+// FNV-1a.
+uint64_t hash_bytes( string_view bytes ) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for( char const c : bytes ) {
+    hash ^= uint64_t( static_cast<unsigned char>( c ) );
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+string with_entry_header( string const& body ) {
+  return fmt::format( "{}{} {:016x}\n{}", kEntryHeaderPrefix,
+                      body.size(), hash_bytes( body ), body );
+}
+
+// Returns the text of the entry at the start of `text` after
+// checking that it is complete, then advances `text` past it.
+expect<string_view> next_entry_body( string_view& text ) {
+  if( !text.starts_with( kEntryHeaderPrefix ) )
+    return "entry header is missing.";
+  size_t const eol = text.find( '\n' );
+  if( eol == string_view::npos )
+    return "entry header is incomplete.";
+  vector<string> const fields = base::str_split(
+      text.substr( kEntryHeaderPrefix.size(),
+                   eol - kEntryHeaderPrefix.size() ),
+      ' ' );
+  if( fields.size() != 2 ) return "entry header is malformed.";
+  maybe<int> const size = base::from_chars<int>( fields[0] );
+  maybe<uint64_t> const hash =
+      base::from_chars<uint64_t>( fields[1], /*base=*/16 );
+  if( !size.has_value() || !hash.has_value() || *size < 0 )
+    return "entry header is malformed.";
+  string_view const rest = text.substr( eol + 1 );
+  if( rest.size() < size_t( *size ) )
+    return fmt::format( "entry is incomplete ({} of {} bytes).",
+                        rest.size(), *size );
+  string_view const body = rest.substr( 0, *size );
+  if( hash_bytes( body ) != *hash )
+    return "entry does not match its hash.";
+  text = rest.substr( *size );
+  return body;
+}
+
+cdr::value patch_to_cdr( CdrPatch const& patch ) {
+  cdr::table tbl;
+  tbl["op"]   = string( patch.value.has_value() ? "set"
+                                                : "remove" );
+  tbl["path"] = cdr::list( patch.path );
+  if( patch.value.has_value() ) tbl["value"] = *patch.value;
+  return tbl;
+}
+
+expect<CdrPatch> patch_from_cdr( cdr::value const& v ) {
+  maybe<cdr::table const&> tbl = v.get_if<cdr::table>();
+  if( !tbl.has_value() ) return "journal op is not a table.";
+  maybe<cdr::value const&> op   = ( *tbl )["op"];
+  maybe<cdr::value const&> path = ( *tbl )["path"];
+  if( !op.has_value() || !path.has_value() ||
+      !path->holds<cdr::list>() )
+    return "journal op is missing its op or path.";
+  CdrPatch res;
+  for( cdr::value const& elem : path->get<cdr::list>() )
+    res.path.push_back( elem );
+  if( *op == cdr::value( string( "remove" ) ) ) return res;
+  if( *op != cdr::value( string( "set" ) ) )
+    return fmt::format( "unrecognized journal op: {}.",
+                        base::to_str( *op ) );
+  maybe<cdr::value const&> val = ( *tbl )["value"];
+  if( !val.has_value() )
+    return "journal set op is missing its value.";
+  res.value = *val;
+  return res;
+}
+
+// Applies all of the patches or, if one of them fails, none of
+// them. To that end the top-level fields of `v` that the patches
+// touch are copied first so that they can be restored.
+valid_or<string> apply_cdr_patches(
+    cdr::value& v, vector<CdrPatch> const& patches ) {
+  maybe<cdr::table&> tbl = v.get_if<cdr::table>();
+  if( !tbl.has_value() ) return "snapshot is not a table.";
+  map<string, cdr::value> backup;
+  for( CdrPatch const& patch : patches ) {
+    if( patch.path.empty() )
+      return "cannot replace the entire snapshot.";
+    maybe<string const&> key = patch.path[0].get_if<string>();
+    if( !key.has_value() || !tbl->contains( *key ) )
+      return fmt::format( "invalid top-level path element: {}.",
+                          base::to_str( patch.path[0] ) );
+    if( !backup.contains( *key ) )
+      backup.emplace( *key, ( *tbl )[*key] );
+  }
+  for( CdrPatch const& patch : patches ) {
+    valid_or<string> ok = apply_cdr_patch( v, patch );
+    if( ok.valid() ) continue;
+    for( auto& [key, val] : backup )
+      ( *tbl )[key] = std::move( val );
+    return ok;
+  }
+  return valid;
+}
+
+// Applies the entry with the given text, which must be entry
+// number `n`.
+valid_or<string> apply_entry( cdr::value& snapshot,
+                              string_view filename,
+                              string_view body, int n ) {
+  rcl::ProcessingOptions proc_opts{ .run_key_parse  = true,
+                                    .unflatten_keys = true };
+  UNWRAP_RETURN( rcl_doc, rcl::parse( filename, string( body ),
+                                      proc_opts ) );
+  string const             key = entry_key( n );
+  maybe<cdr::table const&> top =
+      rcl_doc.top_val().get_if<cdr::table>();
+  if( !top.has_value() || top->size() != 1 ||
+      !top->contains( key ) )
+    return fmt::format( "expected {}.", key );
+  maybe<cdr::table const&> entry =
+      ( *top )[key]->get_if<cdr::table>();
+  if( !entry.has_value() || !entry->contains( "ops" ) ||
+      !( *entry )["ops"]->holds<cdr::list>() )
+    return fmt::format( "{} has no ops.", key );
+  vector<CdrPatch> patches;
+  for( cdr::value const& op :
+       ( *entry )["ops"]->get<cdr::list>() ) {
+    UNWRAP_RETURN( patch, patch_from_cdr( op ) );
+    patches.push_back( std::move( patch ) );
+  }
+  return apply_cdr_patches( snapshot, patches );
+}
+
+} // namespace
+
+/****************************************************************
+** Cdr Patches
+*****************************************************************/
+void diff_cdr( cdr::value const& old, cdr::value const& now,
+               vector<cdr::value> const& path,
+               vector<CdrPatch>&         out ) {
+  vector<cdr::value> scratch = path;
+  diff_impl( old, now, scratch, out );
+}
+
+valid_or<string> apply_cdr_patch( cdr::value&     v,
+                                  CdrPatch const& patch ) {
+  if( patch.path.empty() ) {
+    if( !patch.value.has_value() )
+      return "cannot remove the top-level value.";
+    v = *patch.value;
+    return valid;
+  }
+  cdr::value* parent = &v;
+  for( size_t i = 0; i < patch.path.size() - 1; ++i ) {
+    UNWRAP_RETURN( child,
+                   select_child( *parent, patch.path[i] ) );
+    parent = child;
+  }
+  return set_or_remove_child( *parent, patch.path.back(),
+                              patch.value );
+}
+
+/****************************************************************
+** SaveJournal
+*****************************************************************/
+SaveJournal::SaveJournal() = default;
+
+SaveJournal::~SaveJournal() = default;
+
+void SaveJournal::reset( RootState const& root, int entries ) {
+  using Tr = refl::traits<RootState>;
+  static constexpr size_t kNumFields =
+      tuple_size_v<decltype( Tr::fields )>;
+  baseline_ = make_unique<RootState>();
+  FOR_CONSTEXPR_IDX( Idx, kNumFields ) {
+    auto& field_desc = get<Idx>( Tr::fields );
+    auto& old_val    = ( *baseline_ ).*field_desc.accessor;
+    auto& now_val    = root.*field_desc.accessor;
+    if constexpr( is_same_v<remove_cvref_t<decltype( now_val )>,
+                            TerrainState> )
+      terrain_ =
+          make_unique<wrapped::TerrainState>( now_val.refl() );
+    else
+      old_val = now_val;
+  };
+  entries_ = entries;
+}
+
+void SaveJournal::clear() {
+  baseline_.reset();
+  terrain_.reset();
+  entries_ = 0;
+}
+
+bool SaveJournal::has_baseline() const {
+  return baseline_ != nullptr;
+}
+
+maybe<string> SaveJournal::record( RootState const& root ) {
+  CHECK( baseline_ != nullptr );
+  using Tr = refl::traits<RootState>;
+  static constexpr size_t kNumFields =
+      tuple_size_v<decltype( Tr::fields )>;
+  vector<CdrPatch> patches;
+  FOR_CONSTEXPR_IDX( Idx, kNumFields ) {
+    auto& field_desc = get<Idx>( Tr::fields );
+    auto& old_val    = ( *baseline_ ).*field_desc.accessor;
+    auto& now_val    = root.*field_desc.accessor;
+    vector<cdr::value> path{ string( field_desc.name ) };
+    if constexpr( is_same_v<remove_cvref_t<decltype( now_val )>,
+                            TerrainState> ) {
+      diff_terrain( *terrain_, now_val.refl(), path, patches );
+    } else {
+      if( old_val == now_val ) return;
+      diff_cdr(
+          cdr::run_conversion_to_canonical( old_val, kCdrOpts ),
+          cdr::run_conversion_to_canonical( now_val, kCdrOpts ),
+          path, patches );
+      // Only the fields that have changed need to be copied.
+      old_val = now_val;
+    }
+  };
+  if( patches.empty() ) return nothing;
+  cdr::list ops;
+  ops.reserve( patches.size() );
+  for( CdrPatch const& patch : patches )
+    ops.push_back( patch_to_cdr( patch ) );
+  cdr::table entry;
+  entry["ops"] = std::move( ops );
+  cdr::table top;
+  top[entry_key( ++entries_ )] = std::move( entry );
+  rcl::ProcessingOptions proc_opts{ .run_key_parse  = false,
+                                    .unflatten_keys = false };
+  UNWRAP_CHECK(
+      rcl_doc, rcl::doc::create( std::move( top ), proc_opts ) );
+  rcl::EmitOptions const emit_opts{ .flatten_keys = false };
+  string body = rcl::emit( rcl_doc, emit_opts );
+  if( !body.ends_with( '\n' ) ) body += '\n';
+  return with_entry_header( body );
+}
+
+AppliedSaveJournal apply_save_journal( cdr::value& snapshot,
+                                       string_view filename,
+                                       string_view text ) {
+  AppliedSaveJournal res;
+  string_view        rest = text;
+  while( !rest.empty() ) {
+    int const n = res.entries + 1;
+    expect<string_view> const body = next_entry_body( rest );
+    if( !body.has_value() ) {
+      res.truncated = fmt::format( "{}: entry {}: {}", filename,
+                                   n, body.error() );
+      break;
+    }
+    valid_or<string> const ok =
+        apply_entry( snapshot, filename, *body, n );
+    if( !ok.valid() ) {
+      res.truncated = fmt::format( "{}: entry {}: {}", filename,
+                                   n, ok.error() );
+      break;
+    }
+    res.entries = n;
+    res.size    = int( text.size() - rest.size() );
+  }
+  return res;
+}
+
+} // namespace rn
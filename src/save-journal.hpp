@@ -0,0 +1,142 @@
+/****************************************************************
+**save-journal.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Journal of game state changes between full
+*              autosaves.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// Revolution Now
+#include "error.hpp"
+#include "expect.hpp"
+#include "maybe.hpp"
+
+// cdr
+#include "cdr/repr.hpp"
+
+// C++ standard library
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rn {
+
+struct RootState;
+
+namespace wrapped {
+struct TerrainState;
+}
+
+/****************************************************************
+** Cdr Patches
+*****************************************************************/
+// A change to one location within a canonical (cdr) value. Each
+// element of the path selects a child of the value: a string se-
+// lects a table key, an integer selects a list index, and a ta-
+// ble of the form {key=K} selects the element of a list of
+// {key,val} pairs (which is how maps with non-string keys are
+// represented) whose key is K. A value of `nothing` means that
+// the location is to be removed.
+struct CdrPatch {
+  std::vector<cdr::value> path;
+  maybe<cdr::value>       value;
+
+  bool operator==( CdrPatch const& ) const = default;
+};
+
+// Appends to `out` the patches that will turn `old` into `now`.
+// Tables are compared key by key and lists element by element
+// (or by key if they hold {key,val} pairs), so that a change
+// deep down in a large value produces a small patch. The `path`
+// is prepended to the paths of the patches.
+void diff_cdr( cdr::value const& old, cdr::value const& now,
+               std::vector<cdr::value> const& path,
+               std::vector<CdrPatch>&         out );
+
+valid_or<std::string> apply_cdr_patch( cdr::value&     v,
+                                       CdrPatch const& patch );
+
+/****************************************************************
+** SaveJournal
+*****************************************************************/
+// Records the changes made to the game state since the last full
+// save so that they can be appended to a journal file instead of
+// writing out the entire game each turn. The journal is itself
+// an Rcl document whose top-level keys are the entries, so that
+// appending one is just a matter of writing to the end of the
+// file. Each entry is preceded by a comment line holding its
+// size and hash so that one that was only partially written
+// (e.g. if the game crashed while appending it) can be detected.
+//
+// The game state is handed out by mutable reference all over the
+// place, so instead of recording each change as it is made we
+// keep a copy of the state as of the last entry and diff against
+// it. Only the top-level fields that have changed (as determined
+// by their equality operators) are converted to canonical form
+// and diffed, so the size of an entry and the time to write it
+// scale with what has changed and not with the size of the map.
+// The terrain is the exception: the players' fog maps change
+// nearly every turn, so it is compared square by square and only
+// the squares that have changed get converted.
+struct SaveJournal {
+  SaveJournal();
+  ~SaveJournal();
+
+  // To be called after `root` has been written out in full; sub-
+  // sequent entries will be relative to it. The number of en-
+  // tries is the number that are already in the journal file on
+  // top of that save (e.g. if they were just applied on load).
+  void reset( RootState const& root, int entries = 0 );
+
+  // Forget the baseline, e.g. when a different game is loaded.
+  void clear();
+
+  bool has_baseline() const;
+
+  int entries() const { return entries_; }
+
+  // Produces the text of a new entry to be appended to the jour-
+  // nal file that holds the changes since the previous one, then
+  // makes `root` the new baseline. Returns nothing if nothing
+  // has changed. There must be a baseline.
+  maybe<std::string> record( RootState const& root );
+
+ private:
+  // The terrain is held separately from the rest of the baseline
+  // so that it can be updated one square at a time; the terrain
+  // field of baseline_ is left empty.
+  std::unique_ptr<RootState>             baseline_;
+  std::unique_ptr<wrapped::TerrainState> terrain_;
+  int                                    entries_ = 0;
+};
+
+struct AppliedSaveJournal {
+  int entries = 0;
+  // The number of bytes at the start of the journal text that
+  // hold the entries that were applied.
+  int size = 0;
+  // If not all of the journal could be applied then this says
+  // why; nothing after that point was applied.
+  maybe<std::string> truncated;
+};
+
+// Applies the entries in the given journal text (in order) to
+// `snapshot`, which is the canonical form of the full save that
+// the journal was written on top of. This stops at the first en-
+// try that is incomplete or that fails to parse or apply, so
+// that a journal whose last entry was torn still gets the en-
+// tries before it applied; an entry is either applied in full or
+// not at all. The filename is only used for error reporting.
+AppliedSaveJournal apply_save_journal( cdr::value&      snapshot,
+                                       std::string_view filename,
+                                       std::string_view text );
+
+} // namespace rn
@@ -0,0 +1,65 @@
+/****************************************************************
+**sheet-images.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Decodes the sprite and font sheet images.
+*
+*****************************************************************/
+#include "sheet-images.hpp"
+
+// Revolution Now
+#include "error.hpp"
+#include "init.hpp"
+
+// config
+#include "config/tile-sheet.rds.hpp"
+
+// stb
+#include "stb/image.hpp"
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+vector<gfx::image> g_sprite_sheet_images;
+vector<gfx::image> g_font_sheet_images;
+
+void init_images() {
+  for( rr::SpriteSheetConfig const& sheet :
+       config_tile_sheet.sheets.sprite_sheets ) {
+    UNWRAP_CHECK( img, stb::load_image( sheet.img_path ) );
+    g_sprite_sheet_images.push_back( std::move( img ) );
+  }
+  for( rr::AsciiFontSheetConfig const& sheet :
+       config_tile_sheet.sheets.font_sheets ) {
+    UNWRAP_CHECK( img, stb::load_image( sheet.img_path ) );
+    g_font_sheet_images.push_back( std::move( img ) );
+  }
+}
+
+void cleanup_images() {
+  g_sprite_sheet_images.clear();
+  g_font_sheet_images.clear();
+}
+
+REGISTER_INIT_ROUTINE( images );
+
+} // namespace
+
+/****************************************************************
+** Public API
+*****************************************************************/
+vector<gfx::image>& sprite_sheet_images() {
+  return g_sprite_sheet_images;
+}
+
+vector<gfx::image>& font_sheet_images() {
+  return g_font_sheet_images;
+}
+
+} // namespace rn
@@ -0,0 +1,31 @@
+/****************************************************************
+**sheet-images.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Decodes the sprite and font sheet images.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// gfx
+#include "gfx/image.hpp"
+
+// C++ standard library
+#include <vector>
+
+namespace rn {
+
+// The decoded images of the sprite sheets and font sheets in the
+// tile sheet config, in the same order. They are decoded during
+// initialization on a worker thread (decoding does not need the
+// GL context) and then moved out by the renderer when it builds
+// the texture atlas, after which they are empty.
+std::vector<gfx::image>& sprite_sheet_images();
+std::vector<gfx::image>& font_sheet_images();
+
+} // namespace rn
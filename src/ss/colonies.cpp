@@ -22,6 +22,7 @@
 #include "base/to-str-ext-std.hpp"
 
 // C++ standard library
+#include <algorithm>
 #include <unordered_map>
 
 using namespace std;
@@ -32,6 +33,18 @@ namespace {
 
 constexpr int kFirstColonyId = 1;
 
+void insert_sorted( vector<ColonyId>& ids, ColonyId id ) {
+  auto it = lower_bound( ids.begin(), ids.end(), id );
+  CHECK( it == ids.end() || *it != id );
+  ids.insert( it, id );
+}
+
+void erase_sorted( vector<ColonyId>& ids, ColonyId id ) {
+  auto it = lower_bound( ids.begin(), ids.end(), id );
+  CHECK( it != ids.end() && *it == id );
+  ids.erase( it );
+}
+
 } // namespace
 
 /****************************************************************
@@ -95,14 +108,46 @@ base::valid_or<std::string> ColoniesState::validate() const {
   // Colony location matches coord.
   for( auto const& [colony_id, colony] : o_.colonies ) {
     Coord const&          coord = colony.location;
-    base::maybe<ColonyId> actual_colony_id =
-        base::lookup( colony_from_coord_, coord );
+    ColonyId const actual_colony_id = colony_layer_[coord];
     REFL_VALIDATE(
         actual_colony_id == colony_id,
         "Inconsistent colony map coordinate ({}) for colony {}.",
         coord, colony_id );
   }
 
+  // Per-nation index matches.
+  for( auto const& [nation, ids] : colonies_for_nation_ ) {
+    REFL_VALIDATE( is_sorted( ids.begin(), ids.end() ),
+                   "colony index for {} is not sorted.", nation );
+    for( ColonyId const id : ids ) {
+      base::maybe<Colony const&> colony =
+          base::lookup( o_.colonies, id );
+      REFL_VALIDATE( colony.has_value(),
+                     "colony index for {} has nonexistent colony "
+                     "{}.",
+                     nation, id );
+      REFL_VALIDATE( colony->nation == nation,
+                     "colony {} is in the index for {} but it "
+                     "belongs to {}.",
+                     id, nation, colony->nation );
+    }
+  }
+  int num_indexed = 0;
+  for( auto const& [nation, ids] : colonies_for_nation_ )
+    num_indexed += ids.size();
+  REFL_VALIDATE( num_indexed == int( o_.colonies.size() ),
+                 "colony index has {} colonies but there are {} "
+                 "colonies.",
+                 num_indexed, o_.colonies.size() );
+
+  // No stale colonies left in the tile layer.
+  auto const has_colony = []( ColonyId id ) { return id != 0; };
+  int const  num_in_layer = colony_layer_.count_if( has_colony );
+  REFL_VALIDATE( num_in_layer == int( o_.colonies.size() ),
+                 "colony tile layer has {} colonies but there are "
+                 "{} colonies.",
+                 num_in_layer, o_.colonies.size() );
+
   return base::valid;
 }
 
@@ -112,13 +157,26 @@ void ColoniesState::validate_or_die() const {
 
 ColoniesState::ColoniesState( wrapped::ColoniesState&& o )
   : o_( std::move( o ) ) {
-  // Populate colony_from_coord_.
+  // Populate colony_layer_. Size it first so that it doesn't
+  // have to grow while being populated.
+  Delta bounds;
+  for( auto const& [id, colony] : o_.colonies ) {
+    bounds.w = std::max( bounds.w, colony.location.x + 1 );
+    bounds.h = std::max( bounds.h, colony.location.y + 1 );
+  }
+  colony_layer_ = TileLayer<ColonyId>( bounds );
   for( auto const& [id, colony] : o_.colonies )
-    colony_from_coord_[colony.location] = id;
+    colony_layer_.mutable_at( colony.location ) = id;
 
   // Populate colony_from_name_.
   for( auto const& [id, colony] : o_.colonies )
     colony_from_name_[colony.name] = id;
+
+  // Populate colonies_for_nation_.
+  for( auto const& [id, colony] : o_.colonies )
+    colonies_for_nation_[colony.nation].push_back( id );
+  for( auto& [nation, ids] : colonies_for_nation_ )
+    sort( ids.begin(), ids.end() );
 }
 
 ColoniesState::ColoniesState()
@@ -148,13 +206,9 @@ Coord ColoniesState::coord_for( ColonyId id ) const {
   return colony_for( id ).location;
 }
 
-vector<ColonyId> ColoniesState::for_nation(
+span<ColonyId const> ColoniesState::for_nation(
     e_nation nation ) const {
-  vector<ColonyId> res;
-  res.reserve( o_.colonies.size() );
-  for( auto const& [id, colony] : o_.colonies )
-    if( colony.nation == nation ) res.push_back( id );
-  return res;
+  return colonies_for_nation_[nation];
 }
 
 ColonyId ColoniesState::add_colony( Colony&& colony ) {
@@ -162,10 +216,12 @@ ColonyId ColoniesState::add_colony( Colony&& colony ) {
          "colony ID must be zero when creating colony." );
   ColonyId id = next_colony_id();
   colony.id   = id;
-  CHECK( !colony_from_coord_.contains( colony.location ) );
+  CHECK( colony_layer_[colony.location] == 0 );
   CHECK( !colony_from_name_.contains( colony.name ) );
-  colony_from_coord_[colony.location] = id;
-  colony_from_name_[colony.name]      = id;
+  colony_layer_.mutable_at( colony.location ) = id;
+  colony_from_name_[colony.name]              = id;
+  // Ids are increasing, so this will normally be an append.
+  insert_sorted( colonies_for_nation_[colony.nation], id );
   // Must be last to avoid use-after-move.
   CHECK( !o_.colonies.contains( id ) );
   o_.colonies[id] = std::move( colony );
@@ -174,16 +230,26 @@ ColonyId ColoniesState::add_colony( Colony&& colony ) {
 
 void ColoniesState::destroy_colony( ColonyId id ) {
   Colony& colony = colony_for( id );
-  CHECK( colony_from_coord_.contains( colony.location ) );
-  colony_from_coord_.erase( colony.location );
+  CHECK( colony_layer_[colony.location] == id );
+  colony_layer_.reset( colony.location );
   CHECK( colony_from_name_.contains( colony.name ),
          "colony_from_name_ does not contain '{}'.",
          colony.name );
   colony_from_name_.erase( colony.name );
+  erase_sorted( colonies_for_nation_[colony.nation], id );
   // Should be last so above reference doesn't dangle.
   o_.colonies.erase( id );
 }
 
+void ColoniesState::change_nation( ColonyId id,
+                                   e_nation nation ) {
+  Colony& colony = colony_for( id );
+  if( colony.nation == nation ) return;
+  erase_sorted( colonies_for_nation_[colony.nation], id );
+  insert_sorted( colonies_for_nation_[nation], id );
+  colony.nation = nation;
+}
+
 ColonyId ColoniesState::next_colony_id() {
   return ColonyId{ o_.next_colony_id++ };
 }
@@ -195,7 +261,9 @@ ColonyId ColoniesState::last_colony_id() const {
 
 base::maybe<ColonyId> ColoniesState::maybe_from_coord(
     Coord const& coord ) const {
-  return base::lookup( colony_from_coord_, coord );
+  ColonyId const id = colony_layer_[coord];
+  if( id == 0 ) return base::nothing;
+  return id;
 }
 
 ColonyId ColoniesState::from_coord( Coord const& coord ) const {
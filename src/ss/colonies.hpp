@@ -13,9 +13,18 @@
 // Rds
 #include "ss/colonies.rds.hpp"
 
+// ss
+#include "ss/tile-layer.hpp"
+
 // luapp
 #include "luapp/ext-userdata.hpp"
 
+// refl
+#include "refl/enum-map.hpp"
+
+// C++ standard library
+#include <span>
+
 namespace rn {
 
 struct ColoniesState {
@@ -37,7 +46,10 @@ struct ColoniesState {
 
   std::unordered_map<ColonyId, Colony> const& all() const;
 
-  std::vector<ColonyId> for_nation( e_nation nation ) const;
+  // Sorted by id. This is a view into an index that is updated
+  // as colonies are added, destroyed or change hands, so don't
+  // hold on to it across any of those.
+  std::span<ColonyId const> for_nation( e_nation nation ) const;
 
   Colony const& colony_for( ColonyId id ) const;
   Colony&       colony_for( ColonyId id );
@@ -62,6 +74,12 @@ struct ColoniesState {
   // ences to the colony after this.
   void destroy_colony( ColonyId id );
 
+  // This is the only way that a colony's nation should be
+  // changed, since the per-nation index must be kept up to date.
+  // DO NOT call this directly as it will not change the units in
+  // the colony; use change_colony_nation instead.
+  void change_nation( ColonyId id, e_nation nation );
+
  private:
   [[nodiscard]] ColonyId next_colony_id();
 
@@ -72,8 +90,11 @@ struct ColoniesState {
   wrapped::ColoniesState o_;
 
   // ----- Non-serializable (transient) state.
-  std::unordered_map<Coord, ColonyId>       colony_from_coord_;
+  // Colony ID on each tile, or zero if there is none.
+  TileLayer<ColonyId>                       colony_layer_;
   std::unordered_map<std::string, ColonyId> colony_from_name_;
+  refl::enum_map<e_nation, std::vector<ColonyId>>
+      colonies_for_nation_;
 };
 
 } // namespace rn
@@ -245,10 +245,12 @@ LUA_STARTUP( lua::state& st ) {
   auto u  = st.usertype.create<U>();
 
   // Getters.
-  u["id"]              = &U::id;
-  u["nation"]          = &U::nation;
-  u["name"]            = &U::name;
-  u["location"]        = &U::location;
+  u["id"]   = &U::id;
+  u["name"] = &U::name;
+  // These are read-only since ColoniesState indexes colonies by
+  // nation and location; changes must go through its mutators.
+  u["nation"]   = static_cast<e_nation const U::*>( &U::nation );
+  u["location"] = static_cast<Coord const U::*>( &U::location );
   u["sons_of_liberty"] = &U::sons_of_liberty;
   u["buildings"]       = &U::buildings;
   u["commodities"]     = &U::commodities;
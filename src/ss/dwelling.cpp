@@ -88,7 +88,9 @@ LUA_STARTUP( lua::state& st ) {
     u["id"]         = &U::id;
     u["tribe"]      = &U::tribe;
     u["is_capital"] = &U::is_capital;
-    u["location"]   = &U::location;
+    // Read-only since NativesState indexes dwellings by tile.
+    u["location"] =
+        static_cast<Coord const U::*>( &U::location );
     u["population"] = &U::population;
     u["trading"]    = &U::trading;
     u["teaches"]    = &U::teaches;
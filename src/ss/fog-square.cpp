@@ -40,7 +40,11 @@ LUA_STARTUP( lua::state& st ) {
 
     auto u = st.usertype.create<U>();
 
-    u["square"] = &U::square;
+    // Returns nil when the player's view of the square is cur-
+    // rent, in which case the real map square should be used.
+    u["square"] = []( U& o ) -> base::maybe<MapSquare&> {
+      return o.square;
+    };
   }();
 };
 
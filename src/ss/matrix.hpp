@@ -180,7 +180,7 @@ cdr::value to_canonical( cdr::converter&  conv,
   lst.reserve( m.data().size() );
   if( !write_defaults ) {
     conv.to_field( tbl, "has_coords", true );
-    for( Rect const r : gfx::subrects( m.rect() ) ) {
+    for( Rect const r : gfx::subrect_range( m.rect() ) ) {
       T const&       elem = m[r.upper_left()];
       static const T def{};
       if( elem == def ) continue;
@@ -206,7 +206,7 @@ cdr::result<Matrix<T>> from_canonical( cdr::converter&   conv,
                                        cdr::value const& v,
                                        cdr::tag_t<Matrix<T>> ) {
   UNWRAP_RETURN( tbl, conv.ensure_type<cdr::table>( v ) );
-  std::unordered_set<std::string> used_keys;
+  cdr::field_tracker<3> used_keys;
   UNWRAP_RETURN(
       has_coords,
       conv.from_field<bool>( tbl, "has_coords", used_keys ) );
@@ -28,6 +28,9 @@
 #include "base/keyval.hpp"
 #include "base/to-str-ext-std.hpp"
 
+// C++ standard library
+#include <algorithm>
+
 using namespace std;
 
 namespace rn {
@@ -76,15 +79,39 @@ base::valid_or<std::string> NativesState::validate() const {
 
   // Dwelling location matches coord.
   for( auto const& [dwelling_id, dwelling] : o_.dwellings ) {
-    Coord const&            coord = dwelling.location;
-    base::maybe<DwellingId> actual_dwelling_id =
-        base::lookup( dwelling_from_coord_, coord );
+    Coord const&     coord = dwelling.location;
+    DwellingId const actual_dwelling_id =
+        tile_layer_[coord].dwelling;
     REFL_VALIDATE( actual_dwelling_id == dwelling_id,
                    "Inconsistent dwelling map coordinate ({}) "
                    "for dwelling {}.",
                    coord, dwelling_id );
   }
 
+  // Owned land matches the tile layer.
+  for( auto const& [coord, dwelling_id] :
+       o_.owned_land_without_minuit ) {
+    DwellingId const actual_owner = tile_layer_[coord].owner;
+    REFL_VALIDATE( actual_owner == dwelling_id,
+                   "Inconsistent owner for native land tile {}: "
+                   "{} != {}.",
+                   coord, actual_owner, dwelling_id );
+  }
+
+  // No stale entries left in the tile layer.
+  int const num_dwellings = tile_layer_.count_if(
+      []( Tile const& tile ) { return tile.dwelling != 0; } );
+  REFL_VALIDATE( num_dwellings == int( o_.dwellings.size() ),
+                 "native tile layer has {} dwellings but there "
+                 "are {} dwellings.",
+                 num_dwellings, o_.dwellings.size() );
+  int const num_owned = tile_layer_.count_if(
+      []( Tile const& tile ) { return tile.owner != 0; } );
+  REFL_VALIDATE(
+      num_owned == int( o_.owned_land_without_minuit.size() ),
+      "native tile layer has {} owned tiles but there are {}.",
+      num_owned, o_.owned_land_without_minuit.size() );
+
   return base::valid;
 }
 
@@ -94,9 +121,22 @@ void NativesState::validate_or_die() const {
 
 NativesState::NativesState( wrapped::NativesState&& o )
   : o_( std::move( o ) ) {
-  // Populate dwelling_from_coord_.
+  // Populate tile_layer_. Size it first so that it doesn't have
+  // to grow while being populated.
+  Delta bounds;
+  auto  include = [&]( Coord coord ) {
+    bounds.w = std::max( bounds.w, coord.x + 1 );
+    bounds.h = std::max( bounds.h, coord.y + 1 );
+  };
   for( auto const& [id, dwelling] : o_.dwellings )
-    dwelling_from_coord_[dwelling.location] = id;
+    include( dwelling.location );
+  for( auto const& [coord, id] : o_.owned_land_without_minuit )
+    include( coord );
+  tile_layer_ = TileLayer<Tile>( bounds );
+  for( auto const& [id, dwelling] : o_.dwellings )
+    tile_layer_.mutable_at( dwelling.location ).dwelling = id;
+  for( auto const& [coord, id] : o_.owned_land_without_minuit )
+    tile_layer_.mutable_at( coord ).owner = id;
 }
 
 NativesState::NativesState()
@@ -167,8 +207,8 @@ DwellingId NativesState::add_dwelling( Dwelling&& dwelling ) {
          "dwelling ID must be zero when creating dwelling." );
   DwellingId id = next_dwelling_id();
   dwelling.id   = id;
-  CHECK( !dwelling_from_coord_.contains( dwelling.location ) );
-  dwelling_from_coord_[dwelling.location] = id;
+  CHECK( tile_layer_[dwelling.location].dwelling == 0 );
+  tile_layer_.mutable_at( dwelling.location ).dwelling = id;
   // Must be last to avoid use-after-move.
   CHECK( !o_.dwellings.contains( id ) );
   o_.dwellings[id] = std::move( dwelling );
@@ -177,8 +217,8 @@ DwellingId NativesState::add_dwelling( Dwelling&& dwelling ) {
 
 void NativesState::destroy_dwelling( DwellingId id ) {
   Dwelling& dwelling = dwelling_for( id );
-  CHECK( dwelling_from_coord_.contains( dwelling.location ) );
-  dwelling_from_coord_.erase( dwelling.location );
+  CHECK( tile_layer_[dwelling.location].dwelling == id );
+  tile_layer_.mutable_at( dwelling.location ).dwelling = 0;
   // Should be last so above reference doesn't dangle.
   o_.dwellings.erase( id );
 }
@@ -194,7 +234,9 @@ DwellingId NativesState::last_dwelling_id() const {
 
 base::maybe<DwellingId> NativesState::maybe_dwelling_from_coord(
     Coord const& coord ) const {
-  return base::lookup( dwelling_from_coord_, coord );
+  DwellingId const id = tile_layer_[coord].dwelling;
+  if( id == 0 ) return nothing;
+  return id;
 }
 
 DwellingId NativesState::dwelling_from_coord(
@@ -207,25 +249,24 @@ bool NativesState::dwelling_exists( DwellingId id ) const {
   return o_.dwellings.contains( id );
 }
 
-unordered_map<Coord, DwellingId>&
-NativesState::owned_land_without_minuit() {
-  return o_.owned_land_without_minuit;
-}
-
-unordered_map<Coord, DwellingId> const&
-NativesState::owned_land_without_minuit() const {
-  return o_.owned_land_without_minuit;
+base::maybe<DwellingId> NativesState::land_owner_without_minuit(
+    Coord where ) const {
+  DwellingId const id = tile_layer_[where].owner;
+  if( id == 0 ) return nothing;
+  return id;
 }
 
 void NativesState::mark_land_owned( DwellingId dwelling_id,
                                     Coord      where ) {
   o_.owned_land_without_minuit[where] = dwelling_id;
+  tile_layer_.mutable_at( where ).owner = dwelling_id;
 }
 
 void NativesState::mark_land_unowned( Coord where ) {
   auto it = o_.owned_land_without_minuit.find( where );
   if( it == o_.owned_land_without_minuit.end() ) return;
   o_.owned_land_without_minuit.erase( it );
+  tile_layer_.mutable_at( where ).owner = 0;
 }
 
 /****************************************************************
@@ -14,6 +14,9 @@
 // Rds
 #include "ss/natives.rds.hpp"
 
+// ss
+#include "ss/tile-layer.hpp"
+
 // luapp
 #include "luapp/ext-userdata.hpp"
 
@@ -89,15 +92,13 @@ struct NativesState {
   // ------------------------------------------------------------
 
  private:
-  // NOTE: Normal game logic should not be calling these methods
-  // directly since they don't take into account Peter Minuit.
+  // NOTE: Normal game logic should not be calling this method
+  // directly since it doesn't take into account Peter Minuit.
   // that whether the player has Peter Minuit, in which case
   // there is effectively no land ownership by the natives from
   // the perspective of that player.
-  std::unordered_map<Coord, DwellingId>&
-  owned_land_without_minuit();
-  std::unordered_map<Coord, DwellingId> const&
-  owned_land_without_minuit() const;
+  base::maybe<DwellingId> land_owner_without_minuit(
+      Coord where ) const;
 
   friend base::maybe<DwellingId>
   is_land_native_owned_after_meeting_without_colonies(
@@ -118,7 +119,18 @@ struct NativesState {
   wrapped::NativesState o_;
 
   // ----- Non-serializable (transient) state.
-  std::unordered_map<Coord, DwellingId> dwelling_from_coord_;
+  struct Tile {
+    // Dwelling on the tile, or zero if there is none.
+    DwellingId dwelling = 0;
+    // Dwelling that owns the land (without taking Peter Minuit
+    // into account), or zero if it is not owned.
+    DwellingId owner = 0;
+
+    bool operator==( Tile const& ) const = default;
+  };
+
+  // This mirrors the dwelling locations and the owned land map.
+  TileLayer<Tile> tile_layer_;
 };
 
 } // namespace rn
@@ -0,0 +1,122 @@
+/****************************************************************
+**packed-square.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Compact encoding of a MapSquare.
+*
+*****************************************************************/
+#include "packed-square.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+
+// C++ standard library
+#include <span>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+using Field = PackedSquare::Field;
+
+template<typename E>
+constexpr bool fits( Field f, bool optional ) {
+  return refl::enum_count<E> + ( optional ? 1 : 0 ) <=
+         ( 1 << f.width );
+}
+
+static_assert(
+    fits<e_surface>( PackedSquare::kSurface, false ) );
+static_assert(
+    fits<e_ground_terrain>( PackedSquare::kGround, false ) );
+static_assert(
+    fits<e_land_overlay>( PackedSquare::kOverlay, true ) );
+static_assert( fits<e_river>( PackedSquare::kRiver, true ) );
+static_assert( fits<e_natural_resource>(
+    PackedSquare::kGroundResource, true ) );
+static_assert( fits<e_natural_resource>(
+    PackedSquare::kForestResource, true ) );
+
+void write_field( uint32_t& bits, Field f, uint32_t val ) {
+  bits |= val << f.offset;
+}
+
+uint32_t read_field( uint32_t bits, Field f ) {
+  return ( bits >> f.offset ) & ( ( 1u << f.width ) - 1 );
+}
+
+template<typename E>
+void write_maybe( uint32_t& bits, Field f, base::maybe<E> val ) {
+  if( val.has_value() )
+    write_field( bits, f, static_cast<uint32_t>( *val ) + 1 );
+}
+
+template<typename E>
+base::maybe<E> read_maybe( uint32_t bits, Field f ) {
+  uint32_t const val = read_field( bits, f );
+  if( val == 0 ) return base::nothing;
+  return static_cast<E>( val - 1 );
+}
+
+} // namespace
+
+/****************************************************************
+** PackedSquare
+*****************************************************************/
+PackedSquare PackedSquare::pack( MapSquare const& square ) {
+  uint32_t bits = 0;
+  write_field( bits, kSurface,
+               static_cast<uint32_t>( square.surface ) );
+  write_field( bits, kGround,
+               static_cast<uint32_t>( square.ground ) );
+  write_maybe( bits, kOverlay, square.overlay );
+  write_maybe( bits, kRiver, square.river );
+  write_maybe( bits, kGroundResource, square.ground_resource );
+  write_maybe( bits, kForestResource, square.forest_resource );
+  write_field( bits, kIrrigation, square.irrigation ? 1 : 0 );
+  write_field( bits, kRoad, square.road ? 1 : 0 );
+  write_field( bits, kSeaLane, square.sea_lane ? 1 : 0 );
+  write_field( bits, kLostCityRumor,
+               square.lost_city_rumor ? 1 : 0 );
+  return PackedSquare{ .bits = bits };
+}
+
+MapSquare PackedSquare::unpack() const {
+  return MapSquare{
+      .surface =
+          static_cast<e_surface>( read_field( bits, kSurface ) ),
+      .ground = static_cast<e_ground_terrain>(
+          read_field( bits, kGround ) ),
+      .overlay = read_maybe<e_land_overlay>( bits, kOverlay ),
+      .river   = read_maybe<e_river>( bits, kRiver ),
+      .ground_resource =
+          read_maybe<e_natural_resource>( bits,
+                                          kGroundResource ),
+      .forest_resource =
+          read_maybe<e_natural_resource>( bits,
+                                          kForestResource ),
+      .irrigation      = read_field( bits, kIrrigation ) != 0,
+      .road            = read_field( bits, kRoad ) != 0,
+      .sea_lane        = read_field( bits, kSeaLane ) != 0,
+      .lost_city_rumor =
+          read_field( bits, kLostCityRumor ) != 0 };
+}
+
+Matrix<PackedSquare> pack_map( Matrix<MapSquare> const& m ) {
+  Delta const          size = m.size();
+  Matrix<PackedSquare> res( size );
+  for( int y = 0; y < size.h; ++y ) {
+    span<MapSquare const> const src = m[y];
+    span<PackedSquare> const    dst = res[y];
+    for( int x = 0; x < size.w; ++x )
+      dst[x] = PackedSquare::pack( src[x] );
+  }
+  return res;
+}
+
+} // namespace rn
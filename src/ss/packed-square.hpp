@@ -0,0 +1,99 @@
+/****************************************************************
+**packed-square.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Compact encoding of a MapSquare.
+*
+*****************************************************************/
+#pragma once
+
+// Rds
+#include "ss/map-square.rds.hpp"
+
+// ss
+#include "ss/matrix.hpp"
+
+// C++ standard library
+#include <cstdint>
+
+namespace rn {
+
+// Holds all of the information in a MapSquare in 32 bits instead
+// of the ~44 bytes taken by the struct (each of its maybe<enum>
+// members is eight bytes). This is not used as storage for the
+// map, since the rest of the game deals in MapSquare references.
+// Instead, algorithms that make many passes over the map while
+// only looking at one or two attributes (e.g. flood fills and
+// distance fields over the surface) can pack the map once up
+// front with pack_map and then touch an eleventh of the memory
+// on each pass.
+//
+// Optional enums are stored as zero for `nothing` and otherwise
+// one plus the enum value. The conversion is lossless.
+struct PackedSquare {
+  uint32_t bits = 0;
+
+  static PackedSquare pack( MapSquare const& square );
+
+  MapSquare unpack() const;
+
+  e_surface surface() const {
+    return static_cast<e_surface>( get_field( kSurface ) );
+  }
+
+  e_ground_terrain ground() const {
+    return static_cast<e_ground_terrain>(
+        get_field( kGround ) );
+  }
+
+  bool has_overlay() const { return get_field( kOverlay ) != 0; }
+  bool has_river() const { return get_field( kRiver ) != 0; }
+  bool road() const { return get_field( kRoad ) != 0; }
+  bool sea_lane() const { return get_field( kSeaLane ) != 0; }
+
+  bool irrigation() const {
+    return get_field( kIrrigation ) != 0;
+  }
+
+  bool lost_city_rumor() const {
+    return get_field( kLostCityRumor ) != 0;
+  }
+
+  bool operator==( PackedSquare const& ) const = default;
+
+  // Each field is given by its offset and width in bits.
+  struct Field {
+    int offset = 0;
+    int width  = 0;
+  };
+
+  static constexpr Field kSurface{ .offset = 0, .width = 1 };
+  static constexpr Field kGround{ .offset = 1, .width = 4 };
+  static constexpr Field kOverlay{ .offset = 5, .width = 2 };
+  static constexpr Field kRiver{ .offset = 7, .width = 2 };
+  static constexpr Field kGroundResource{ .offset = 9,
+                                          .width  = 4 };
+  static constexpr Field kForestResource{ .offset = 13,
+                                          .width  = 4 };
+  static constexpr Field kIrrigation{ .offset = 17, .width = 1 };
+  static constexpr Field kRoad{ .offset = 18, .width = 1 };
+  static constexpr Field kSeaLane{ .offset = 19, .width = 1 };
+  static constexpr Field kLostCityRumor{ .offset = 20,
+                                         .width  = 1 };
+
+ private:
+  uint32_t get_field( Field f ) const {
+    return ( bits >> f.offset ) & ( ( 1u << f.width ) - 1 );
+  }
+};
+
+static_assert( sizeof( PackedSquare ) == 4 );
+
+// A packed snapshot of the given map; it does not track later
+// changes to the map.
+Matrix<PackedSquare> pack_map( Matrix<MapSquare> const& m );
+
+} // namespace rn
@@ -25,6 +25,7 @@
 #include "gfx/iter.hpp"
 
 // refl
+#include "refl/query-enum.hpp"
 #include "refl/to-str.hpp"
 
 // base
@@ -61,9 +62,94 @@ Matrix<MapSquare> const& TerrainState::world_map() const {
 }
 
 Matrix<MapSquare>& TerrainState::mutable_world_map() {
+  snapshot_player_squares();
   return o_.world_map;
 }
 
+void TerrainState::snapshot_player_squares( Coord tile ) {
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    base::maybe<PlayerTerrain>& player_terrain =
+        o_.player_terrain[nation];
+    if( !player_terrain.has_value() ) continue;
+    // The map may have been resized without the player maps
+    // being re-initialized yet.
+    if( !tile.is_inside( player_terrain->map.rect() ) ) continue;
+    base::maybe<FogSquare>& fog_square =
+        player_terrain->map[tile];
+    if( !fog_square.has_value() ) continue;
+    if( fog_square->square.has_value() ) continue;
+    fog_square->square = o_.world_map[tile];
+  }
+}
+
+void TerrainState::snapshot_player_squares() {
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    base::maybe<PlayerTerrain>& player_terrain =
+        o_.player_terrain[nation];
+    if( !player_terrain.has_value() ) continue;
+    Matrix<base::maybe<FogSquare>>& map = player_terrain->map;
+    // The map may have been resized without the player maps
+    // being re-initialized yet, in which case they will be
+    // thrown away anyway.
+    if( map.size() != o_.world_map.size() ) continue;
+    for( Rect const r : gfx::subrect_range( map.rect() ) ) {
+      Coord const             tile       = r.upper_left();
+      base::maybe<FogSquare>& fog_square = map[tile];
+      if( !fog_square.has_value() ) continue;
+      if( fog_square->square.has_value() ) continue;
+      fog_square->square = o_.world_map[tile];
+    }
+  }
+}
+
+void TerrainState::drop_redundant_player_squares( Coord tile ) {
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    base::maybe<PlayerTerrain>& player_terrain =
+        o_.player_terrain[nation];
+    if( !player_terrain.has_value() ) continue;
+    if( !tile.is_inside( player_terrain->map.rect() ) ) continue;
+    base::maybe<FogSquare>& fog_square =
+        player_terrain->map[tile];
+    if( !fog_square.has_value() ) continue;
+    base::maybe<MapSquare>& copy = fog_square->square;
+    if( copy.has_value() && *copy == o_.world_map[tile] )
+      copy.reset();
+  }
+}
+
+void TerrainState::drop_redundant_player_squares() {
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    base::maybe<PlayerTerrain>& player_terrain =
+        o_.player_terrain[nation];
+    if( !player_terrain.has_value() ) continue;
+    Matrix<base::maybe<FogSquare>>& map = player_terrain->map;
+    if( map.size() != o_.world_map.size() ) continue;
+    for( Rect const r : gfx::subrect_range( map.rect() ) ) {
+      Coord const             tile       = r.upper_left();
+      base::maybe<FogSquare>& fog_square = map[tile];
+      if( !fog_square.has_value() ) continue;
+      base::maybe<MapSquare>& copy = fog_square->square;
+      if( copy.has_value() && *copy == o_.world_map[tile] )
+        copy.reset();
+    }
+  }
+}
+
+void TerrainState::reinitialize_player_terrain_after_resize() {
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    base::maybe<PlayerTerrain> const& player_terrain =
+        o_.player_terrain[nation];
+    if( !player_terrain.has_value() ) continue;
+    if( player_terrain->map.size() == o_.world_map.size() )
+      continue;
+    bool fully_explored = true;
+    for( base::maybe<FogSquare> const& fog_square :
+         player_terrain->map.data() )
+      fully_explored &= fog_square.has_value();
+    initialize_player_terrain( nation, fully_explored );
+  }
+}
+
 Delta TerrainState::world_size_tiles() const {
   return o_.world_map.size();
 }
@@ -84,7 +170,8 @@ bool TerrainState::square_exists( Coord coord ) const {
 base::maybe<MapSquare&> TerrainState::mutable_maybe_square_at(
     Coord coord ) {
   if( !square_exists( coord ) ) return base::nothing;
-  return mutable_world_map()[coord.y][coord.x];
+  snapshot_player_squares( coord );
+  return o_.world_map[coord.y][coord.x];
 }
 
 base::maybe<PlayerTerrain const&> TerrainState::player_terrain(
@@ -162,13 +249,11 @@ void TerrainState::initialize_player_terrain( e_nation nation,
       o_.player_terrain[nation]->map;
   map = Matrix<base::maybe<FogSquare>>( o_.world_map.size() );
   if( visible ) {
-    Matrix<MapSquare> const& world_map = o_.world_map;
+    // An empty fog square refers to the real map square, so
+    // there is nothing to copy here.
     for( Rect const tile :
-         gfx::subrects( o_.world_map.rect() ) ) {
+         gfx::subrect_range( o_.world_map.rect() ) )
       map[tile.upper_left()].emplace();
-      map[tile.upper_left()]->square =
-          world_map[tile.upper_left()];
-    }
   }
 }
 
@@ -240,13 +325,23 @@ LUA_STARTUP( lua::state& st ) {
     u["set_placement_seed"] = &U::set_placement_seed;
     u["size"]               = &U::world_size_tiles;
     u["square_exists"]      = &U::square_exists;
-    u["square_at"]          = &U::mutable_square_at;
     u["proto_square"]       = &U::mutable_proto_square;
+    // Lua has no const references, so this hands out a mutable
+    // one, but it is meant for reading only; it does not give
+    // the players' fog copies a chance to snapshot the square.
+    u["square_at"] = []( U const& o, Coord tile ) -> MapSquare& {
+      return const_cast<MapSquare&>( o.square_at( tile ) );
+    };
+    // Use this to change a square. Callers should be running in-
+    // side the map updater (e.g. map generation) so that redun-
+    // dant fog copies get dropped afterwards.
+    u["mutable_square_at"] = &U::mutable_square_at;
     u["initialize_player_terrain"] =
         &U::initialize_player_terrain;
 
     u["reset"] = []( U& o, Delta size ) {
       o.mutable_world_map() = Matrix<MapSquare>( size );
+      o.reinitialize_player_terrain_after_resize();
     };
   }();
 };
@@ -61,6 +61,22 @@ struct TerrainState {
   void initialize_player_terrain( e_nation nation,
                                   bool     visible );
 
+  // To be called after the size of the world map has been
+  // changed: the existing player maps no longer line up with it,
+  // so each is re-initialized. A player map that was fully ex-
+  // plored stays fully visible, otherwise it becomes non-visible
+  // since there is no way to carry its contents over.
+  void reinitialize_player_terrain_after_resize();
+
+  // For each player, if their copy of the square is the same as
+  // the real square then it is dropped so that they go back to
+  // referring to the real one (see FogSquare). The map updater
+  // calls this after a change, since the mutable accessors below
+  // will have made copies for all players that can't see the
+  // square.
+  void drop_redundant_player_squares( Coord tile );
+  void drop_redundant_player_squares();
+
   // This essentially returns what square_at does, except it also
   // returns valid values for any squares outside of the map, in
   // which case it will return the "proto" squares specified in
@@ -90,6 +106,12 @@ struct TerrainState {
   // the map gets redrawn accordingly. If you don't want to
   // redraw a map (e.g. you are in unit tests) then just use the
   // non-rendering map updater.
+  //
+  // Since the returned reference might be written through, any
+  // player whose view of a square refers to the real square gets
+  // a copy of it first (the whole map for mutable_world_map), so
+  // that a change made without the map updater can't leak into a
+  // player's view of a tile they can't see.
   Matrix<MapSquare>&      mutable_world_map();
   MapSquare&              mutable_square_at( Coord coord );
   base::maybe<MapSquare&> mutable_maybe_square_at( Coord coord );
@@ -104,6 +126,9 @@ struct TerrainState {
   base::valid_or<std::string> validate() const;
   void                        validate_or_die() const;
 
+  void snapshot_player_squares( Coord tile );
+  void snapshot_player_squares();
+
   // ----- Serializable state.
   wrapped::TerrainState o_;
 
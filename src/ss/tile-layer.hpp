@@ -0,0 +1,124 @@
+/****************************************************************
+**tile-layer.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Dense per-tile index over map squares.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// ss
+#include "ss/matrix.hpp"
+
+// gfx
+#include "gfx/coord.hpp"
+
+// C++ standard library
+#include <algorithm>
+
+namespace rn {
+
+// Holds a small record for each map square, for use as a tran-
+// sient index from tile to entity (e.g. which colony is on a
+// tile) where we would otherwise use a hash map keyed on Coord.
+// Looking up a tile is then just an index into a flat array,
+// which matters for code that scans many tiles (rendering, the
+// minimap, land-view, production).
+//
+// The game state objects that hold these layers don't know the
+// size of the map, so the layer grows to cover whatever tiles
+// are written to it. Tiles that have never been written, in-
+// cluding any that are off of the map, hold a default-construc-
+// ted T, which should therefore mean "nothing here."
+template<typename T>
+class TileLayer {
+ public:
+  TileLayer() = default;
+
+  // Makes a layer of the given size up front, e.g. when rebuild-
+  // ing it from scratch and all of the tiles are known.
+  explicit TileLayer( Delta size ) : m_( size ) {}
+
+  // Two layers are equal if they hold the same records, regard-
+  // less of how far they have each grown.
+  bool operator==( TileLayer const& rhs ) const {
+    Delta const sz{
+        .w = std::max( size().w, rhs.size().w ),
+        .h = std::max( size().h, rhs.size().h ) };
+    for( int y = 0; y < sz.h; ++y )
+      for( int x = 0; x < sz.w; ++x )
+        if( ( *this )[Coord{ .x = x, .y = y }] !=
+            rhs[Coord{ .x = x, .y = y }] )
+          return false;
+    return true;
+  }
+
+  T const& operator[]( Coord coord ) const {
+    if( !contains( coord ) ) return kEmpty;
+    return m_[coord];
+  }
+
+  // Grows the layer if needed to include the tile.
+  T& mutable_at( Coord coord ) {
+    if( !contains( coord ) ) grow_to_contain( coord );
+    return m_[coord];
+  }
+
+  // Sets the tile back to the default value. Never shrinks the
+  // layer.
+  void reset( Coord coord ) {
+    if( contains( coord ) ) m_[coord] = T{};
+  }
+
+  void clear() { m_.clear(); }
+
+  Delta size() const { return m_.size(); }
+
+  // Number of tiles whose records satisfy the predicate. This
+  // visits every tile so it is meant for validation.
+  template<typename Pred>
+  int count_if( Pred&& pred ) const {
+    return int( std::count_if( m_.data().begin(),
+                               m_.data().end(), pred ) );
+  }
+
+ private:
+  bool contains( Coord coord ) const {
+    Delta const sz = m_.size();
+    return coord.x >= 0 && coord.y >= 0 && coord.x < sz.w &&
+           coord.y < sz.h;
+  }
+
+  // Grows by at least half each time so that filling a layer
+  // one tile at a time (as the map generator does) doesn't do a
+  // quadratic amount of copying.
+  void grow_to_contain( Coord coord ) {
+    CHECK( coord.x >= 0 && coord.y >= 0,
+           "tile layer coordinates must be non-negative: {}",
+           coord );
+    Delta const old_size = m_.size();
+    auto        grown    = []( int curr, int needed ) {
+      if( needed <= curr ) return curr;
+      return std::max( needed, curr + curr / 2 );
+    };
+    Delta const new_size{ .w = grown( old_size.w, coord.x + 1 ),
+                          .h = grown( old_size.h, coord.y + 1 ) };
+    Matrix<T> m( new_size );
+    for( int y = 0; y < old_size.h; ++y )
+      for( int x = 0; x < old_size.w; ++x )
+        m[Coord{ .x = x, .y = y }] =
+            std::move( m_[Coord{ .x = x, .y = y }] );
+    m_ = std::move( m );
+  }
+
+  static inline T const kEmpty{};
+
+  Matrix<T> m_;
+};
+
+} // namespace rn
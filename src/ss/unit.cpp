@@ -134,7 +134,9 @@ void Unit::change_nation( UnitsState& units_state,
     units_state.unit_for( u.id ).change_nation( units_state,
                                                 nation );
 
-  o_.nation = nation;
+  e_nation const old_nation = o_.nation;
+  o_.nation                 = nation;
+  units_state.on_nation_changed( o_.id, old_nation );
 }
 
 void Unit::change_type( Player const&   player,
@@ -28,6 +28,9 @@
 #include "base/keyval.hpp"
 #include "base/to-str-ext-std.hpp"
 
+// C++ standard library
+#include <algorithm>
+
 using namespace std;
 
 namespace rn {
@@ -46,6 +49,18 @@ valid_or<generic_err> check_harbor_state_invariants(
   return base::valid;
 }
 
+void insert_sorted( vector<UnitId>& ids, UnitId id ) {
+  auto it = lower_bound( ids.begin(), ids.end(), id );
+  CHECK( it == ids.end() || *it != id );
+  ids.insert( it, id );
+}
+
+void erase_sorted( vector<UnitId>& ids, UnitId id ) {
+  auto it = lower_bound( ids.begin(), ids.end(), id );
+  CHECK( it != ids.end() && *it == id );
+  ids.erase( it );
+}
+
 } // namespace
 
 /****************************************************************
@@ -95,6 +110,29 @@ valid_or<std::string> UnitsState::validate() const {
     }
   }
 
+  // Per-nation index matches.
+  int num_indexed = 0;
+  for( auto const& [nation, ids] : euro_units_for_nation_ ) {
+    REFL_VALIDATE( is_sorted( ids.begin(), ids.end() ),
+                   "unit index for {} is not sorted.", nation );
+    for( UnitId const id : ids ) {
+      auto it = euro_units_.find( id );
+      REFL_VALIDATE( it != euro_units_.end(),
+                     "unit index for {} has nonexistent unit {}.",
+                     nation, id );
+      e_nation const actual = it->second->unit.nation();
+      REFL_VALIDATE( actual == nation,
+                     "unit {} is in the index for {} but it "
+                     "belongs to {}.",
+                     id, nation, actual );
+    }
+    num_indexed += ids.size();
+  }
+  REFL_VALIDATE( num_indexed == int( euro_units_.size() ),
+                 "unit index has {} units but there are {} "
+                 "european units.",
+                 num_indexed, euro_units_.size() );
+
   return base::valid;
 }
 
@@ -170,6 +208,8 @@ UnitsState::UnitsState( wrapped::UnitsState&& o )
       case UnitState::e::euro: {
         auto& o = unit_state.get<UnitState::euro>();
         euro_units_[UnitId{ to_underlying( id ) }] = &o.state;
+        euro_units_for_nation_[o.state.unit.nation()].push_back(
+            UnitId{ to_underlying( id ) } );
         break;
       }
       case UnitState::e::native: {
@@ -180,6 +220,8 @@ UnitsState::UnitsState( wrapped::UnitsState&& o )
       }
     }
   }
+  for( auto& [nation, ids] : euro_units_for_nation_ )
+    sort( ids.begin(), ids.end() );
 }
 
 UnitsState::UnitsState()
@@ -233,6 +275,23 @@ UnitsState::native_all() const {
   return native_units_;
 }
 
+span<UnitId const> UnitsState::euro_units_for_nation(
+    e_nation nation ) const {
+  return euro_units_for_nation_[nation];
+}
+
+void UnitsState::on_nation_changed( UnitId   id,
+                                    e_nation old_nation ) {
+  // The unit might not be in this UnitsState, e.g. if it was
+  // created standalone in a unit test.
+  auto it = euro_units_.find( id );
+  if( it == euro_units_.end() ) return;
+  e_nation const new_nation = it->second->unit.nation();
+  if( new_nation == old_nation ) return;
+  erase_sorted( euro_units_for_nation_[old_nation], id );
+  insert_sorted( euro_units_for_nation_[new_nation], id );
+}
+
 UnitState_t const& UnitsState::state_of(
     GenericUnitId id ) const {
   CHECK( !deleted_.contains( id ),
@@ -615,8 +674,12 @@ UnitId UnitsState::add_unit( Unit&& unit ) {
   o_.units[id] = UnitState::euro{
       .state = { .unit      = std::move( unit ),
                  .ownership = UnitOwnership::free{} } };
-  euro_units_[unit_id] =
-      &o_.units[id].get<UnitState::euro>().state;
+  EuroUnitState const& state =
+      o_.units[id].get<UnitState::euro>().state;
+  euro_units_[unit_id] = &state;
+  // Ids are increasing, so this will normally be an append.
+  insert_sorted( euro_units_for_nation_[state.unit.nation()],
+                 unit_id );
   return unit_id;
 }
 
@@ -661,6 +724,7 @@ void UnitsState::destroy_unit( UnitId unit_id ) {
   for( UnitId to_destroy : cargo_units_to_destroy )
     destroy_unit( to_destroy );
   disown_unit( unit_id );
+  erase_sorted( euro_units_for_nation_[unit.nation()], unit_id );
 
   o_.units.erase( id );
   euro_units_.erase( unit_id );
@@ -25,9 +25,14 @@
 // luapp
 #include "luapp/ext-userdata.hpp"
 
+// refl
+#include "refl/enum-map.hpp"
+
 // C++ standard library
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace rn {
 
@@ -62,6 +67,13 @@ struct UnitsState {
   std::unordered_map<NativeUnitId, NativeUnitState const*> const&
   native_all() const;
 
+  // All European units belonging to the nation, sorted by id.
+  // This is a view into an index that is updated as units are
+  // added, destroyed, or change nations, so don't hold on to it
+  // across any of those.
+  std::span<UnitId const> euro_units_for_nation(
+      e_nation nation ) const;
+
   // Is this a European or native unit.
   e_unit_kind unit_kind( GenericUnitId id ) const;
 
@@ -212,6 +224,11 @@ struct UnitsState {
   UnitOwnership_t&       ownership_of( UnitId id );
   NativeUnitOwnership_t& ownership_of( NativeUnitId id );
 
+  // Called by Unit::change_nation after the nation has been
+  // changed so that the per-nation index can be updated.
+  friend struct Unit;
+  void on_nation_changed( UnitId id, e_nation old_nation );
+
   valid_or<std::string> validate() const;
   void                  validate_or_die() const;
 
@@ -249,6 +266,10 @@ struct UnitsState {
   std::unordered_map<UnitId, EuroUnitState const*> euro_units_;
   std::unordered_map<NativeUnitId, NativeUnitState const*>
       native_units_;
+
+  // European units by nation, each sorted by id.
+  refl::enum_map<e_nation, std::vector<UnitId>>
+      euro_units_for_nation_;
 };
 
 } // namespace rn
@@ -0,0 +1,186 @@
+/****************************************************************
+**task-graph.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Runs a graph of dependent tasks concurrently.
+*
+*****************************************************************/
+#include "task-graph.hpp"
+
+// Revolution Now
+#include "error.hpp"
+
+// C++ standard library
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+// All of the mutable state of a run. Everything here is guarded
+// by the mutex.
+struct Scheduler {
+  // If all_on_main is true then the tasks' thread affinities
+  // will be ignored and they will all be run on the main thread.
+  Scheduler( vector<TaskGraphNode> const& nodes,
+             bool                         all_on_main )
+    : nodes_( nodes ),
+      all_on_main_( all_on_main ),
+      start_( Clock::now() ),
+      remaining_deps_( nodes.size() ),
+      dependents_( nodes.size() ) {
+    for( int i = 0; i < int( nodes.size() ); ++i ) {
+      remaining_deps_[i] = int( nodes[i].deps.size() );
+      for( int dep : nodes[i].deps ) {
+        CHECK( dep >= 0 && dep < int( nodes.size() ),
+               "task dependency out of range: {}", dep );
+        dependents_[dep].push_back( i );
+      }
+      if( remaining_deps_[i] == 0 ) make_ready( i );
+    }
+  }
+
+  // Runs tasks from the given queue until there is nothing left
+  // for this thread to do.
+  void run_loop( bool main_thread ) {
+    deque<int>& queue =
+        main_thread ? main_ready_ : worker_ready_;
+    unique_lock lock( mutex_ );
+    while( true ) {
+      cv_.wait( lock, [&] {
+        return !queue.empty() || finished() || eptr_ ||
+               stalled();
+      } );
+      if( finished() || eptr_ || stalled() ) break;
+      int const node = queue.front();
+      queue.pop_front();
+      ++running_;
+      lock.unlock();
+      TaskTiming timing{ .node           = node,
+                         .start          = elapsed(),
+                         .on_main_thread = main_thread };
+      exception_ptr eptr;
+      try {
+        nodes_[node].run();
+      } catch( ... ) { eptr = current_exception(); }
+      timing.end = elapsed();
+      lock.lock();
+      --running_;
+      if( eptr ) {
+        if( !eptr_ ) eptr_ = eptr;
+      } else {
+        on_finished( timing );
+      }
+      cv_.notify_all();
+    }
+  }
+
+  exception_ptr exception() const { return eptr_; }
+
+  vector<TaskTiming> const& timings() const { return timings_; }
+
+ private:
+  chrono::microseconds elapsed() const {
+    return chrono::duration_cast<chrono::microseconds>(
+        Clock::now() - start_ );
+  }
+
+  bool finished() const {
+    return int( timings_.size() ) == int( nodes_.size() );
+  }
+
+  // Nothing is running and nothing can be started, which means
+  // that there is a cycle.
+  bool stalled() const {
+    return main_ready_.empty() && worker_ready_.empty() &&
+           running_ == 0 && !finished();
+  }
+
+  void make_ready( int node ) {
+    bool const main = all_on_main_ || nodes_[node].main_thread;
+    ( main ? main_ready_ : worker_ready_ ).push_back( node );
+  }
+
+  void on_finished( TaskTiming const& timing ) {
+    timings_.push_back( timing );
+    for( int dependent : dependents_[timing.node] )
+      if( --remaining_deps_[dependent] == 0 )
+        make_ready( dependent );
+  }
+
+  vector<TaskGraphNode> const& nodes_;
+  bool const                   all_on_main_;
+  Clock::time_point const      start_;
+
+  mutex              mutex_;
+  condition_variable cv_;
+
+  vector<int>         remaining_deps_;
+  vector<vector<int>> dependents_;
+  deque<int>          main_ready_;
+  deque<int>          worker_ready_;
+  int                 running_ = 0;
+  exception_ptr       eptr_;
+  vector<TaskTiming>  timings_;
+};
+
+} // namespace
+
+vector<TaskTiming> run_task_graph(
+    vector<TaskGraphNode> const& nodes, int num_workers ) {
+  Scheduler scheduler( nodes,
+                       /*all_on_main=*/num_workers <= 0 );
+  vector<jthread> workers;
+  for( int i = 0; i < num_workers; ++i )
+    workers.emplace_back(
+        [&] { scheduler.run_loop( /*main_thread=*/false ); } );
+  scheduler.run_loop( /*main_thread=*/true );
+  // Waits for any tasks that are still running (which can only
+  // happen if one threw).
+  workers.clear();
+  if( scheduler.exception() )
+    rethrow_exception( scheduler.exception() );
+  // If the loop ended without an exception then everything must
+  // have run, otherwise there is a cycle.
+  CHECK( scheduler.timings().size() == nodes.size(),
+         "task graph has a cycle" );
+  return scheduler.timings();
+}
+
+vector<int> task_graph_critical_path(
+    vector<TaskGraphNode> const& nodes,
+    vector<TaskTiming> const&    timings ) {
+  vector<int> res;
+  if( timings.empty() ) return res;
+  vector<TaskTiming const*> by_node( nodes.size() );
+  for( TaskTiming const& timing : timings )
+    by_node[timing.node] = &timing;
+  TaskTiming const* curr = &timings.back();
+  while( curr != nullptr ) {
+    res.push_back( curr->node );
+    TaskTiming const* prev = nullptr;
+    for( int dep : nodes[curr->node].deps ) {
+      TaskTiming const* candidate = by_node[dep];
+      if( candidate == nullptr ) continue;
+      if( prev == nullptr || candidate->end > prev->end )
+        prev = candidate;
+    }
+    curr = prev;
+  }
+  reverse( res.begin(), res.end() );
+  return res;
+}
+
+} // namespace rn
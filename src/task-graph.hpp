@@ -0,0 +1,66 @@
+/****************************************************************
+**task-graph.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Runs a graph of dependent tasks concurrently.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// C++ standard library
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace rn {
+
+struct TaskGraphNode {
+  std::function<void()> run;
+
+  // Indices of nodes that must finish before this one starts.
+  std::vector<int> deps;
+
+  // Some tasks (e.g. those that touch SDL video or the OpenGL
+  // context) must run on the thread that calls run_task_graph.
+  bool main_thread = true;
+};
+
+// The start and end times are relative to the start of the run.
+struct TaskTiming {
+  int                       node           = 0;
+  std::chrono::microseconds start          = {};
+  std::chrono::microseconds end            = {};
+  bool                      on_main_thread = false;
+};
+
+// Runs each task once all of its dependencies have finished.
+// Tasks with main_thread=false are run on up to `num_workers`
+// worker threads (which only live for the duration of the call)
+// so that independent tasks can overlap; the others are run on
+// the calling thread. If num_workers is zero then everything
+// runs on the calling thread, in which case the tasks will run
+// in a valid topological order, though which one is unspecified.
+//
+// The graph must be acyclic and the dependencies in range. If a
+// task throws then no further tasks will be started, and the
+// first exception will be rethrown once the running ones have
+// finished. Returns the timings in the order that the tasks
+// finished, which only includes tasks that finished success-
+// fully.
+std::vector<TaskTiming> run_task_graph(
+    std::vector<TaskGraphNode> const& nodes, int num_workers );
+
+// Given the timings of a completed run, returns the chain of
+// tasks leading to the one that finished last, where each task
+// is preceded by the dependency that finished last. This is the
+// sequence that bounds the total time.
+std::vector<int> task_graph_critical_path(
+    std::vector<TaskGraphNode> const& nodes,
+    std::vector<TaskTiming> const&    timings );
+
+} // namespace rn
@@ -69,7 +69,7 @@ maybe<CommodityInColony> find_what_to_boycott(
   refl::enum_map<e_commodity, /*bid=*/int> prices;
   for( auto& [comm, bid] : prices )
     bid = market_price( player, comm ).bid;
-  vector<ColonyId> const player_colonies =
+  span<ColonyId const> const player_colonies =
       ss.colonies.for_nation( player.nation );
   maybe<CommodityInColony> res;
   int                      largest_value = 0;
@@ -30,6 +30,7 @@
 #include "base-util/string.hpp"
 
 // C++ standard library
+#include <cstring>
 #include <unordered_map>
 
 using namespace std;
@@ -43,7 +44,13 @@ namespace rl = ::base::rl;
 using ::base::function_ref;
 using ::lua::lua_valid;
 
-size_t constexpr max_scrollback_lines = 10000;
+uint64_t constexpr kArenaSize =
+    uint64_t( Terminal::kArenaChunkSize ) *
+    Terminal::kArenaChunks;
+
+uint64_t constexpr kStampWriting = 1;
+
+uint64_t stamp_for_line( uint64_t n ) { return 2 * ( n + 1 ); }
 
 unordered_map<string,
               function_ref<void( Terminal& ) const>> const
@@ -138,27 +145,47 @@ void Terminal::push_history( std::string const& what ) {
 /****************************************************************
 ** Terminal Log
 *****************************************************************/
-// NOTE: this function should only be called while holding the
-// g_muffer_mutex.
-void Terminal::trim() {
-  if( buffer_.size() > max_scrollback_lines )
-    buffer_ = vector<string>(
-        buffer_.begin() + max_scrollback_lines / 2,
-        buffer_.end() );
+uint64_t Terminal::reserve_arena( uint64_t const size ) {
+  uint64_t const chunk = kArenaChunkSize;
+  CHECK_LE( size, chunk );
+  uint64_t pos = arena_pos_.load( memory_order_relaxed );
+  while( true ) {
+    uint64_t start = pos;
+    // If it won't fit in the rest of this chunk then skip to the
+    // start of the next one.
+    if( start % chunk + size > chunk )
+      start = ( start / chunk + 1 ) * chunk;
+    if( arena_pos_.compare_exchange_weak(
+            pos, start + size, memory_order_relaxed ) )
+      return start;
+  }
 }
 
 /****************************************************************
 ** Public API
 *****************************************************************/
 void Terminal::clear() {
-  lock_guard<mutex> lock( buffer_mutex_ );
-  buffer_.clear();
+  first_line_.store( next_line_.load( memory_order_acquire ),
+                     memory_order_release );
 }
 
 void Terminal::log( string_view msg ) {
-  lock_guard<mutex> lock( buffer_mutex_ );
-  buffer_.push_back( string( msg ) );
-  trim();
+  if( msg.size() > size_t( kMaxLineLength ) )
+    msg = msg.substr( 0, kMaxLineLength );
+  uint64_t const n =
+      next_line_.fetch_add( 1, memory_order_relaxed );
+  uint64_t const offset = reserve_arena( msg.size() );
+  if( !msg.empty() )
+    memcpy( &arena_[offset % kArenaSize], msg.data(),
+            msg.size() );
+  LineRecord& record = lines_[n % kMaxScrollbackLines];
+  record.stamp.store( kStampWriting, memory_order_relaxed );
+  atomic_thread_fence( memory_order_release );
+  record.offset.store( offset, memory_order_relaxed );
+  record.size.store( uint32_t( msg.size() ),
+                     memory_order_relaxed );
+  record.stamp.store( stamp_for_line( n ),
+                      memory_order_release );
 }
 
 lua_valid Terminal::run_cmd( string const& cmd ) {
@@ -167,11 +194,32 @@ lua_valid Terminal::run_cmd( string const& cmd ) {
   return valid;
 }
 
-maybe<string const&> Terminal::line( int idx ) {
-  lock_guard<mutex> lock( buffer_mutex_ );
-  if( idx < int( buffer_.size() ) )
-    return buffer_[buffer_.size() - 1 - idx];
-  return nothing;
+maybe<string> Terminal::line( int idx ) const {
+  uint64_t const total = next_line_.load( memory_order_acquire );
+  uint64_t       first = first_line_.load( memory_order_acquire );
+  if( total > uint64_t( kMaxScrollbackLines ) )
+    first = std::max( first, total - kMaxScrollbackLines );
+  if( idx < 0 || first + idx >= total ) return nothing;
+  uint64_t const    n        = total - 1 - idx;
+  uint64_t const    expected = stamp_for_line( n );
+  LineRecord const& record   = lines_[n % kMaxScrollbackLines];
+  // Still being written.
+  if( record.stamp.load( memory_order_acquire ) != expected )
+    return string{};
+  uint64_t const offset =
+      record.offset.load( memory_order_relaxed );
+  uint32_t const size = record.size.load( memory_order_relaxed );
+  string         res( &arena_[offset % kArenaSize], size );
+  atomic_thread_fence( memory_order_acquire );
+  if( record.stamp.load( memory_order_relaxed ) != expected )
+    return string{};
+  // If the arena has since wrapped around past this line then
+  // its text may have been overwritten, in which case the same
+  // is true of all older lines.
+  if( arena_pos_.load( memory_order_acquire ) - offset >
+      kArenaSize )
+    return nothing;
+  return res;
 }
 
 maybe<string const&> Terminal::history( int idx ) {
@@ -405,7 +453,10 @@ vector<string> Terminal::autocomplete_iterative(
   return res;
 }
 
-Terminal::Terminal( lua::state& st ) : st_( st ) {}
+Terminal::Terminal( lua::state& st )
+  : st_( st ),
+    lines_( new LineRecord[kMaxScrollbackLines] ),
+    arena_( new char[kArenaSize] ) {}
 
 Terminal::~Terminal() {}
 
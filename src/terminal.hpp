@@ -17,7 +17,9 @@
 #include "maybe.hpp"
 
 // C++ standard library
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -32,7 +34,8 @@ struct Terminal {
   Terminal( lua::state& st );
   ~Terminal();
 
-  // This function is thread safe.
+  // This function is thread safe and lock free. Lines longer
+  // than kMaxLineLength will be truncated.
   void log( std::string_view msg );
 
   valid_or<std::string> run_cmd( std::string const& cmd );
@@ -40,8 +43,12 @@ struct Terminal {
   // This function is thread safe.
   void clear();
 
-  // idx zero is most recent. This function is thread safe.
-  maybe<std::string const&> line( int idx );
+  // idx zero is most recent. This function is thread safe and
+  // lock free. It returns a copy because the storage for the
+  // line can be reused at any time by other threads that are
+  // logging. If a line is in the middle of being written then
+  // this will return an empty string for it.
+  maybe<std::string> line( int idx ) const;
 
   // idx zero is most recent.
   maybe<std::string const&> history( int idx );
@@ -62,16 +69,52 @@ struct Terminal {
 
   lua::state& lua_state() { return st_; }
 
+  // Only this many of the most recent lines are kept.
+  static constexpr int kMaxScrollbackLines = 16384;
+
+  // The text of the lines is stored in an arena made up of
+  // chunks of this size, and a line's text never straddles two
+  // chunks.
+  static constexpr int kArenaChunkSize = 16384;
+  static constexpr int kArenaChunks    = 128;
+
+  static constexpr int kMaxLineLength = kArenaChunkSize;
+
  private:
-  void trim();
+  // The log can be written to by any thread (via the logging
+  // framework) and read on the main thread each frame, so it
+  // is stored in a way that does not require taking a lock in
+  // either case. Line records live in a fixed-capacity ring,
+  // and the text that they refer to lives in a ring of chunks
+  // (the arena). Writers claim a line number and a range of the
+  // arena with atomic increments, then publish the record using
+  // its stamp as a sequence lock. Readers verify the stamp (and
+  // that the arena range has not since been reused) after
+  // copying a line out.
+  struct LineRecord {
+    // Zero if never written, odd while being written, otherwise
+    // 2*(n+1) where n is the line number held.
+    std::atomic<uint64_t> stamp  = 0;
+    // Position in the arena, not wrapped.
+    std::atomic<uint64_t> offset = 0;
+    std::atomic<uint32_t> size   = 0;
+  };
+
+  // Returns the (unwrapped) position in the arena at which `size`
+  // bytes can be written.
+  uint64_t reserve_arena( uint64_t size );
 
   lua::state&              st_;
   std::vector<std::string> history_;
-  // The g_buffer MUST ONLY be accessed while holding the below
-  // mutex because it can be modified by multiple threads by way
-  // of the logging framework.
-  std::mutex               buffer_mutex_;
-  std::vector<std::string> buffer_;
+
+  std::unique_ptr<LineRecord[]> lines_;
+  std::unique_ptr<char[]>       arena_;
+  // Number of lines ever logged.
+  std::atomic<uint64_t> next_line_ = 0;
+  // Total number of bytes ever reserved in the arena.
+  std::atomic<uint64_t> arena_pos_ = 0;
+  // Lines numbered below this have been cleared.
+  std::atomic<uint64_t> first_line_ = 0;
 };
 
 } // namespace rn
@@ -17,6 +17,7 @@
 #include "maybe.hpp"
 
 // base
+#include "base/hash.hpp"
 #include "base/range-lite.hpp"
 #include "base/string.hpp"
 
@@ -24,6 +25,11 @@
 #include "base-util/algo.hpp"
 #include "base-util/string.hpp"
 
+// C++ standard library
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 using namespace std;
 
 namespace rn {
@@ -31,6 +37,12 @@ namespace {
 
 namespace rl = ::base::rl;
 
+/****************************************************************
+** Constants
+*****************************************************************/
+// Enough to hold all of the text on even a busy screen.
+constexpr int kDefaultLayoutCacheCapacity = 256;
+
 /****************************************************************
 ** Markup Parsing
 *****************************************************************/
@@ -74,10 +86,6 @@ namespace rl = ::base::rl;
  * }
  */
 
-struct MarkupStyle {
-  bool highlight{ false };
-  bool shadow{ false };
-};
 NOTHROW_MOVE( MarkupStyle );
 
 struct MarkedUpText {
@@ -146,39 +154,40 @@ void render_impl( rr::Typer& typer, gfx::pixel color,
   typer.write( text );
 }
 
-void render_markup( rr::Typer& typer, MarkedUpText const& mk,
+void render_markup( rr::Typer& typer, string_view text,
+                    MarkupStyle const&    style,
                     TextMarkupInfo const& info ) {
-  if( mk.style.highlight ) {
-    render_impl( typer, info.highlight, mk.text );
+  if( style.highlight ) {
+    render_impl( typer, info.highlight, text );
     return;
   }
 
-  if( mk.style.shadow ) {
+  if( style.shadow ) {
     {
       rr::Typer typer_shadow =
           typer.with_frame_offset( gfx::size{ .w = 1, .h = 0 } );
       render_impl( typer_shadow, info.shadowed_shadow_color,
-                   mk.text );
+                   text );
     }
     {
       rr::Typer typer_shadow =
           typer.with_frame_offset( gfx::size{ .w = 0, .h = 1 } );
       render_impl( typer_shadow, info.shadowed_shadow_color,
-                   mk.text );
+                   text );
     }
     {
       rr::Typer typer_shadow =
           typer.with_frame_offset( gfx::size{ .w = 1, .h = 1 } );
       render_impl( typer_shadow, info.shadowed_shadow_color,
-                   mk.text );
+                   text );
     }
-    render_impl( typer, info.shadowed_text_color, mk.text );
+    render_impl( typer, info.shadowed_text_color, text );
     return;
   }
 
   // Here we assume now special style info, just do default ren-
   // dering.
-  return render_impl( typer, info.normal, mk.text );
+  return render_impl( typer, info.normal, text );
 }
 
 void render_line( rr::Typer& typer, gfx::pixel fg,
@@ -186,14 +195,6 @@ void render_line( rr::Typer& typer, gfx::pixel fg,
   return render_impl( typer, fg, text );
 }
 
-void render_line_markup( rr::Typer&                  typer,
-                         vector<MarkedUpText> const& mks,
-                         TextMarkupInfo const&       info ) {
-  for( MarkedUpText const& mut : mks )
-    if( !mut.text.empty() ) //
-      render_markup( typer, mut, info );
-}
-
 void render_lines( rr::Typer& typer, gfx::pixel fg,
                    vector<string> const& txt ) {
   for( string const& line : txt ) {
@@ -202,13 +203,33 @@ void render_lines( rr::Typer& typer, gfx::pixel fg,
   }
 }
 
-void render_lines_markup(
-    rr::Typer&                          typer,
-    vector<vector<MarkedUpText>> const& mk_text,
-    TextMarkupInfo const&               info ) {
-  for( vector<MarkedUpText> const& muts : mk_text ) {
-    render_line_markup( typer, muts, info );
-    render_impl( typer, gfx::pixel{}, "\n" );
+void render_layout( rr::Typer& typer, TextLayout const& layout,
+                    TextMarkupInfo const& info ) {
+  for( TextRun const& run : layout.runs ) {
+    rr::Typer run_typer = typer.with_frame_offset( run.offset );
+    render_markup( run_typer, run.text, run.style, info );
+  }
+}
+
+// Given the text broken into lines (and each line into marked up
+// segments) this will compute where each segment will go. This
+// must mirror the way that the Typer moves as it writes.
+TextLayout layout_lines( vector<vector<MarkedUpText>>&& lines,
+                         gfx::size char_size ) {
+  TextLayout res;
+  gfx::size  line_start;
+  for( vector<MarkedUpText>& muts : lines ) {
+    gfx::size pos = line_start;
+    for( MarkedUpText& mut : muts ) {
+      if( mut.text.empty() ) continue;
+      int const width = char_size.w * int( mut.text.size() );
+      res.runs.push_back( TextRun{ .offset = pos,
+                                   .style  = mut.style,
+                                   .text   = std::move( mut.text ) } );
+      pos.w += width;
+    }
+    line_start.h +=
+        char_size.h + rr::rendered_text_line_spacing_pixels();
     // If there was any shadowed text on this line then we need
     // to add one additional pixel (vertically) of space when
     // moving to the next line.
@@ -216,9 +237,9 @@ void render_lines_markup(
         muts.begin(), muts.end(), []( MarkedUpText const& mut ) {
           return mut.style.shadow;
         } );
-    if( has_shadow )
-      typer.move_frame_by( gfx::size{ .w = 0, .h = 1 } );
+    if( has_shadow ) ++line_start.h;
   }
+  return res;
 }
 
 // Will flatten the text onto one line, then wrap it to within
@@ -331,6 +352,62 @@ vector<vector<MarkedUpText>> text_markup_reflow_impl(
   return reflowed;
 }
 
+/****************************************************************
+** Layout Cache
+*****************************************************************/
+// There is no font in the key since all fonts currently render
+// with the same glyphs, so the only thing about the font that
+// affects the layout is its character size.
+struct LayoutKey {
+  // When the key is in the cache this points to the text owned
+  // by the cache entry.
+  string_view text      = {};
+  maybe<int>  max_cols  = {};
+  gfx::size   char_size = {};
+
+  bool operator==( LayoutKey const& ) const = default;
+};
+
+struct LayoutKeyHash {
+  size_t operator()( LayoutKey const& key ) const {
+    size_t seed = hash<string_view>{}( key.text );
+    base::hash_combine( seed, key.max_cols.value_or( -1 ) );
+    base::hash_combine( seed, key.char_size.w );
+    base::hash_combine( seed, key.char_size.h );
+    return seed;
+  }
+};
+
+struct LayoutCacheEntry {
+  string                       text   = {};
+  LayoutKey                    key    = {};
+  shared_ptr<TextLayout const> layout = {};
+};
+
+struct LayoutCache {
+  // Most recently used first. The nodes of a list don't move,
+  // which allows the keys to refer to the text that they hold.
+  list<LayoutCacheEntry> entries;
+  unordered_map<LayoutKey, list<LayoutCacheEntry>::iterator,
+                LayoutKeyHash>
+                       index;
+  TextLayoutCacheStats stats{
+      .capacity = kDefaultLayoutCacheCapacity };
+
+  void evict_down_to( int size ) {
+    while( int( entries.size() ) > size ) {
+      index.erase( entries.back().key );
+      entries.pop_back();
+      ++stats.evictions;
+    }
+  }
+};
+
+LayoutCache& layout_cache() {
+  static LayoutCache cache;
+  return cache;
+}
+
 } // namespace
 
 /****************************************************************
@@ -340,10 +417,12 @@ void render_text_markup( rr::Renderer& renderer,
                          gfx::point where, e_font font,
                          TextMarkupInfo const& info,
                          std::string_view      text ) {
-  (void)font; // TODO
+  (void)font; // See LayoutKey.
   // The color will be set later.
   rr::Typer typer = renderer.typer( where, gfx::pixel{} );
-  render_lines_markup( typer, parse_text( text ), info );
+  shared_ptr<TextLayout const> const layout = cached_text_layout(
+      typer.scale(), /*max_cols=*/nothing, text );
+  render_layout( typer, *layout, info );
 }
 
 void render_text( rr::Renderer& renderer, gfx::point where,
@@ -364,12 +443,12 @@ void render_text_markup_reflow(
     rr::Renderer& renderer, gfx::point where, e_font font,
     TextMarkupInfo const& markup_info,
     TextReflowInfo const& reflow_info, string_view text ) {
-  (void)font; // TODO
-  vector<vector<MarkedUpText>> markedup_reflowed =
-      text_markup_reflow_impl( reflow_info, text );
+  (void)font; // See LayoutKey.
   // The color will be set later.
   rr::Typer typer = renderer.typer( where, gfx::pixel{} );
-  render_lines_markup( typer, markedup_reflowed, markup_info );
+  shared_ptr<TextLayout const> const layout = cached_text_layout(
+      typer.scale(), reflow_info.max_cols, text );
+  render_layout( typer, *layout, markup_info );
 }
 
 string remove_markup( string_view text ) {
@@ -425,4 +504,67 @@ Delta rendered_text_size_no_reflow( string_view text ) {
   return res;
 }
 
+TextLayout compute_text_layout( gfx::size   char_size,
+                                maybe<int>  max_cols,
+                                string_view text ) {
+  vector<vector<MarkedUpText>> lines =
+      max_cols.has_value()
+          ? text_markup_reflow_impl(
+                TextReflowInfo{ .max_cols = *max_cols }, text )
+          : parse_text( text );
+  return layout_lines( std::move( lines ), char_size );
+}
+
+shared_ptr<TextLayout const> cached_text_layout(
+    gfx::size char_size, maybe<int> max_cols,
+    string_view text ) {
+  LayoutCache&    cache = layout_cache();
+  LayoutKey const key{ .text      = text,
+                       .max_cols  = max_cols,
+                       .char_size = char_size };
+  if( auto it = cache.index.find( key );
+      it != cache.index.end() ) {
+    ++cache.stats.hits;
+    cache.entries.splice( cache.entries.begin(), cache.entries,
+                          it->second );
+    return it->second->layout;
+  }
+  ++cache.stats.misses;
+  // Copy the text before evicting anything in case it refers to
+  // the text of an entry that is about to be evicted.
+  string owned_text( text );
+  auto   layout = make_shared<TextLayout const>(
+      compute_text_layout( char_size, max_cols, text ) );
+  cache.evict_down_to( cache.stats.capacity - 1 );
+  LayoutCacheEntry& entry = cache.entries.emplace_front();
+  entry.text              = std::move( owned_text );
+  entry.key               = key;
+  entry.key.text          = entry.text;
+  entry.layout            = std::move( layout );
+  cache.index[entry.key]  = cache.entries.begin();
+  return entry.layout;
+}
+
+TextLayoutCacheStats text_layout_cache_stats() {
+  LayoutCache const&   cache = layout_cache();
+  TextLayoutCacheStats res   = cache.stats;
+  res.size                   = int( cache.entries.size() );
+  return res;
+}
+
+void set_text_layout_cache_capacity( int capacity ) {
+  CHECK_GE( capacity, 1 );
+  LayoutCache& cache   = layout_cache();
+  cache.stats.capacity = capacity;
+  cache.evict_down_to( capacity );
+}
+
+void clear_text_layout_cache() {
+  LayoutCache& cache = layout_cache();
+  cache.index.clear();
+  cache.entries.clear();
+  cache.stats =
+      TextLayoutCacheStats{ .capacity = cache.stats.capacity };
+}
+
 } // namespace rn
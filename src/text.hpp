@@ -15,6 +15,7 @@
 
 // Revolution Now
 #include "font.hpp"
+#include "maybe.hpp"
 
 // render
 #include "render/renderer.hpp"
@@ -24,7 +25,11 @@
 #include "gfx/pixel.hpp"
 
 // C++ standard library
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace rn {
 
@@ -81,4 +86,70 @@ Delta rendered_text_size( TextReflowInfo const& reflow_info,
 // Same as above but no reflow.  Will still account for markup.
 Delta rendered_text_size_no_reflow( std::string_view text );
 
+/****************************************************************
+** Text Layout
+*****************************************************************/
+// The two markup rendering functions above don't render the text
+// directly; they first lay it out, which involves parsing the
+// markup, reflowing (if requested), and computing where each run
+// of uniformly styled characters goes. That is the expensive
+// part and its result does not depend on where the text is ren-
+// dered or which colors are used, so it is cached.
+
+struct MarkupStyle {
+  bool highlight = false;
+  bool shadow    = false;
+
+  bool operator==( MarkupStyle const& ) const = default;
+};
+
+// A run of characters with the same style, all on one line.
+struct TextRun {
+  // Pixel offset of the first character from the upper left
+  // corner of the text.
+  gfx::size   offset = {};
+  MarkupStyle style  = {};
+  std::string text   = {};
+
+  bool operator==( TextRun const& ) const = default;
+};
+
+struct TextLayout {
+  std::vector<TextRun> runs = {};
+
+  bool operator==( TextLayout const& ) const = default;
+};
+
+// Computes the layout without consulting the cache. If max_cols
+// is nothing then the text will not be reflowed. `char_size` is
+// the pixel size of a character in the font.
+TextLayout compute_text_layout( gfx::size        char_size,
+                                maybe<int>       max_cols,
+                                std::string_view text );
+
+// Same as above but will return the layout from the cache if it
+// is there, otherwise will compute it and add it to the cache,
+// evicting the least recently used layout if the cache is full.
+// The layout is shared with the cache, so it stays valid after
+// it is evicted.
+std::shared_ptr<TextLayout const> cached_text_layout(
+    gfx::size char_size, maybe<int> max_cols,
+    std::string_view text );
+
+struct TextLayoutCacheStats {
+  int64_t hits      = 0;
+  int64_t misses    = 0;
+  int64_t evictions = 0;
+  int     size      = 0;
+  int     capacity  = 0;
+};
+
+TextLayoutCacheStats text_layout_cache_stats();
+
+// Evicts as needed. Must be at least one.
+void set_text_layout_cache_capacity( int capacity );
+
+// Removes all entries and resets the counters.
+void clear_text_layout_cache();
+
 } // namespace rn
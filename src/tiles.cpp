@@ -50,17 +50,7 @@ vector<int> cache;
 void init_sprites() {
   // FIXME: need to find a better way to get the renderer to gen-
   // erate the atlas ID cache.
-  rr::Renderer& renderer =
-      global_renderer_use_only_when_needed();
-  cache.resize( refl::enum_count<e_tile> );
-  auto& atlas_ids = renderer.atlas_ids();
-  int   i         = 0;
-  for( e_tile tile : refl::enum_values<e_tile> ) {
-    UNWRAP_CHECK( atlas_id,
-                  base::lookup( atlas_ids, refl::enum_value_name(
-                                               tile ) ) );
-    cache[i++] = atlas_id;
-  }
+  load_tile_atlas_ids( global_renderer_use_only_when_needed() );
 }
 
 void cleanup_sprites() { cache.clear(); }
@@ -75,6 +65,18 @@ REGISTER_INIT_ROUTINE( sprites );
 
 } // namespace
 
+void load_tile_atlas_ids( rr::Renderer const& renderer ) {
+  cache.resize( refl::enum_count<e_tile> );
+  auto& atlas_ids = renderer.atlas_ids();
+  int   i         = 0;
+  for( e_tile tile : refl::enum_values<e_tile> ) {
+    UNWRAP_CHECK( atlas_id,
+                  base::lookup( atlas_ids, refl::enum_value_name(
+                                               tile ) ) );
+    cache[i++] = atlas_id;
+  }
+}
+
 Delta sprite_size( e_tile tile ) {
   // FIXME: find a better way to do this. Maybe store it in the
   // renderer object.
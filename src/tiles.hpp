@@ -27,6 +27,10 @@
 // C++ standard library
 #include <string_view>
 
+namespace rr {
+struct Renderer;
+}
+
 namespace rn {
 
 /****************************************************************
@@ -41,6 +45,15 @@ inline constexpr SY    g_tile_height{ detail::tile_pixel_size };
 inline constexpr Delta g_tile_delta = Delta{
     .w = W{ 1 } * g_tile_width, .h = H{ 1 } * g_tile_height };
 
+/****************************************************************
+** Loading Tiles
+*****************************************************************/
+// Fills out the mapping from tile to atlas ID using the given
+// renderer. Normally this is done during initialization using
+// the global renderer, but it is exposed for the benchmarks,
+// which run without one.
+void load_tile_atlas_ids( rr::Renderer const& renderer );
+
 /****************************************************************
 ** Querying Tiles
 *****************************************************************/
@@ -0,0 +1,224 @@
+/****************************************************************
+**timer-wheel.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Hierarchical timing wheel.
+*
+*****************************************************************/
+#include "timer-wheel.hpp"
+
+// Revolution Now
+#include "error.hpp"
+
+using namespace std;
+
+namespace rn {
+
+/****************************************************************
+** TimerWheel
+*****************************************************************/
+TimerWheel::TimerWheel( uint64_t now, int resolution_bits )
+  : resolution_bits_( resolution_bits ),
+    now_( now ),
+    processed_slot_( slot_of( now ) ) {
+  CHECK_GE( resolution_bits, 0 );
+  CHECK_LT( resolution_bits, 32 );
+  heads_.fill( kNone );
+}
+
+int32_t TimerWheel::allocate() {
+  ++size_;
+  if( !free_.empty() ) {
+    int32_t const idx = free_.back();
+    free_.pop_back();
+    return idx;
+  }
+  nodes_.emplace_back();
+  // Start at one so that a default-constructed id is never
+  // valid.
+  nodes_.back().generation = 1;
+  return int32_t( nodes_.size() - 1 );
+}
+
+void TimerWheel::release( int32_t idx ) {
+  Node& node = nodes_[idx];
+  DCHECK( node.list == kNone );
+  node.func = {};
+  ++node.generation;
+  free_.push_back( idx );
+  --size_;
+}
+
+void TimerWheel::link( int32_t idx, int list ) {
+  Node& node = nodes_[idx];
+  DCHECK( node.list == kNone );
+  node.list = list;
+  node.prev = kNone;
+  node.next = heads_[list];
+  if( node.next != kNone ) nodes_[node.next].prev = idx;
+  heads_[list] = idx;
+}
+
+void TimerWheel::unlink( int32_t idx ) {
+  Node& node = nodes_[idx];
+  DCHECK( node.list != kNone );
+  if( node.prev != kNone )
+    nodes_[node.prev].next = node.next;
+  else
+    heads_[node.list] = node.next;
+  if( node.next != kNone ) nodes_[node.next].prev = node.prev;
+  node.list = kNone;
+  node.prev = kNone;
+  node.next = kNone;
+}
+
+void TimerWheel::place( int32_t idx ) {
+  // The next slot to be processed.
+  uint64_t const base = processed_slot_ + 1;
+  uint64_t       target =
+      std::max( slot_of( nodes_[idx].deadline ), base );
+  auto const level_span = []( int level ) {
+    return uint64_t{ 1 } << ( kSlotBits * level );
+  };
+  uint64_t const diff  = target - base;
+  int            level = 0;
+  while( level < kLevels - 1 && diff >= level_span( level + 1 ) )
+    ++level;
+  if( diff >= level_span( kLevels ) )
+    // Too far out to be represented; put it in the last slot and
+    // it will be re-placed (using its real deadline) when that
+    // slot is reached.
+    target = base + level_span( kLevels ) - 1;
+  int const slot =
+      int( ( target >> ( kSlotBits * level ) ) & ( kSlots - 1 ) );
+  link( idx, level * kSlots + slot );
+}
+
+void TimerWheel::move_to_firing( int list ) {
+  while( heads_[list] != kNone ) {
+    int32_t const idx = heads_[list];
+    unlink( idx );
+    link( idx, kFiringList );
+  }
+}
+
+void TimerWheel::fire( int32_t idx ) {
+  Node&          node       = nodes_[idx];
+  Func           func       = std::move( node.func );
+  uint64_t const period     = node.period;
+  uint32_t const generation = node.generation;
+  if( period == 0 )
+    release( idx );
+  else {
+    node.deadline = now_ + period;
+    place( idx );
+  }
+  // Note that this can add or cancel timers, which can resize
+  // nodes_, so we can't hold any references across it.
+  func();
+  if( period == 0 ) return;
+  Node& after = nodes_[idx];
+  // The timer may have cancelled itself.
+  if( after.generation == generation && after.list != kNone )
+    after.func = std::move( func );
+}
+
+void TimerWheel::drain_firing() {
+  while( heads_[kFiringList] != kNone ) {
+    int32_t const idx = heads_[kFiringList];
+    unlink( idx );
+    if( nodes_[idx].deadline <= now_ )
+      fire( idx );
+    else
+      place( idx );
+  }
+}
+
+void TimerWheel::step( uint64_t const slot ) {
+  // First cascade the upper levels, highest first, so that
+  // timers can move down more than one level in one step. These
+  // are placed relative to the previous slot so that those that
+  // are due in this slot end up in the level zero list that we
+  // are about to process.
+  processed_slot_ = slot - 1;
+  for( int level = kLevels - 1; level >= 1; --level ) {
+    uint64_t const mask =
+        ( uint64_t{ 1 } << ( kSlotBits * level ) ) - 1;
+    if( ( slot & mask ) != 0 ) continue;
+    int const list =
+        level * kSlots +
+        int( ( slot >> ( kSlotBits * level ) ) & ( kSlots - 1 ) );
+    move_to_firing( list );
+    while( heads_[kFiringList] != kNone ) {
+      int32_t const idx = heads_[kFiringList];
+      unlink( idx );
+      place( idx );
+    }
+  }
+  processed_slot_ = slot;
+  move_to_firing( int( slot & ( kSlots - 1 ) ) );
+  drain_firing();
+}
+
+TimerWheelId TimerWheel::add( uint64_t deadline, uint64_t period,
+                              Func func ) {
+  int32_t const idx = allocate();
+  Node&         node = nodes_[idx];
+  node.deadline      = deadline;
+  node.period        = period;
+  node.func          = std::move( func );
+  place( idx );
+  return TimerWheelId{ .index      = uint32_t( idx ),
+                       .generation = node.generation };
+}
+
+bool TimerWheel::cancel( TimerWheelId id ) {
+  if( id.index >= nodes_.size() ) return false;
+  int32_t const idx  = int32_t( id.index );
+  Node&         node = nodes_[idx];
+  if( node.generation != id.generation ) return false;
+  // A repeating timer is still linked while it is firing, but a
+  // one-shot timer has already been released by then.
+  if( node.list == kNone ) return false;
+  unlink( idx );
+  release( idx );
+  return true;
+}
+
+void TimerWheel::advance_to( uint64_t now ) {
+  if( now <= now_ ) return;
+  now_                = now;
+  uint64_t const to   = slot_of( now );
+  uint64_t const from = processed_slot_;
+  if( size_ == 0 ) {
+    processed_slot_ = to;
+    return;
+  }
+  if( to - from > uint64_t( kSlots ) * kSlots ) {
+    // A lot of time has passed (e.g. the game was stopped in a
+    // debugger), so instead of stepping through every slot just
+    // take everything out and put it back relative to now.
+    for( int list = 0; list < kFiringList; ++list )
+      move_to_firing( list );
+    processed_slot_ = to;
+    drain_firing();
+    return;
+  }
+  for( uint64_t slot = from + 1; slot <= to; ++slot )
+    step( slot );
+}
+
+void TimerWheel::clear() {
+  // Release the nodes one by one instead of clearing the vector
+  // so that any outstanding ids become stale.
+  for( int32_t idx = 0; idx < int32_t( nodes_.size() ); ++idx ) {
+    if( nodes_[idx].list == kNone ) continue;
+    unlink( idx );
+    release( idx );
+  }
+}
+
+} // namespace rn
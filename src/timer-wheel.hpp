@@ -0,0 +1,134 @@
+/****************************************************************
+**timer-wheel.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Hierarchical timing wheel.
+*
+*****************************************************************/
+#pragma once
+
+#include "core-config.hpp"
+
+// C++ standard library
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace rn {
+
+// Identifies a timer in a TimerWheel so that it can be can-
+// celled. Once the timer has fired (if it is not repeating) or
+// has been cancelled, the id becomes stale and cancelling it is
+// a no-op, even if the slot is reused by another timer.
+struct TimerWheelId {
+  uint32_t index      = 0;
+  uint32_t generation = 0;
+
+  bool operator==( TimerWheelId const& ) const = default;
+};
+
+/****************************************************************
+** TimerWheel
+*****************************************************************/
+// Holds a set of timers, each with a deadline, and fires them as
+// time is advanced. Time is just an unsigned integer here whose
+// units are up to the caller (e.g. microseconds or frames).
+//
+// Adding and cancelling a timer are O(1), and advancing time
+// costs O(1) per elapsed slot plus O(1) per timer that fires or
+// moves down a level, so the cost of a frame does not depend on
+// the number of timers that are waiting, which is important
+// since every active animation is waiting on a timer.
+//
+// Time is divided into slots of 2^resolution_bits units. A timer
+// never fires before its deadline, but it may fire up to one
+// slot after it, and callers will generally only advance the
+// wheel once per frame anyway.
+struct TimerWheel {
+  using Func = std::function<void()>;
+
+  TimerWheel( uint64_t now, int resolution_bits );
+
+  // If `period` is zero then the timer will fire once, otherwise
+  // it will fire repeatedly, each time being rescheduled for
+  // `period` after the time at which it fired.
+  TimerWheelId add( uint64_t deadline, uint64_t period,
+                    Func func );
+
+  // Returns true if the timer was active.
+  bool cancel( TimerWheelId id );
+
+  // Fires all of the timers whose deadlines are <= now. A timer
+  // callback may add or cancel timers (including itself).
+  void advance_to( uint64_t now );
+
+  // Removes all timers without firing them.
+  void clear();
+
+  // Number of active timers.
+  int size() const { return size_; }
+
+  uint64_t now() const { return now_; }
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots    = 1 << kSlotBits;
+  static constexpr int kLevels   = 4;
+  // The list into which timers that are about to fire are moved.
+  static constexpr int kFiringList = kLevels * kSlots;
+  static constexpr int kNumLists   = kFiringList + 1;
+
+  static constexpr int32_t kNone = -1;
+
+  struct Node {
+    uint64_t deadline   = 0;
+    uint64_t period     = 0;
+    Func     func       = {};
+    uint32_t generation = 0;
+    // Which list this node is in, or kNone if it is free.
+    int32_t list = kNone;
+    int32_t prev = kNone;
+    int32_t next = kNone;
+  };
+
+  uint64_t slot_of( uint64_t t ) const {
+    return t >> resolution_bits_;
+  }
+
+  int32_t allocate();
+  void    release( int32_t idx );
+
+  void link( int32_t idx, int list );
+  void unlink( int32_t idx );
+
+  // Puts the node into the appropriate wheel list given its
+  // deadline and processed_slot_.
+  void place( int32_t idx );
+
+  // Moves all nodes in the given list to the firing list.
+  void move_to_firing( int list );
+
+  // Fires or re-places each node in the firing list.
+  void drain_firing();
+
+  void fire( int32_t idx );
+
+  // Processes one slot.
+  void step( uint64_t slot );
+
+  int      resolution_bits_ = 0;
+  uint64_t now_             = 0;
+  // All slots up to and including this one have been processed.
+  uint64_t processed_slot_ = 0;
+  int      size_           = 0;
+
+  std::vector<Node>              nodes_;
+  std::vector<int32_t>           free_;
+  std::array<int32_t, kNumLists> heads_;
+};
+
+} // namespace rn
@@ -42,13 +42,11 @@ int king_transport_cost_percent( int          tax_rate,
 
 bool player_has_galleons( SSConst const& ss,
                           Player const&  player ) {
-  unordered_map<UnitId, EuroUnitState const*> const& units_all =
-      ss.units.euro_all();
-  for( auto& [unit_id, state] : units_all ) {
-    Unit const& unit = ss.units.unit_for( unit_id );
-    if( unit.nation() != player.nation ) continue;
-    if( unit.type() == e_unit_type::galleon ) return true;
-  }
+  for( UnitId const unit_id :
+       ss.units.euro_units_for_nation( player.nation ) )
+    if( ss.units.unit_for( unit_id ).type() ==
+        e_unit_type::galleon )
+      return true;
   return false;
 }
 
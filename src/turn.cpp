@@ -33,6 +33,7 @@
 #include "plane-stack.hpp"
 #include "plane.hpp"
 #include "plow.hpp"
+#include "replay.hpp"
 #include "road.hpp"
 #include "save-game.hpp"
 #include "sound.hpp"
@@ -56,6 +57,7 @@
 
 // Rds
 #include "menu.rds.hpp"
+#include "replay.rds.hpp"
 
 // refl
 #include "refl/to-str.hpp"
@@ -65,9 +67,6 @@
 #include "base/scope-exit.hpp"
 #include "base/to-str-ext-std.hpp"
 
-// base-util
-#include "base-util/algo.hpp"
-
 // C++ standard library
 #include <algorithm>
 #include <deque>
@@ -267,15 +266,6 @@ void unsentry_surroundings( UnitsState& units_state,
   }
 }
 
-vector<UnitId> euro_units_all( UnitsState const& units_state,
-                               e_nation          n ) {
-  vector<UnitId> res;
-  res.reserve( units_state.all().size() );
-  for( auto const& p : units_state.euro_all() )
-    if( n == p.second->unit.nation() ) res.push_back( p.first );
-  return res;
-}
-
 // Apply a function to all units. The function may mutate the
 // units.
 void map_all_euro_units(
@@ -290,10 +280,17 @@ void map_all_euro_units(
 void map_active_euro_units(
     UnitsState& units_state, e_nation nation,
     base::function_ref<void( Unit& )> func ) {
-  for( auto& p : units_state.euro_all() ) {
-    Unit& unit = units_state.unit_for( p.first );
+  // Copy the ids since the index that they come from changes if
+  // the function creates or destroys units.
+  span<UnitId const> const for_nation =
+      units_state.euro_units_for_nation( nation );
+  vector<UnitId> const ids( for_nation.begin(),
+                            for_nation.end() );
+  for( UnitId const id : ids ) {
+    if( !units_state.exists( id ) ) continue;
+    Unit& unit = units_state.unit_for( id );
     if( unit.mv_pts_exhausted() ) continue;
-    if( unit.nation() == nation ) func( unit );
+    func( unit );
   }
 }
 
@@ -411,25 +408,48 @@ wait<> process_player_input( next_turn_t, Planes&, SS&, TS&,
   co_return;
 }
 
+wait<ReplayedInput_t> race_user_inputs( Planes& planes ) {
+  auto wait_for_button =
+      co::fmap( [] λ( next_turn_t{} ),
+                planes.panel().wait_for_eot_button_click() );
+  // The reason that we want to use co::first here instead of
+  // interleaving the three streams is because as soon as one be-
+  // comes ready (and we start processing it) we want all the
+  // others to be automatically be cancelled, which will have the
+  // effect of disabling further input on them (e.g., disabling
+  // menu items), which is what we want for a good user experi-
+  // ence.
+  UserInput const command = co_await co::first( //
+      wait_for_menu_selection( planes.menu() ), //
+      planes.land_view().eot_get_next_input(),  //
+      std::move( wait_for_button )              //
+  );
+  if( auto item = command.get_if<e_menu_item>(); item )
+    co_return ReplayedInput::menu{ .item = *item };
+  if( auto input = command.get_if<LandViewPlayerInput_t>();
+      input )
+    co_return ReplayedInput::land_view{ .input = *input };
+  co_return ReplayedInput::eot_button{};
+}
+
+// Which of the inputs wins the race is a matter of timing, so it
+// is the outcome of the race as a whole that gets recorded.
+wait<UserInput> next_user_input( Planes& planes ) {
+  ReplayedInput_t const input = co_await replayable_player_input(
+      [&] { return race_user_inputs( planes ); } );
+  switch( input.to_enum() ) {
+    using namespace ReplayedInput;
+    case e::menu: co_return input.get<menu>().item;
+    case e::land_view: co_return input.get<land_view>().input;
+    case e::eot_button: co_return next_turn_t{};
+  }
+}
+
 wait<> process_inputs( Planes& planes, SS& ss, TS& ts,
                        Player& player ) {
   planes.land_view().reset_input_buffers();
   while( true ) {
-    auto wait_for_button =
-        co::fmap( [] λ( next_turn_t{} ),
-                  planes.panel().wait_for_eot_button_click() );
-    // The reason that we want to use co::first here instead of
-    // interleaving the three streams is because as soon as one
-    // becomes ready (and we start processing it) we want all the
-    // others to be automatically be cancelled, which will have
-    // the effect of disabling further input on them (e.g., dis-
-    // abling menu items), which is what we want for a good user
-    // experience.
-    UserInput command = co_await co::first(       //
-        wait_for_menu_selection( planes.menu() ), //
-        planes.land_view().eot_get_next_input(),  //
-        std::move( wait_for_button )              //
-    );
+    UserInput const command = co_await next_user_input( planes );
     co_await rn::visit(
         command, LC( process_player_input( _, planes, ss, ts,
                                            player ) ) );
@@ -587,30 +607,47 @@ wait<> process_player_input( UnitId                       id,
   }
 }
 
-wait<LandViewPlayerInput_t> landview_player_input(
-    ILandViewPlane&  land_view_plane,
-    NationTurnState& nat_turn_st, UnitsState const& units_state,
-    UnitId id ) {
-  LandViewPlayerInput_t response;
-  if( auto maybe_orders = pop_unit_orders( id ) ) {
-    response = LandViewPlayerInput::give_orders{
+using UnitInput =
+    base::variant<e_menu_item, LandViewPlayerInput_t>;
+
+wait<ReplayedInput_t> race_unit_inputs( Planes& planes,
+                                        UnitId  id ) {
+  UnitInput const command = co_await co::first(
+      wait_for_menu_selection( planes.menu() ),
+      planes.land_view().get_next_input( id ) );
+  if( auto item = command.get_if<e_menu_item>(); item )
+    co_return ReplayedInput::menu{ .item = *item };
+  co_return ReplayedInput::land_view{
+      .input = command.get<LandViewPlayerInput_t>() };
+}
+
+// Orders that were queued up for the unit are not player input
+// and so they don't go through the replay journal.
+wait<UnitInput> next_unit_input( Planes& planes, SS& ss,
+                                 NationTurnState& nat_turn_st,
+                                 UnitId           id ) {
+  if( auto maybe_orders = pop_unit_orders( id ) )
+    co_return LandViewPlayerInput::give_orders{
         .orders = *maybe_orders };
-  } else {
-    lg.debug( "asking orders for: {}",
-              debug_string( units_state, id ) );
-    nat_turn_st.need_eot = false;
-    response = co_await land_view_plane.get_next_input( id );
+  lg.debug( "asking orders for: {}",
+            debug_string( ss.units, id ) );
+  nat_turn_st.need_eot = false;
+  ReplayedInput_t const input = co_await replayable_player_input(
+      [&] { return race_unit_inputs( planes, id ); } );
+  switch( input.to_enum() ) {
+    using namespace ReplayedInput;
+    case e::menu: co_return input.get<menu>().item;
+    case e::land_view: co_return input.get<land_view>().input;
+    case e::eot_button:
+      FATAL( "the end-of-turn button is not active mid-turn." );
   }
-  co_return response;
 }
 
 wait<> query_unit_input( UnitId id, Planes& planes, SS& ss,
                          TS& ts, Player& player,
                          NationTurnState& nat_turn_st ) {
-  auto command = co_await co::first(
-      wait_for_menu_selection( planes.menu() ),
-      landview_player_input( planes.land_view(), nat_turn_st,
-                             ss.units, id ) );
+  UnitInput const command =
+      co_await next_unit_input( planes, ss, nat_turn_st, id );
   co_await overload_visit( command, [&]( auto const& action ) {
     return process_player_input( id, action, planes, ss, ts,
                                  player, nat_turn_st );
@@ -829,15 +866,13 @@ wait<> units_turn( Planes& planes, SS& ss, TS& ts,
     co_await units_turn_one_pass( planes, ss, ts, player,
                                   nat_turn_st, q );
     CHECK( q.empty() );
-    // Refill the queue.
-    vector<UnitId> units = euro_units_all( ss.units, st.nation );
-    util::sort_by_key( units, []( auto id ) { return id; } );
-    erase_if( units, [&]( UnitId id ) {
-      return should_remove_unit_from_queue(
-          ss.units.unit_for( id ) );
-    } );
-    if( units.empty() ) co_return;
-    for( UnitId id : units ) q.push_back( id );
+    // Refill the queue. The index is already sorted by id.
+    for( UnitId const id :
+         ss.units.euro_units_for_nation( st.nation ) )
+      if( !should_remove_unit_from_queue(
+              ss.units.unit_for( id ) ) )
+        q.push_back( id );
+    if( q.empty() ) co_return;
   }
 }
 
@@ -1005,6 +1040,7 @@ void reset_units( SS& ss ) {
 }
 
 wait<> next_turn( Planes& planes, SS& ss, TS& ts ) {
+  replay_state_checkpoint( ss.root );
   planes.land_view().start_new_turn();
   auto& st = ss.turn;
 
@@ -1033,9 +1069,8 @@ wait<> next_turn( Planes& planes, SS& ss, TS& ts ) {
   reset_turn_obj( ss.players, st );
   co_await advance_time( ts.gui, st.time_point );
 
-  // Autosave.
-  if( should_autosave( st.time_point.turns ) )
-    autosave( ss, ts );
+  // Autosave (either in full or as a journal entry).
+  autosave( ss, ts );
 }
 
 } // namespace
@@ -11,6 +11,7 @@
 #include "views.hpp"
 
 // Revolution Now
+#include "frame.hpp"
 #include "math.hpp"
 #include "render.hpp"
 #include "text.hpp"
@@ -36,6 +37,35 @@ namespace rn::ui {
 
 namespace {} // namespace
 
+/****************************************************************
+** VertexCache
+*****************************************************************/
+void VertexCache::draw(
+    rr::Renderer& renderer, Coord coord,
+    base::function_ref<void( Coord )> drawer ) {
+  using namespace chrono;
+  auto const start = steady_clock::now();
+  if( !dirty_ && renderer.mods() == recorded_mods_ ) {
+    renderer.replay( vertices_, coord - recorded_at_ );
+    auto const replay_time =
+        duration_cast<microseconds>( steady_clock::now() - start );
+    event_counts()[counters_.replayed_vertices].tick(
+        int( vertices_.size() ) );
+    if( record_time_ > replay_time )
+      event_counts()[counters_.micros_saved].tick(
+          ( record_time_ - replay_time ).count() );
+    return;
+  }
+  rr::VertexRange const rng =
+      renderer.range_for( [&] { drawer( coord ); } );
+  vertices_      = renderer.copy_range( rng );
+  recorded_at_   = coord;
+  recorded_mods_ = renderer.mods();
+  record_time_ =
+      duration_cast<microseconds>( steady_clock::now() - start );
+  dirty_ = false;
+}
+
 /****************************************************************
 ** CompositeView
 *****************************************************************/
@@ -250,14 +280,16 @@ Delta OneLineStringView::delta() const { return view_size_; }
 
 void OneLineStringView::draw( rr::Renderer& renderer,
                               Coord         coord ) const {
-  int const start_offset = ( view_size_.h - text_size_.h ) / 2;
-  TextMarkupInfo const markup_info{
-      .normal = color_,
-      // FIXME
-      .highlight = gfx::pixel::white() };
-  render_text_markup( renderer,
-                      coord + Delta{ .h = start_offset },
-                      e_font{}, markup_info, msg_ );
+  cache_.draw( renderer, coord, [&]( Coord where ) {
+    int const start_offset = ( view_size_.h - text_size_.h ) / 2;
+    TextMarkupInfo const markup_info{
+        .normal = color_,
+        // FIXME
+        .highlight = gfx::pixel::white() };
+    render_text_markup( renderer,
+                        where + Delta{ .h = start_offset },
+                        e_font{}, markup_info, msg_ );
+  } );
 }
 
 /****************************************************************
@@ -279,8 +311,10 @@ Delta TextView::delta() const { return text_size_; }
 
 void TextView::draw( rr::Renderer& renderer,
                      Coord         coord ) const {
-  render_text_markup_reflow( renderer, coord, font::standard(),
-                             markup_info_, reflow_info_, msg_ );
+  cache_.draw( renderer, coord, [&]( Coord where ) {
+    render_text_markup_reflow( renderer, where, font::standard(),
+                               markup_info_, reflow_info_, msg_ );
+  } );
 }
 
 /****************************************************************
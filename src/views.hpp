@@ -33,8 +33,14 @@
 // gfx
 #include "gfx/pixel.hpp"
 
+// base
+#include "base/function-ref.hpp"
+
 // C++ standard library
+#include <chrono>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 namespace rn::ui {
 
@@ -44,6 +50,48 @@ namespace rn::ui {
 TextMarkupInfo const& default_text_markup_info();
 TextReflowInfo const& default_text_reflow_info();
 
+/****************************************************************
+** VertexCache
+*****************************************************************/
+// Names of the per-frame counters (see event_counts) to which a
+// VertexCache reports what it has saved.
+struct VertexCacheCounters {
+  std::string_view replayed_vertices = "ui cached verts";
+  std::string_view micros_saved      = "ui cached us saved";
+};
+
+// Holds on to the vertices that a view emitted the last time it
+// was drawn so that, as long as the view has not changed, subse-
+// quent frames can just copy them into the vertex buffer (moved
+// to wherever the view is now) instead of re-running layout and
+// text rendering. Owners must call `invalidate` when anything
+// that affects what they draw changes. The cache will also re-
+// record on its own if the renderer mods are not the same as
+// those that were in effect when the vertices were recorded.
+class VertexCache {
+ public:
+  VertexCache() = default;
+
+  explicit VertexCache( VertexCacheCounters counters )
+    : counters_( counters ) {}
+
+  void invalidate() { dirty_ = true; }
+
+  // If the cache is valid then this will replay the cached ver-
+  // tices at `coord`, otherwise it will call `drawer` with
+  // `coord` and record what it emits.
+  void draw( rr::Renderer& renderer, Coord coord,
+             base::function_ref<void( Coord )> drawer );
+
+ private:
+  VertexCacheCounters            counters_      = {};
+  bool                           dirty_         = true;
+  std::vector<rr::GenericVertex> vertices_      = {};
+  Coord                          recorded_at_   = {};
+  rr::RendererMods               recorded_mods_ = {};
+  std::chrono::microseconds      record_time_   = {};
+};
+
 /****************************************************************
 ** Fundamental Views
 *****************************************************************/
@@ -270,10 +318,11 @@ class OneLineStringView : public View {
   bool needs_padding() const override { return true; }
 
  protected:
-  std::string msg_;
-  Delta       view_size_;
-  Delta       text_size_; // rendered pixel size.
-  gfx::pixel  color_;
+  std::string         msg_;
+  Delta               view_size_;
+  Delta               text_size_; // rendered pixel size.
+  gfx::pixel          color_;
+  mutable VertexCache cache_;
 };
 
 class TextView : public View {
@@ -293,10 +342,11 @@ class TextView : public View {
   bool needs_padding() const override { return true; }
 
  private:
-  std::string    msg_;
-  Delta          text_size_; // rendered pixel size.
-  TextMarkupInfo markup_info_;
-  TextReflowInfo reflow_info_;
+  std::string         msg_;
+  Delta               text_size_; // rendered pixel size.
+  TextMarkupInfo      markup_info_;
+  TextReflowInfo      reflow_info_;
+  mutable VertexCache cache_;
 };
 
 class ButtonBaseView : public View {
@@ -103,15 +103,9 @@ bool Visibility::visible( Coord tile ) const {
     // Proto squares are never considered visible.
     return false;
   DCHECK( player_terrain_.has_value() );
-  maybe<MapSquare const&> square =
-      ( *player_terrain_ )
-          ->map[tile]
-          .member( &FogSquare::square );
-  if( !square.has_value() )
-    // There is a player and they can't see this tile.
-    return false;
-  // There is a player and they can see this tile.
-  return true;
+  // There is a player and they can see this tile iff there is a
+  // fog square.
+  return ( *player_terrain_ )->map[tile].has_value();
 }
 
 MapSquare const& Visibility::square_at( Coord tile ) const {
@@ -124,16 +118,17 @@ MapSquare const& Visibility::square_at( Coord tile ) const {
   if( !tile.is_inside( terrain_->world_rect_tiles() ) )
     // Will yield a proto square.
     return terrain_->total_square_at( tile );
-  maybe<MapSquare const&> square =
-      ( *player_terrain_ )
-          ->map[tile]
-          .member( &FogSquare::square );
-  if( !square.has_value() )
+  maybe<FogSquare> const& fog_square =
+      ( *player_terrain_ )->map[tile];
+  if( !fog_square.has_value() )
     // Player can't see this tile.
     return terrain_->total_square_at( tile );
-  // The player can see this tile, so return the player's version
-  // of it.
-  return *square;
+  if( !fog_square->square.has_value() )
+    // The player's view of this tile is current.
+    return terrain_->square_at( tile );
+  // The tile has changed since the player last saw it, so return
+  // the player's version of it.
+  return *fog_square->square;
 };
 
 Rect Visibility::rect_tiles() const {
@@ -165,7 +160,7 @@ vector<Coord> unit_visible_squares( SSConst const& ss,
   int const largest_block_size =
       largest_possible_sighting_radius() * 2 + 1;
   res.reserve( largest_block_size * largest_block_size );
-  for( Rect rect : gfx::subrects( possible ) ) {
+  for( Rect rect : gfx::subrect_range( possible ) ) {
     Coord                   coord = rect.upper_left();
     maybe<MapSquare const&> square =
         terrain.maybe_square_at( coord );
@@ -192,7 +187,7 @@ refl::enum_map<e_nation, bool> nations_with_visibility_of_square(
       Rect::from( tile, Delta{ .w = 1, .h = 1 } )
           .with_border_added(
               largest_possible_sighting_radius() );
-  for( Rect rect : gfx::subrects( possible_for_units ) ) {
+  for( Rect rect : gfx::subrect_range( possible_for_units ) ) {
     Coord coord = rect.upper_left();
     // We don't use the recursive variant because we don't want
     // e.g. a scout on a ship to increase the sighting radius.
@@ -226,7 +221,8 @@ refl::enum_map<e_nation, bool> nations_with_visibility_of_square(
       Rect::from( tile, Delta{ .w = 1, .h = 1 } )
           .with_border_added(
               config_colony.colony_visibility_radius );
-  for( Rect rect : gfx::subrects( possible_for_colonies ) ) {
+  for( Rect rect :
+       gfx::subrect_range( possible_for_colonies ) ) {
     Coord                  coord = rect.upper_left();
     maybe<ColonyId> const& colony_id =
         ss.colonies.maybe_from_coord( coord );
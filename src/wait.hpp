@@ -81,6 +81,13 @@ class wait_shared_state {
     coro_ = std::move( coro );
   }
 
+  // Called when the wait is cancelled, which allows the producer
+  // of the value to release any resources (e.g. timers) that it
+  // is holding on behalf of this wait.
+  void set_cancel_callback( base::unique_func<void()> func ) {
+    cancel_callback_ = std::move( func );
+  }
+
   void cancel() {
     eptr_ = {};
     coro_.reset();
@@ -88,6 +95,14 @@ class wait_shared_state {
     callbacks_.clear();
     exception_callback_.reset();
     exception_ucallback_.reset();
+    if( cancel_callback_.has_value() ) {
+      // Move it out first in case it causes this to be called
+      // again.
+      base::unique_func<void()> func =
+          std::move( *cancel_callback_ );
+      cancel_callback_.reset();
+      func();
+    }
   }
 
   // So that we can access private members of this class when it
@@ -199,6 +214,8 @@ class wait_shared_state {
   maybe<std::function<ExceptFunc>>     exception_callback_;
   maybe<base::unique_func<ExceptFunc>> exception_ucallback_;
 
+  maybe<base::unique_func<void()>> cancel_callback_;
+
   // Will be populated if this shared state is created by a
   // coroutine.
   maybe<base::unique_coro<promise_type<T>>> coro_;
@@ -363,6 +380,19 @@ class wait_promise {
     set_value_emplace();
   }
 
+  /**************************************************************
+  ** on_cancel
+  ***************************************************************/
+  // The function will be called when the wait is cancelled, e.g.
+  // to remove a timer that would otherwise fire for nothing.
+  // Note that a wait is also cancelled when it is destroyed, so
+  // this must be harmless to call after the value has been set.
+  template<typename Func>
+  void on_cancel( Func&& func ) const {
+    mutable_state()->set_cancel_callback(
+        std::forward<Func>( func ) );
+  }
+
   /**************************************************************
   ** set_value_if_not_set
   ***************************************************************/
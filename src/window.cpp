@@ -696,6 +696,24 @@ wait<vector<UnitSelection>> unit_selection_box(
   co_return co_await s_promise.wait();
 }
 
+/****************************************************************
+** StatusWindow
+*****************************************************************/
+StatusWindow::StatusWindow( WindowManager& window_manager,
+                            string_view    msg )
+  : win_( async_window_builder(
+        window_manager,
+        make_unique<ui::TextView>( string( msg ) ),
+        /*auto_pad=*/true ) ) {}
+
+StatusWindow::~StatusWindow() = default;
+
+void StatusWindow::set_message( string_view msg ) {
+  win_->set_view( make_unique<ui::TextView>( string( msg ) ) );
+  win_->autopad_me();
+  win_->center_me();
+}
+
 /****************************************************************
 ** WindowPlane
 *****************************************************************/
@@ -716,6 +734,11 @@ wait<> WindowPlane::message_box( string_view msg ) {
   co_await p.wait();
 }
 
+unique_ptr<StatusWindow> WindowPlane::status_window(
+    string_view msg ) {
+  return make_unique<StatusWindow>( impl_->wm, msg );
+}
+
 wait<maybe<int>> WindowPlane::select_box(
     string_view msg, vector<SelectBoxOption> const& options,
     e_input_required required, maybe<int> initial_selection ) {
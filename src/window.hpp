@@ -91,6 +91,24 @@ struct Window {
   std::unique_ptr<ui::View> view_;
 };
 
+/****************************************************************
+** StatusWindow
+*****************************************************************/
+// A window showing a message that the player can't dismiss and
+// whose text can be changed while it is displayed, e.g. to re-
+// port the progress of a long-running operation. The window is
+// closed when this object is destroyed.
+struct StatusWindow {
+  StatusWindow( WindowManager&   window_manager,
+                std::string_view msg );
+  ~StatusWindow();
+
+  void set_message( std::string_view msg );
+
+ private:
+  std::unique_ptr<Window> win_;
+};
+
 /****************************************************************
 ** Helper Configs.
 *****************************************************************/
@@ -147,6 +165,9 @@ struct WindowPlane {
   wait<maybe<int>> int_input_box(
       IntInputBoxOptions const& options );
 
+  std::unique_ptr<StatusWindow> status_window(
+      std::string_view msg );
+
  private:
   friend struct Window;
 
@@ -13,6 +13,10 @@
 // Under test.
 #include "src/base/io.hpp"
 
+// C++ standard library
+#include <atomic>
+#include <thread>
+
 // Must be last.
 #include "test/catch-common.hpp"
 
@@ -303,5 +307,47 @@ TEST_CASE( "[io] read_text_file_as_string empty" ) {
   REQUIRE( s == "" );
 }
 
+TEST_CASE( "[io] binary files" ) {
+  fs::path const dir = "/tmp/test-base-io-binary";
+  fs::remove_all( dir );
+  fs::path const p = dir / "nested" / "file.bin";
+  REQUIRE( read_binary_file( p ) == nothing );
+
+  // Includes bytes that would be mangled in text mode.
+  string const data( "a\r\nb\0c\xff", 7 );
+  REQUIRE( write_binary_file_atomic( p, data ) );
+  REQUIRE( read_binary_file( p ) == data );
+  // No temporary files are left behind.
+  REQUIRE( distance( fs::directory_iterator( p.parent_path() ),
+                     fs::directory_iterator() ) == 1 );
+
+  REQUIRE( write_binary_file_atomic( p, "" ) );
+  REQUIRE( read_binary_file( p ) == "" );
+  fs::remove_all( dir );
+}
+
+TEST_CASE( "[io] write_binary_file_atomic concurrent" ) {
+  fs::path const dir = "/tmp/test-base-io-binary-concurrent";
+  fs::remove_all( dir );
+  fs::path const p = dir / "file.bin";
+
+  int const      kThreads = 8;
+  string const   data( 100000, 'x' );
+  vector<thread> threads;
+  atomic<int>    succeeded = 0;
+  for( int i = 0; i < kThreads; ++i )
+    threads.emplace_back( [&] {
+      for( int j = 0; j < 10; ++j )
+        if( write_binary_file_atomic( p, data ) ) ++succeeded;
+    } );
+  for( thread& t : threads ) t.join();
+  REQUIRE( succeeded == kThreads * 10 );
+  // Whichever one won, the file is complete.
+  REQUIRE( read_binary_file( p ) == data );
+  REQUIRE( distance( fs::directory_iterator( dir ),
+                     fs::directory_iterator() ) == 1 );
+  fs::remove_all( dir );
+}
+
 } // namespace
 } // namespace base
@@ -0,0 +1,174 @@
+/****************************************************************
+**bench-world.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Game state shared by the benchmarks.
+*
+*****************************************************************/
+#include "bench-world.hpp"
+
+// ss
+#include "src/ss/colony.hpp"
+#include "src/ss/terrain.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+
+// C++ standard library
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+constexpr array kLandTerrains{
+    e_terrain::desert,
+    e_terrain::scrub,
+    e_terrain::grassland,
+    e_terrain::conifer,
+    e_terrain::marsh,
+    e_terrain::wetland,
+    e_terrain::plains,
+    e_terrain::mixed,
+    e_terrain::prairie,
+    e_terrain::broadleaf,
+    e_terrain::savannah,
+    e_terrain::tropical,
+    e_terrain::swamp,
+    e_terrain::rain,
+    e_terrain::tundra,
+    e_terrain::boreal,
+    e_terrain::hills,
+    e_terrain::mountains,
+};
+
+constexpr array kOutdoorJobs{
+    pair{ e_direction::nw, e_outdoor_job::food },
+    pair{ e_direction::n, e_outdoor_job::food },
+    pair{ e_direction::ne, e_outdoor_job::lumber },
+    pair{ e_direction::w, e_outdoor_job::ore },
+    pair{ e_direction::e, e_outdoor_job::cotton },
+    pair{ e_direction::sw, e_outdoor_job::fur },
+    pair{ e_direction::s, e_outdoor_job::food },
+};
+
+constexpr array kIndoorJobs{
+    e_indoor_job::bells, e_indoor_job::hammers,
+    e_indoor_job::tools, e_indoor_job::cloth,
+    e_indoor_job::coats,
+};
+
+// Cheap deterministic scrambling of the square coordinates.
+uint32_t square_hash( int x, int y ) {
+  uint32_t h = uint32_t( x ) * 73856093u ^
+               uint32_t( y ) * 19349663u;
+  h ^= h >> 13;
+  h *= 0x5bd1e995u;
+  h ^= h >> 15;
+  return h;
+}
+
+constexpr array kColonySites{
+    Coord{ .x = 16, .y = 16 }, Coord{ .x = 48, .y = 16 },
+    Coord{ .x = 16, .y = 48 }, Coord{ .x = 48, .y = 48 } };
+
+// Each colony gets a 3x3 patch of grassland around it.
+bool is_colony_site( int x, int y ) {
+  for( Coord const site : kColonySites )
+    if( abs( x - site.x._ ) <= 1 && abs( y - site.y._ ) <= 1 )
+      return true;
+  return false;
+}
+
+} // namespace
+
+/****************************************************************
+** BenchWorld
+*****************************************************************/
+BenchWorld::BenchWorld() {
+  set_default_player( e_nation::dutch );
+  add_player( e_nation::dutch );
+  add_player( e_nation::english );
+  add_player( e_nation::french );
+  add_player( e_nation::spanish );
+  create_map();
+  add_map_units();
+  add_colonies();
+}
+
+void BenchWorld::create_map() {
+  vector<MapSquare> tiles;
+  tiles.reserve( kMapSize * kMapSize );
+  for( int y = 0; y < kMapSize; ++y ) {
+    for( int x = 0; x < kMapSize; ++x ) {
+      uint32_t const h    = square_hash( x, y );
+      int const      edge = std::min(
+          { x, y, kMapSize - 1 - x, kMapSize - 1 - y } );
+      if( is_colony_site( x, y ) )
+        tiles.push_back( make_grassland() );
+      else if( edge < 2 || h % 9 == 0 )
+        tiles.push_back( make_ocean() );
+      else
+        tiles.push_back( make_terrain(
+            kLandTerrains[( x / 3 + y / 4 + h % 3 ) %
+                          kLandTerrains.size()] ) );
+    }
+  }
+  build_map( std::move( tiles ), kMapSize );
+
+  for( int y = 0; y < kMapSize; ++y ) {
+    for( int x = 0; x < kMapSize; ++x ) {
+      gfx::point const p{ .x = x, .y = y };
+      if( square( p ).surface != e_surface::land ) continue;
+      uint32_t const h = square_hash( x, y );
+      if( h % 7 == 0 ) add_minor_river( p );
+      if( h % 23 == 0 ) add_major_river( p );
+      if( x == kMapSize / 2 || y == kMapSize / 2 )
+        add_road( p );
+    }
+  }
+}
+
+void BenchWorld::add_map_units() {
+  int i = 0;
+  for( int y = 3; y < kMapSize - 3; y += 5 ) {
+    for( int x = 3; x < kMapSize - 3; x += 5 ) {
+      if( is_colony_site( x, y ) ) continue;
+      e_nation const nation =
+          refl::enum_values<e_nation>[i++ % 4];
+      Coord const where{ .x = x, .y = y };
+      if( square( where ).surface == e_surface::land )
+        add_unit_on_map( ( i % 3 == 0 ) ? e_unit_type::scout
+                                        : e_unit_type::soldier,
+                         where, nation );
+      else
+        add_unit_on_map( e_unit_type::caravel, where, nation );
+    }
+  }
+}
+
+void BenchWorld::add_colonies() {
+  int i = 0;
+  for( Coord const site : kColonySites ) {
+    e_nation const nation  = refl::enum_values<e_nation>[i++];
+    Colony&        colony  = add_colony( site, nation );
+    give_all_buildings( colony );
+    for( e_commodity c : refl::enum_values<e_commodity> )
+      colony.commodities[c] = 50;
+    for( auto [d, job] : kOutdoorJobs )
+      add_unit_outdoors( colony.id, d, job );
+    for( e_indoor_job job : kIndoorJobs )
+      add_unit_indoors( colony.id, job );
+    colony_ids_.push_back( colony.id );
+  }
+}
+
+} // namespace rn
@@ -0,0 +1,52 @@
+/****************************************************************
+**bench-world.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Game state shared by the benchmarks.
+*
+*****************************************************************/
+#pragma once
+
+// Testing
+#include "test/fake/world.hpp"
+
+// Revolution Now
+#include "src/maybe.hpp"
+
+// ss
+#include "src/ss/colony-id.hpp"
+
+// C++ standard library
+#include <vector>
+
+namespace rn {
+
+// The unit tests use tiny maps with a handful of units, which is
+// not representative of a real game. This builds a larger state:
+// a map with a mix of terrain, rivers and roads, four players
+// each with units spread over land and sea, and one colony per
+// player with workers in most of its jobs. Everything is derived
+// from the square coordinates, so the state is the same on every
+// run and timings are comparable across commits.
+struct BenchWorld : testing::World {
+  BenchWorld();
+
+  static constexpr int kMapSize = 64;
+
+  // The colonies that were created, one per player.
+  std::vector<ColonyId> const& colony_ids() const {
+    return colony_ids_;
+  }
+
+ private:
+  void create_map();
+  void add_map_units();
+  void add_colonies();
+
+  std::vector<ColonyId> colony_ids_;
+};
+
+} // namespace rn
@@ -0,0 +1,60 @@
+/****************************************************************
+**co-lua.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for awaiting waits from Lua.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/co-lua.hpp"
+#include "src/co-runner.hpp"
+#include "src/co-wait.hpp"
+#include "src/lua-wait.hpp"
+#include "src/lua.hpp"
+
+// luapp
+#include "src/luapp/state.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] lua waits" ) {
+  lua::state st;
+  lua_init( st ); // NOTE: expensive.
+
+  st["ready_wait"] = []( int n ) -> wait<int> { co_return n; };
+  st.script.run( R"(
+    function short_wait( n )
+      return wait.await( ready_wait( n ) ) + 1
+    end
+  )" );
+
+  reset_lua_coro_pool_stats();
+  BENCHMARK( "1000 short lua waits" ) {
+    int sum = 0;
+    for( int i = 0; i < 1000; ++i ) {
+      wait<int> w = lua_wait<int>( st["short_wait"], i );
+      run_all_coroutines();
+      sum += *w;
+    }
+    return sum;
+  };
+  LuaCoroPoolStats const& stats = lua_coro_pool_stats();
+  INFO( fmt::format( "created: {}, reused: {}, peak live: {}",
+                     stats.created, stats.reused,
+                     stats.peak_live ) );
+  CHECK( stats.created == 1 );
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,70 @@
+/****************************************************************
+**colony.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for colony production and evolution.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/bench/bench-world.hpp"
+
+// Revolution Now
+#include "src/colony-evolve.hpp"
+#include "src/production.hpp"
+
+// ss
+#include "src/ss/colonies.hpp"
+#include "src/ss/player.rds.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] colony production" ) {
+  BenchWorld W;
+
+  BENCHMARK( "production_for_colony (all colonies)" ) {
+    int food = 0;
+    for( ColonyId const id : W.colony_ids() )
+      food += production_for_colony(
+                  W.ss(), W.colonies().colony_for( id ) )
+                  .food_horses.food_produced;
+    return food;
+  };
+}
+
+TEST_CASE( "[bench] colony evolution" ) {
+  BenchWorld W;
+
+  // Evolving a colony changes it, so each run gets fresh copies
+  // of the colonies; only the evolution itself is timed.
+  BENCHMARK_ADVANCED( "evolve_colony_one_turn (all colonies)" )
+  ( Catch::Benchmark::Chronometer meter ) {
+    vector<vector<Colony>> copies( meter.runs() );
+    for( vector<Colony>& colonies : copies )
+      for( ColonyId const id : W.colony_ids() )
+        colonies.push_back( W.colonies().colony_for( id ) );
+    meter.measure( [&]( int run ) {
+      int notifications = 0;
+      for( Colony& colony : copies[run] )
+        notifications +=
+            evolve_colony_one_turn( W.ss(), W.ts(),
+                                    W.player( colony.nation ),
+                                    colony )
+                .notifications.size();
+      return notifications;
+    } );
+  };
+}
+
+} // namespace
+} // namespace rn
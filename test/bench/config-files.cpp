@@ -0,0 +1,61 @@
+/****************************************************************
+**config-files.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for parsing and loading config files.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/config-files.hpp"
+
+// rcl
+#include "src/rcl/model.hpp"
+#include "src/rcl/parse.hpp"
+
+// rds
+#include "src/rds/config-helper.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] config files" ) {
+  vector<pair<rds::PopulatorFunc const*, string>> files;
+  for( auto const& [name, populator] :
+       rds::config_populators() )
+    files.emplace_back( &populator,
+                        config_file_for_name( name ) );
+
+  BENCHMARK( "rcl::parse_file (all configs)" ) {
+    int n = 0;
+    for( auto const& [populator, file] : files )
+      n += rcl::parse_file( file ).has_value();
+    return n;
+  };
+
+  vector<pair<rds::PopulatorFunc const*, rcl::doc>> docs;
+  for( auto const& [populator, file] : files ) {
+    UNWRAP_CHECK( doc, rcl::parse_file( file ) );
+    docs.emplace_back( populator, std::move( doc ) );
+  }
+
+  // This is mostly enum and field name lookups.
+  BENCHMARK( "populate (all configs)" ) {
+    int n = 0;
+    for( auto const& [populator, doc] : docs )
+      n += ( *populator )( doc.top_val() ).valid();
+    return n;
+  };
+}
+
+} // namespace
+} // namespace rn
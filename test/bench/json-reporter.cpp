@@ -0,0 +1,125 @@
+/****************************************************************
+**json-reporter.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Catch2 reporter that writes benchmark results as
+*              JSON.
+*
+*****************************************************************/
+// base
+#include "base/fmt.hpp"
+
+// Catch2
+#define CATCH_CONFIG_EXTERNAL_INTERFACES
+#include "catch2/catch.hpp"
+
+// C++ standard library
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+namespace rn {
+
+namespace {
+
+string json_string( string_view s ) {
+  string res = "\"";
+  for( char const c : s ) {
+    switch( c ) {
+      case '"': res += "\\\""; break;
+      case '\\': res += "\\\\"; break;
+      case '\n': res += "\\n"; break;
+      case '\t': res += "\\t"; break;
+      default:
+        if( static_cast<unsigned char>( c ) < 0x20 )
+          res += fmt::format( "\\u{:04x}", int( c ) );
+        else
+          res += c;
+        break;
+    }
+  }
+  res += '"';
+  return res;
+}
+
+// Writes one object per benchmark into a single JSON document so
+// that runs can be saved and diffed or plotted across commits:
+//
+//   { "benchmarks": [
+//       { "test_case": "...", "name": "...", "mean_ns": ...,
+//         ... },
+//       ...
+//   ] }
+//
+// All times are in nanoseconds per iteration. The low/high
+// fields are the bounds of Catch2's bootstrapped confidence in-
+// terval.
+struct JsonReporter
+  : Catch::StreamingReporterBase<JsonReporter> {
+  using StreamingReporterBase::StreamingReporterBase;
+
+  static string getDescription() {
+    return "Writes benchmark results as JSON.";
+  }
+
+  void assertionStarting(
+      Catch::AssertionInfo const& ) override {}
+
+  bool assertionEnded( Catch::AssertionStats const& ) override {
+    return true;
+  }
+
+  void testRunStarting(
+      Catch::TestRunInfo const& run_info ) override {
+    StreamingReporterBase::testRunStarting( run_info );
+    stream << "{\n  \"benchmarks\": [";
+  }
+
+  void benchmarkEnded(
+      Catch::BenchmarkStats<> const& stats ) override {
+    string const test_case =
+        currentTestCaseInfo.some()
+            ? currentTestCaseInfo->name
+            : string{};
+    stream << ( first_ ? "\n" : ",\n" );
+    first_ = false;
+    stream << fmt::format(
+        "    {{ \"test_case\": {}, \"name\": {}, "
+        "\"samples\": {}, \"iterations\": {}, "
+        "\"mean_ns\": {:.1f}, \"mean_low_ns\": {:.1f}, "
+        "\"mean_high_ns\": {:.1f}, \"std_dev_ns\": {:.1f}, "
+        "\"outlier_variance\": {:.3f} }}",
+        json_string( test_case ), json_string( stats.info.name ),
+        stats.info.samples, stats.info.iterations,
+        stats.mean.point.count(), stats.mean.lower_bound.count(),
+        stats.mean.upper_bound.count(),
+        stats.standardDeviation.point.count(),
+        stats.outlierVariance );
+  }
+
+  void benchmarkFailed( string const& error ) override {
+    stream << ( first_ ? "\n" : ",\n" );
+    first_ = false;
+    stream << fmt::format( "    {{ \"error\": {} }}",
+                           json_string( error ) );
+  }
+
+  void testRunEnded(
+      Catch::TestRunStats const& run_stats ) override {
+    stream << "\n  ]\n}\n";
+    StreamingReporterBase::testRunEnded( run_stats );
+  }
+
+ private:
+  bool first_ = true;
+};
+
+} // namespace
+
+CATCH_REGISTER_REPORTER( "json", JsonReporter )
+
+} // namespace rn
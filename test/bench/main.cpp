@@ -0,0 +1,35 @@
+/****************************************************************
+**main.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Provides main() for the benchmarks.
+*
+*****************************************************************/
+// Testing
+#include "test/fake/world.hpp"
+
+// Revolution Now
+#include "src/init.hpp"
+#include "src/linking.hpp"
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch.hpp"
+
+using namespace rn;
+
+// Run from the root of the repo, since the config files and
+// test data are found relative to it, e.g.:
+//
+//   bench --reporter=json --out=bench.json
+//
+int main( int argc, char** argv ) {
+  linker_dont_discard_me();
+  run_all_init_routines( e_log_level::off,
+                         { e_init_routine::configs } );
+  int result = Catch::Session().run( argc, argv );
+  run_all_cleanup_routines();
+  return result;
+}
@@ -0,0 +1,97 @@
+/****************************************************************
+**map-gen-kernels.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the native map generation
+*              kernels.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/mocks/irand.hpp"
+
+// Revolution Now
+#include "src/map-gen-kernels.hpp"
+#include "src/rand.hpp"
+
+// ss
+#include "src/ss/packed-square.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+Matrix<MapSquare> make_random_map( Delta size, Rand& rand ) {
+  Matrix<MapSquare> m( size );
+  for( int y = 0; y < size.h; ++y ) {
+    for( int x = 0; x < size.w; ++x ) {
+      MapSquare& square = m[y][x];
+      square.surface    = rand.bernoulli( .4 ) ? e_surface::land
+                                               : e_surface::water;
+      square.ground     = e_ground_terrain::grassland;
+    }
+  }
+  return m;
+}
+
+TEST_CASE( "[bench] map-gen kernels" ) {
+  MockIRand          unused;
+  Rand               rand( 0 );
+  vector<Delta> const sizes{ { .w = 56, .h = 70 },
+                             { .w = 128, .h = 128 },
+                             { .w = 256, .h = 256 },
+                             { .w = 512, .h = 512 } };
+  for( Delta const size : sizes ) {
+    Matrix<MapSquare> const original =
+        make_random_map( size, rand );
+    string const name = fmt::format( "{}x{}", size.w, size.h );
+
+    BENCHMARK( "fill_where hills " + name ) {
+      Matrix<MapSquare> m = original;
+      return fill_where(
+          m, m.rect(),
+          MapGenFilter{ .surface     = e_surface::land,
+                        .has_overlay = false,
+                        .probability = .1 },
+          MapGenEdit{ .overlay = e_land_overlay::hills }, rand );
+    };
+
+    BENCHMARK( "remove islands " + name ) {
+      Matrix<MapSquare> m = original;
+      return fill_where(
+          m, m.rect(),
+          MapGenFilter{ .surface = e_surface::land,
+                        .max_land_component_size = 1 },
+          MapGenEdit{ .surface = e_surface::water }, unused );
+    };
+
+    BENCHMARK( "distance_to_surface " + name ) {
+      return distance_to_surface( original, e_surface::land );
+    };
+
+    BENCHMARK( "label_components " + name ) {
+      return label_components( original, e_surface::land );
+    };
+
+    Matrix<PackedSquare> const packed = pack_map( original );
+
+    BENCHMARK( "distance_to_surface (packed) " + name ) {
+      return distance_to_surface( packed, e_surface::land );
+    };
+
+    BENCHMARK( "label_components (packed) " + name ) {
+      return label_components( packed, e_surface::land );
+    };
+  }
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,75 @@
+/****************************************************************
+**map-loops.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the rectangle and spiral
+*              ranges used to loop over the map.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/fake/world.hpp"
+
+// Revolution Now
+#include "src/map-search.hpp"
+
+// ss
+#include "src/ss/ref.hpp"
+
+// gfx
+#include "src/gfx/iter.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] subrect_range" ) {
+  // The size of a large map.
+  Rect const r{ .x = 0, .y = 0, .w = 256, .h = 256 };
+
+  BENCHMARK( "subrects (generator)" ) {
+    long sum = 0;
+    for( Rect const sub : gfx::subrects( r ) ) sum += sub.x;
+    return sum;
+  };
+
+  BENCHMARK( "subrect_range" ) {
+    long sum = 0;
+    for( Rect const sub : gfx::subrect_range( r ) ) sum += sub.x;
+    return sum;
+  };
+}
+
+TEST_CASE( "[bench] outward spiral" ) {
+  testing::World W;
+  W.build_map( vector<MapSquare>( 56 * 70, W.make_grassland() ),
+               56 );
+  gfx::point const start{ .x = 20, .y = 30 };
+
+  BENCHMARK( "outward_spiral_search_existing (generator)" ) {
+    long sum = 0;
+    for( gfx::point const p :
+         outward_spiral_search_existing( W.ss(), start ) )
+      sum += p.x;
+    return sum;
+  };
+
+  BENCHMARK( "OutwardSpiralExisting" ) {
+    long sum = 0;
+    for( gfx::point const p :
+         OutwardSpiralExisting( W.ss(), start ) )
+      sum += p.x;
+    return sum;
+  };
+}
+
+} // namespace
+} // namespace rn
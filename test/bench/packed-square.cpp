@@ -0,0 +1,69 @@
+/****************************************************************
+**packed-square.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the bit-packed map squares.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/rand.hpp"
+
+// ss
+#include "src/ss/packed-square.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+MapSquare make_land() {
+  return MapSquare{ .surface = e_surface::land,
+                    .ground  = e_ground_terrain::grassland };
+}
+
+TEST_CASE( "[bench] packed square" ) {
+  Rand                rand( 0 );
+  vector<Delta> const sizes{ { .w = 256, .h = 256 },
+                             { .w = 1024, .h = 1024 } };
+  for( Delta const size : sizes ) {
+    Matrix<MapSquare> world( size );
+    for( int y = 0; y < size.h; ++y )
+      for( int x = 0; x < size.w; ++x )
+        if( rand.bernoulli( .4 ) ) world[y][x] = make_land();
+    Matrix<PackedSquare> const packed = pack_map( world );
+    string const name = fmt::format( "{}x{}", size.w, size.h );
+    WARN( fmt::format(
+        "{}: MapSquare map: {}KB, packed map: {}KB", name,
+        size.area() * sizeof( MapSquare ) / 1024,
+        size.area() * sizeof( PackedSquare ) / 1024 ) );
+
+    BENCHMARK( "count land " + name ) {
+      int res = 0;
+      for( MapSquare const& square : world.data() )
+        res += ( square.surface == e_surface::land ) ? 1 : 0;
+      return res;
+    };
+
+    BENCHMARK( "count land (packed) " + name ) {
+      int res = 0;
+      for( PackedSquare const square : packed.data() )
+        res += ( square.surface() == e_surface::land ) ? 1 : 0;
+      return res;
+    };
+
+    BENCHMARK( "pack whole map " + name ) {
+      return pack_map( world ).size();
+    };
+  }
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,50 @@
+/****************************************************************
+**rect-pack.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the texture atlas rect packer.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// render
+#include "src/render/rect-pack.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+// Roughly what the game's sprite and font sheets produce: mostly
+// tile sized rects with some smaller and some larger ones.
+vector<gfx::rect> atlas_like_rects() {
+  vector<gfx::rect> res;
+  for( int i = 0; i < 2000; ++i ) {
+    int const w = 8 + ( i * 37 ) % 57;
+    int const h = 8 + ( i * 53 ) % 41;
+    res.push_back( gfx::rect{ .size = { .w = w, .h = h } } );
+  }
+  return res;
+}
+
+TEST_CASE( "[bench] rect pack" ) {
+  vector<gfx::rect> const input = atlas_like_rects();
+  gfx::size const         max_size{ .w = 3000, .h = 2000 };
+
+  BENCHMARK_ADVANCED( "pack_rects 2000" )
+  ( Catch::Benchmark::Chronometer meter ) {
+    vector<vector<gfx::rect>> copies( meter.runs(), input );
+    meter.measure( [&]( int run ) {
+      return rr::pack_rects( copies[run], max_size ).has_value();
+    } );
+  };
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,70 @@
+/****************************************************************
+**render-terrain.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for rendering the landscape.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/bench/bench-world.hpp"
+#include "test/fake/renderer.hpp"
+
+// Revolution Now
+#include "src/render-terrain.hpp"
+#include "src/visibility.hpp"
+
+// ss
+#include "src/ss/terrain.hpp"
+
+// render
+#include "src/render/renderer.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] render terrain" ) {
+  BenchWorld            W;
+  testing::FakeRenderer fake;
+  gl::RecordingOpenGL&  gl       = fake.gl();
+  rr::Renderer&         renderer = fake.renderer();
+
+  Visibility const viz =
+      Visibility::create( W.ss(), e_nation::dutch );
+  TerrainRenderOptions const options;
+  Matrix<rr::VertexRange>    tile_bounds(
+      W.terrain().world_size_tiles() );
+  Matrix<rr::VertexRange> lod_tile_bounds(
+      W.terrain().world_size_tiles() );
+
+  BENCHMARK( "render_terrain" ) {
+    render_terrain( renderer, viz, options, tile_bounds,
+                    lod_tile_bounds );
+    return renderer.buffer_vertex_count(
+        rr::e_render_target_buffer::landscape );
+  };
+
+  BENCHMARK( "render_buffer landscape" ) {
+    renderer.render_buffer(
+        rr::e_render_target_buffer::landscape );
+    return gl.stats().vertices_drawn;
+  };
+
+  BENCHMARK( "render_buffer landscape_lod" ) {
+    renderer.render_buffer(
+        rr::e_render_target_buffer::landscape_lod );
+    return gl.stats().vertices_drawn;
+  };
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,81 @@
+/****************************************************************
+**save-game.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for saving/loading games.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/bench/bench-world.hpp"
+
+// Revolution Now
+#include "src/save-game.hpp"
+
+// ss
+#include "src/ss/root.hpp"
+
+// cdr
+#include "src/cdr/converter.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] save game" ) {
+  BenchWorld W;
+  W.expensive_run_lua_init();
+  W.initialize_ts();
+
+  fs::path const path =
+      fs::temp_directory_path() / "rn-bench.sav.rcl";
+  SaveGameOptions const opts{
+      .verbosity = e_savegame_verbosity::compact,
+  };
+  REQUIRE( save_game_to_rcl_file( W.root(), path, opts ) );
+
+  BENCHMARK( "save_game_to_rcl_file" ) {
+    return save_game_to_rcl_file( W.root(), path, opts ).valid();
+  };
+
+  BENCHMARK( "load_game_from_rcl_file" ) {
+    return load_game_from_rcl_file( W.root(), path, opts )
+        .valid();
+  };
+
+  fs::remove( path );
+}
+
+// The cdr conversion half of saving and loading.
+TEST_CASE( "[bench] save game cdr conversion" ) {
+  BenchWorld W;
+  W.expensive_run_lua_init();
+  W.initialize_ts();
+
+  cdr::converter::options const from_opts{
+      .allow_unrecognized_fields        = false,
+      .default_construct_missing_fields = true,
+  };
+  cdr::value const canonical =
+      cdr::run_conversion_to_canonical( W.root() );
+
+  BENCHMARK( "to canonical" ) {
+    return cdr::run_conversion_to_canonical( W.root() );
+  };
+
+  BENCHMARK( "from canonical" ) {
+    return cdr::run_conversion_from_canonical<RootState>(
+        canonical, from_opts );
+  };
+}
+
+} // namespace
+} // namespace rn
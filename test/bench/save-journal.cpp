@@ -0,0 +1,98 @@
+/****************************************************************
+**save-journal.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the save journal.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/bench/bench-world.hpp"
+
+// Revolution Now
+#include "src/map-updater.hpp"
+#include "src/save-journal.hpp"
+
+// ss
+#include "src/ss/player.rds.hpp"
+#include "src/ss/root.hpp"
+#include "src/ss/terrain.hpp"
+
+// cdr
+#include "src/cdr/converter.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+// What changes in a typical turn between full autosaves: some
+// money, a road, and a strip of squares explored by each player.
+TEST_CASE( "[bench] save journal" ) {
+  BenchWorld  W;
+  SaveJournal journal;
+  journal.reset( W.root() );
+  int const kSize = BenchWorld::kMapSize;
+
+  int  turn      = 0;
+  auto play_turn = [&] {
+    ++turn;
+    W.dutch().money += 1;
+    Coord const tile{ .x = turn % kSize,
+                      .y = ( turn / kSize ) % kSize };
+    W.map_updater().modify_map_square(
+        tile, []( MapSquare& square ) {
+          square.road = !square.road;
+        } );
+    for( e_nation const nation : refl::enum_values<e_nation> ) {
+      if( !W.terrain().player_terrain( nation ).has_value() )
+        continue;
+      PlayerTerrainMatrix& m =
+          W.terrain().mutable_player_terrain( nation ).map;
+      for( int x = 0; x < 8; ++x ) {
+        maybe<FogSquare>& fog = m[Coord{
+            .x = ( turn * 8 + x ) % kSize, .y = tile.y }];
+        if( fog.has_value() )
+          fog.reset();
+        else
+          fog.emplace();
+      }
+    }
+  };
+
+  BENCHMARK( "record" ) {
+    play_turn();
+    return journal.record( W.root() );
+  };
+
+  // What recording the terrain would cost if it were converted
+  // and diffed as a whole, for comparison.
+  cdr::converter::options const opts{
+      .write_fields_with_default_value = true,
+  };
+  TerrainState old_terrain = W.root().zzz_terrain;
+  BENCHMARK( "terrain diff via cdr" ) {
+    play_turn();
+    vector<CdrPatch> patches;
+    diff_cdr(
+        cdr::run_conversion_to_canonical( old_terrain, opts ),
+        cdr::run_conversion_to_canonical( W.root().zzz_terrain,
+                                          opts ),
+        {}, patches );
+    old_terrain = W.root().zzz_terrain;
+    return patches;
+  };
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,62 @@
+/****************************************************************
+**society.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the society module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/fake/world.hpp"
+
+// Revolution Now
+#include "src/society.hpp"
+
+// ss
+#include "src/ss/ref.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] society_on_square" ) {
+  // Standard map size, all land, with a colony or dwelling on
+  // about one in every sixteen tiles, as the minimap or a full
+  // land-view scan would see it.
+  testing::World W;
+  W.add_player( e_nation::english );
+  W.set_default_player( e_nation::english );
+  Delta const       size{ .w = 56, .h = 70 };
+  vector<MapSquare> tiles( size.area(), W.make_grassland() );
+  W.build_map( std::move( tiles ), size.w );
+  for( int y = 0; y < size.h; y += 4 ) {
+    for( int x = 0; x < size.w; x += 4 ) {
+      Coord const where{ .x = x, .y = y };
+      if( ( x + y ) % 8 == 0 )
+        W.add_colony( where );
+      else
+        W.add_dwelling( where, e_tribe::sioux );
+    }
+  }
+
+  BENCHMARK( "society_on_square full map" ) {
+    int found = 0;
+    for( int y = 0; y < size.h; ++y )
+      for( int x = 0; x < size.w; ++x )
+        found += society_on_square( W.ss(),
+                                    Coord{ .x = x, .y = y } )
+                     .has_value();
+    return found;
+  };
+}
+
+} // namespace
+} // namespace rn
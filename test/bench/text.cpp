@@ -0,0 +1,60 @@
+/****************************************************************
+**text.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for text layout.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/font.hpp"
+#include "src/text.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+gfx::size const kCharSize{ .w = 6, .h = 8 };
+
+// Something resembling a long report screen: many paragraphs
+// with some highlighted and shadowed text, reflowed.
+string long_report() {
+  string res;
+  for( int i = 0; i < 40; ++i )
+    res += fmt::format(
+        "@[H]Colony {}@[]: the colonists of this colony have "
+        "produced a great deal of @[S]furs@[] this year, and "
+        "the merchants in the harbor have taken note of it. "
+        "Production is expected to increase by {} percent.\n",
+        i, i * 3 );
+  return res;
+}
+
+TEST_CASE( "[bench] text layout" ) {
+  string const report = long_report();
+  clear_text_layout_cache();
+
+  BENCHMARK( "long report uncached" ) {
+    return compute_text_layout( kCharSize, /*max_cols=*/60,
+                                report );
+  };
+
+  BENCHMARK( "long report cached" ) {
+    return cached_text_layout( kCharSize, /*max_cols=*/60,
+                               report )
+        ->runs.size();
+  };
+
+  clear_text_layout_cache();
+}
+
+} // namespace
+} // namespace rn
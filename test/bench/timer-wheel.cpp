@@ -0,0 +1,56 @@
+/****************************************************************
+**timer-wheel.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the timer wheel.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/timer-wheel.hpp"
+
+// C++ standard library
+#include <functional>
+#include <random>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] timer wheel" ) {
+  // Simulates a lot of concurrent animations, each of which
+  // waits on a timer a few frames out and then re-arms.
+  int const  kTimers = 10000;
+  TimerWheel wheel( /*now=*/0, /*resolution_bits=*/10 );
+  mt19937    rng( 1 );
+  uint64_t   now   = 0;
+  int        fired = 0;
+
+  function<void()> rearm = [&] {
+    ++fired;
+    wheel.add( now + 1000 + rng() % 100000, 0, rearm );
+  };
+  for( int i = 0; i < kTimers; ++i )
+    wheel.add( now + rng() % 100000, 0, rearm );
+
+  BENCHMARK( "advance one 60fps frame" ) {
+    now += 16667;
+    wheel.advance_to( now );
+    return fired;
+  };
+
+  BENCHMARK( "add and cancel" ) {
+    return wheel.cancel( wheel.add( now + 5000, 0, [] {} ) );
+  };
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,62 @@
+/****************************************************************
+**units.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the units state.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/fake/world.hpp"
+
+// ss
+#include "src/ss/units.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+
+// C++ standard library
+#include <algorithm>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] units for nation" ) {
+  // Hundreds of units for each nation, as the turn processor
+  // sees them when it refills its queue.
+  World W;
+  for( e_nation const nation : refl::enum_values<e_nation> ) {
+    if( nation != W.default_nation() ) W.add_player( nation );
+    for( int i = 0; i < 500; ++i )
+      W.add_free_unit( e_unit_type::free_colonist, nation );
+  }
+
+  BENCHMARK( "scan all units for one nation" ) {
+    vector<UnitId> res;
+    for( auto const& [id, st] : W.units().euro_all() )
+      if( st->unit.nation() == e_nation::dutch )
+        res.push_back( id );
+    sort( res.begin(), res.end() );
+    return res.size();
+  };
+
+  BENCHMARK( "euro_units_for_nation" ) {
+    int count = 0;
+    for( UnitId const id :
+         W.units().euro_units_for_nation( e_nation::dutch ) )
+      count += ( id != UnitId{ 0 } );
+    return count;
+  };
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,67 @@
+/****************************************************************
+**visibility.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Benchmarks for the visibility module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Testing
+#include "test/bench/bench-world.hpp"
+
+// Revolution Now
+#include "src/visibility.hpp"
+
+// ss
+#include "src/ss/terrain.hpp"
+
+// gfx
+#include "src/gfx/iter.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[bench] visibility" ) {
+  BenchWorld W;
+  Rect const rect = W.terrain().world_rect_tiles();
+
+  BENCHMARK( "nations_with_visibility_of_square (all)" ) {
+    int n = 0;
+    for( Rect const square : gfx::subrect_range( rect ) )
+      n += nations_with_visibility_of_square(
+               W.ss(), square.upper_left() )[e_nation::dutch];
+    return n;
+  };
+
+  BENCHMARK( "unit_visible_squares scout (all)" ) {
+    size_t n = 0;
+    for( Rect const square : gfx::subrect_range( rect ) )
+      n += unit_visible_squares( W.ss(), e_nation::dutch,
+                                 e_unit_type::scout,
+                                 square.upper_left() )
+               .size();
+    return n;
+  };
+
+  BENCHMARK( "unit_visible_squares caravel (all)" ) {
+    size_t n = 0;
+    for( Rect const square : gfx::subrect_range( rect ) )
+      n += unit_visible_squares( W.ss(), e_nation::dutch,
+                                 e_unit_type::caravel,
+                                 square.upper_left() )
+               .size();
+    return n;
+  };
+}
+
+} // namespace
+} // namespace rn
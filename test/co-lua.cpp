@@ -855,6 +855,100 @@ TEST_CASE( "[co-lua] scenario 3" ) {
   REQUIRE( *w == 42 );
 }
 
+/****************************************************************
+** Thread Pool
+*****************************************************************/
+TEST_CASE( "[co-lua] thread pool" ) {
+  lua::state st;
+  lua_init( st ); // NOTE: expensive.
+
+  wait_promise<int> p;
+  st["get_wait"] = [&] { return p.wait(); };
+  st.script.run( R"(
+    function add( a, b ) return a + b end
+
+    function add_waited( a )
+      return a + wait.await( get_wait() )
+    end
+
+    function nested( a )
+      return wait.await( co_lua.wait_from_lua(
+                           function() return add( a, 1 ) end ) )
+    end
+
+    function fail() error( 'failed' ) end
+  )" );
+
+  reset_lua_coro_pool_stats();
+  REQUIRE( lua_coro_pool_stats() == LuaCoroPoolStats{} );
+
+  // Each call finishes before the next starts, so a single
+  // thread is reused.
+  for( int i = 0; i < 10; ++i ) {
+    wait<int> w = lua_wait<int>( st["add"], i, 1 );
+    run_all_coroutines();
+    REQUIRE( w.ready() );
+    REQUIRE( *w == i + 1 );
+  }
+  REQUIRE( lua_coro_pool_stats() ==
+           LuaCoroPoolStats{
+               .created = 1, .reused = 9, .live = 0,
+               .peak_live = 1 } );
+
+  // A Lua error is caught by the runner, so the thread can still
+  // be reused.
+  {
+    wait<> w = lua_wait<>( st["fail"] );
+    run_all_coroutines();
+    REQUIRE( w.has_exception() );
+  }
+  REQUIRE( lua_coro_pool_stats().created == 1 );
+  REQUIRE( lua_coro_pool_stats().reused == 10 );
+
+  // Suspended.
+  {
+    p           = {};
+    wait<int> w = lua_wait<int>( st["add_waited"], 2 );
+    run_all_coroutines();
+    REQUIRE( !w.ready() );
+    REQUIRE( lua_coro_pool_stats().live == 1 );
+    p.set_value( 3 );
+    run_all_coroutines();
+    REQUIRE( w.ready() );
+    REQUIRE( *w == 5 );
+  }
+  REQUIRE( lua_coro_pool_stats().created == 1 );
+  REQUIRE( lua_coro_pool_stats().reused == 11 );
+
+  // A thread that is cancelled while suspended is not reused.
+  {
+    p           = {};
+    wait<int> w = lua_wait<int>( st["add_waited"], 2 );
+    run_all_coroutines();
+    REQUIRE( !w.ready() );
+    w.cancel();
+    REQUIRE( lua_coro_pool_stats().live == 0 );
+  }
+  REQUIRE( lua_coro_pool_stats().created == 1 );
+  REQUIRE( lua_coro_pool_stats().reused == 12 );
+  {
+    wait<int> w = lua_wait<int>( st["add"], 1, 1 );
+    run_all_coroutines();
+    REQUIRE( *w == 2 );
+  }
+  REQUIRE( lua_coro_pool_stats().created == 2 );
+
+  // Nested calls need more than one thread at a time.
+  reset_lua_coro_pool_stats();
+  {
+    wait<int> w = lua_wait<int>( st["nested"], 4 );
+    run_all_coroutines();
+    REQUIRE( w.ready() );
+    REQUIRE( *w == 5 );
+  }
+  REQUIRE( lua_coro_pool_stats().peak_live == 2 );
+}
+
 struct MyType {};
 void to_str( MyType const&, string&, base::ADL_t ) {}
 
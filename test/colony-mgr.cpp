@@ -285,13 +285,18 @@ TEST_CASE( "[colony-mgr] create, query, destroy" ) {
   REQUIRE( W.colonies().all().size() == 2 );
   REQUIRE( W.colonies().all().contains( 1 ) );
   REQUIRE( W.colonies().all().contains( 2 ) );
+  auto for_nation = [&]( e_nation nation ) {
+    span<ColonyId const> const ids =
+        W.colonies().for_nation( nation );
+    return vector<ColonyId>( ids.begin(), ids.end() );
+  };
   REQUIRE_THAT(
-      W.colonies().for_nation( e_nation::dutch ),
+      for_nation( e_nation::dutch ),
       UnorderedEquals( vector<ColonyId>{ ColonyId{ 2 } } ) );
   REQUIRE_THAT(
-      W.colonies().for_nation( e_nation::english ),
+      for_nation( e_nation::english ),
       UnorderedEquals( vector<ColonyId>{ ColonyId{ 1 } } ) );
-  REQUIRE_THAT( W.colonies().for_nation( e_nation::french ),
+  REQUIRE_THAT( for_nation( e_nation::french ),
                 UnorderedEquals( vector<ColonyId>{} ) );
 
   REQUIRE( W.colonies().maybe_from_name( "1" ) ==
@@ -304,6 +309,34 @@ TEST_CASE( "[colony-mgr] create, query, destroy" ) {
   REQUIRE( W.colonies().all().size() == 0 );
 }
 
+TEST_CASE( "[colony-mgr] change_colony_nation" ) {
+  World         W;
+  Colony const& colony = W.add_colony_with_new_unit(
+      Coord{ .x = 1, .y = 1 }, e_nation::dutch );
+  UnitId const soldier =
+      W.add_unit_on_map( e_unit_type::soldier,
+                         Coord{ .x = 1, .y = 1 }, e_nation::dutch )
+          .id();
+  UnitId const ship =
+      W.add_unit_on_map( e_unit_type::caravel,
+                         Coord{ .x = 0, .y = 0 }, e_nation::dutch )
+          .id();
+
+  change_colony_nation( W.colonies(), W.units(), colony.id,
+                        e_nation::english );
+  REQUIRE( colony.nation == e_nation::english );
+  REQUIRE( W.colonies().for_nation( e_nation::dutch ).empty() );
+  REQUIRE( W.colonies().for_nation( e_nation::english ).size() ==
+           1 );
+  REQUIRE( W.units().unit_for( soldier ).nation() ==
+           e_nation::english );
+  span<UnitId const> const dutch_units =
+      W.units().euro_units_for_nation( e_nation::dutch );
+  REQUIRE( vector<UnitId>( dutch_units.begin(),
+                           dutch_units.end() ) ==
+           vector<UnitId>{ ship } );
+}
+
 TEST_CASE( "[colony-mgr] initial colony buildings." ) {
   World   W;
   Colony& colony =
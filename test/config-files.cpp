@@ -0,0 +1,61 @@
+/****************************************************************
+**config-files.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/config-files.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/config-files.hpp"
+
+// rcl
+#include "src/rcl/model.hpp"
+#include "src/rcl/parse.hpp"
+
+// rds
+#include "src/rds/config-helper.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+// Parses every config file that has a registered populator.
+vector<pair<rds::PopulatorFunc const*, rcl::doc>>
+parse_all_configs() {
+  vector<pair<rds::PopulatorFunc const*, rcl::doc>> res;
+  for( auto const& [name, populator] :
+       rds::config_populators() ) {
+    UNWRAP_CHECK(
+        doc, rcl::parse_file( config_file_for_name( name ) ) );
+    res.emplace_back( &populator, std::move( doc ) );
+  }
+  return res;
+}
+
+TEST_CASE( "[config-files] config_file_for_name" ) {
+  REQUIRE( config_file_for_name( "rn" ) == "config/rcl/rn.rcl" );
+  REQUIRE( config_file_for_name( "unit_type" ) ==
+           "config/rcl/unit-type.rcl" );
+}
+
+TEST_CASE( "[config-files] populate" ) {
+  REQUIRE( configs_loaded() );
+  auto const docs = parse_all_configs();
+  REQUIRE( !docs.empty() );
+  // The configs have already been loaded once, so this tests
+  // that they can be reloaded.
+  for( auto const& [populator, doc] : docs )
+    REQUIRE( ( *populator )( doc.top_val() ).valid() );
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,357 @@
+/****************************************************************
+**recording-gl.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: IOpenGL implementation that needs no GPU, for
+*              tests and benchmarks.
+*
+*****************************************************************/
+#include "recording-gl.hpp"
+
+// base
+#include "base/error.hpp"
+
+// C++ standard library
+#include <algorithm>
+#include <cstring>
+#include <regex>
+
+using namespace std;
+
+namespace gl {
+
+namespace {
+
+GLenum attrib_type_from_glsl( string const& type ) {
+  if( type == "int" ) return GL_INT;
+  if( type == "float" ) return GL_FLOAT;
+  if( type == "vec2" ) return GL_FLOAT_VEC2;
+  if( type == "vec3" ) return GL_FLOAT_VEC3;
+  if( type == "vec4" ) return GL_FLOAT_VEC4;
+  FATAL( "unsupported vertex attribute type: {}", type );
+}
+
+void copy_c_str( string_view from, GLsizei buf_size,
+                 GLsizei* length, GLchar* to ) {
+  if( buf_size <= 0 ) return;
+  size_t const n =
+      std::min( from.size(), size_t( buf_size - 1 ) );
+  memcpy( to, from.data(), n );
+  to[n] = '\0';
+  if( length != nullptr ) *length = GLsizei( n );
+}
+
+} // namespace
+
+/****************************************************************
+** RecordingOpenGL
+*****************************************************************/
+RecordingOpenGL::RecordingOpenGL() {
+  prev_ = global_gl_implementation();
+  set_global_gl_implementation( this );
+}
+
+RecordingOpenGL::~RecordingOpenGL() {
+  set_global_gl_implementation( prev_ );
+}
+
+GLuint RecordingOpenGL::next_id() { return ++last_id_; }
+
+void RecordingOpenGL::gen_ids( GLsizei n, GLuint* ids ) {
+  for( GLsizei i = 0; i < n; ++i ) ids[i] = next_id();
+}
+
+void RecordingOpenGL::gl_AttachShader( GLuint program,
+                                       GLuint shader ) {
+  ++stats_.calls;
+  attached_[program].push_back( shader );
+}
+
+void RecordingOpenGL::gl_BindBuffer( GLenum target,
+                                     GLuint buffer ) {
+  ++stats_.calls;
+  if( target == GL_ARRAY_BUFFER ) array_buffer_binding_ = buffer;
+}
+
+void RecordingOpenGL::gl_BindVertexArray( GLuint array ) {
+  ++stats_.calls;
+  vertex_array_binding_ = array;
+}
+
+void RecordingOpenGL::gl_BufferData( GLenum, GLsizeiptr size,
+                                     void const*, GLenum ) {
+  ++stats_.calls;
+  stats_.bytes_uploaded += size;
+}
+
+void RecordingOpenGL::gl_BufferSubData( GLenum, GLintptr,
+                                        GLsizeiptr size,
+                                        void const* ) {
+  ++stats_.calls;
+  stats_.bytes_uploaded += size;
+}
+
+void RecordingOpenGL::gl_CompileShader( GLuint ) {
+  ++stats_.calls;
+}
+
+GLuint RecordingOpenGL::gl_CreateProgram() {
+  ++stats_.calls;
+  return next_id();
+}
+
+GLuint RecordingOpenGL::gl_CreateShader( GLenum ) {
+  ++stats_.calls;
+  return next_id();
+}
+
+void RecordingOpenGL::gl_DeleteBuffers( GLsizei,
+                                        GLuint const* ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_DeleteProgram( GLuint program ) {
+  ++stats_.calls;
+  attached_.erase( program );
+  program_attribs_.erase( program );
+}
+
+void RecordingOpenGL::gl_DeleteShader( GLuint shader ) {
+  ++stats_.calls;
+  shader_attribs_.erase( shader );
+}
+
+void RecordingOpenGL::gl_DeleteVertexArrays( GLsizei,
+                                             GLuint const* ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_DetachShader( GLuint program,
+                                       GLuint shader ) {
+  ++stats_.calls;
+  erase( attached_[program], shader );
+}
+
+void RecordingOpenGL::gl_DrawArrays( GLenum, GLint,
+                                     GLsizei count ) {
+  ++stats_.calls;
+  ++stats_.draw_calls;
+  stats_.vertices_drawn += count;
+}
+
+void RecordingOpenGL::gl_EnableVertexAttribArray( GLuint ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_GenBuffers( GLsizei n,
+                                     GLuint* buffers ) {
+  ++stats_.calls;
+  gen_ids( n, buffers );
+}
+
+void RecordingOpenGL::gl_GenVertexArrays( GLsizei n,
+                                          GLuint* arrays ) {
+  ++stats_.calls;
+  gen_ids( n, arrays );
+}
+
+void RecordingOpenGL::gl_GetActiveAttrib(
+    GLuint program, GLuint index, GLsizei bufSize,
+    GLsizei* length, GLint* size, GLenum* type, GLchar* name ) {
+  ++stats_.calls;
+  vector<Attrib> const& attribs = program_attribs_[program];
+  CHECK_LT( index, attribs.size() );
+  Attrib const& attrib = attribs[index];
+  *size                = 1;
+  *type                = attrib.type;
+  copy_c_str( attrib.name, bufSize, length, name );
+}
+
+GLint RecordingOpenGL::gl_GetAttribLocation(
+    GLuint program, GLchar const* name ) {
+  ++stats_.calls;
+  for( Attrib const& attrib : program_attribs_[program] )
+    if( attrib.name == name ) return attrib.location;
+  return -1;
+}
+
+GLenum RecordingOpenGL::gl_GetError() {
+  ++stats_.calls;
+  return GL_NO_ERROR;
+}
+
+void RecordingOpenGL::gl_GetIntegerv( GLenum pname,
+                                      GLint* data ) {
+  ++stats_.calls;
+  switch( pname ) {
+    case GL_VERTEX_ARRAY_BINDING:
+      *data = vertex_array_binding_;
+      break;
+    case GL_ARRAY_BUFFER_BINDING:
+      *data = array_buffer_binding_;
+      break;
+    case GL_TEXTURE_BINDING_2D:
+      *data = texture_binding_2d_;
+      break;
+    case GL_MAX_VERTEX_ATTRIBS: //
+      *data = 16;
+      break;
+    default: //
+      *data = 0;
+      break;
+  }
+}
+
+void RecordingOpenGL::gl_GetProgramInfoLog( GLuint,
+                                            GLsizei  bufSize,
+                                            GLsizei* length,
+                                            GLchar*  infoLog ) {
+  ++stats_.calls;
+  copy_c_str( "", bufSize, length, infoLog );
+}
+
+void RecordingOpenGL::gl_GetProgramiv( GLuint program,
+                                       GLenum pname,
+                                       GLint* params ) {
+  ++stats_.calls;
+  switch( pname ) {
+    case GL_ACTIVE_ATTRIBUTES:
+      *params = GLint( program_attribs_[program].size() );
+      break;
+    case GL_LINK_STATUS:
+    case GL_VALIDATE_STATUS: //
+      *params = GL_TRUE;
+      break;
+    default: //
+      *params = 0;
+      break;
+  }
+}
+
+void RecordingOpenGL::gl_GetShaderInfoLog( GLuint,
+                                           GLsizei  bufSize,
+                                           GLsizei* length,
+                                           GLchar*  infoLog ) {
+  ++stats_.calls;
+  copy_c_str( "", bufSize, length, infoLog );
+}
+
+void RecordingOpenGL::gl_GetShaderiv( GLuint, GLenum pname,
+                                      GLint* params ) {
+  ++stats_.calls;
+  *params = ( pname == GL_COMPILE_STATUS ) ? GL_TRUE : 0;
+}
+
+GLint RecordingOpenGL::gl_GetUniformLocation(
+    GLuint, GLchar const* name ) {
+  ++stats_.calls;
+  auto [it, inserted] =
+      uniforms_.try_emplace( name, GLint( uniforms_.size() ) );
+  return it->second;
+}
+
+void RecordingOpenGL::gl_LinkProgram( GLuint program ) {
+  ++stats_.calls;
+  vector<Attrib>& attribs = program_attribs_[program];
+  attribs.clear();
+  for( GLuint const shader : attached_[program] )
+    for( Attrib const& attrib : shader_attribs_[shader] )
+      attribs.push_back( attrib );
+}
+
+void RecordingOpenGL::gl_ShaderSource(
+    GLuint shader, GLsizei count, GLchar const* const* string,
+    GLint const* length ) {
+  ++stats_.calls;
+  std::string source;
+  for( GLsizei i = 0; i < count; ++i ) {
+    if( length != nullptr && length[i] >= 0 )
+      source.append( string[i], length[i] );
+    else
+      source.append( string[i] );
+  }
+  static regex const kAttrib(
+      R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+)"
+      R"((\w+)\s+(\w+)\s*;)" );
+  vector<Attrib>& attribs = shader_attribs_[shader];
+  attribs.clear();
+  for( sregex_iterator it( source.begin(), source.end(),
+                           kAttrib );
+       it != sregex_iterator(); ++it )
+    attribs.push_back(
+        Attrib{ .location = stoi( ( *it )[1] ),
+                .type = attrib_type_from_glsl( ( *it )[2] ),
+                .name = ( *it )[3] } );
+}
+
+void RecordingOpenGL::gl_Uniform1f( GLint, GLfloat ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_Uniform1i( GLint, GLint ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_Uniform2f( GLint, GLfloat, GLfloat ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_UseProgram( GLuint ) { ++stats_.calls; }
+
+void RecordingOpenGL::gl_ValidateProgram( GLuint ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_VertexAttribPointer( GLuint, GLint,
+                                              GLenum, GLboolean,
+                                              GLsizei,
+                                              void const* ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_VertexAttribIPointer( GLuint, GLint,
+                                               GLenum, GLsizei,
+                                               void const* ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_GenTextures( GLsizei n,
+                                      GLuint* textures ) {
+  ++stats_.calls;
+  gen_ids( n, textures );
+}
+
+void RecordingOpenGL::gl_DeleteTextures( GLsizei,
+                                         GLuint const* ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_BindTexture( GLenum target,
+                                      GLuint texture ) {
+  ++stats_.calls;
+  if( target == GL_TEXTURE_2D ) texture_binding_2d_ = texture;
+}
+
+void RecordingOpenGL::gl_TexParameteri( GLenum, GLenum, GLint ) {
+  ++stats_.calls;
+}
+
+void RecordingOpenGL::gl_TexImage2D( GLenum, GLint, GLint,
+                                     GLsizei width,
+                                     GLsizei height, GLint,
+                                     GLenum, GLenum,
+                                     void const* ) {
+  ++stats_.calls;
+  // Assumes RGBA8, which is all that the renderer uses.
+  stats_.bytes_uploaded += long( width ) * height * 4;
+}
+
+void RecordingOpenGL::gl_Viewport( GLint, GLint, GLsizei,
+                                   GLsizei ) {
+  ++stats_.calls;
+}
+
+} // namespace gl
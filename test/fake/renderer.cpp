@@ -0,0 +1,63 @@
+/****************************************************************
+**renderer.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: A real renderer that needs no GPU, for tests and
+*              benchmarks.
+*
+*****************************************************************/
+#include "test/fake/renderer.hpp"
+
+// Testing
+#include "test/testing.hpp"
+
+// Revolution Now
+#include "src/tiles.hpp"
+
+// render
+#include "src/render/renderer.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+
+using namespace std;
+
+namespace rn::testing {
+
+namespace {
+
+rr::SpriteSheetConfig synthetic_sprite_sheet() {
+  rr::SpriteSheetConfig res{
+      .img_path =
+          ::testing::data_dir() / "images/64w_x_32h.png",
+      .sprite_size = { .w = 32, .h = 32 },
+      .sprites     = {} };
+  for( e_tile tile : refl::enum_values<e_tile> )
+    res.sprites[string( refl::enum_value_name( tile ) )] =
+        gfx::point{ .x = 0, .y = 0 };
+  return res;
+}
+
+} // namespace
+
+FakeRenderer::FakeRenderer() {
+  vector<rr::SpriteSheetConfig> const sprite_sheets{
+      synthetic_sprite_sheet() };
+  vector<rr::AsciiFontSheetConfig> const font_sheets;
+
+  rr::RendererConfig const config{
+      .logical_screen_size = { .w = 640, .h = 360 },
+      .max_atlas_size      = { .w = 3000, .h = 2000 },
+      .sprite_sheets       = sprite_sheets,
+      .font_sheets         = font_sheets,
+  };
+  renderer_ = rr::Renderer::create( config, [] {} );
+  load_tile_atlas_ids( *renderer_ );
+}
+
+FakeRenderer::~FakeRenderer() = default;
+
+} // namespace rn::testing
@@ -0,0 +1,44 @@
+/****************************************************************
+**renderer.hpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: A real renderer that needs no GPU, for tests and
+*              benchmarks.
+*
+*****************************************************************/
+#pragma once
+
+// Testing
+#include "test/fake/recording-gl.hpp"
+
+// C++ standard library
+#include <memory>
+
+namespace rr {
+struct Renderer;
+}
+
+namespace rn::testing {
+
+// A real renderer sitting on top of a RecordingOpenGL. The real
+// sprite sheets are not needed to run code that renders, so
+// every tile is mapped to the same sprite in a small test image;
+// the tile atlas IDs are loaded on construction.
+struct FakeRenderer {
+  FakeRenderer();
+  ~FakeRenderer();
+
+  rr::Renderer& renderer() { return *renderer_; }
+
+  gl::RecordingOpenGL& gl() { return gl_; }
+
+ private:
+  // Must come first since the renderer uses it.
+  gl::RecordingOpenGL           gl_;
+  std::unique_ptr<rr::Renderer> renderer_;
+};
+
+} // namespace rn::testing
@@ -0,0 +1,101 @@
+/****************************************************************
+**frame-timing.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/frame-timing.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/frame-timing.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+using namespace std::chrono;
+
+TEST_CASE( "[frame-timing] empty histogram" ) {
+  FrameTimeHistogram h;
+  REQUIRE( h.count() == 0 );
+  REQUIRE( h.percentile( 50 ) == 0us );
+  REQUIRE( h.max() == 0us );
+  REQUIRE( h.mean() == 0us );
+}
+
+TEST_CASE( "[frame-timing] small values are exact" ) {
+  FrameTimeHistogram h;
+  for( int i = 1; i <= 20; ++i ) h.record( microseconds( i ) );
+  REQUIRE( h.count() == 20 );
+  REQUIRE( h.percentile( 0 ) == 1us );
+  REQUIRE( h.percentile( 50 ) == 10us );
+  REQUIRE( h.percentile( 100 ) == 20us );
+  REQUIRE( h.max() == 20us );
+  REQUIRE( h.mean() == 10us );
+}
+
+TEST_CASE( "[frame-timing] large values are approximate" ) {
+  FrameTimeHistogram h;
+  // 99 normal frames and one hitch.
+  for( int i = 0; i < 99; ++i ) h.record( 16'667us );
+  h.record( 250'000us );
+  REQUIRE( h.count() == 100 );
+  // Buckets are accurate to within 1/16.
+  REQUIRE( h.percentile( 50 ) >= 16'667us );
+  REQUIRE( h.percentile( 50 ) <= 16'667us + 16'667us / 16 );
+  REQUIRE( h.percentile( 99 ) == h.percentile( 50 ) );
+  // The max is exact, and bounds the percentiles.
+  REQUIRE( h.max() == 250'000us );
+  REQUIRE( h.percentile( 100 ) == 250'000us );
+}
+
+TEST_CASE( "[frame-timing] clamping and reset" ) {
+  FrameTimeHistogram h;
+  h.record( -5us );
+  h.record( hours( 1 ) );
+  REQUIRE( h.count() == 2 );
+  REQUIRE( h.percentile( 0 ) == 0us );
+  REQUIRE( h.max() ==
+           microseconds( FrameTimeHistogram::kMaxMicros ) );
+  h.reset();
+  REQUIRE( h.count() == 0 );
+  REQUIRE( h.max() == 0us );
+}
+
+TEST_CASE( "[frame-timing] report" ) {
+  reset_frame_timings();
+  FramePhaseDurations durations;
+  durations[e_frame_phase::draw] = 3ms;
+  record_frame_phases( durations );
+  REQUIRE( frame_phase_histogram( e_frame_phase::draw ).max() ==
+           3000us );
+  REQUIRE( frame_phase_histogram( e_frame_phase::upload ).max() ==
+           0us );
+  vector<string> const report = frame_timing_report();
+  // Header plus one per phase plus input latency.
+  REQUIRE( report.size() ==
+           size_t( refl::enum_count<e_frame_phase> + 2 ) );
+  REQUIRE( report[0].starts_with( "phase" ) );
+  REQUIRE( report.back().starts_with( "input-latency" ) );
+  reset_frame_timings();
+}
+
+TEST_CASE( "[frame-timing] input latency" ) {
+  reset_frame_timings();
+  record_input_latency( 5ms );
+  record_input_latency( 20ms );
+  REQUIRE( input_latency_histogram().count() == 2 );
+  REQUIRE( input_latency_histogram().max() == 20'000us );
+  reset_frame_timings();
+  REQUIRE( input_latency_histogram().count() == 0 );
+}
+
+} // namespace
+} // namespace rn
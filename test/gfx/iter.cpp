@@ -13,6 +13,9 @@
 // Under test.
 #include "src/gfx/iter.hpp"
 
+// C++ standard library
+#include <vector>
+
 // Must be last.
 #include "test/catch-common.hpp"
 
@@ -154,5 +157,67 @@ TEST_CASE( "[gfx/iter] subrects non-even multiple" ) {
   REQUIRE( it == iterable.end() );
 }
 
+template<typename RectT, typename SizeT>
+vector<RectT> from_generator( RectT r, SizeT chunk ) {
+  vector<RectT> res;
+  for( RectT const sub : subrects( r, chunk ) )
+    res.push_back( sub );
+  return res;
+}
+
+template<typename RectT, typename SizeT>
+vector<RectT> from_range( RectT r, SizeT chunk ) {
+  vector<RectT> res;
+  for( RectT const sub : subrect_range( r, chunk ) )
+    res.push_back( sub );
+  return res;
+}
+
+TEST_CASE( "[gfx/iter] subrect_range same as subrects" ) {
+  vector<size> const chunks{ { .w = 1, .h = 1 },
+                             { .w = 2, .h = 3 },
+                             { .w = 32, .h = 32 } };
+  vector<rect> const rects{
+      { .origin = { .x = 64, .y = 32 },
+        .size   = { .w = 32 * 3, .h = 32 * 2 } },
+      { .origin = { .x = 64, .y = 32 },
+        .size   = { .w = 32 * 3 + 3, .h = 32 * 2 + 4 } },
+      { .origin = { .x = -3, .y = -5 },
+        .size   = { .w = 7, .h = 4 } },
+      { .origin = { .x = 1, .y = 1 },
+        .size   = { .w = 1, .h = 1 } },
+      { .origin = { .x = 1, .y = 1 },
+        .size   = { .w = 0, .h = 5 } },
+      { .origin = { .x = 1, .y = 1 },
+        .size   = { .w = 5, .h = 0 } },
+      { .origin = { .x = 1, .y = 1 },
+        .size   = { .w = 0, .h = 0 } },
+  };
+  for( rect const r : rects ) {
+    for( size const chunk : chunks ) {
+      REQUIRE( from_range( r, chunk ) ==
+               from_generator( r, chunk ) );
+      rn::Rect const  rn_r     = rn::Rect::from_gfx( r );
+      rn::Delta const rn_chunk = { .w = chunk.w, .h = chunk.h };
+      REQUIRE( from_range( rn_r, rn_chunk ) ==
+               from_generator( rn_r, rn_chunk ) );
+    }
+  }
+}
+
+TEST_CASE( "[gfx/iter] subrect_range default chunk" ) {
+  rn::Rect const r{ .x = 2, .y = 3, .w = 2, .h = 2 };
+  vector<rn::Coord> coords;
+  for( rn::Rect const sub : subrect_range( r ) ) {
+    REQUIRE( sub.delta() == rn::Delta{ .w = 1, .h = 1 } );
+    coords.push_back( sub.upper_left() );
+  }
+  vector<rn::Coord> const expected{ { .x = 2, .y = 3 },
+                                    { .x = 3, .y = 3 },
+                                    { .x = 2, .y = 4 },
+                                    { .x = 3, .y = 4 } };
+  REQUIRE( coords == expected );
+}
+
 } // namespace
 } // namespace gfx
@@ -0,0 +1,99 @@
+/****************************************************************
+**input.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/input.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/input.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn::input {
+namespace {
+
+using namespace std;
+
+mouse_move_event_t motion( Coord prev, Coord pos ) {
+  mouse_move_event_t event;
+  event.prev = prev;
+  event.pos  = pos;
+  return event;
+}
+
+mouse_drag_event_t drag( Coord prev, Coord pos,
+                         e_drag_phase phase ) {
+  mouse_drag_event_t event;
+  event.prev         = prev;
+  event.pos          = pos;
+  event.button       = e_mouse_button::l;
+  event.state.origin = Coord{ .x = 1, .y = 1 };
+  event.state.phase  = phase;
+  event.l_mouse_down = true;
+  return event;
+}
+
+TEST_CASE( "[input] coalesce mouse motion" ) {
+  event_t into =
+      motion( { .x = 1, .y = 1 }, { .x = 2, .y = 3 } );
+  REQUIRE( coalesce_events(
+      into, motion( { .x = 2, .y = 3 }, { .x = 5, .y = 4 } ) ) );
+  auto const& merged = into.get<mouse_move_event_t>();
+  REQUIRE( merged.prev == Coord{ .x = 1, .y = 1 } );
+  REQUIRE( merged.pos == Coord{ .x = 5, .y = 4 } );
+  REQUIRE( merged.delta() == Delta{ .w = 4, .h = 3 } );
+
+  // Not when a button changes.
+  mouse_move_event_t pressed =
+      motion( { .x = 5, .y = 4 }, { .x = 6, .y = 4 } );
+  pressed.l_mouse_down = true;
+  REQUIRE_FALSE( coalesce_events( into, pressed ) );
+
+  // Nor with other kinds of events.
+  REQUIRE_FALSE( coalesce_events( into, key_event_t{} ) );
+  event_t key = key_event_t{};
+  REQUIRE_FALSE( coalesce_events(
+      key, motion( { .x = 5, .y = 4 }, { .x = 6, .y = 4 } ) ) );
+}
+
+TEST_CASE( "[input] coalesce drag" ) {
+  event_t into = drag( { .x = 1, .y = 1 }, { .x = 2, .y = 1 },
+                       e_drag_phase::begin );
+  REQUIRE( coalesce_events(
+      into, drag( { .x = 2, .y = 1 }, { .x = 4, .y = 1 },
+                  e_drag_phase::in_progress ) ) );
+  REQUIRE( coalesce_events(
+      into, drag( { .x = 4, .y = 1 }, { .x = 4, .y = 6 },
+                  e_drag_phase::in_progress ) ) );
+  auto const& merged = into.get<mouse_drag_event_t>();
+  REQUIRE( merged.state.phase == e_drag_phase::begin );
+  REQUIRE( merged.prev == Coord{ .x = 1, .y = 1 } );
+  REQUIRE( merged.pos == Coord{ .x = 4, .y = 6 } );
+
+  // The end of the drag is kept.
+  REQUIRE_FALSE( coalesce_events(
+      into, drag( { .x = 4, .y = 6 }, { .x = 4, .y = 7 },
+                  e_drag_phase::end ) ) );
+  event_t end = drag( { .x = 4, .y = 6 }, { .x = 4, .y = 7 },
+                      e_drag_phase::end );
+  REQUIRE_FALSE( coalesce_events(
+      end, drag( { .x = 4, .y = 7 }, { .x = 4, .y = 8 },
+                 e_drag_phase::in_progress ) ) );
+
+  // A different drag is not merged.
+  mouse_drag_event_t other =
+      drag( { .x = 4, .y = 6 }, { .x = 4, .y = 7 },
+            e_drag_phase::in_progress );
+  other.state.origin = Coord{ .x = 9, .y = 9 };
+  REQUIRE_FALSE( coalesce_events( into, other ) );
+}
+
+} // namespace
+} // namespace rn::input
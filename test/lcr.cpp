@@ -22,6 +22,7 @@
 // Revolution Now
 #include "imap-updater.hpp"
 #include "ustate.hpp"
+#include "visibility.hpp"
 
 // ss
 #include "ss/players.hpp"
@@ -375,6 +376,10 @@ TEST_CASE( "[lcr] unit lost" ) {
       W.player_square( Coord{} );
   square.lost_city_rumor = true;
   REQUIRE( !player_square.has_value() );
+  auto player_view = [&]() -> MapSquare const& {
+    return Visibility::create( W.ss(), player.nation )
+        .square_at( Coord{} );
+  };
 
   // Create unit on map.
   UnitId unit_id =
@@ -382,7 +387,7 @@ TEST_CASE( "[lcr] unit lost" ) {
           .id();
   REQUIRE( W.units().all().size() == 1 );
   REQUIRE( player_square.has_value() );
-  REQUIRE( player_square->square.lost_city_rumor == true );
+  REQUIRE( player_view().lost_city_rumor == true );
 
   // Set outcome types.
   e_rumor_type         rumor_type = e_rumor_type::unit_lost;
@@ -416,7 +421,7 @@ TEST_CASE( "[lcr] unit lost" ) {
   // will still appear to be there to the player until they move
   // another unit near it, at which point it will disappear mys-
   // teriously.
-  REQUIRE( player_square->square.lost_city_rumor == false );
+  REQUIRE( player_view().lost_city_rumor == false );
 }
 
 TEST_CASE( "[lcr] cibola / treasure" ) {
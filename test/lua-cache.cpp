@@ -0,0 +1,120 @@
+/****************************************************************
+**lua-cache.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/lua-cache.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/lua-cache.hpp"
+
+// luapp
+#include "luapp/state.hpp"
+
+// C++ standard library
+#include <fstream>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+void write_file( fs::path const& p, string_view contents ) {
+  ofstream out( p, ios::binary );
+  out.write( contents.data(), contents.size() );
+}
+
+TEST_CASE( "[lua-cache] cache entries" ) {
+  string const source   = "return 5";
+  string const bytecode = "some bytes";
+  string const entry = make_lua_cache_entry( source, bytecode );
+  REQUIRE( lua_cache_entry_bytecode( entry, source ) ==
+           bytecode );
+
+  // Different source.
+  REQUIRE( lua_cache_entry_bytecode( entry, "return 6" ) ==
+           nothing );
+  REQUIRE( lua_cache_entry_bytecode( entry, "return 55" ) ==
+           nothing );
+  // Truncated.
+  string_view const truncated( entry.data(), entry.size() - 1 );
+  REQUIRE( lua_cache_entry_bytecode( truncated, source ) ==
+           nothing );
+  REQUIRE( lua_cache_entry_bytecode( "", source ) == nothing );
+  // Bad magic.
+  string corrupt = entry;
+  corrupt[0]     = 'x';
+  REQUIRE( lua_cache_entry_bytecode( corrupt, source ) ==
+           nothing );
+  // Corrupted bytecode.
+  corrupt        = entry;
+  corrupt.back() = 'x';
+  REQUIRE( lua_cache_entry_bytecode( corrupt, source ) ==
+           nothing );
+
+  REQUIRE( lua_source_hash( "a" ) != lua_source_hash( "b" ) );
+}
+
+TEST_CASE( "[lua-cache] load_lua_file" ) {
+  fs::path const dir       = "/tmp/test-lua-cache";
+  fs::path const cache_dir = dir / "cache";
+  fs::path const file      = dir / "module.lua";
+  fs::remove_all( dir );
+  fs::create_directories( dir );
+  write_file( file, "local x = ...; return { y=x*2 }" );
+  // The cache mirrors the path of the source file.
+  fs::path const cache_file =
+      cache_dir / "tmp/test-lua-cache/module.luac";
+
+  lua::state st;
+  auto       y = []( LuaChunk const& chunk, int x ) {
+    return chunk.fn.call<lua::table>( x )["y"].as<int>();
+  };
+
+  SECTION( "no cache" ) {
+    LuaChunk const chunk = load_lua_file( st, file, nothing );
+    REQUIRE_FALSE( chunk.from_cache );
+    REQUIRE( y( chunk, 3 ) == 6 );
+    REQUIRE_FALSE( fs::exists( cache_dir ) );
+  }
+
+  SECTION( "with cache" ) {
+    LuaChunk const first = load_lua_file( st, file, cache_dir );
+    REQUIRE_FALSE( first.from_cache );
+    REQUIRE( y( first, 3 ) == 6 );
+    REQUIRE( fs::exists( cache_file ) );
+
+    LuaChunk const second = load_lua_file( st, file, cache_dir );
+    REQUIRE( second.from_cache );
+    REQUIRE( y( second, 4 ) == 8 );
+
+    // Changing the source invalidates the cache.
+    write_file( file, "local x = ...; return { y=x*3 }" );
+    LuaChunk const third = load_lua_file( st, file, cache_dir );
+    REQUIRE_FALSE( third.from_cache );
+    REQUIRE( y( third, 4 ) == 12 );
+    LuaChunk const fourth = load_lua_file( st, file, cache_dir );
+    REQUIRE( fourth.from_cache );
+    REQUIRE( y( fourth, 5 ) == 15 );
+
+    // A corrupt cache file is ignored and then rewritten.
+    write_file( cache_file, "garbage" );
+    LuaChunk const fifth = load_lua_file( st, file, cache_dir );
+    REQUIRE_FALSE( fifth.from_cache );
+    REQUIRE( y( fifth, 5 ) == 15 );
+    REQUIRE( load_lua_file( st, file, cache_dir ).from_cache );
+  }
+
+  fs::remove_all( dir );
+}
+
+} // namespace
+} // namespace rn
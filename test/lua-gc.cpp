@@ -0,0 +1,94 @@
+/****************************************************************
+**lua-gc.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/lua-gc.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/lua-gc.hpp"
+
+// config
+#include "config/rn.rds.hpp"
+
+// luapp
+#include "luapp/c-api.hpp"
+#include "luapp/state.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+using namespace std::chrono_literals;
+
+TEST_CASE( "[lua-gc] scheduler" ) {
+  lua::state    st;
+  lua::c_api    C( st.thread.main().cthread() );
+  e_lua_gc_mode mode = {};
+
+  SECTION( "incremental" ) {
+    mode = e_lua_gc_mode::incremental;
+    C.gc_incremental( 0, 0, 0 );
+  }
+  SECTION( "generational" ) {
+    mode = e_lua_gc_mode::generational;
+    C.gc_generational( 0, 0 );
+  }
+
+  LuaGcScheduler scheduler( st, mode, /*idle_pause=*/150 );
+  REQUIRE( scheduler.stats().cycles_finished == 0 );
+
+  // Nothing allocated, so nothing to do.
+  scheduler.run_frame( 1s );
+  REQUIRE( scheduler.stats().frame_steps == 0 );
+  REQUIRE( scheduler.stats().frame_time == 0us );
+  REQUIRE( scheduler.stats().heap_bytes > 0 );
+  int64_t const base = scheduler.stats().heap_bytes;
+
+  st.script.run(
+      "x = {} for i=1,10000 do x[i] = {} end x = nil" );
+
+  // No budget.
+  scheduler.run_frame( 0us );
+  REQUIRE( scheduler.stats().frame_steps == 0 );
+  REQUIRE( scheduler.stats().heap_bytes > base * 3 / 2 );
+
+  // The heap has grown enough to start a cycle, and with this
+  // budget it should finish.
+  scheduler.run_frame( 1s );
+  REQUIRE( scheduler.stats().frame_steps > 0 );
+  REQUIRE( scheduler.stats().cycles_finished == 1 );
+
+  // The cycle has ended and there has not been enough growth
+  // since then to start another, so idle frames do no work.
+  for( int i = 0; i < 3; ++i ) {
+    scheduler.run_frame( 1s );
+    REQUIRE( scheduler.stats().frame_steps == 0 );
+    REQUIRE( scheduler.stats().frame_time == 0us );
+    REQUIRE( scheduler.stats().cycles_finished == 1 );
+  }
+}
+
+TEST_CASE( "[lua-gc] frame scheduler" ) {
+  REQUIRE( frame_lua_gc_stats() == nothing );
+  lua::state     st;
+  LuaGcScheduler scheduler( st, config_rn.lua.gc.mode,
+                            /*idle_pause=*/150 );
+  set_frame_lua_gc_scheduler( &scheduler );
+  run_frame_lua_gc( 10ms );
+  REQUIRE( frame_lua_gc_stats().has_value() );
+  REQUIRE( frame_lua_gc_stats()->heap_bytes > 0 );
+  set_frame_lua_gc_scheduler( nullptr );
+  REQUIRE( frame_lua_gc_stats() == nothing );
+}
+
+} // namespace
+} // namespace rn
@@ -1951,6 +1951,29 @@ LUA_TEST_CASE( "[lua-c-api] resetthread" ) {
   }
 }
 
+LUA_TEST_CASE( "[lua-c-api] gc step and count" ) {
+  C.gc_incremental( /*pause=*/200, /*stepmul=*/100,
+                    /*stepsize=*/13 );
+  C.gc_collect();
+  int64_t const base = C.gc_count_bytes();
+  REQUIRE( base > 0 );
+  REQUIRE( C.dostring( "x = {} for i=1,10000 do x[i] = {} end "
+                       "x = nil" ) == valid );
+  REQUIRE( C.gc_count_bytes() > base );
+  // Stepping eventually finishes the cycle and frees the garbage.
+  // Do two cycles since one may have started before the garbage
+  // was released.
+  for( int i = 0; i < 2; ++i )
+    while( !C.gc_step( /*kbytes=*/0 ) ) {}
+  REQUIRE( C.gc_count_bytes() < base + 1024 );
+  REQUIRE( C.stack_size() == 0 );
+
+  C.gc_generational( /*minormul=*/20, /*majormul=*/100 );
+  REQUIRE( C.dostring( "y = {}" ) == valid );
+  C.gc_step( /*kbytes=*/0 );
+  REQUIRE( C.gc_count_bytes() > 0 );
+}
+
 LUA_TEST_CASE( "[lua-c-api] resume_or_leak" ) {
   C.openlibs();
   st.script.run( R"(
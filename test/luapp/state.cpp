@@ -89,6 +89,15 @@ LUA_TEST_CASE( "[lua-state] state indexing" ) {
   REQUIRE( ( G["a"][5] != st["a"] ) );
 }
 
+LUA_TEST_CASE( "[lua-state] registry" ) {
+  table R  = st.table.registry();
+  R["abc"] = 5;
+  table R2 = st.table.registry();
+  REQUIRE( R2["abc"] == 5 );
+  REQUIRE( st["abc"] == nil );
+  REQUIRE( C.stack_size() == 0 );
+}
+
 LUA_TEST_CASE( "[lua-state] script loading" ) {
   rfunction f = st.script.load( R"(
     return 'hello'
@@ -97,6 +106,29 @@ LUA_TEST_CASE( "[lua-state] script loading" ) {
   REQUIRE( f() == "hello" );
 }
 
+LUA_TEST_CASE( "[lua-state] script load chunk and dump" ) {
+  lua_expect<rfunction> f =
+      st.script.load_chunk_safe( "return ... * 2", "@f.lua" );
+  REQUIRE( f.has_value() );
+  REQUIRE( f->call<int>( 3 ) == 6 );
+
+  lua_expect<string> bytecode = st.script.dump( *f );
+  REQUIRE( bytecode.has_value() );
+  REQUIRE( !bytecode->empty() );
+  lua_expect<rfunction> g =
+      st.script.load_chunk_safe( *bytecode, "@f.lua" );
+  REQUIRE( g.has_value() );
+  REQUIRE( g->call<int>( 4 ) == 8 );
+  REQUIRE( C.stack_size() == 0 );
+
+  // Corrupted bytecode is rejected.
+  string bad = *bytecode;
+  bad[5] ^= 0xff;
+  REQUIRE( !st.script.load_chunk_safe( bad, "@f.lua" ) );
+  REQUIRE( !st.script.load_chunk_safe( "x = = 1", "@f.lua" ) );
+  REQUIRE( C.stack_size() == 0 );
+}
+
 LUA_TEST_CASE( "[lua-state] script run unsafe" ) {
   REQUIRE( st.script.run<string>( R"(
     return 'hello'
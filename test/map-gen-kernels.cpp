@@ -0,0 +1,332 @@
+/****************************************************************
+**map-gen-kernels.cpp
+*
+* Project: Revolution Now
+*
+* Created by dsicilia on 2022-12-22.
+*
+* Description: Unit tests for the src/map-gen-kernels.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/map-gen-kernels.hpp"
+
+// Testing
+#include "test/mocks/irand.hpp"
+
+// Revolution Now
+#include "src/lua.hpp"
+#include "src/rand.hpp"
+
+// luapp
+#include "luapp/state.hpp"
+
+// refl
+#include "refl/to-str.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+/****************************************************************
+** Helpers
+*****************************************************************/
+// Builds a map from rows of characters where 'L' is land and
+// anything else is water.
+Matrix<MapSquare> make_map( vector<string> const& rows ) {
+  CHECK( !rows.empty() );
+  Matrix<MapSquare> m( Delta{ .w = int( rows[0].size() ),
+                              .h = int( rows.size() ) } );
+  for( int y = 0; y < int( rows.size() ); ++y ) {
+    CHECK_EQ( rows[y].size(), rows[0].size() );
+    for( int x = 0; x < int( rows[y].size() ); ++x ) {
+      MapSquare& square = m[y][x];
+      if( rows[y][x] == 'L' ) {
+        square.surface = e_surface::land;
+        square.ground  = e_ground_terrain::grassland;
+      } else {
+        square.surface = e_surface::water;
+      }
+    }
+  }
+  return m;
+}
+
+Matrix<MapSquare> make_random_map( Delta size, Rand& rand ) {
+  Matrix<MapSquare> m( size );
+  for( int y = 0; y < size.h; ++y ) {
+    for( int x = 0; x < size.w; ++x ) {
+      MapSquare& square = m[y][x];
+      square.surface    = rand.bernoulli( .4 ) ? e_surface::land
+                                               : e_surface::water;
+      square.ground     = e_ground_terrain::grassland;
+    }
+  }
+  return m;
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[map-gen-kernels] fill_where" ) {
+  MockIRand         rand;
+  Matrix<MapSquare> m = make_map( {
+      "_LL_",
+      "_L__",
+      "____",
+  } );
+
+  MapGenFilter filter;
+  MapGenEdit   edit;
+  Rect const   all = m.rect();
+
+  SECTION( "whole map" ) {
+    edit.sea_lane = true;
+    REQUIRE( fill_where( m, all, filter, edit, rand ) == 12 );
+    for( int y = 0; y < 3; ++y )
+      for( int x = 0; x < 4; ++x ) REQUIRE( m[y][x].sea_lane );
+  }
+
+  SECTION( "by surface" ) {
+    filter.surface = e_surface::land;
+    edit.overlay   = e_land_overlay::hills;
+    REQUIRE( fill_where( m, all, filter, edit, rand ) == 3 );
+    REQUIRE( m[0][1].overlay == e_land_overlay::hills );
+    REQUIRE( m[0][2].overlay == e_land_overlay::hills );
+    REQUIRE( m[1][1].overlay == e_land_overlay::hills );
+    REQUIRE( m[1][2].overlay == nothing );
+  }
+
+  SECTION( "region is clipped" ) {
+    edit.surface = e_surface::land;
+    REQUIRE( fill_where( m,
+                         Rect{ .x = 2, .y = 1, .w = 10, .h = 10 },
+                         filter, edit, rand ) == 4 );
+    REQUIRE( m[2][3].surface == e_surface::land );
+    REQUIRE( m[2][1].surface == e_surface::water );
+    REQUIRE( fill_where( m,
+                         Rect{ .x = 5, .y = 0, .w = 2, .h = 2 },
+                         filter, edit, rand ) == 0 );
+  }
+
+  SECTION( "probability" ) {
+    filter.surface     = e_surface::land;
+    filter.probability = .3;
+    edit.overlay       = e_land_overlay::forest;
+    // Only consulted for squares that pass the other criteria,
+    // and in raster order.
+    EXPECT_CALL( rand, bernoulli( .3 ) ).returns( true );
+    EXPECT_CALL( rand, bernoulli( .3 ) ).returns( false );
+    EXPECT_CALL( rand, bernoulli( .3 ) ).returns( true );
+    REQUIRE( fill_where( m, all, filter, edit, rand ) == 2 );
+    REQUIRE( m[0][1].overlay == e_land_overlay::forest );
+    REQUIRE( m[0][2].overlay == nothing );
+    REQUIRE( m[1][1].overlay == e_land_overlay::forest );
+  }
+
+  SECTION( "one in N" ) {
+    filter.surface = e_surface::land;
+    filter.one_in  = 2;
+    edit.overlay   = e_land_overlay::forest;
+    // Drawn like math.random(1,2)==1 so that the random stream
+    // is consumed as it was by the original Lua code.
+    auto const kClosed = IRand::e_interval::closed;
+    EXPECT_CALL( rand, between_ints( 1, 2, kClosed ) )
+        .returns( 2 );
+    EXPECT_CALL( rand, between_ints( 1, 2, kClosed ) )
+        .returns( 1 );
+    EXPECT_CALL( rand, between_ints( 1, 2, kClosed ) )
+        .returns( 2 );
+    REQUIRE( fill_where( m, all, filter, edit, rand ) == 1 );
+    REQUIRE( m[0][1].overlay == nothing );
+    REQUIRE( m[0][2].overlay == e_land_overlay::forest );
+    REQUIRE( m[1][1].overlay == nothing );
+  }
+
+  SECTION( "near water source" ) {
+    m                        = make_map( {
+        "LLLLL",
+        "LLLLL",
+        "LLLLL",
+        "LLLL_",
+    } );
+    filter.surface           = e_surface::land;
+    filter.near_water_source = true;
+    edit.overlay             = e_land_overlay::hills;
+    REQUIRE( fill_where( m, m.rect(), filter, edit, rand ) == 3 );
+    REQUIRE( m[2][2].overlay == nothing );
+    REQUIRE( m[2][3].overlay == e_land_overlay::hills );
+    REQUIRE( m[2][4].overlay == e_land_overlay::hills );
+    REQUIRE( m[3][3].overlay == e_land_overlay::hills );
+  }
+
+  SECTION( "islands" ) {
+    m                              = make_map( {
+        "L___L",
+        "___LL",
+        "L____",
+        "__L__",
+    } );
+    filter.surface                 = e_surface::land;
+    filter.max_land_component_size = 1;
+    edit.surface                   = e_surface::water;
+    REQUIRE( fill_where( m, m.rect(), filter, edit, rand ) == 3 );
+    REQUIRE( m[0][0].surface == e_surface::water );
+    REQUIRE( m[2][0].surface == e_surface::water );
+    REQUIRE( m[3][2].surface == e_surface::water );
+    REQUIRE( m[0][4].surface == e_surface::land );
+    REQUIRE( m[1][3].surface == e_surface::land );
+  }
+}
+
+TEST_CASE( "[map-gen-kernels] label_components" ) {
+  Matrix<MapSquare> const m = make_map( {
+      "LL__L",
+      "___L_",
+      "L____",
+      "L__LL",
+  } );
+
+  MapComponents const comps =
+      label_components( m, e_surface::land );
+  REQUIRE( comps.count() == 4 );
+  REQUIRE( comps.label_at( { .x = 0, .y = 0 } ) == 1 );
+  REQUIRE( comps.label_at( { .x = 1, .y = 0 } ) == 1 );
+  REQUIRE( comps.label_at( { .x = 2, .y = 0 } ) == 0 );
+  // Diagonal neighbors are connected.
+  REQUIRE( comps.label_at( { .x = 4, .y = 0 } ) == 2 );
+  REQUIRE( comps.label_at( { .x = 3, .y = 1 } ) == 2 );
+  REQUIRE( comps.label_at( { .x = 0, .y = 3 } ) == 3 );
+  REQUIRE( comps.label_at( { .x = 4, .y = 3 } ) == 4 );
+  REQUIRE( comps.label_at( { .x = 9, .y = 9 } ) == 0 );
+  REQUIRE( comps.size_of( 1 ) == 2 );
+  REQUIRE( comps.size_of( 2 ) == 2 );
+  REQUIRE( comps.size_of( 3 ) == 2 );
+  REQUIRE( comps.size_of( 4 ) == 2 );
+  REQUIRE( comps.size_of( 0 ) == 0 );
+  REQUIRE( comps.size_of( 5 ) == 0 );
+
+  MapComponents const water =
+      label_components( m, e_surface::water );
+  REQUIRE( water.count() == 1 );
+  REQUIRE( water.size_of( 1 ) == 12 );
+}
+
+TEST_CASE( "[map-gen-kernels] distance_to_surface" ) {
+  Matrix<MapSquare> m = make_map( {
+      "______",
+      "_L____",
+      "______",
+      "______",
+  } );
+
+  MapDistanceField const dist =
+      distance_to_surface( m, e_surface::land );
+  REQUIRE( dist.at( { .x = 1, .y = 1 } ) == 0 );
+  REQUIRE( dist.at( { .x = 0, .y = 0 } ) == 1 );
+  REQUIRE( dist.at( { .x = 2, .y = 2 } ) == 1 );
+  REQUIRE( dist.at( { .x = 3, .y = 3 } ) == 2 );
+  REQUIRE( dist.at( { .x = 5, .y = 0 } ) == 4 );
+  REQUIRE( dist.at( { .x = 5, .y = 3 } ) == 4 );
+  REQUIRE( dist.at( { .x = 6, .y = 0 } ) ==
+           MapDistanceField::kUnreachable );
+
+  m = make_map( { "___", "___" } );
+  REQUIRE( distance_to_surface( m, e_surface::land )
+               .at( { .x = 1, .y = 1 } ) ==
+           MapDistanceField::kUnreachable );
+}
+
+TEST_CASE( "[map-gen-kernels] select_ground_by_row" ) {
+  MockIRand         rand;
+  Matrix<MapSquare> m = make_map( {
+      "LL_",
+      "L_L",
+  } );
+
+  vector<GroundWeights> const weights{
+      // Row 0.
+      { { e_ground_terrain::plains, .5 },
+        { e_ground_terrain::desert, .5 } },
+      // Row 1.
+      { { nothing, .25 }, { e_ground_terrain::tundra, .75 } },
+  };
+
+  EXPECT_CALL( rand, between_doubles( 0.0, 1.0 ) ).returns( .1 );
+  EXPECT_CALL( rand, between_doubles( 0.0, 1.0 ) ).returns( .6 );
+  EXPECT_CALL( rand, between_doubles( 0.0, 1.0 ) ).returns( .2 );
+  EXPECT_CALL( rand, between_doubles( 0.0, 1.0 ) ).returns( .9 );
+  MapGenFilter const filter{ .surface = e_surface::land };
+  REQUIRE( select_ground_by_row( m, weights, m.rect(), filter,
+                                 rand ) == 3 );
+  REQUIRE( m[0][0].ground == e_ground_terrain::plains );
+  REQUIRE( m[0][1].ground == e_ground_terrain::desert );
+  REQUIRE( m[1][0].ground == e_ground_terrain::grassland );
+  REQUIRE( m[1][2].ground == e_ground_terrain::tundra );
+}
+
+TEST_CASE( "[map-gen-kernels] resource_placement_mask" ) {
+  ResourcePattern const pattern{ .board_size = 8,
+                                 .shifts     = { 0, 1, 0, 1 },
+                                 .columns    = { 0 },
+                                 .x_offset   = 0,
+                                 .y_offset   = 0 };
+  // column = x + 12*((y//4 + shifts[y%4]) % 2), selected when
+  // column % 8 == 0.
+  vector<Coord> const expected{
+      { .x = 0, .y = 0 }, { .x = 4, .y = 1 }, { .x = 0, .y = 2 },
+      { .x = 4, .y = 3 }, { .x = 4, .y = 4 }, { .x = 0, .y = 5 },
+  };
+  REQUIRE( resource_placement_mask( Delta{ .w = 6, .h = 6 },
+                                    pattern ) == expected );
+}
+
+TEST_CASE( "[map-gen-kernels] land_coords" ) {
+  Matrix<MapSquare> const m = make_map( {
+      "L__",
+      "_LL",
+  } );
+  vector<Coord> const expected{
+      { .x = 0, .y = 0 }, { .x = 1, .y = 1 }, { .x = 2, .y = 1 } };
+  REQUIRE( land_coords( m ) == expected );
+}
+
+TEST_CASE( "[map-gen-kernels] packed map overloads" ) {
+  Rand                    rand( 1 );
+  Matrix<MapSquare> const m =
+      make_random_map( { .w = 23, .h = 17 }, rand );
+  Matrix<PackedSquare> const packed = pack_map( m );
+  for( e_surface const surface :
+       { e_surface::land, e_surface::water } ) {
+    REQUIRE( label_components( packed, surface ) ==
+             label_components( m, surface ) );
+    REQUIRE( distance_to_surface( packed, surface ) ==
+             distance_to_surface( m, surface ) );
+  }
+  REQUIRE( land_coords( packed ) == land_coords( m ) );
+}
+
+TEST_CASE( "[map-gen-kernels] native resource-dist" ) {
+  // Runs the Lua resource distribution tests but this time with
+  // the native kernels registered so that they get used instead
+  // of the Lua implementation.
+  lua::state st;
+  st.lib.open_all();
+  run_lua_startup_routines( st );
+  auto script = R"(
+    assert( map_gen_kernels )
+    package.path = 'src/lua/?.lua'
+    local main = require( 'test.runner' )
+    main( true )
+  )";
+  REQUIRE( st.script.run_safe( script ) == valid );
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,203 @@
+/****************************************************************
+**map-gen.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/map-gen.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/map-gen.hpp"
+
+// ss
+#include "src/ss/ref.hpp"
+#include "src/ss/terrain.hpp"
+
+// luapp
+#include "luapp/rtable.hpp"
+#include "luapp/state.hpp"
+
+// C++ standard library
+#include <thread>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+using namespace std::chrono_literals;
+
+using Catch::Contains;
+
+// Runs the given code to produce a value, converts it back to
+// source, and runs that in a fresh state.
+string round_trip( string const& code ) {
+  lua::state st;
+  UNWRAP_CHECK( o, st.script.run_safe<lua::any>( code ) );
+  string const src = lua_value_to_source( o );
+  lua::state st2;
+  UNWRAP_CHECK( tbl, st2.script.run_safe<lua::table>(
+                         "return { v=" + src + " }" ) );
+  // Compare by converting to source again, which is determin-
+  // istic for values with only a few keys.
+  return lua_value_to_source( tbl["v"].as<lua::any>() );
+}
+
+// Replaces the generator in the worker's Lua state with the
+// given Lua function (source) and gives it a small map.
+MapGenWorker::Setup fake_generator( string const& fn ) {
+  return [fn]( lua::state& st, SS& ss ) {
+    ss.mutable_terrain_use_with_care.mutable_world_map() =
+        Matrix<MapSquare>( Delta{ .w = 3, .h = 2 } );
+    st.script.run( "map_gen.generate_terrain = " + fn );
+  };
+}
+
+void wait_until_finished( MapGenWorker const& worker ) {
+  while( !worker.finished() ) this_thread::sleep_for( 1ms );
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[map-gen] lua_value_to_source" ) {
+  lua::state st;
+
+  auto f = [&]( string const& code ) {
+    UNWRAP_CHECK( o, st.script.run_safe<lua::any>( code ) );
+    return lua_value_to_source( o );
+  };
+
+  SECTION( "scalars" ) {
+    REQUIRE( f( "return nil" ) == "nil" );
+    REQUIRE( f( "return true" ) == "true" );
+    REQUIRE( f( "return false" ) == "false" );
+    REQUIRE( f( "return 42" ) == "42" );
+    REQUIRE( f( "return -7" ) == "-7" );
+    REQUIRE( f( "return 2.5" ) == "2.5" );
+    REQUIRE( f( "return 'hello'" ) == R"("hello")" );
+  }
+
+  SECTION( "strings" ) {
+    REQUIRE( f( R"(return 'a"b')" ) == R"("a\"b")" );
+    REQUIRE( f( R"(return 'a\\b')" ) == R"("a\\b")" );
+    REQUIRE( f( R"(return 'a\nb')" ) == R"("a\010b")" );
+    REQUIRE( round_trip( R"(return 'x"y\\z\n\t')" ) ==
+             R"("x\"y\\z\010\009")" );
+  }
+
+  SECTION( "tables" ) {
+    REQUIRE( f( "return {}" ) == "{}" );
+    REQUIRE( f( "return { x=1 }" ) == R"({["x"]=1,})" );
+    REQUIRE( f( "return { 'a' }" ) == R"({[1]="a",})" );
+    REQUIRE( f( "return { y={ z={ 1.5 } } }" ) ==
+             R"({["y"]={["z"]={[1]=1.5,},},})" );
+    REQUIRE( round_trip( "return { y={ z={ 'q', 3 } } }" ) ==
+             R"({["y"]={["z"]={[1]="q",[2]=3,},},})" );
+  }
+
+  SECTION( "numbers round trip" ) {
+    REQUIRE( round_trip( "return 123456789" ) == "123456789" );
+    REQUIRE( round_trip( "return 0.1" ) == "0.1" );
+    REQUIRE( round_trip( "return -1e-20" ) == "-1e-20" );
+  }
+}
+
+TEST_CASE( "[map-gen] background worker" ) {
+  MapGenWorker worker(
+      "{ size={ w=3, h=2 } }", /*seed=*/1,
+      fake_generator( R"(
+        function( options, on_progress )
+          assert( options.size.w == 3 )
+          assert( options.size.h == 2 )
+          on_progress( 'stage one', 0.5 )
+        end
+      )" ) );
+  wait_until_finished( worker );
+  MapGenProgress const expected{ .stage    = "stage one",
+                                .fraction = 0.5 };
+  REQUIRE( worker.progress() == expected );
+  UNWRAP_CHECK( res, worker.take_result() );
+  REQUIRE( res.world_map.size() == Delta{ .w = 3, .h = 2 } );
+}
+
+TEST_CASE( "[map-gen] background worker error" ) {
+  MapGenWorker worker( "{}", /*seed=*/1,
+                       fake_generator( R"(
+        function( options, on_progress )
+          error( 'some failure' )
+        end
+      )" ) );
+  wait_until_finished( worker );
+  auto const res = worker.take_result();
+  REQUIRE_FALSE( res.has_value() );
+  REQUIRE_THAT( res.error(), Contains( "some failure" ) );
+}
+
+// Stands in for the real generator, which errors out at its next
+// stage boundary once `on_progress` returns false.
+string const kLoopUntilCancelled = R"(
+  function( options, on_progress )
+    while on_progress( 'looping', 0.5 ) ~= false do end
+    error( 'map generation cancelled.' )
+  end
+)";
+
+TEST_CASE( "[map-gen] background worker cancellation" ) {
+  MapGenWorker worker( "{}", /*seed=*/1,
+                       fake_generator( kLoopUntilCancelled ) );
+  // Make sure that the generator is running.
+  while( worker.progress().stage.empty() )
+    this_thread::sleep_for( 1ms );
+  REQUIRE_FALSE( worker.finished() );
+  worker.cancel();
+  wait_until_finished( worker );
+  auto const res = worker.take_result();
+  REQUIRE_FALSE( res.has_value() );
+  REQUIRE_THAT( res.error(), Contains( "cancelled" ) );
+}
+
+TEST_CASE( "[map-gen] background worker cancelled mid-stage" ) {
+  // Never reaches a stage boundary.
+  MapGenWorker worker( "{}", /*seed=*/1,
+                       fake_generator( R"(
+        function( options, on_progress )
+          on_progress( 'looping', 0.5 )
+          while true do end
+        end
+      )" ) );
+  while( worker.progress().stage.empty() )
+    this_thread::sleep_for( 1ms );
+  REQUIRE_FALSE( worker.finished() );
+  worker.cancel();
+  wait_until_finished( worker );
+  auto const res = worker.take_result();
+  REQUIRE_FALSE( res.has_value() );
+  REQUIRE_THAT( res.error(), Contains( "cancelled" ) );
+}
+
+TEST_CASE( "[map-gen] background worker destroyed early" ) {
+  {
+    MapGenWorker worker( "{}", /*seed=*/1,
+                         fake_generator( kLoopUntilCancelled ) );
+    while( worker.progress().stage.empty() )
+      this_thread::sleep_for( 1ms );
+    // The destructor cancels the thread but does not join it.
+  }
+  // The orphaned thread from above gets cleaned up when the next
+  // worker is started.
+  MapGenWorker worker( "{}", /*seed=*/1,
+                       fake_generator( kLoopUntilCancelled ) );
+  worker.cancel();
+  wait_until_finished( worker );
+  REQUIRE_FALSE( worker.take_result().has_value() );
+}
+
+} // namespace
+} // namespace rn
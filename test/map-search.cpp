@@ -99,5 +99,58 @@ TEST_CASE( "[map-search] outward_spiral_search_existing" ) {
   REQUIRE( vec == expected );
 }
 
+TEST_CASE( "[map-search] OutwardSpiral" ) {
+  gfx::point const            start{ .x = 2, .y = 3 };
+  base::generator<gfx::point> gen =
+      outward_spiral_search( start );
+  vector<gfx::point> const expected =
+      rl::all( gen ).take( 500 ).to_vector();
+  vector<gfx::point> vec;
+  for( gfx::point const p : OutwardSpiral( start ) ) {
+    if( vec.size() == expected.size() ) break;
+    vec.push_back( p );
+  }
+  REQUIRE( vec == expected );
+}
+
+TEST_CASE( "[map-search] outward_spiral_offsets" ) {
+  auto const offsets = outward_spiral_offsets( 2 );
+  REQUIRE( offsets->size() >= 25 );
+  base::generator<gfx::point> gen = outward_spiral_search( {} );
+  vector<gfx::point> const    expected =
+      rl::all( gen ).take( 25 ).to_vector();
+  for( int i = 0; i < 25; ++i ) {
+    INFO( fmt::format( "i={}", i ) );
+    REQUIRE( ( *offsets )[i] ==
+             expected[i].distance_from_origin() );
+  }
+  // Growing the table does not affect the one that we are hold-
+  // ing.
+  vector<gfx::size> const before = *offsets;
+  REQUIRE( outward_spiral_offsets( 5 )->size() >= 121 );
+  REQUIRE( *offsets == before );
+}
+
+TEST_CASE( "[map-search] OutwardSpiralExisting" ) {
+  World W;
+  auto  f = [&]( gfx::point start ) {
+    base::generator<gfx::point> gen =
+        outward_spiral_search_existing( W.ss(), start );
+    vector<gfx::point> const expected =
+        rl::all( gen ).to_vector();
+    vector<gfx::point> vec;
+    for( gfx::point const p :
+         OutwardSpiralExisting( W.ss(), start ) )
+      vec.push_back( p );
+    return vec == expected;
+  };
+  REQUIRE( f( { .x = 2, .y = 3 } ) );
+  REQUIRE( f( { .x = 0, .y = 0 } ) );
+  REQUIRE( f( { .x = 4, .y = 4 } ) );
+  REQUIRE( f( { .x = 4, .y = 0 } ) );
+  // Off of the map.
+  REQUIRE( f( { .x = -2, .y = 7 } ) );
+}
+
 } // namespace
 } // namespace rn
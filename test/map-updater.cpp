@@ -0,0 +1,269 @@
+/****************************************************************
+**map-updater.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/map-updater.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/map-updater.hpp"
+
+// Testing
+#include "test/fake/renderer.hpp"
+#include "test/fake/world.hpp"
+
+// render
+#include "src/render/renderer.hpp"
+
+// ss
+#include "ss/ref.hpp"
+#include "ss/terrain.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+/****************************************************************
+** Fake World Setup
+*****************************************************************/
+Delta const kLargeMapSize{ .w = 40, .h = 40 };
+
+struct World : testing::World {
+  using Base = testing::World;
+  World() : Base() {
+    add_player( e_nation::english );
+    set_default_player( e_nation::english );
+    MapSquare const L = make_grassland();
+    MapSquare const _ = make_ocean();
+    // clang-format off
+    vector<MapSquare> tiles{
+      _, L, _,
+      L, L, L,
+      _, L, L,
+    };
+    // clang-format on
+    build_map( std::move( tiles ), 3 );
+  }
+
+  void create_large_map() {
+    build_map( vector<MapSquare>( kLargeMapSize.area(),
+                                  make_grassland() ),
+               kLargeMapSize.w );
+  }
+};
+
+// Changing a tile requests redraws of the 5x5 block of tiles
+// around it. This returns the centers of some blocks that don't
+// overlap each other or the edges of the large map.
+vector<Coord> disjoint_blocks( int count ) {
+  vector<Coord> res;
+  for( int y = 2; y < kLargeMapSize.h - 2; y += 5 )
+    for( int x = 2; x < kLargeMapSize.w - 2; x += 5 )
+      if( int( res.size() ) < count )
+        res.push_back( { .x = x, .y = y } );
+  CHECK_EQ( int( res.size() ), count );
+  return res;
+}
+
+void toggle_road( IMapUpdater& map_updater, Coord tile ) {
+  map_updater.modify_map_square(
+      tile, []( MapSquare& square ) {
+        square.road = !square.road;
+      } );
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[map-updater] transactions" ) {
+  World                  W;
+  NonRenderingMapUpdater map_updater( W.ss() );
+  Coord const            tile{ .x = 1, .y = 1 };
+
+  REQUIRE_FALSE( map_updater.in_transaction() );
+  {
+    auto const outer = map_updater.begin_transaction();
+    REQUIRE( map_updater.in_transaction() );
+    {
+      auto const inner = map_updater.begin_transaction();
+      REQUIRE( map_updater.in_transaction() );
+      // The map itself is updated right away.
+      REQUIRE( map_updater.modify_map_square(
+          tile,
+          []( MapSquare& square ) { square.road = true; } ) );
+      REQUIRE( W.square( tile ).road );
+      REQUIRE( map_updater.make_square_visible(
+          tile, e_nation::english ) );
+      REQUIRE( W.player_square( tile ).has_value() );
+    }
+    REQUIRE( map_updater.in_transaction() );
+  }
+  REQUIRE_FALSE( map_updater.in_transaction() );
+  // Nothing to render here.
+  REQUIRE( map_updater.last_transaction_stats() ==
+           MapUpdaterTransactionStats{} );
+}
+
+TEST_CASE( "[map-updater] rendering transactions" ) {
+  World W;
+  W.create_large_map();
+  testing::FakeRenderer fake;
+  rr::Renderer&         renderer = fake.renderer();
+  RenderingMapUpdater   map_updater( W.ss(), renderer );
+  Coord const           tile{ .x = 20, .y = 20 };
+  using Stats = MapUpdaterTransactionStats;
+
+  auto annex_vertices = [&] {
+    return renderer.buffer_vertex_count(
+        rr::e_render_target_buffer::landscape_annex );
+  };
+
+  // Start with an empty annex buffer.
+  map_updater.redraw();
+  REQUIRE( annex_vertices() == 0 );
+
+  SECTION( "no transaction" ) {
+    using rr::e_render_target_buffer;
+    auto const lod_vertices = [&] {
+      return renderer.buffer_vertex_count(
+          e_render_target_buffer::landscape_lod );
+    };
+    auto const lod_annex_vertices = [&] {
+      return renderer.buffer_vertex_count(
+          e_render_target_buffer::landscape_lod_annex );
+    };
+    long const lod = lod_vertices();
+    REQUIRE( lod_annex_vertices() == 0 );
+    toggle_road( map_updater, tile );
+    REQUIRE( annex_vertices() > 0 );
+    // The simplified tiles go to their own annex and leave the
+    // whole-map LOD buffer alone.
+    REQUIRE( lod_vertices() == lod );
+    REQUIRE( lod_annex_vertices() > 0 );
+    long const vertices = annex_vertices();
+    // No change, so nothing gets redrawn.
+    REQUIRE_FALSE( map_updater.modify_map_square(
+        tile, []( MapSquare& ) {} ) );
+    REQUIRE( annex_vertices() == vertices );
+  }
+
+  SECTION( "duplicates are redrawn once" ) {
+    {
+      auto const committer = map_updater.begin_transaction();
+      toggle_road( map_updater, tile );
+      map_updater.modify_map_square(
+          tile, []( MapSquare& square ) {
+            square.irrigation = true;
+          } );
+      // Nothing is drawn until the commit.
+      REQUIRE( annex_vertices() == 0 );
+    }
+    REQUIRE( annex_vertices() > 0 );
+    REQUIRE( map_updater.last_transaction_stats() ==
+             Stats{ .tiles_requested = 50,
+                    .tiles_redrawn   = 25 } );
+  }
+
+  SECTION( "tiles off the map are skipped" ) {
+    {
+      auto const committer = map_updater.begin_transaction();
+      toggle_road( map_updater, { .x = 0, .y = 0 } );
+    }
+    REQUIRE( map_updater.last_transaction_stats() ==
+             Stats{ .tiles_requested = 9,
+                    .tiles_redrawn   = 9 } );
+  }
+
+  SECTION( "large fraction of the map" ) {
+    // 16 blocks of 25 is a quarter of the map.
+    {
+      auto const committer = map_updater.begin_transaction();
+      for( Coord const center : disjoint_blocks( 16 ) )
+        toggle_road( map_updater, center );
+    }
+    REQUIRE( map_updater.last_transaction_stats() ==
+             Stats{ .tiles_requested = 400,
+                    .tiles_redrawn   = 0,
+                    .full_redraw     = true } );
+    REQUIRE( annex_vertices() == 0 );
+  }
+
+  SECTION( "redraw requested" ) {
+    {
+      auto const committer = map_updater.begin_transaction();
+      toggle_road( map_updater, tile );
+      map_updater.redraw();
+    }
+    REQUIRE( map_updater.last_transaction_stats().full_redraw );
+    REQUIRE( annex_vertices() == 0 );
+  }
+
+  SECTION( "annex threshold" ) {
+    // Just under a quarter of the map each time.
+    vector<Coord> const blocks = disjoint_blocks( 15 );
+    int const           per_transaction = 15 * 25;
+    int const           expected_transactions =
+        ( RenderingMapUpdater::kAnnexRedrawThreshold +
+          per_transaction - 1 ) /
+        per_transaction;
+    int transactions = 0;
+    while( transactions < expected_transactions ) {
+      {
+        auto const committer = map_updater.begin_transaction();
+        for( Coord const center : blocks )
+          toggle_road( map_updater, center );
+      }
+      ++transactions;
+      if( map_updater.last_transaction_stats().full_redraw )
+        break;
+      REQUIRE( map_updater.last_transaction_stats()
+                   .tiles_redrawn == per_transaction );
+    }
+    // The transaction that would have pushed the annex buffer
+    // over the limit redraws the map instead.
+    REQUIRE( transactions == expected_transactions );
+    REQUIRE( map_updater.last_transaction_stats().full_redraw );
+    REQUIRE( annex_vertices() == 0 );
+
+    // The count starts over after that.
+    {
+      auto const committer = map_updater.begin_transaction();
+      for( Coord const center : blocks )
+        toggle_road( map_updater, center );
+    }
+    REQUIRE_FALSE(
+        map_updater.last_transaction_stats().full_redraw );
+  }
+}
+
+TEST_CASE( "[map-updater] modify_entire_map resize" ) {
+  World                  W;
+  NonRenderingMapUpdater map_updater( W.ss() );
+  e_nation const         nation = e_nation::english;
+  TerrainState const&    terrain = W.ss().terrain;
+  Delta const            new_size{ .w = 4, .h = 2 };
+
+  REQUIRE( terrain.player_terrain( nation )->map.size() ==
+           Delta{ .w = 3, .h = 3 } );
+  map_updater.modify_entire_map( [&]( Matrix<MapSquare>& m ) {
+    m = Matrix<MapSquare>( new_size );
+  } );
+  REQUIRE( terrain.world_size_tiles() == new_size );
+  // The player maps follow the real one.
+  REQUIRE( terrain.player_terrain( nation )->map.size() ==
+           new_size );
+  REQUIRE( map_updater.make_square_visible( { .x = 3, .y = 1 },
+                                            nation ) );
+}
+
+} // namespace
+} // namespace rn
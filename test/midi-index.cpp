@@ -0,0 +1,170 @@
+/****************************************************************
+**midi-index.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/midi-index.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/midi-index.hpp"
+
+// C++ standard library
+#include <fstream>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+using namespace std::chrono;
+
+IndexedMidiTune make_tune() {
+  IndexedMidiTune tune;
+  tune.duration = 1500ms;
+  tune.bytes    = { 0x90, 60, 100, 0x80, 60, 0, 0xc0, 5 };
+  tune.events   = {
+      { .time_us = 0, .offset = 0, .size = 3 },
+      { .time_us = 500'000, .offset = 3, .size = 3 },
+      { .time_us = 1'500'000, .offset = 6, .size = 2 },
+  };
+  return tune;
+}
+
+// A format 0 file with one quarter note at the default tempo of
+// 120 bpm, i.e. it lasts half a second.
+void write_test_midi_file( fs::path const& p ) {
+  vector<unsigned char> const data = {
+      // Header: format 0, one track, 96 ticks per quarter note.
+      'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96,
+      // Track of 15 bytes.
+      'M', 'T', 'r', 'k', 0, 0, 0, 15,
+      // Note on.
+      0x00, 0x90, 60, 100,
+      // Note off after 96 ticks.
+      0x60, 0x80, 60, 0,
+      // End of track (meta).
+      0x00, 0xff, 0x2f, 0x00 };
+  ofstream out( p, ios::binary );
+  out.write( reinterpret_cast<char const*>( data.data() ),
+             data.size() );
+}
+
+TEST_CASE( "[midi-index] event_bytes" ) {
+  IndexedMidiTune const tune = make_tune();
+  auto const            bytes = tune.event_bytes( tune.events[2] );
+  REQUIRE( bytes.size() == 2 );
+  REQUIRE( bytes[0] == 0xc0 );
+  REQUIRE( bytes[1] == 5 );
+}
+
+TEST_CASE( "[midi-index] serialization round trip" ) {
+  IndexedMidiTune const tune = make_tune();
+  MidiSourceStamp const stamp{ .mtime = 12345, .size = 678 };
+  string const          data = serialize_midi_tune( tune, stamp );
+  REQUIRE( deserialize_midi_tune( data, stamp ) == tune );
+
+  IndexedMidiTune const empty;
+  REQUIRE( deserialize_midi_tune(
+               serialize_midi_tune( empty, stamp ), stamp ) ==
+           empty );
+}
+
+TEST_CASE( "[midi-index] stale or corrupt cache" ) {
+  IndexedMidiTune const tune = make_tune();
+  MidiSourceStamp const stamp{ .mtime = 12345, .size = 678 };
+  string const          data = serialize_midi_tune( tune, stamp );
+
+  SECTION( "different mtime" ) {
+    MidiSourceStamp const other{ .mtime = 12346, .size = 678 };
+    REQUIRE( deserialize_midi_tune( data, other ) == nothing );
+  }
+  SECTION( "different size" ) {
+    MidiSourceStamp const other{ .mtime = 12345, .size = 679 };
+    REQUIRE( deserialize_midi_tune( data, other ) == nothing );
+  }
+  SECTION( "truncated" ) {
+    string_view const truncated( data.data(), data.size() - 1 );
+    REQUIRE( deserialize_midi_tune( truncated, stamp ) ==
+             nothing );
+    REQUIRE( deserialize_midi_tune( "", stamp ) == nothing );
+  }
+  SECTION( "bad magic" ) {
+    string corrupt = data;
+    corrupt[0]     = 'x';
+    REQUIRE( deserialize_midi_tune( corrupt, stamp ) == nothing );
+  }
+  SECTION( "event out of range" ) {
+    IndexedMidiTune bad = tune;
+    bad.events[2].size  = 3;
+    REQUIRE( deserialize_midi_tune(
+                 serialize_midi_tune( bad, stamp ), stamp ) ==
+             nothing );
+  }
+}
+
+TEST_CASE( "[midi-index] load_midi_tune" ) {
+  fs::path const dir       = "/tmp/test-midi-index";
+  fs::path const cache_dir = dir / "cache";
+  fs::path const file      = dir / "tune.mid";
+  fs::remove_all( dir );
+  fs::create_directories( dir );
+  write_test_midi_file( file );
+
+  maybe<IndexedMidiTune> const parsed = parse_midi_tune( file );
+  REQUIRE( parsed.has_value() );
+  REQUIRE( parsed->duration == 500ms );
+  // The end-of-track meta event is dropped.
+  REQUIRE( parsed->events.size() == 2 );
+  REQUIRE( parsed->events[0].time_us == 0 );
+  REQUIRE( parsed->events[1].time_us == 500'000 );
+  REQUIRE( parsed->bytes == vector<unsigned char>{
+                                0x90, 60, 100, 0x80, 60, 0 } );
+
+  // First load writes the cache.
+  REQUIRE( load_midi_tune( file, cache_dir ) == parsed );
+  fs::path const cache_file = midi_cache_file( file, cache_dir );
+  REQUIRE( fs::exists( cache_file ) );
+
+  // Second load comes from the cache. To prove it, replace the
+  // cache with a different tune having the same stamp.
+  maybe<MidiSourceStamp> const stamp = midi_source_stamp( file );
+  REQUIRE( stamp.has_value() );
+  IndexedMidiTune const fake = make_tune();
+  {
+    string const data = serialize_midi_tune( fake, *stamp );
+    ofstream     out( cache_file, ios::binary );
+    out.write( data.data(), data.size() );
+  }
+  REQUIRE( load_midi_tune( file, cache_dir ) == fake );
+
+  // If the source file changes then the cache is rebuilt.
+  fs::last_write_time( file, fs::last_write_time( file ) +
+                                 seconds( 1 ) );
+  REQUIRE( load_midi_tune( file, cache_dir ) == parsed );
+
+  REQUIRE( load_midi_tune( dir / "missing.mid", cache_dir ) ==
+           nothing );
+  fs::remove_all( dir );
+}
+
+TEST_CASE( "[midi-index] cache file per path" ) {
+  fs::path const cache_dir = "/cache";
+  REQUIRE( midi_cache_file( "music/a/tune.mid", cache_dir ) ==
+           "/cache/music/a/tune.midx" );
+  REQUIRE( midi_cache_file( "/music/b/tune.mid", cache_dir ) ==
+           "/cache/music/b/tune.midx" );
+  // Tunes with the same name in different folders must not
+  // share a cache entry.
+  REQUIRE( midi_cache_file( "music/a/tune.mid", cache_dir ) !=
+           midi_cache_file( "music/b/tune.mid", cache_dir ) );
+}
+
+} // namespace
+} // namespace rn
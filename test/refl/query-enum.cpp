@@ -0,0 +1,135 @@
+/****************************************************************
+**query-enum.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/refl/query-enum.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/refl/query-enum.hpp"
+
+// rds
+#include "rds/testing.rds.hpp"
+
+// C++ standard library
+#include <algorithm>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace refl {
+
+using namespace ::std;
+
+using ::base::nothing;
+using ::rn::e_color;
+using ::rn::e_count;
+using ::rn::e_empty;
+
+/****************************************************************
+** e_tree
+*****************************************************************/
+namespace my_ns {
+namespace {
+
+// The names are deliberately not in sorted order, and some of
+// them are prefixes of others.
+enum class e_tree { pine, oak, pin, pines, oaks, ash };
+
+} // namespace
+} // namespace my_ns
+
+template<>
+struct traits<my_ns::e_tree> {
+  using type                        = my_ns::e_tree;
+  static constexpr type_kind   kind = type_kind::enum_kind;
+  static constexpr string_view ns   = "my_ns";
+  static constexpr string_view name = "e_tree";
+
+  // Enum specific.
+  static constexpr array<string_view, 6> value_names{
+      "pine", "oak", "pin", "pines", "oaks", "ash",
+  };
+};
+
+static_assert( ReflectedEnum<my_ns::e_tree> );
+
+namespace {
+
+using ::refl::my_ns::e_tree;
+
+template<ReflectedEnum E>
+constexpr bool names_are_sorted() {
+  auto const& sorted = detail::enum_values_by_name<E>;
+  return is_sorted( sorted.begin(), sorted.end() );
+}
+
+static_assert( names_are_sorted<e_empty>() );
+static_assert( names_are_sorted<e_color>() );
+static_assert( names_are_sorted<e_count>() );
+static_assert( names_are_sorted<e_tree>() );
+
+// Lookups can be done at compile time.
+static_assert( enum_from_string<e_tree>( "pines" ) ==
+               e_tree::pines );
+static_assert( enum_from_string<e_tree>( "pi" ) == nothing );
+
+template<ReflectedEnum E>
+void check_round_trip() {
+  for( E const val : enum_values<E> ) {
+    INFO( enum_value_name( val ) );
+    REQUIRE( enum_from_string<E>( enum_value_name( val ) ) ==
+             val );
+  }
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[refl/query-enum] round trip" ) {
+  check_round_trip<e_empty>();
+  check_round_trip<e_color>();
+  check_round_trip<e_count>();
+  check_round_trip<e_tree>();
+}
+
+TEST_CASE( "[refl/query-enum] unknown names" ) {
+  REQUIRE( enum_from_string<e_empty>( "" ) == nothing );
+  REQUIRE( enum_from_string<e_empty>( "red" ) == nothing );
+
+  REQUIRE( enum_from_string<e_color>( "" ) == nothing );
+  REQUIRE( enum_from_string<e_color>( "Red" ) == nothing );
+  REQUIRE( enum_from_string<e_color>( " red" ) == nothing );
+  REQUIRE( enum_from_string<e_color>( "purple" ) == nothing );
+  // Before the first and after the last in sorted order.
+  REQUIRE( enum_from_string<e_color>( "aaa" ) == nothing );
+  REQUIRE( enum_from_string<e_color>( "zzz" ) == nothing );
+
+  REQUIRE( enum_from_string<e_tree>( "elm" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "zzz" ) == nothing );
+}
+
+TEST_CASE( "[refl/query-enum] names that share a prefix" ) {
+  REQUIRE( enum_from_string<e_tree>( "pin" ) == e_tree::pin );
+  REQUIRE( enum_from_string<e_tree>( "pine" ) == e_tree::pine );
+  REQUIRE( enum_from_string<e_tree>( "pines" ) ==
+           e_tree::pines );
+  REQUIRE( enum_from_string<e_tree>( "oak" ) == e_tree::oak );
+  REQUIRE( enum_from_string<e_tree>( "oaks" ) == e_tree::oaks );
+
+  // Prefixes and extensions of names are not names.
+  REQUIRE( enum_from_string<e_tree>( "p" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "pi" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "pinesx" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "oa" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "oaksx" ) == nothing );
+  REQUIRE( enum_from_string<e_tree>( "as" ) == nothing );
+}
+
+} // namespace
+} // namespace refl
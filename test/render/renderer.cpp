@@ -24,6 +24,9 @@
 // gl
 #include "src/gl/shader.hpp"
 
+// Revolution Now
+#include "src/views.hpp"
+
 // Must be last.
 #include "test/catch-common.hpp"
 
@@ -157,12 +160,34 @@ void expect_create_vertex_array( gl::MockOpenGL& mock ) {
   EXPECT_CALL( mock, gl_DeleteVertexArrays( 1, Pointee( 21 ) ) );
 }
 
-/****************************************************************
-** Test Cases
-*****************************************************************/
-TEST_CASE( "[render/renderer] workflows" ) {
-  gl::MockOpenGL mock;
+void expect_bind_atlas_texture( gl::MockOpenGL& mock ) {
+  EXPECT_CALL( mock, gl_GetError() )
+      .times( 2 )
+      .returns( GL_NO_ERROR );
+  EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
+                                     Not( Null() ) ) )
+      .sets_arg<1>( 41 );
+  EXPECT_CALL( mock, gl_BindTexture( GL_TEXTURE_2D, 42 ) );
+}
+
+void expect_unbind_atlas_texture( gl::MockOpenGL& mock ) {
+  EXPECT_CALL( mock, gl_GetError() )
+      .times( 3 )
+      .returns( GL_NO_ERROR );
+  EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
+                                     Not( Null() ) ) )
+      .sets_arg<1>( 42 );
+  EXPECT_CALL( mock, gl_BindTexture( GL_TEXTURE_2D, 41 ) );
+  EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
+                                     Not( Null() ) ) )
+      .sets_arg<1>( 41 );
+}
 
+// Sets up the expectations for the construction of a renderer
+// and then creates it. The caller must call expect_unbind_at-
+// las_texture at the end of the test.
+unique_ptr<Renderer> expect_create_renderer(
+    gl::MockOpenGL& mock ) {
   int const num_get_errors = 51;
 
   EXPECT_CALL( mock, gl_GetError() )
@@ -197,8 +222,10 @@ TEST_CASE( "[render/renderer] workflows" ) {
   EXPECT_CALL( mock, gl_DeleteShader( 6 ) );
   EXPECT_CALL( mock, gl_DeleteShader( 5 ) );
 
-  // Create the normal, backdrop landscape, and landscape_annex
-  // vertex arrays.
+  // Create the normal, backdrop, landscape, landscape_annex,
+  // landscape_lod, and landscape_lod_annex vertex arrays.
+  expect_create_vertex_array( mock );
+  expect_create_vertex_array( mock );
   expect_create_vertex_array( mock );
   expect_create_vertex_array( mock );
   expect_create_vertex_array( mock );
@@ -312,32 +339,10 @@ TEST_CASE( "[render/renderer] workflows" ) {
   EXPECT_CALL( mock, gl_Uniform2f( 90, 500.0, 400.0 ) );
 
   // Create the atlas texture.
-  auto expect_bind_tx = [&] {
-    EXPECT_CALL( mock, gl_GetError() )
-        .times( 2 )
-        .returns( GL_NO_ERROR );
-    EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
-                                       Not( Null() ) ) )
-        .sets_arg<1>( 41 );
-    EXPECT_CALL( mock, gl_BindTexture( GL_TEXTURE_2D, 42 ) );
-  };
-  auto expect_unbind_tx = [&] {
-    EXPECT_CALL( mock, gl_GetError() )
-        .times( 3 )
-        .returns( GL_NO_ERROR );
-    EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
-                                       Not( Null() ) ) )
-        .sets_arg<1>( 42 );
-    EXPECT_CALL( mock, gl_BindTexture( GL_TEXTURE_2D, 41 ) );
-    EXPECT_CALL( mock, gl_GetIntegerv( GL_TEXTURE_BINDING_2D,
-                                       Not( Null() ) ) )
-        .sets_arg<1>( 41 );
-  };
-
   EXPECT_CALL( mock, gl_GenTextures( 1, Not( Null() ) ) )
       .sets_arg<1>( 42 );
-  expect_bind_tx();
-  expect_unbind_tx();
+  expect_bind_atlas_texture( mock );
+  expect_unbind_atlas_texture( mock );
   EXPECT_CALL( mock, gl_TexParameteri( GL_TEXTURE_2D,
                                        GL_TEXTURE_MIN_FILTER,
                                        GL_NEAREST ) );
@@ -353,8 +358,8 @@ TEST_CASE( "[render/renderer] workflows" ) {
   EXPECT_CALL( mock, gl_DeleteTextures( 1, Pointee( 42 ) ) );
 
   // Set texture image.
-  expect_bind_tx();
-  expect_unbind_tx();
+  expect_bind_atlas_texture( mock );
+  expect_unbind_atlas_texture( mock );
   EXPECT_CALL(
       mock, gl_TexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 64, 32, 0,
                            GL_RGBA, GL_UNSIGNED_BYTE,
@@ -365,12 +370,11 @@ TEST_CASE( "[render/renderer] workflows" ) {
   EXPECT_CALL( mock, gl_Uniform2f( 89, 64, 32 ) );
 
   // We bind the atlas texture on construction of the renderer
-  // one final time. The corresponding unbind must come at the
-  // end of this test case otherwise it interferes with other ex-
-  // pect calls that we need to make in the mean time.
-  expect_bind_tx();
-
-  // *** The test.
+  // one final time. The corresponding unbind must be expected by
+  // the caller at the end of the test case otherwise it inter-
+  // feres with other expect calls that we need to make in the
+  // mean time.
+  expect_bind_atlas_texture( mock );
 
   vector<SpriteSheetConfig> sprite_config{
       {
@@ -392,8 +396,29 @@ TEST_CASE( "[render/renderer] workflows" ) {
       .sprite_sheets       = sprite_config,
       .font_sheets         = font_config,
   };
-  unique_ptr<Renderer> renderer =
-      Renderer::create( config, [] {} );
+  return Renderer::create( config, [] {} );
+}
+
+// The positions of the given vertices, in order.
+vector<gl::vec2> positions(
+    vector<GenericVertex> const& verts ) {
+  vector<gl::vec2> res;
+  res.reserve( verts.size() );
+  for( GenericVertex const& vert : verts )
+    res.push_back( vert.position );
+  return res;
+}
+
+gl::vec2 shifted( gl::vec2 v, gfx::size by ) {
+  return { .x = v.x + by.w, .y = v.y + by.h };
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[render/renderer] workflows" ) {
+  gl::MockOpenGL       mock;
+  unique_ptr<Renderer> renderer = expect_create_renderer( mock );
 
   // Try zapping.
   {
@@ -485,7 +510,139 @@ TEST_CASE( "[render/renderer] workflows" ) {
     }
   }
 
-  expect_unbind_tx();
+  expect_unbind_atlas_texture( mock );
+}
+
+TEST_CASE( "[render/renderer] copy_range and replay" ) {
+  gl::MockOpenGL       mock;
+  unique_ptr<Renderer> renderer = expect_create_renderer( mock );
+
+  gfx::pixel const red  = gfx::pixel::red();
+  gfx::pixel const blue = gfx::pixel::blue();
+
+  VertexRange const rng = renderer->range_for( [&] {
+    rr::Painter painter = renderer->painter();
+    painter.draw_solid_rect(
+        gfx::rect{ .origin = { .x = 1, .y = 2 },
+                   .size   = { .w = 3, .h = 4 } },
+        red );
+    painter.draw_solid_rect(
+        gfx::rect{ .origin = { .x = 10, .y = 20 },
+                   .size   = { .w = 5, .h = 5 } },
+        blue );
+  } );
+  REQUIRE( rng.finish - rng.start == 12 );
+  vector<GenericVertex> const recorded =
+      renderer->copy_range( rng );
+  REQUIRE( recorded.size() == 12 );
+
+  SECTION( "in place" ) {
+    VertexRange const replayed = renderer->range_for(
+        [&] { renderer->replay( recorded, gfx::size{} ); } );
+    REQUIRE( replayed.start == rng.finish );
+    REQUIRE( renderer->copy_range( replayed ) == recorded );
+  }
+
+  SECTION( "translated" ) {
+    gfx::size const   by{ .w = 7, .h = -2 };
+    VertexRange const replayed = renderer->range_for(
+        [&] { renderer->replay( recorded, by ); } );
+    vector<GenericVertex> const got =
+        renderer->copy_range( replayed );
+    REQUIRE( got.size() == recorded.size() );
+    // Same vertices in the same order, only moved.
+    for( size_t i = 0; i < got.size(); ++i ) {
+      INFO( fmt::format( "i={}", i ) );
+      REQUIRE( got[i].position ==
+               shifted( recorded[i].position, by ) );
+      GenericVertex moved_back = got[i];
+      moved_back.position      = recorded[i].position;
+      REQUIRE( moved_back == recorded[i] );
+    }
+    // The original vertices are untouched.
+    REQUIRE( renderer->copy_range( rng ) == recorded );
+  }
+
+  expect_unbind_atlas_texture( mock );
+}
+
+TEST_CASE( "[render/renderer] ui::VertexCache" ) {
+  gl::MockOpenGL       mock;
+  unique_ptr<Renderer> renderer = expect_create_renderer( mock );
+
+  ::rn::ui::VertexCache cache;
+  int                   records = 0;
+
+  // Draws two rects relative to `where`.
+  auto drawer = [&]( ::rn::Coord where ) {
+    ++records;
+    gfx::point const p       = where.to_gfx();
+    rr::Painter      painter = renderer->painter();
+    painter.draw_solid_rect(
+        gfx::rect{ .origin = p, .size = { .w = 2, .h = 2 } },
+        gfx::pixel::red() );
+    painter.draw_solid_rect(
+        gfx::rect{ .origin = p + gfx::size{ .w = 4 },
+                   .size   = { .w = 1, .h = 3 } },
+        gfx::pixel::green() );
+  };
+
+  auto draw = [&]( ::rn::Coord where ) {
+    return renderer->copy_range( renderer->range_for(
+        [&] { cache.draw( *renderer, where, drawer ); } ) );
+  };
+
+  // What the drawer emits when run directly.
+  auto direct = [&]( ::rn::Coord where ) {
+    int const             saved = records;
+    vector<GenericVertex> res   = renderer->copy_range(
+        renderer->range_for( [&] { drawer( where ); } ) );
+    records = saved;
+    return res;
+  };
+
+  ::rn::Coord const c1{ .x = 5, .y = 6 };
+  ::rn::Coord const c2{ .x = 50, .y = 3 };
+
+  // First draw records.
+  vector<GenericVertex> const first = draw( c1 );
+  REQUIRE( records == 1 );
+  REQUIRE( first == direct( c1 ) );
+
+  // Hit at the same position.
+  REQUIRE( draw( c1 ) == first );
+  REQUIRE( records == 1 );
+
+  // Hit at a different position; replayed in the same order but
+  // moved.
+  vector<GenericVertex> const moved = draw( c2 );
+  REQUIRE( records == 1 );
+  REQUIRE( moved == direct( c2 ) );
+  REQUIRE( positions( moved ) != positions( first ) );
+
+  // Invalidation forces a new recording.
+  cache.invalidate();
+  REQUIRE( draw( c2 ) == direct( c2 ) );
+  REQUIRE( records == 2 );
+  REQUIRE( draw( c2 ) == direct( c2 ) );
+  REQUIRE( records == 2 );
+
+  // Different renderer mods force a new recording, and so does
+  // switching back.
+  {
+    auto popper = renderer->push_mods( []( RendererMods& mods ) {
+      mods.painter_mods.alpha = .5;
+    } );
+    vector<GenericVertex> const faded = draw( c2 );
+    REQUIRE( records == 3 );
+    REQUIRE( faded == direct( c2 ) );
+    REQUIRE( draw( c2 ) == faded );
+    REQUIRE( records == 3 );
+  }
+  REQUIRE( draw( c2 ) == direct( c2 ) );
+  REQUIRE( records == 4 );
+
+  expect_unbind_atlas_texture( mock );
 }
 
 } // namespace
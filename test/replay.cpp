@@ -0,0 +1,237 @@
+/****************************************************************
+**replay.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/replay.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/replay.hpp"
+
+// Testing
+#include "test/fake/world.hpp"
+#include "test/mocks/igui.hpp"
+#include "test/mocks/irand.hpp"
+
+// Revolution Now
+#include "src/interrupts.hpp"
+
+// ss
+#include "src/ss/root.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[replay] journal round trip" ) {
+  ReplayWriter writer;
+  writer.bernoulli( true );
+  writer.between_ints( 0 );
+  writer.between_ints( -5 );
+  writer.between_ints( 1'000'000 );
+  writer.between_doubles( .25 );
+  writer.choice( string( "some choice" ) );
+  writer.choice( nothing );
+  writer.string_input( string() );
+  writer.int_input( -3 );
+  writer.int_input( nothing );
+  writer.player_input( ReplayedInput::land_view{
+      .input = LandViewPlayerInput::give_orders{
+          .orders = orders::move{ .d = e_direction::sw } } } );
+  writer.player_input( ReplayedInput::land_view{
+      .input = LandViewPlayerInput::prioritize{
+          .units = { UnitId{ 3 }, UnitId{ 5 } } } } );
+  writer.player_input(
+      ReplayedInput::menu{ .item = e_menu_item::save } );
+  writer.player_input( ReplayedInput::eot_button{} );
+  writer.state_hash( 0x0123456789abcdef );
+
+  ReplayReader reader( writer.buffer() );
+  REQUIRE( !reader.finished() );
+  REQUIRE( reader.bernoulli() == true );
+  REQUIRE( reader.between_ints() == 0 );
+  REQUIRE( reader.between_ints() == -5 );
+  REQUIRE( reader.between_ints() == 1'000'000 );
+  REQUIRE( reader.between_doubles() == .25 );
+  REQUIRE( reader.choice() == "some choice" );
+  REQUIRE( reader.choice() == nothing );
+  REQUIRE( reader.string_input() == "" );
+  REQUIRE( reader.int_input() == -3 );
+  REQUIRE( reader.int_input() == nothing );
+  ReplayedInput_t const expected1 = ReplayedInput::land_view{
+      .input = LandViewPlayerInput::give_orders{
+          .orders = orders::move{ .d = e_direction::sw } } };
+  REQUIRE( reader.player_input() == expected1 );
+  ReplayedInput_t const expected2 = ReplayedInput::land_view{
+      .input = LandViewPlayerInput::prioritize{
+          .units = { UnitId{ 3 }, UnitId{ 5 } } } };
+  REQUIRE( reader.player_input() == expected2 );
+  ReplayedInput_t const expected3 =
+      ReplayedInput::menu{ .item = e_menu_item::save };
+  REQUIRE( reader.player_input() == expected3 );
+  ReplayedInput_t const expected4 = ReplayedInput::eot_button{};
+  REQUIRE( reader.player_input() == expected4 );
+  REQUIRE( reader.state_hash() == 0x0123456789abcdef );
+  REQUIRE( reader.finished() );
+  REQUIRE( reader.entries_read() == 15 );
+}
+
+TEST_CASE( "[replay] journal is compact" ) {
+  ReplayWriter writer;
+  int const    header_size = writer.buffer().size();
+  for( int i = 0; i < 100; ++i ) writer.between_ints( i );
+  // One byte for the tag and at most two for the value.
+  REQUIRE( int( writer.buffer().size() ) - header_size <= 300 );
+}
+
+TEST_CASE( "[replay] record and replay rand" ) {
+  MockIRand    real;
+  ReplayWriter writer;
+
+  RecordingRand recording( real, writer );
+  EXPECT_CALL( real, bernoulli( .5 ) ).returns( false );
+  REQUIRE( recording.bernoulli( .5 ) == false );
+  auto const kHalfOpen = IRand::e_interval::half_open;
+  EXPECT_CALL( real, between_ints( 0, 10, kHalfOpen ) )
+      .returns( 7 );
+  REQUIRE( recording.between_ints( 0, 10, kHalfOpen ) == 7 );
+  EXPECT_CALL( real, between_doubles( 1.0, 2.0 ) )
+      .returns( 1.5 );
+  REQUIRE( recording.between_doubles( 1.0, 2.0 ) == 1.5 );
+
+  // The replay does not consult the real generator.
+  ReplayReader reader( writer.buffer() );
+  ReplayRand   replay( reader );
+  REQUIRE( replay.bernoulli( .5 ) == false );
+  REQUIRE( replay.between_ints( 0, 10, kHalfOpen ) == 7 );
+  REQUIRE( replay.between_doubles( 1.0, 2.0 ) == 1.5 );
+  REQUIRE( reader.finished() );
+}
+
+TEST_CASE( "[replay] record and replay gui" ) {
+  MockIGui     real;
+  ReplayWriter writer;
+
+  ChoiceConfig const config{
+      .msg     = "Select One",
+      .options = { ChoiceConfigOption{ .key          = "a",
+                                       .display_name = "A" } } };
+  IntInputConfig const int_config{ .msg = "How many?" };
+
+  RecordingGui recording( real, writer );
+  EXPECT_CALL( real, choice( config, e_input_required::no ) )
+      .returns( make_wait<maybe<string>>( "a" ) );
+  wait<maybe<string>> w1 = recording.optional_choice( config );
+  REQUIRE( w1.ready() );
+  REQUIRE( *w1 == "a" );
+  EXPECT_CALL( real, int_input( int_config,
+                                e_input_required::yes ) )
+      .returns( make_wait<maybe<int>>( 42 ) );
+  wait<int> w2 = recording.required_int_input( int_config );
+  REQUIRE( w2.ready() );
+  REQUIRE( *w2 == 42 );
+
+  ReplayReader reader( writer.buffer() );
+  ReplayGui    replay( reader );
+  wait<maybe<string>> w3 = replay.optional_choice( config );
+  REQUIRE( w3.ready() );
+  REQUIRE( *w3 == "a" );
+  wait<int> w4 = replay.required_int_input( int_config );
+  REQUIRE( w4.ready() );
+  REQUIRE( *w4 == 42 );
+  // Messages and waits are skipped.
+  REQUIRE( replay.message_box( "hello" ).ready() );
+  wait<chrono::microseconds> w5 =
+      replay.wait_for( chrono::seconds( 1 ) );
+  REQUIRE( w5.ready() );
+  REQUIRE( *w5 == chrono::seconds( 1 ) );
+  REQUIRE( reader.finished() );
+
+  // Once the journal runs out the game is quit, and that comes
+  // back through the wait.
+  wait<maybe<string>> w6 = replay.optional_choice( config );
+  REQUIRE( w6.has_exception() );
+  REQUIRE_THROWS_AS( rethrow_exception( w6.exception() ),
+                     game_quit_interrupt );
+}
+
+TEST_CASE( "[replay] session" ) {
+  World          W;
+  MockIRand      real_rand;
+  MockIGui       real_gui;
+  fs::path const path =
+      fs::temp_directory_path() / "rn-test-session.rpl";
+  ReplayedInput_t const menu_input =
+      ReplayedInput::menu{ .item = e_menu_item::save };
+  ReplayedInput_t const button_input =
+      ReplayedInput::eot_button{};
+
+  {
+    ReplaySession session( ReplayMode::record{ .path = path },
+                           real_rand, real_gui );
+    REQUIRE_FALSE( is_replaying() );
+    replay_state_checkpoint( W.root() );
+    auto const menu = [&] {
+      return make_wait<ReplayedInput_t>( menu_input );
+    };
+    wait<ReplayedInput_t> const w1 =
+        replayable_player_input( menu );
+    REQUIRE( w1.ready() );
+    REQUIRE( *w1 == menu_input );
+    // A race that is still pending when the game is quit is not
+    // recorded.
+    wait_promise<ReplayedInput_t> p;
+    auto const pending = [&] { return p.wait(); };
+    wait<ReplayedInput_t> const w2 =
+        replayable_player_input( pending );
+    REQUIRE_FALSE( w2.ready() );
+    replay_state_checkpoint( W.root() );
+    auto const button = [&] {
+      return make_wait<ReplayedInput_t>( button_input );
+    };
+    wait<ReplayedInput_t> const w3 =
+        replayable_player_input( button );
+    REQUIRE( *w3 == button_input );
+  }
+
+  ReplaySession session( ReplayMode::replay{ .path = path },
+                         real_rand, real_gui );
+  REQUIRE( is_replaying() );
+  // The races are not run at all when replaying.
+  auto const no_race = []() -> wait<ReplayedInput_t> {
+    FATAL( "should not be called." );
+  };
+  replay_state_checkpoint( W.root() );
+  wait<ReplayedInput_t> const w1 =
+      replayable_player_input( no_race );
+  REQUIRE( w1.ready() );
+  REQUIRE( *w1 == menu_input );
+  replay_state_checkpoint( W.root() );
+  wait<ReplayedInput_t> const w3 =
+      replayable_player_input( no_race );
+  REQUIRE( *w3 == button_input );
+  wait<ReplayedInput_t> const w4 =
+      replayable_player_input( no_race );
+  REQUIRE( w4.has_exception() );
+  fs::remove( path );
+}
+
+TEST_CASE( "[replay] state hash" ) {
+  World          W;
+  uint64_t const hash = replay_state_hash( W.root() );
+  REQUIRE( replay_state_hash( W.root() ) == hash );
+  W.add_player( e_nation::dutch );
+  REQUIRE( replay_state_hash( W.root() ) != hash );
+}
+
+} // namespace
+} // namespace rn
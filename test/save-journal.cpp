@@ -0,0 +1,340 @@
+/****************************************************************
+**save-journal.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/save-journal.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/save-journal.hpp"
+
+// Testing
+#include "test/fake/world.hpp"
+
+// ss
+#include "src/ss/player.rds.hpp"
+#include "src/ss/root.hpp"
+#include "src/ss/terrain.hpp"
+
+// refl
+#include "refl/cdr.hpp"
+
+// cdr
+#include "src/cdr/converter.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+using namespace ::cdr::literals;
+
+/****************************************************************
+** Fake World Setup
+*****************************************************************/
+struct World : testing::World {
+  using Base = testing::World;
+  World() : Base() {
+    add_player( e_nation::dutch );
+    set_default_player( e_nation::dutch );
+    create_default_map();
+  }
+
+  void create_default_map() {
+    MapSquare const   _ = make_ocean();
+    MapSquare const   L = make_grassland();
+    vector<MapSquare> tiles{
+        _, L, L, //
+        L, L, L, //
+        _, L, L, //
+    };
+    build_map( std::move( tiles ), 3 );
+  }
+};
+
+cdr::converter::options const kCdrOpts{
+    .write_fields_with_default_value = true,
+};
+
+// Runs the diff and then applies the patches to the old value.
+cdr::value round_trip( cdr::value const& old,
+                       cdr::value const& now ) {
+  vector<CdrPatch> patches;
+  diff_cdr( old, now, {}, patches );
+  cdr::value res = old;
+  for( CdrPatch const& patch : patches ) {
+    auto const ok = apply_cdr_patch( res, patch );
+    REQUIRE( ok.valid() );
+  }
+  return res;
+}
+
+RootState load( cdr::value const& snapshot ) {
+  cdr::converter::options const load_opts{
+      .allow_unrecognized_fields        = false,
+      .default_construct_missing_fields = true,
+  };
+  UNWRAP_CHECK( res,
+                cdr::run_conversion_from_canonical<RootState>(
+                    snapshot, load_opts ) );
+  return res;
+}
+
+/****************************************************************
+** Test Cases
+*****************************************************************/
+TEST_CASE( "[save-journal] diff_cdr" ) {
+  cdr::value const old = cdr::table{
+      "a"_key = 1,
+      "b"_key = cdr::table{ "c"_key = "x", "d"_key = 2.5 },
+      "e"_key = cdr::list{ 1, 2, 3 },
+      "f"_key = cdr::list{
+          cdr::table{ "key"_key = 5, "val"_key = "five" },
+          cdr::table{ "key"_key = 7, "val"_key = "seven" } },
+  };
+  vector<CdrPatch> patches;
+
+  SECTION( "no change" ) {
+    diff_cdr( old, old, {}, patches );
+    REQUIRE( patches.empty() );
+  }
+
+  SECTION( "nested change" ) {
+    cdr::value now = old;
+    now.get<cdr::table>()["b"].get<cdr::table>()["d"] = 3.5;
+    diff_cdr( old, now, {}, patches );
+    vector<CdrPatch> const expected{
+        { .path = { "b", "d" }, .value = 3.5 } };
+    REQUIRE( patches == expected );
+    REQUIRE( round_trip( old, now ) == now );
+  }
+
+  SECTION( "list element" ) {
+    cdr::value now = old;
+    now.get<cdr::table>()["e"] = cdr::list{ 1, 9, 3 };
+    diff_cdr( old, now, {}, patches );
+    vector<CdrPatch> const expected{
+        { .path = { "e", 1 }, .value = 9 } };
+    REQUIRE( patches == expected );
+    REQUIRE( round_trip( old, now ) == now );
+  }
+
+  SECTION( "list size change" ) {
+    cdr::value now = old;
+    now.get<cdr::table>()["e"] = cdr::list{ 1, 2 };
+    REQUIRE( round_trip( old, now ) == now );
+  }
+
+  SECTION( "keyed list" ) {
+    cdr::value now = old;
+    now.get<cdr::table>()["f"] = cdr::list{
+        cdr::table{ "key"_key = 7, "val"_key = "SEVEN" },
+        cdr::table{ "key"_key = 8, "val"_key = "eight" } };
+    diff_cdr( old, now, {}, patches );
+    cdr::value const k5 = cdr::table{ "key"_key = 5 };
+    cdr::value const k7 = cdr::table{ "key"_key = 7 };
+    cdr::value const k8 = cdr::table{ "key"_key = 8 };
+    vector<CdrPatch> const expected{
+        { .path = { "f", k5 }, .value = nothing },
+        { .path = { "f", k7, "val" }, .value = "SEVEN" },
+        { .path = { "f", k8 },
+          .value =
+              cdr::table{ "key"_key = 8, "val"_key = "eight" } },
+    };
+    REQUIRE( patches == expected );
+    REQUIRE( round_trip( old, now ) == now );
+  }
+
+  SECTION( "keys added and removed" ) {
+    cdr::value now = old;
+    cdr::table tbl;
+    for( auto const& [k, v] : now.get<cdr::table>() )
+      if( k != "a" ) tbl[k] = v;
+    tbl["g"] = cdr::null;
+    now      = tbl;
+    REQUIRE( round_trip( old, now ) == now );
+  }
+}
+
+TEST_CASE( "[save-journal] apply_cdr_patch errors" ) {
+  cdr::value v = cdr::table{ "a"_key = cdr::list{ 1 } };
+  REQUIRE_FALSE(
+      apply_cdr_patch( v, { .path = { "b", "c" }, .value = 1 } )
+          .valid() );
+  REQUIRE_FALSE(
+      apply_cdr_patch( v, { .path = { "a", 1 }, .value = 1 } )
+          .valid() );
+  // List elements can't be removed by index.
+  CdrPatch const remove{ .path = { "a", cdr::integer_type{ 0 } },
+                         .value = nothing };
+  REQUIRE_FALSE( apply_cdr_patch( v, remove ).valid() );
+}
+
+TEST_CASE( "[save-journal] journal round trip" ) {
+  World       W;
+  SaveJournal journal;
+  REQUIRE_FALSE( journal.has_baseline() );
+
+  W.add_unit_on_map( e_unit_type::free_colonist,
+                     { .x = 1, .y = 1 } );
+  cdr::value snapshot =
+      cdr::run_conversion_to_canonical( W.root(), kCdrOpts );
+  journal.reset( W.root() );
+  REQUIRE( journal.has_baseline() );
+  REQUIRE( journal.record( W.root() ) == nothing );
+
+  // Turn 1.
+  W.add_unit_on_map( e_unit_type::soldier, { .x = 2, .y = 1 } );
+  W.add_road( { .x = 1, .y = 2 } );
+  maybe<string> const entry1 = journal.record( W.root() );
+  REQUIRE( entry1.has_value() );
+
+  // Turn 2.
+  W.dutch().money = 123;
+  W.square( { .x = 2, .y = 2 } ).overlay = e_land_overlay::hills;
+  maybe<string> const entry2 = journal.record( W.root() );
+  REQUIRE( entry2.has_value() );
+  REQUIRE( journal.entries() == 2 );
+
+  // Only the fields that changed are written.
+  REQUIRE( entry2->find( "units" ) == string::npos );
+  REQUIRE( entry2->find( "players" ) != string::npos );
+  REQUIRE( entry2->find( "zzz_terrain" ) != string::npos );
+
+  string const journal_text = *entry1 + *entry2;
+  AppliedSaveJournal const applied = apply_save_journal(
+      snapshot, "test.jrn.rcl", journal_text );
+  REQUIRE( applied.entries == 2 );
+  REQUIRE( applied.size == int( journal_text.size() ) );
+  REQUIRE( applied.truncated == nothing );
+  REQUIRE( load( snapshot ) == W.root() );
+}
+
+TEST_CASE( "[save-journal] terrain squares" ) {
+  World       W;
+  SaveJournal journal;
+  journal.reset( W.root() );
+  cdr::value snapshot =
+      cdr::run_conversion_to_canonical( W.root(), kCdrOpts );
+
+  W.add_road( { .x = 1, .y = 2 } );
+  Coord const explored{ .x = 2, .y = 0 };
+  W.terrain()
+      .mutable_player_terrain( e_nation::dutch )
+      .map[explored] = FogSquare{};
+  maybe<string> const entry = journal.record( W.root() );
+  REQUIRE( entry.has_value() );
+  // Only the squares that have changed are written, not entire
+  // maps (which would have their sizes written).
+  REQUIRE( entry->find( "world_map" ) != string::npos );
+  REQUIRE( entry->find( "player_terrain" ) != string::npos );
+  REQUIRE( entry->find( "has_coords" ) == string::npos );
+  REQUIRE( entry->find( "proto_squares" ) == string::npos );
+  REQUIRE( apply_save_journal( snapshot, "test.jrn.rcl", *entry )
+               .entries == 1 );
+  REQUIRE( load( snapshot ) == W.root() );
+  REQUIRE( journal.record( W.root() ) == nothing );
+}
+
+TEST_CASE( "[save-journal] truncated journal" ) {
+  World       W;
+  SaveJournal journal;
+  journal.reset( W.root() );
+  cdr::value snapshot =
+      cdr::run_conversion_to_canonical( W.root(), kCdrOpts );
+
+  W.dutch().money = 123;
+  W.add_road( { .x = 1, .y = 2 } );
+  maybe<string> const entry1 = journal.record( W.root() );
+  REQUIRE( entry1.has_value() );
+  RootState const after_entry1 = W.root();
+
+  W.dutch().money = 456;
+  W.add_road( { .x = 2, .y = 2 } );
+  maybe<string> const entry2 = journal.record( W.root() );
+  REQUIRE( entry2.has_value() );
+
+  string journal_text = *entry1 + *entry2;
+  SECTION( "final entry cut off" ) {
+    journal_text.resize( journal_text.size() - 10 );
+  }
+  SECTION( "final entry header cut off" ) {
+    journal_text.resize( entry1->size() + 5 );
+  }
+  SECTION( "final entry corrupted" ) {
+    journal_text[entry1->size() + entry2->size() / 2] ^= 1;
+  }
+  SECTION( "final entry garbage" ) {
+    journal_text = *entry1 + "entry_000002 { ops: [";
+  }
+
+  AppliedSaveJournal const applied = apply_save_journal(
+      snapshot, "test.jrn.rcl", journal_text );
+  REQUIRE( applied.entries == 1 );
+  REQUIRE( applied.size == int( entry1->size() ) );
+  REQUIRE( applied.truncated.has_value() );
+  REQUIRE( applied.truncated->starts_with(
+      "test.jrn.rcl: entry 2: " ) );
+  REQUIRE( load( snapshot ) == after_entry1 );
+}
+
+TEST_CASE( "[save-journal] entry that fails is not applied" ) {
+  World       W;
+  SaveJournal journal;
+  journal.reset( W.root() );
+  cdr::value snapshot =
+      cdr::run_conversion_to_canonical( W.root(), kCdrOpts );
+  cdr::value const original = snapshot;
+
+  // The players are patched before the terrain, which will fail.
+  W.dutch().money = 123;
+  W.add_road( { .x = 1, .y = 2 } );
+  maybe<string> const entry = journal.record( W.root() );
+  REQUIRE( entry.has_value() );
+  cdr::table& tbl = snapshot.get<cdr::table>();
+  tbl["zzz_terrain"] = cdr::table{};
+  cdr::value const expected = snapshot;
+
+  AppliedSaveJournal const applied =
+      apply_save_journal( snapshot, "test.jrn.rcl", *entry );
+  REQUIRE( applied.entries == 0 );
+  REQUIRE( applied.size == 0 );
+  REQUIRE( applied.truncated.has_value() );
+  REQUIRE( snapshot == expected );
+  REQUIRE( snapshot != original );
+}
+
+TEST_CASE( "[save-journal] bad journal" ) {
+  cdr::value snapshot = cdr::table{ "a"_key = 1 };
+  AppliedSaveJournal applied;
+
+  SECTION( "no entry header" ) {
+    applied = apply_save_journal( snapshot, "test.jrn.rcl",
+                                  "entry_000001 { ops: [] }" );
+    REQUIRE( applied.truncated.has_value() );
+    REQUIRE( *applied.truncated ==
+             "test.jrn.rcl: entry 1: entry header is missing." );
+  }
+
+  SECTION( "malformed entry header" ) {
+    applied = apply_save_journal( snapshot, "test.jrn.rcl",
+                                  "# entry 12\nentry_000001" );
+    REQUIRE( applied.truncated.has_value() );
+    REQUIRE( *applied.truncated ==
+             "test.jrn.rcl: entry 1: entry header is "
+             "malformed." );
+  }
+
+  REQUIRE( applied.entries == 0 );
+  REQUIRE( snapshot == cdr::table{ "a"_key = 1 } );
+}
+
+} // namespace
+} // namespace rn
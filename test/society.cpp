@@ -20,6 +20,9 @@
 #include "ss/dwelling.rds.hpp"
 #include "ss/ref.hpp"
 
+// luapp
+#include "luapp/state.hpp"
+
 // Must be last.
 #include "test/catch-common.hpp"
 
@@ -28,6 +31,8 @@ namespace {
 
 using namespace std;
 
+using Catch::Contains;
+
 /****************************************************************
 ** Fake World Setup
 *****************************************************************/
@@ -121,5 +126,40 @@ TEST_CASE( "[society] society_on_square" ) {
   }
 }
 
+TEST_CASE( "[society] lua cannot move colonies or dwellings" ) {
+  World W;
+  W.expensive_run_lua_init();
+  Coord const where{ .x = 1, .y = 1 };
+  W.add_colony_with_new_unit( where, e_nation::french );
+  W.add_dwelling( { .x = 2, .y = 2 }, e_tribe::inca );
+
+  auto run = [&]( string const& code ) {
+    lua::lua_valid const res = W.lua().script.run_safe( code );
+    REQUIRE_FALSE( res.valid() );
+    REQUIRE_THAT( res.error(),
+                  Contains( "attempt to set const field" ) );
+  };
+
+  // These would bypass the per-tile and per-nation indices.
+  run( R"(
+    local colony = ROOT.colonies:colony_for_id( 1 )
+    assert( colony.nation == 'french' )
+    colony.nation = 'dutch'
+  )" );
+  run( R"(
+    local colony = ROOT.colonies:colony_for_id( 1 )
+    assert( colony.location.x == 1 )
+    colony.location = { x=0, y=1 }
+  )" );
+  run( R"(
+    local dwelling = ROOT.natives:dwelling_for_id( 1 )
+    assert( dwelling.location.x == 2 )
+    dwelling.location = { x=0, y=1 }
+  )" );
+
+  REQUIRE( society_on_square( W.ss(), where ) ==
+           Society::european{ .nation = e_nation::french } );
+}
+
 } // namespace
 } // namespace rn
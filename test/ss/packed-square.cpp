@@ -0,0 +1,131 @@
+/****************************************************************
+**packed-square.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/ss/packed-square.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/ss/packed-square.hpp"
+
+// refl
+#include "refl/query-enum.hpp"
+#include "refl/to-str.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+MapSquare make_land() {
+  return MapSquare{ .surface = e_surface::land,
+                    .ground  = e_ground_terrain::grassland };
+}
+
+TEST_CASE( "[packed-square] default" ) {
+  REQUIRE( PackedSquare::pack( MapSquare{} ) == PackedSquare{} );
+  REQUIRE( PackedSquare{}.unpack() == MapSquare{} );
+}
+
+TEST_CASE( "[packed-square] accessors" ) {
+  MapSquare const square{
+      .surface         = e_surface::land,
+      .ground          = e_ground_terrain::tundra,
+      .overlay         = e_land_overlay::forest,
+      .river           = e_river::major,
+      .ground_resource = e_natural_resource::wheat,
+      .forest_resource = e_natural_resource::beaver,
+      .irrigation      = false,
+      .road            = true,
+      .sea_lane        = false,
+      .lost_city_rumor = true };
+  PackedSquare const packed = PackedSquare::pack( square );
+  REQUIRE( packed.surface() == e_surface::land );
+  REQUIRE( packed.ground() == e_ground_terrain::tundra );
+  REQUIRE( packed.has_overlay() );
+  REQUIRE( packed.has_river() );
+  REQUIRE_FALSE( packed.irrigation() );
+  REQUIRE( packed.road() );
+  REQUIRE_FALSE( packed.sea_lane() );
+  REQUIRE( packed.lost_city_rumor() );
+  REQUIRE( packed.unpack() == square );
+}
+
+TEST_CASE( "[packed-square] round trip" ) {
+  // Make sure that the largest value of each enum survives, as
+  // well as each one on its own with everything else set.
+  MapSquare square{
+      .surface = e_surface::water,
+      .ground  = refl::enum_values<e_ground_terrain>.back(),
+      .overlay = refl::enum_values<e_land_overlay>.back(),
+      .river   = refl::enum_values<e_river>.back(),
+      .ground_resource =
+          refl::enum_values<e_natural_resource>.back(),
+      .forest_resource =
+          refl::enum_values<e_natural_resource>.back(),
+      .irrigation      = true,
+      .road            = true,
+      .sea_lane        = true,
+      .lost_city_rumor = true };
+  REQUIRE( PackedSquare::pack( square ).unpack() == square );
+
+  for( e_ground_terrain const ground :
+       refl::enum_values<e_ground_terrain> ) {
+    square.ground = ground;
+    REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  }
+  for( e_land_overlay const overlay :
+       refl::enum_values<e_land_overlay> ) {
+    square.overlay = overlay;
+    REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  }
+  square.overlay = nothing;
+  REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  for( e_river const river : refl::enum_values<e_river> ) {
+    square.river = river;
+    REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  }
+  square.river = nothing;
+  REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  for( e_natural_resource const resource :
+       refl::enum_values<e_natural_resource> ) {
+    square.ground_resource = resource;
+    square.forest_resource = nothing;
+    REQUIRE( PackedSquare::pack( square ).unpack() == square );
+    square.ground_resource = nothing;
+    square.forest_resource = resource;
+    REQUIRE( PackedSquare::pack( square ).unpack() == square );
+  }
+}
+
+TEST_CASE( "[packed-square] pack_map" ) {
+  REQUIRE( pack_map( Matrix<MapSquare>{} ).size() == Delta{} );
+
+  Matrix<MapSquare> m( Delta{ .w = 3, .h = 2 } );
+  Coord const       tile{ .x = 2, .y = 1 };
+  m[tile]      = make_land();
+  m[tile].road = true;
+  Matrix<PackedSquare> const packed = pack_map( m );
+  REQUIRE( packed.size() == Delta{ .w = 3, .h = 2 } );
+  for( int y = 0; y < 2; ++y )
+    for( int x = 0; x < 3; ++x )
+      REQUIRE( packed[y][x].unpack() == m[y][x] );
+  REQUIRE( packed[tile].surface() == e_surface::land );
+  REQUIRE( packed[tile].road() );
+  REQUIRE( packed[Coord{}].surface() == e_surface::water );
+
+  // It is a snapshot.
+  m[Coord{}] = make_land();
+  REQUIRE( packed[Coord{}].surface() == e_surface::water );
+}
+
+} // namespace
+} // namespace rn
@@ -0,0 +1,85 @@
+/****************************************************************
+**tile-layer.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/ss/tile-layer.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/ss/tile-layer.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[tile-layer] empty" ) {
+  TileLayer<int> layer;
+  REQUIRE( layer.size() == Delta{} );
+  REQUIRE( layer[Coord{}] == 0 );
+  REQUIRE( layer[Coord{ .x = 5, .y = 7 }] == 0 );
+  REQUIRE( layer[Coord{ .x = -1, .y = 0 }] == 0 );
+  REQUIRE( layer.count_if( []( int n ) { return n != 0; } ) ==
+           0 );
+}
+
+TEST_CASE( "[tile-layer] grows on write" ) {
+  TileLayer<int> layer;
+  layer.mutable_at( Coord{ .x = 2, .y = 1 } ) = 5;
+  REQUIRE( layer.size() == Delta{ .w = 3, .h = 2 } );
+  REQUIRE( layer[Coord{ .x = 2, .y = 1 }] == 5 );
+  REQUIRE( layer[Coord{ .x = 1, .y = 1 }] == 0 );
+
+  // Grows in one dimension only, keeping existing values.
+  layer.mutable_at( Coord{ .x = 0, .y = 4 } ) = 6;
+  REQUIRE( layer.size() == Delta{ .w = 3, .h = 5 } );
+  REQUIRE( layer[Coord{ .x = 2, .y = 1 }] == 5 );
+  REQUIRE( layer[Coord{ .x = 0, .y = 4 }] == 6 );
+
+  // Grows by at least half.
+  layer.mutable_at( Coord{ .x = 3, .y = 0 } ) = 7;
+  REQUIRE( layer.size() == Delta{ .w = 4, .h = 5 } );
+  layer.mutable_at( Coord{ .x = 4, .y = 0 } ) = 8;
+  REQUIRE( layer.size() == Delta{ .w = 6, .h = 5 } );
+  REQUIRE( layer[Coord{ .x = 3, .y = 0 }] == 7 );
+  REQUIRE( layer[Coord{ .x = 4, .y = 0 }] == 8 );
+  REQUIRE( layer.count_if( []( int n ) { return n != 0; } ) ==
+           4 );
+
+  layer.reset( Coord{ .x = 2, .y = 1 } );
+  REQUIRE( layer[Coord{ .x = 2, .y = 1 }] == 0 );
+  // Resetting outside of the layer does nothing.
+  layer.reset( Coord{ .x = 20, .y = 1 } );
+  REQUIRE( layer.size() == Delta{ .w = 6, .h = 5 } );
+  REQUIRE( layer.count_if( []( int n ) { return n != 0; } ) ==
+           3 );
+
+  layer.clear();
+  REQUIRE( layer.size() == Delta{} );
+  REQUIRE( layer[Coord{ .x = 0, .y = 4 }] == 0 );
+}
+
+TEST_CASE( "[tile-layer] equality ignores size" ) {
+  TileLayer<int> l1;
+  TileLayer<int> l2( Delta{ .w = 10, .h = 10 } );
+  REQUIRE( l1 == l2 );
+  l1.mutable_at( Coord{ .x = 1, .y = 2 } ) = 3;
+  REQUIRE( l1 != l2 );
+  l2.mutable_at( Coord{ .x = 1, .y = 2 } ) = 3;
+  REQUIRE( l1 == l2 );
+  l2.mutable_at( Coord{ .x = 9, .y = 9 } ) = 1;
+  REQUIRE( l1 != l2 );
+  l2.reset( Coord{ .x = 9, .y = 9 } );
+  REQUIRE( l1 == l2 );
+}
+
+} // namespace
+} // namespace rn
@@ -79,5 +79,60 @@ TEST_CASE( "[units] dwelling_for/from_dwelling" ) {
            nothing );
 }
 
+TEST_CASE( "[units] euro_units_for_nation" ) {
+  World W;
+  W.add_player( e_nation::english );
+  W.add_player( e_nation::french );
+  auto ids = [&]( e_nation nation ) {
+    span<UnitId const> const res =
+        W.units().euro_units_for_nation( nation );
+    return vector<UnitId>( res.begin(), res.end() );
+  };
+
+  REQUIRE( ids( e_nation::english ) == vector<UnitId>{} );
+
+  UnitId const id1 =
+      W.add_free_unit( e_unit_type::free_colonist,
+                       e_nation::english )
+          .id();
+  UnitId const id2 =
+      W.add_unit_on_map( e_unit_type::galleon, { .x = 0, .y = 0 },
+                         e_nation::french )
+          .id();
+  UnitId const id3 =
+      W.add_unit_in_cargo( e_unit_type::soldier, id2,
+                           e_nation::french )
+          .id();
+  UnitId const id4 =
+      W.add_free_unit( e_unit_type::scout, e_nation::english )
+          .id();
+  REQUIRE( ids( e_nation::english ) ==
+           vector<UnitId>{ id1, id4 } );
+  REQUIRE( ids( e_nation::french ) ==
+           vector<UnitId>{ id2, id3 } );
+  REQUIRE( ids( e_nation::dutch ) == vector<UnitId>{} );
+
+  // Changing the nation of the ship also changes its cargo, and
+  // the ids end up sorted.
+  W.units().unit_for( id2 ).change_nation( W.units(),
+                                           e_nation::english );
+  REQUIRE( ids( e_nation::english ) ==
+           vector<UnitId>{ id1, id2, id3, id4 } );
+  REQUIRE( ids( e_nation::french ) == vector<UnitId>{} );
+
+  // Destroying the ship also destroys its cargo.
+  W.units().destroy_unit( id2 );
+  REQUIRE( ids( e_nation::english ) ==
+           vector<UnitId>{ id1, id4 } );
+
+  // Rebuilt on load.
+  UnitsState const reloaded(
+      wrapped::UnitsState( W.units().refl() ) );
+  span<UnitId const> const english =
+      reloaded.euro_units_for_nation( e_nation::english );
+  REQUIRE( vector<UnitId>( english.begin(), english.end() ) ==
+           vector<UnitId>{ id1, id4 } );
+}
+
 } // namespace
 } // namespace rn
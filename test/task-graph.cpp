@@ -0,0 +1,144 @@
+/****************************************************************
+**task-graph.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/task-graph.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/task-graph.hpp"
+
+// C++ standard library
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+// A diamond: 0 -> {1, 2} -> 3, plus an unrelated 4.
+vector<TaskGraphNode> diamond( vector<int>& order, mutex& m,
+                               bool main_thread ) {
+  auto record = [&]( int n ) {
+    return [&, n] {
+      lock_guard lock( m );
+      order.push_back( n );
+    };
+  };
+  vector<TaskGraphNode> nodes;
+  nodes.push_back( { record( 0 ), {}, main_thread } );
+  nodes.push_back( { record( 1 ), { 0 }, main_thread } );
+  nodes.push_back( { record( 2 ), { 0 }, main_thread } );
+  nodes.push_back( { record( 3 ), { 1, 2 }, main_thread } );
+  nodes.push_back( { record( 4 ), {}, main_thread } );
+  return nodes;
+}
+
+void check_order( vector<int> const& order ) {
+  REQUIRE( order.size() == 5 );
+  auto pos = [&]( int n ) {
+    return find( order.begin(), order.end(), n ) - order.begin();
+  };
+  REQUIRE( pos( 0 ) < pos( 1 ) );
+  REQUIRE( pos( 0 ) < pos( 2 ) );
+  REQUIRE( pos( 1 ) < pos( 3 ) );
+  REQUIRE( pos( 2 ) < pos( 3 ) );
+}
+
+TEST_CASE( "[task-graph] no workers" ) {
+  vector<int> order;
+  mutex       m;
+  auto nodes = diamond( order, m, /*main_thread=*/false );
+  vector<TaskTiming> const timings =
+      run_task_graph( nodes, /*num_workers=*/0 );
+  check_order( order );
+  REQUIRE( timings.size() == 5 );
+  for( TaskTiming const& timing : timings ) {
+    REQUIRE( timing.on_main_thread );
+    REQUIRE( timing.start <= timing.end );
+  }
+}
+
+TEST_CASE( "[task-graph] with workers" ) {
+  vector<int> order;
+  mutex       m;
+  auto nodes = diamond( order, m, /*main_thread=*/false );
+  // Put one in the middle on the main thread.
+  thread::id main_id   = this_thread::get_id();
+  thread::id ran_on    = {};
+  auto       old_run_1 = nodes[1].run;
+  nodes[1].run         = [&] {
+    ran_on = this_thread::get_id();
+    old_run_1();
+  };
+  nodes[1].main_thread = true;
+  vector<TaskTiming> const timings =
+      run_task_graph( nodes, /*num_workers=*/3 );
+  check_order( order );
+  REQUIRE( ran_on == main_id );
+  REQUIRE( timings.size() == 5 );
+  for( TaskTiming const& timing : timings )
+    REQUIRE( timing.on_main_thread == ( timing.node == 1 ) );
+}
+
+TEST_CASE( "[task-graph] independent tasks overlap" ) {
+  // Each of these waits for the other to start, so this would
+  // time out if they were run one after the other.
+  using Clock            = chrono::steady_clock;
+  atomic<int> started    = 0;
+  auto        rendezvous = [&] {
+    ++started;
+    auto const deadline = Clock::now() + chrono::seconds( 10 );
+    while( started < 2 && Clock::now() < deadline )
+      this_thread::yield();
+  };
+  vector<TaskGraphNode> nodes;
+  nodes.push_back( { rendezvous, {}, /*main_thread=*/false } );
+  nodes.push_back( { rendezvous, {}, /*main_thread=*/true } );
+  run_task_graph( nodes, /*num_workers=*/1 );
+  REQUIRE( started == 2 );
+}
+
+TEST_CASE( "[task-graph] exception" ) {
+  int                   ran = 0;
+  vector<TaskGraphNode> nodes;
+  nodes.push_back(
+      { [] { throw runtime_error( "failed" ); }, {}, false } );
+  nodes.push_back( { [&] { ++ran; }, { 0 }, true } );
+  REQUIRE_THROWS_WITH( run_task_graph( nodes, 2 ), "failed" );
+  // The dependent was never started.
+  REQUIRE( ran == 0 );
+}
+
+TEST_CASE( "[task-graph] critical path" ) {
+  vector<TaskGraphNode> nodes( 4 );
+  nodes[1].deps = { 0 };
+  nodes[2].deps = { 0 };
+  nodes[3].deps = { 1, 2 };
+  using us      = chrono::microseconds;
+  // Finished in this order: 0, 2, 1, 3.
+  vector<TaskTiming> const timings{
+      { .node = 0, .start = us{ 0 }, .end = us{ 10 } },
+      { .node = 2, .start = us{ 10 }, .end = us{ 15 } },
+      { .node = 1, .start = us{ 10 }, .end = us{ 30 } },
+      { .node = 3, .start = us{ 30 }, .end = us{ 40 } },
+  };
+  REQUIRE( task_graph_critical_path( nodes, timings ) ==
+           vector<int>{ 0, 1, 3 } );
+  REQUIRE( task_graph_critical_path( nodes, {} ) ==
+           vector<int>{} );
+}
+
+} // namespace
+} // namespace rn
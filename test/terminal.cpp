@@ -20,6 +20,10 @@
 // luapp
 #include "src/luapp/state.hpp"
 
+// C++ standard library
+#include <cstdio>
+#include <thread>
+
 // Must be last.
 #include "test/catch-common.hpp"
 
@@ -397,5 +401,98 @@ TEST_CASE(
   REQUIRE_THAT( autocomplete( in ), Equals( empty ) );
 }
 
+TEST_CASE( "[terminal] log and line" ) {
+  lua::state st;
+  Terminal   term( st );
+
+  REQUIRE( term.line( 0 ) == nothing );
+
+  term.log( "hello" );
+  term.log( "" );
+  term.log( "world" );
+  REQUIRE( term.line( 0 ) == "world" );
+  REQUIRE( term.line( 1 ) == "" );
+  REQUIRE( term.line( 2 ) == "hello" );
+  REQUIRE( term.line( 3 ) == nothing );
+  REQUIRE( term.line( -1 ) == nothing );
+
+  term.clear();
+  REQUIRE( term.line( 0 ) == nothing );
+  term.log( "after clear" );
+  REQUIRE( term.line( 0 ) == "after clear" );
+  REQUIRE( term.line( 1 ) == nothing );
+
+  // Long lines are truncated.
+  term.log( string( Terminal::kMaxLineLength + 10, 'x' ) );
+  REQUIRE( term.line( 0 ) ==
+           string( Terminal::kMaxLineLength, 'x' ) );
+}
+
+TEST_CASE( "[terminal] scrollback wraps around" ) {
+  lua::state st;
+  Terminal   term( st );
+
+  int const total = Terminal::kMaxScrollbackLines + 100;
+  for( int i = 0; i < total; ++i )
+    term.log( fmt::format( "line {}", i ) );
+  REQUIRE( term.line( 0 ) == fmt::format( "line {}", total - 1 ) );
+  REQUIRE( term.line( Terminal::kMaxScrollbackLines - 1 ) ==
+           fmt::format( "line {}", 100 ) );
+  REQUIRE( term.line( Terminal::kMaxScrollbackLines ) ==
+           nothing );
+}
+
+TEST_CASE( "[terminal] arena wraps around" ) {
+  lua::state st;
+  Terminal   term( st );
+
+  // Each of these takes up most of a chunk, so the arena will
+  // wrap long before the ring of lines does, and lines whose
+  // text has been overwritten must not be returned.
+  string const big( Terminal::kArenaChunkSize - 1, 'y' );
+  for( int i = 0; i < Terminal::kArenaChunks + 10; ++i )
+    term.log( big );
+  term.log( "last" );
+  REQUIRE( term.line( 0 ) == "last" );
+  int count = 1;
+  while( term.line( count ).has_value() ) {
+    REQUIRE( term.line( count ) == big );
+    ++count;
+  }
+  REQUIRE( count > 1 );
+  REQUIRE( count <= Terminal::kArenaChunks + 1 );
+}
+
+TEST_CASE( "[terminal] concurrent logging" ) {
+  lua::state st;
+  Terminal   term( st );
+
+  int const kThreads        = 4;
+  int const kLinesPerThread = 1000;
+
+  vector<jthread> threads;
+  for( int t = 0; t < kThreads; ++t )
+    threads.emplace_back( [&, t] {
+      for( int i = 0; i < kLinesPerThread; ++i )
+        term.log( fmt::format( "thread {} line {}", t, i ) );
+    } );
+  // Read while the others are writing.
+  for( int i = 0; i < 100; ++i ) (void)term.line( i );
+  threads.clear();
+
+  // Each thread's lines must all be present and in order.
+  vector<int> next( kThreads, kLinesPerThread - 1 );
+  for( int i = 0; i < kThreads * kLinesPerThread; ++i ) {
+    maybe<string> const line = term.line( i );
+    REQUIRE( line.has_value() );
+    int t = 0, n = 0;
+    REQUIRE( sscanf( line->c_str(), "thread %d line %d", &t,
+                     &n ) == 2 );
+    REQUIRE( n == next[t] );
+    --next[t];
+  }
+  REQUIRE( term.line( kThreads * kLinesPerThread ) == nothing );
+}
+
 } // namespace
 } // namespace rn
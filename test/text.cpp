@@ -0,0 +1,117 @@
+/****************************************************************
+**text.cpp
+*
+* Project: Revolution Now
+*
+* Created by dsicilia on 2022-12-23.
+*
+* Description: Unit tests for the src/text.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/text.hpp"
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+gfx::size const kCharSize{ .w = 6, .h = 8 };
+
+TEST_CASE( "[text] layout without reflow" ) {
+  TextLayout const expected{
+      .runs = {
+          { .offset = { .w = 0, .h = 0 }, .text = "ab" },
+          { .offset = { .w = 12, .h = 0 },
+            .style  = { .highlight = true },
+            .text   = "cd" },
+          { .offset = { .w = 24, .h = 0 }, .text = "e" },
+          { .offset = { .w = 0, .h = 9 }, .text = "f" },
+      } };
+  REQUIRE( compute_text_layout( kCharSize, /*max_cols=*/nothing,
+                                "ab@[H]cd@[]e\nf" ) == expected );
+}
+
+TEST_CASE( "[text] layout with shadow" ) {
+  // A line with shadowed text gets one extra pixel of height.
+  TextLayout const expected{
+      .runs = {
+          { .offset = { .w = 0, .h = 0 },
+            .style  = { .shadow = true },
+            .text   = "ab" },
+          { .offset = { .w = 0, .h = 10 }, .text = "c" },
+      } };
+  REQUIRE( compute_text_layout( kCharSize, /*max_cols=*/nothing,
+                                "@[S]ab@[]\nc" ) == expected );
+}
+
+TEST_CASE( "[text] layout with reflow" ) {
+  TextLayout const expected{
+      .runs = {
+          { .offset = { .w = 0, .h = 0 }, .text = "one two" },
+          { .offset = { .w = 0, .h = 9 }, .text = "three" },
+      } };
+  REQUIRE( compute_text_layout( kCharSize, /*max_cols=*/9,
+                                "one two\nthree" ) == expected );
+}
+
+TEST_CASE( "[text] layout cache" ) {
+  int const old_capacity = text_layout_cache_stats().capacity;
+  clear_text_layout_cache();
+  set_text_layout_cache_capacity( 2 );
+
+  auto layout = [&]( string_view text, maybe<int> max_cols ) {
+    shared_ptr<TextLayout const> const res =
+        cached_text_layout( kCharSize, max_cols, text );
+    REQUIRE( res != nullptr );
+    REQUIRE( *res ==
+             compute_text_layout( kCharSize, max_cols, text ) );
+    return res;
+  };
+
+  auto stats = [] {
+    TextLayoutCacheStats const s = text_layout_cache_stats();
+    return tuple{ s.hits, s.misses, s.evictions, s.size };
+  };
+
+  using T = tuple<int64_t, int64_t, int64_t, int>;
+
+  REQUIRE( stats() == T{ 0, 0, 0, 0 } );
+  layout( "aaa", nothing );
+  REQUIRE( stats() == T{ 0, 1, 0, 1 } );
+  layout( "aaa", nothing );
+  REQUIRE( stats() == T{ 1, 1, 0, 1 } );
+  // Same text but reflowed is a different entry.
+  layout( "aaa", 10 );
+  REQUIRE( stats() == T{ 1, 2, 0, 2 } );
+  // "aaa" is now the least recently used, so it gets evicted.
+  layout( "bbb", nothing );
+  REQUIRE( stats() == T{ 1, 3, 1, 2 } );
+  layout( "aaa", 10 );
+  REQUIRE( stats() == T{ 2, 3, 1, 2 } );
+  layout( "aaa", nothing );
+  REQUIRE( stats() == T{ 2, 4, 2, 2 } );
+
+  set_text_layout_cache_capacity( 1 );
+  REQUIRE( stats() == T{ 2, 4, 3, 1 } );
+
+  // A layout stays valid after it is evicted.
+  shared_ptr<TextLayout const> const held =
+      layout( "ccc", nothing );
+  layout( "ddd", nothing );
+  REQUIRE( stats() == T{ 2, 6, 5, 1 } );
+  REQUIRE( *held ==
+           compute_text_layout( kCharSize, nothing, "ccc" ) );
+
+  clear_text_layout_cache();
+  REQUIRE( stats() == T{ 0, 0, 0, 0 } );
+  set_text_layout_cache_capacity( old_capacity );
+}
+
+} // namespace
+} // namespace rn
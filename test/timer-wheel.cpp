@@ -0,0 +1,189 @@
+/****************************************************************
+**timer-wheel.cpp
+*
+* Project: Revolution Now
+*
+* Created by agent on 2026-10-18.
+*
+* Description: Unit tests for the src/timer-wheel.* module.
+*
+*****************************************************************/
+#include "test/testing.hpp"
+
+// Under test.
+#include "src/timer-wheel.hpp"
+
+// C++ standard library
+#include <random>
+
+// Must be last.
+#include "test/catch-common.hpp"
+
+namespace rn {
+namespace {
+
+using namespace std;
+
+TEST_CASE( "[timer-wheel] one-shot" ) {
+  TimerWheel  wheel( /*now=*/100, /*resolution_bits=*/0 );
+  vector<int> fired;
+  wheel.add( 105, 0, [&] { fired.push_back( 1 ); } );
+  wheel.add( 103, 0, [&] { fired.push_back( 2 ); } );
+  wheel.add( 100, 0, [&] { fired.push_back( 3 ); } );
+  REQUIRE( wheel.size() == 3 );
+
+  wheel.advance_to( 100 );
+  REQUIRE( fired == vector<int>{} );
+  wheel.advance_to( 101 );
+  REQUIRE( fired == vector<int>{ 3 } );
+  wheel.advance_to( 104 );
+  REQUIRE( fired == vector<int>{ 3, 2 } );
+  REQUIRE( wheel.size() == 1 );
+  wheel.advance_to( 105 );
+  REQUIRE( fired == vector<int>{ 3, 2, 1 } );
+  REQUIRE( wheel.size() == 0 );
+  wheel.advance_to( 1000 );
+  REQUIRE( fired == vector<int>{ 3, 2, 1 } );
+}
+
+TEST_CASE( "[timer-wheel] cancel" ) {
+  TimerWheel   wheel( /*now=*/0, /*resolution_bits=*/0 );
+  int          fired = 0;
+  TimerWheelId id1   = wheel.add( 10, 0, [&] { ++fired; } );
+  TimerWheelId id2   = wheel.add( 20, 0, [&] { ++fired; } );
+  REQUIRE( wheel.cancel( id1 ) );
+  REQUIRE_FALSE( wheel.cancel( id1 ) );
+  REQUIRE( wheel.size() == 1 );
+  wheel.advance_to( 30 );
+  REQUIRE( fired == 1 );
+  // Already fired.
+  REQUIRE_FALSE( wheel.cancel( id2 ) );
+  // The nodes get reused, but the old ids stay stale.
+  TimerWheelId id3 = wheel.add( 40, 0, [&] { ++fired; } );
+  TimerWheelId id4 = wheel.add( 40, 0, [&] { ++fired; } );
+  REQUIRE_FALSE( wheel.cancel( id1 ) );
+  REQUIRE_FALSE( wheel.cancel( id2 ) );
+  REQUIRE( wheel.size() == 2 );
+  REQUIRE( wheel.cancel( id3 ) );
+  REQUIRE( wheel.cancel( id4 ) );
+  REQUIRE_FALSE( wheel.cancel( TimerWheelId{} ) );
+}
+
+TEST_CASE( "[timer-wheel] repeating" ) {
+  TimerWheel   wheel( /*now=*/0, /*resolution_bits=*/0 );
+  int          fired = 0;
+  TimerWheelId id;
+  id = wheel.add( 10, 10, [&] {
+    ++fired;
+    // Cancel itself after the third time.
+    if( fired == 3 ) REQUIRE( wheel.cancel( id ) );
+  } );
+  wheel.advance_to( 9 );
+  REQUIRE( fired == 0 );
+  wheel.advance_to( 10 );
+  REQUIRE( fired == 1 );
+  wheel.advance_to( 25 );
+  REQUIRE( fired == 2 );
+  // Rescheduled relative to when it fired.
+  wheel.advance_to( 34 );
+  REQUIRE( fired == 2 );
+  wheel.advance_to( 35 );
+  REQUIRE( fired == 3 );
+  REQUIRE( wheel.size() == 0 );
+  wheel.advance_to( 1000 );
+  REQUIRE( fired == 3 );
+}
+
+TEST_CASE( "[timer-wheel] large jump fires once" ) {
+  TimerWheel wheel( /*now=*/0, /*resolution_bits=*/0 );
+  int        fired = 0;
+  wheel.add( 1, 1, [&] { ++fired; } );
+  // A repeating timer does not try to catch up.
+  wheel.advance_to( 1'000'000 );
+  REQUIRE( fired == 1 );
+}
+
+TEST_CASE( "[timer-wheel] callback adds timers" ) {
+  TimerWheel  wheel( /*now=*/0, /*resolution_bits=*/0 );
+  vector<int> fired;
+  wheel.add( 5, 0, [&] {
+    fired.push_back( 1 );
+    wheel.add( 5, 0, [&] { fired.push_back( 2 ); } );
+    wheel.add( 7, 0, [&] { fired.push_back( 3 ); } );
+  } );
+  wheel.advance_to( 5 );
+  REQUIRE( fired == vector<int>{ 1 } );
+  wheel.advance_to( 6 );
+  REQUIRE( fired == vector<int>{ 1, 2 } );
+  wheel.advance_to( 7 );
+  REQUIRE( fired == vector<int>{ 1, 2, 3 } );
+}
+
+TEST_CASE( "[timer-wheel] clear" ) {
+  TimerWheel   wheel( /*now=*/0, /*resolution_bits=*/4 );
+  int          fired = 0;
+  TimerWheelId id    = wheel.add( 10, 0, [&] { ++fired; } );
+  wheel.add( 100'000, 0, [&] { ++fired; } );
+  wheel.clear();
+  REQUIRE( wheel.size() == 0 );
+  REQUIRE_FALSE( wheel.cancel( id ) );
+  wheel.advance_to( 1'000'000 );
+  REQUIRE( fired == 0 );
+}
+
+TEST_CASE( "[timer-wheel] randomized" ) {
+  // Checks that every timer fires exactly once and on time,
+  // using a mix of near and very distant deadlines and of small
+  // and large steps in time.
+  mt19937              rng( 12345 );
+  int const            kResolutionBits = 3;
+  uint64_t const       kSlot = uint64_t{ 1 } << kResolutionBits;
+  TimerWheel           wheel( /*now=*/0, kResolutionBits );
+  uint64_t             now = 0;
+  vector<uint64_t>     deadlines;
+  vector<int>          fire_counts;
+  vector<TimerWheelId> ids;
+  vector<bool>         cancelled;
+  uint64_t             prev = 0;
+  for( int frame = 0; frame < 20000; ++frame ) {
+    int const num_adds = rng() % 5;
+    for( int i = 0; i < num_adds; ++i ) {
+      uint64_t const deadline =
+          now + ( rng() % 4 == 0 ? rng() % ( 1 << 28 )
+                                 : rng() % 2000 );
+      int const n = deadlines.size();
+      deadlines.push_back( deadline );
+      fire_counts.push_back( 0 );
+      cancelled.push_back( false );
+      ids.push_back( wheel.add( deadline, 0, [&, n] {
+        ++fire_counts[n];
+        // Never early, and at most one slot late.
+        REQUIRE( deadlines[n] <= wheel.now() );
+        REQUIRE( prev < deadlines[n] + kSlot );
+      } ) );
+    }
+    if( !ids.empty() && rng() % 3 == 0 ) {
+      int const n = rng() % ids.size();
+      bool const was_active =
+          !cancelled[n] && fire_counts[n] == 0;
+      REQUIRE( wheel.cancel( ids[n] ) == was_active );
+      cancelled[n] = true;
+    }
+    prev = now;
+    now += ( rng() % 10 == 0 ) ? rng() % 100000 : rng() % 20;
+    wheel.advance_to( now );
+  }
+  prev = now;
+  wheel.advance_to( now + ( uint64_t{ 1 } << 29 ) );
+  REQUIRE( wheel.size() == 0 );
+  for( int n = 0; n < int( ids.size() ); ++n ) {
+    INFO( fmt::format( "n={}, deadline={}", n, deadlines[n] ) );
+    if( cancelled[n] )
+      REQUIRE( fire_counts[n] <= 1 );
+    else
+      REQUIRE( fire_counts[n] == 1 );
+  }
+}
+
+} // namespace
+} // namespace rn
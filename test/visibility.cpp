@@ -953,7 +953,11 @@ TEST_CASE( "[visibility] Visibility" ) {
         W.terrain()
             .mutable_player_terrain( e_nation::english )
             .map;
-    player_map[{ .x = 1, .y = 0 }].emplace();
+    // This one has changed (it's now land) since the player last
+    // saw it, so they have their own copy.
+    player_map[{ .x = 1, .y = 0 }].emplace(
+        FogSquare{ .square = MapSquare{} } );
+    // This one refers to the real square.
     player_map[{ .x = 0, .y = 0 }].emplace();
 
     // visible.
@@ -987,6 +991,164 @@ TEST_CASE( "[visibility] Visibility" ) {
   }
 }
 
+TEST_CASE( "[visibility] fog squares refer to the real map" ) {
+  World W;
+  W.create_small_map();
+  Coord const             tile{ .x = 1, .y = 0 };
+  e_nation const          nation = e_nation::english;
+  maybe<FogSquare> const& fog_square =
+      W.player_square( tile, nation );
+  auto player_view = [&]() -> MapSquare const& {
+    return Visibility::create( W.ss(), nation )
+        .square_at( tile );
+  };
+  // Must not go through W.square, which hands out a mutable ref-
+  // erence and so would snapshot the player's square.
+  auto real_square = [&]() -> MapSquare const& {
+    return W.terrain().square_at( tile );
+  };
+
+  REQUIRE( !fog_square.has_value() );
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  REQUIRE( fog_square.has_value() );
+  // No copy is made of a square that the player is looking at.
+  REQUIRE( fog_square->square == nothing );
+  REQUIRE( player_view() == real_square() );
+  REQUIRE_FALSE(
+      W.map_updater().make_square_visible( tile, nation ) );
+
+  // No units can see the tile, so the player keeps the old one.
+  W.map_updater().modify_map_square(
+      tile, []( MapSquare& square ) { square.road = true; } );
+  REQUIRE( real_square().road );
+  REQUIRE( fog_square->square.has_value() );
+  REQUIRE_FALSE( player_view().road );
+  REQUIRE( player_view().surface == e_surface::land );
+
+  // A second change does not touch the player's copy.
+  W.map_updater().modify_map_square(
+      tile,
+      []( MapSquare& square ) { square.irrigation = true; } );
+  REQUIRE_FALSE( player_view().irrigation );
+
+  // Seeing the tile again drops the copy.
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  REQUIRE( fog_square->square == nothing );
+  REQUIRE( player_view().road );
+  REQUIRE( player_view().irrigation );
+
+  // Same when the whole map is changed.
+  W.map_updater().modify_entire_map(
+      [&]( Matrix<MapSquare>& m ) { m[tile].road = false; } );
+  REQUIRE( fog_square->square.has_value() );
+  REQUIRE( player_view().road );
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  REQUIRE_FALSE( player_view().road );
+
+  // Other nations have not seen the tile.
+  REQUIRE(
+      !W.player_square( tile, e_nation::french ).has_value() );
+}
+
+TEST_CASE( "[visibility] non-updater writes stay out of fog" ) {
+  World W;
+  W.create_small_map();
+  Coord const             tile{ .x = 1, .y = 0 };
+  e_nation const          nation = e_nation::english;
+  maybe<FogSquare> const& fog_square =
+      W.player_square( tile, nation );
+  auto player_view = [&]() -> MapSquare const& {
+    return Visibility::create( W.ss(), nation )
+        .square_at( tile );
+  };
+  TerrainState& terrain = W.ss().mutable_terrain_use_with_care;
+
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  REQUIRE( fog_square->square == nothing );
+
+  SECTION( "single square" ) {
+    terrain.mutable_square_at( tile ).road = true;
+    REQUIRE( terrain.square_at( tile ).road );
+    REQUIRE( fog_square->square.has_value() );
+    REQUIRE_FALSE( player_view().road );
+  }
+
+  SECTION( "entire map" ) {
+    terrain.mutable_world_map()[tile].road = true;
+    REQUIRE( terrain.square_at( tile ).road );
+    REQUIRE_FALSE( player_view().road );
+  }
+
+  SECTION( "lua" ) {
+    W.expensive_run_lua_init();
+    W.lua().script.run( R"(
+      local square = ROOT.terrain:mutable_square_at{ x=1, y=0 }
+      square.road = true
+    )" );
+    REQUIRE( terrain.square_at( tile ).road );
+    REQUIRE_FALSE( player_view().road );
+  }
+
+  // Seeing the tile brings the player up to date.
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  REQUIRE( fog_square->square == nothing );
+  REQUIRE( player_view().road );
+}
+
+TEST_CASE( "[visibility] reads leave the fog store alone" ) {
+  World W;
+  W.create_small_map();
+  Coord const    tile{ .x = 1, .y = 0 };
+  e_nation const nation = e_nation::english;
+  REQUIRE( W.map_updater().make_square_visible( tile, nation ) );
+  W.expensive_run_lua_init();
+  W.lua()["SS"] = W.ss();
+
+  auto fog_map = [&]() -> PlayerTerrainMatrix const& {
+    UNWRAP_CHECK( player_terrain,
+                  W.terrain().player_terrain( nation ) );
+    return player_terrain.map;
+  };
+  PlayerTerrainMatrix const expected = fog_map();
+  REQUIRE( expected[tile].has_value() );
+  REQUIRE( expected[tile]->square == nothing );
+
+  SECTION( "c++" ) {
+    REQUIRE_FALSE( W.terrain().square_at( tile ).road );
+    REQUIRE( W.terrain().world_map().size() ==
+             W.terrain().world_size_tiles() );
+  }
+
+  SECTION( "lua" ) {
+    W.lua().script.run( R"(
+      assert( not ROOT.terrain:square_at{ x=1, y=0 }.road )
+    )" );
+  }
+
+  SECTION( "map-gen kernels" ) {
+    // Reads the whole map but there are no rivers to match.
+    W.lua().script.run( R"(
+      local n = map_gen_kernels.fill_where{
+        where={ has_river=true },
+        set={ road=true } }
+      assert( n == 0 )
+    )" );
+  }
+
+  SECTION( "map-gen kernels changing squares" ) {
+    // Changing the map snapshots the fog squares, but the ones
+    // that did not change get dropped again.
+    W.lua().script.run( R"(
+      map_gen_kernels.fill_where{
+        region={ x=0, y=1, w=1, h=1 },
+        set={ road=true } }
+    )" );
+    REQUIRE( W.terrain().square_at( { .x = 0, .y = 1 } ).road );
+  }
+
+  REQUIRE( fog_map() == expected );
+}
+
 TEST_CASE( "[visibility] set_map_visibility" ) {
   World W;
 
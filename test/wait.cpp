@@ -12,7 +12,9 @@
 
 // Revolution Now
 #include "co-scheduler.hpp"
+#include "co-time.hpp"
 #include "co-wait.hpp"
+#include "frame.hpp"
 #include "wait.hpp"
 
 // base
@@ -883,5 +885,57 @@ TEST_CASE( "[wait] exception coro complex" ) {
   }
 }
 
+TEST_CASE( "[wait] on_cancel" ) {
+  wait_promise<> p;
+  int            cancelled = 0;
+  p.on_cancel( [&] { ++cancelled; } );
+  wait<> w = p.wait();
+  REQUIRE( cancelled == 0 );
+  w.cancel();
+  REQUIRE( cancelled == 1 );
+  // Only called once.
+  w.cancel();
+  REQUIRE( cancelled == 1 );
+}
+
+wait<> wait_on_frames( int& places ) {
+  ++places;
+  co_await wait_n_frames( FrameCount{ 5 } );
+  ++places;
+}
+
+TEST_CASE( "[wait] cancelling a timer wait removes the timer" ) {
+  int const start  = active_frame_subscriptions();
+  int       places = 0;
+
+  SECTION( "coroutine cancelled" ) {
+    wait<> w = wait_on_frames( places );
+    run_all_cpp_coroutines();
+    REQUIRE( places == 1 );
+    REQUIRE( active_frame_subscriptions() == start + 1 );
+    w.cancel();
+    REQUIRE( active_frame_subscriptions() == start );
+    REQUIRE( places == 1 );
+  }
+
+  SECTION( "coroutine destroyed" ) {
+    {
+      wait<> w = wait_on_frames( places );
+      run_all_cpp_coroutines();
+      REQUIRE( active_frame_subscriptions() == start + 1 );
+    }
+    REQUIRE( active_frame_subscriptions() == start );
+    REQUIRE( places == 1 );
+  }
+
+  SECTION( "duration" ) {
+    wait<chrono::microseconds> w =
+        wait_for_duration( chrono::seconds{ 5 } );
+    REQUIRE( active_frame_subscriptions() == start + 1 );
+    w.cancel();
+    REQUIRE( active_frame_subscriptions() == start );
+  }
+}
+
 } // namespace
 } // namespace rn